@@ -19,6 +19,7 @@
 #endif
 
 #include "lv_xml.h"
+#include "../lvgl.h"
 #include "lui_xml_base_types.h"
 #include "lui_xml_parser.h"
 #include "lui_xml_component.h"
@@ -28,7 +29,12 @@
 #include "lui_xml_translation.h"
 #include "lui_xml_utils.h"
 #include "lui_xml_load_private.h"
+#include "lui_xml_memory_private.h"
 #include "lui_xml_private.h"
+#include "lui_xml_update_private.h"
+#include "lui_xml_subject_private.h"
+#include "lui_xml_fmt_private.h"
+#include "lui_xml_event_private.h"
 #include "parsers/lui_xml_obj_parser.h"
 #include "parsers/lui_xml_button_parser.h"
 #include "parsers/lui_xml_label_parser.h"
@@ -55,6 +61,7 @@
 #include "parsers/lui_xml_spinner_parser.h"
 #include "parsers/lui_xml_qrcode_parser.h"
 #include "../libs/expat/expat.h"
+#include "lui_xml_pack_private.h"
 #include "../draw/lv_draw_image.h"
 #include "../core/lv_global.h"
 #include "../misc/lv_anim_timeline_private.h"
@@ -77,6 +84,7 @@ static void view_end_element_handler(void * user_data, const char * name);
 static void create_timeline_instances(lui_xml_parser_state_t * state);
 static void get_timeline_from_event_cb(lv_event_t * e);
 static void free_timelines_event_cb(lv_event_t * e);
+static lui_xml_subject_t * find_subject_entry(lui_xml_component_scope_t * scope, const char * name);
 
 /**********************
  *  STATIC VARIABLES
@@ -273,6 +281,19 @@ void lui_xml_deinit(void)
 
     lui_xml_load_deinit();
 
+    lui_xml_subjects_deinit();
+
+#if LUI_XML_USE_COMPILED_FMT
+    lui_xml_fmt_deinit();
+#endif
+
+#if LV_USE_OBJ_NAME
+    lui_xml_update_bin_deinit();
+#if LUI_XML_USE_NAME_INDEX
+    lui_xml_update_index_deinit();
+#endif
+#endif
+
     lv_free((void *)xml_path_prefix);
 }
 
@@ -291,21 +312,30 @@ void * lui_xml_create_in_scope(lv_obj_t * parent, lui_xml_component_scope_t * pa
     lv_obj_t ** parent_node = lv_ll_ins_head(&state.parent_ll);
     *parent_node = parent;
 
-    /* Create an XML parser and set handlers */
-    XML_Memory_Handling_Suite mem_handlers;
-    mem_handlers.malloc_fcn = lv_malloc;
-    mem_handlers.realloc_fcn = lv_realloc;
-    mem_handlers.free_fcn = lv_free;
-    XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
-    XML_SetUserData(parser, &state);
-    XML_SetElementHandler(parser, view_start_element_handler, view_end_element_handler);
-
-    /* Parse the XML */
-    if(XML_Parse(parser, scope->view_def, lv_strlen(scope->view_def), XML_TRUE) == XML_STATUS_ERROR) {
-        LV_LOG_WARN("XML parsing error: %s on line %lu", XML_ErrorString(XML_GetErrorCode(parser)),
-                    XML_GetCurrentLineNumber(parser));
+    if(scope->view_tokens) {
+        /* The view is compiled already, no need to parse it */
+        lui_xml_pack_replay(scope->pack, scope->view_tokens, scope->view_token_cnt, scope->view_token_attrs,
+                            view_start_element_handler, view_end_element_handler, &state);
+    }
+    else {
+        /* Create an XML parser and set handlers */
+        XML_Memory_Handling_Suite mem_handlers;
+        mem_handlers.malloc_fcn = lv_malloc;
+        mem_handlers.realloc_fcn = lv_realloc;
+        mem_handlers.free_fcn = lv_free;
+        XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+        XML_SetUserData(parser, &state);
+        XML_SetElementHandler(parser, view_start_element_handler, view_end_element_handler);
+
+        /* Parse the XML */
+        if(XML_Parse(parser, scope->view_def, scope->view_def_len, XML_TRUE) == XML_STATUS_ERROR) {
+            LV_LOG_WARN("XML parsing error: %s on line %lu", XML_ErrorString(XML_GetErrorCode(parser)),
+                        XML_GetCurrentLineNumber(parser));
+            XML_ParserFree(parser);
+            lv_ll_clear(&state.parent_ll);
+            return NULL;
+        }
         XML_ParserFree(parser);
-        return NULL;
     }
 
     state.item = state.view;
@@ -315,6 +345,7 @@ void * lui_xml_create_in_scope(lv_obj_t * parent, lui_xml_component_scope_t * pa
     if(state.item) {
         if(state.scope.is_screen) {
             lv_obj_set_name(state.item, scope->name);
+            LUI_XML_UPDATE_INDEX_ADD(state.item);
         }
         else if(lv_obj_get_name(state.item) == NULL) {
             char name_buf[128];
@@ -325,8 +356,9 @@ void * lui_xml_create_in_scope(lv_obj_t * parent, lui_xml_component_scope_t * pa
 
     create_timeline_instances(&state);
 
+    lui_xml_memory_count_instance(scope, state.view);
+
     lv_ll_clear(&state.parent_ll);
-    XML_ParserFree(parser);
 
     return state.view;
 }
@@ -379,7 +411,10 @@ void * lui_xml_create(lv_obj_t * parent, const char * name, const char ** attrs)
             p->apply_cb(&state, attrs);
 #if LV_USE_OBJ_NAME
             value_of_name = lui_xml_get_value_of(attrs, "name");
-            if(value_of_name) lv_obj_set_name(item, value_of_name);
+            if(value_of_name) {
+                lv_obj_set_name(item, value_of_name);
+                LUI_XML_UPDATE_INDEX_ADD(item);
+            }
 #endif
         }
 
@@ -389,6 +424,7 @@ void * lui_xml_create(lv_obj_t * parent, const char * name, const char ** attrs)
             char name_buf[128];
             lv_snprintf(name_buf, sizeof(name_buf), "%s_#", scope->name);
             lv_obj_set_name(item, name_buf);
+            LUI_XML_UPDATE_INDEX_ADD(item);
         }
 #endif
 
@@ -434,7 +470,7 @@ lv_result_t lui_xml_register_font(lui_xml_component_scope_t * scope, const char
 
     f = lv_ll_ins_head(&scope->font_ll);
     lv_memzero(f, sizeof(*f));
-    f->name = lv_strdup(name);
+    f->name = lui_xml_arena_strdup(&scope->arena, name);
     f->font = font;
 
     return LV_RESULT_OK;
@@ -442,27 +478,68 @@ lv_result_t lui_xml_register_font(lui_xml_component_scope_t * scope, const char
 
 const lv_font_t * lui_xml_get_font(lui_xml_component_scope_t * scope, const char * name)
 {
-    lui_xml_font_t * f;
+    lui_xml_font_t * f = NULL;
+    lui_xml_font_t * f_act;
     if(scope) {
-        LV_LL_READ(&scope->font_ll, f) {
-            if(lv_streq(f->name, name)) return f->font;
+        LV_LL_READ(&scope->font_ll, f_act) {
+            if(lv_streq(f_act->name, name)) {
+                f = f_act;
+                break;
+            }
         }
     }
 
     /*If not found in the component check the global space*/
-    if((scope == NULL || scope->name == NULL) || !lv_streq(scope->name, "globals")) {
+    if(f == NULL && ((scope == NULL || scope->name == NULL) || !lv_streq(scope->name, "globals"))) {
         scope = lui_xml_component_get_scope("globals");
         if(scope) {
-            LV_LL_READ(&scope->font_ll, f) {
-                if(lv_streq(f->name, name)) return f->font;
+            LV_LL_READ(&scope->font_ll, f_act) {
+                if(lv_streq(f_act->name, name)) {
+                    f = f_act;
+                    break;
+                }
             }
         }
     }
 
-    LV_LOG_WARN("No font was found with name \"%s\". Using LV_FONT_DEFAULT instead.", name);
+    /*Create a lazily loaded font on its first use*/
+    if(f && f->src_path) lui_xml_font_create(f);
+    if(f && f->font) return f->font;
+
+    if(f) LV_LOG_WARN("The font \"%s\" couldn't be created. Using LV_FONT_DEFAULT instead.", name);
+    else LV_LOG_WARN("No font was found with name \"%s\". Using LV_FONT_DEFAULT instead.", name);
     return lv_font_get_default();
 }
 
+lv_result_t lui_xml_font_create(lui_xml_font_t * font)
+{
+    lv_font_t * created = NULL;
+    switch(font->type) {
+        case LUI_XML_FONT_TYPE_TINY_TTF:
+#if LV_TINY_TTF_FILE_SUPPORT
+            created = lv_tiny_ttf_create_file(font->src_path, font->size);
+            font->font_destroy_cb = lv_tiny_ttf_destroy;
+#endif
+            break;
+        case LUI_XML_FONT_TYPE_BIN:
+            created = lv_binfont_create(font->src_path);
+            font->font_destroy_cb = lv_binfont_destroy;
+            break;
+        default:
+            break;
+    }
+
+    if(created == NULL) {
+        LV_LOG_WARN("Couldn't load `%s` font from %s", font->name, font->src_path);
+        font->font_destroy_cb = NULL;
+    }
+
+    font->font = created;
+    font->src_path = NULL;
+
+    return created ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
 lv_result_t lui_xml_register_subject(lui_xml_component_scope_t * scope, const char * name, lv_subject_t * subject)
 {
     if(scope == NULL) scope = lui_xml_component_get_scope("globals");
@@ -481,33 +558,91 @@ lv_result_t lui_xml_register_subject(lui_xml_component_scope_t * scope, const ch
 
     s = lv_ll_ins_head(&scope->subjects_ll);
     lv_memzero(s, sizeof(*s));
-    s->name = lv_strdup(name);
+    s->name = lui_xml_arena_strdup(&scope->arena, name);
     s->subject = subject;
 
+#if LUI_XML_USE_SUBJECT_CACHE
+    /*The new subject can hide a global one with the same name*/
+    if(scope->subject_cache && !lv_streq(scope->name, "globals")) lui_xml_subject_cache_clear(scope->subject_cache);
+#endif
+
     return LV_RESULT_OK;
 }
 
+lui_xml_subject_t * lui_xml_find_subject_entry(lui_xml_component_scope_t * scope, const char * name)
+{
+#if LUI_XML_USE_SUBJECT_CACHE
+    /*Only registered components have a cache, the scopes being parsed don't*/
+    if(scope && scope->subject_cache) {
+        lui_xml_subject_t * s = lui_xml_subject_cache_get(scope->subject_cache, name);
+        if(s) return s;
+
+        s = find_subject_entry(scope, name);
+        if(s) lui_xml_subject_cache_add(scope->subject_cache, name, s);
+        return s;
+    }
+#endif
+
+    return find_subject_entry(scope, name);
+}
+
 lv_subject_t * lui_xml_get_subject(lui_xml_component_scope_t * scope, const char * name)
 {
-    lui_xml_subject_t * s;
-    if(scope) {
-        LV_LL_READ(&scope->subjects_ll, s) {
-            if(lv_streq(s->name, name)) return s->subject;
-        }
+    lui_xml_subject_t * s = lui_xml_find_subject_entry(scope, name);
+    return s ? s->subject : NULL;
+}
+
+lv_subject_t * lui_xml_get_bind_subject(lui_xml_component_scope_t * scope, const char * name)
+{
+    lui_xml_subject_t * s = lui_xml_find_subject_entry(scope, name);
+    if(s == NULL) return NULL;
+
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+    if(s->relay) return s->relay;
+#endif
+    return s->subject;
+}
+
+lv_result_t lui_xml_subject_copy_string(lv_subject_t * subject, const char * str)
+{
+    if(subject->type != LV_SUBJECT_TYPE_STRING) {
+        LV_LOG_WARN("Subject is not a string subject");
+        return LV_RESULT_INVALID;
     }
 
-    /*If not found in the component check the global space*/
-    if((scope == NULL || scope->name == NULL) || !lv_streq(scope->name, "globals")) {
-        scope = lui_xml_component_get_scope("globals");
-        if(scope) {
-            LV_LL_READ(&scope->subjects_ll, s) {
-                if(lv_streq(s->name, name)) return s->subject;
-            }
+    size_t size_req = lv_strlen(str) + 1;
+    if(size_req > subject->size) {
+        lui_xml_subject_t * entry = lui_xml_component_find_subject(subject);
+        if(entry == NULL || !entry->growable) {
+            lv_subject_copy_string(subject, str);
+            return LV_RESULT_INVALID;
+        }
+
+        /*Grow geometrically to avoid reallocating on every small change*/
+        size_t new_size = subject->size * 2;
+        if(new_size < size_req) new_size = size_req;
+
+        char * buf_act = lv_realloc((void *)subject->value.pointer, new_size);
+        LV_ASSERT_MALLOC(buf_act);
+        if(buf_act == NULL) {
+            lv_subject_copy_string(subject, str);
+            return LV_RESULT_INVALID;
+        }
+        subject->value.pointer = buf_act;
+
+        char * buf_prev = lv_realloc((void *)subject->prev_value.pointer, new_size);
+        LV_ASSERT_MALLOC(buf_prev);
+        if(buf_prev == NULL) {
+            /*The active buffer is already larger, but keep using the old size for both*/
+            lv_subject_copy_string(subject, str);
+            return LV_RESULT_INVALID;
         }
+        subject->prev_value.pointer = buf_prev;
+        subject->size = new_size;
     }
 
-    LV_LOG_WARN("No subject was found with name \"%s\".", name);
-    return NULL;
+    lv_subject_copy_string(subject, str);
+    return LV_RESULT_OK;
 }
 
 
@@ -528,7 +663,7 @@ lv_result_t lui_xml_register_timeline(lui_xml_component_scope_t * scope, const c
     }
 
     at = lv_ll_ins_head(&scope->timeline_ll);
-    at->name = lv_strdup(name);
+    at->name = lui_xml_arena_strdup(&scope->arena, name);
     lv_ll_init(&at->anims_ll, sizeof(lui_xml_anim_timeline_child_t));
 
     return LV_RESULT_OK;
@@ -577,8 +712,8 @@ lv_result_t lui_xml_register_const(lui_xml_component_scope_t * scope, const char
     cnst = lv_ll_ins_head(&scope->const_ll);
     lv_memzero(cnst, sizeof(*cnst));
 
-    cnst->name = lv_strdup(name);
-    cnst->value = lv_strdup(value);
+    cnst->name = lui_xml_arena_strdup(&scope->arena, name);
+    cnst->value = lui_xml_arena_strdup(&scope->arena, value);
 
     return LV_RESULT_OK;
 }
@@ -629,11 +764,11 @@ lv_result_t lui_xml_register_image(lui_xml_component_scope_t * scope, const char
 
     img = lv_ll_ins_head(&scope->image_ll);
     lv_memzero(img, sizeof(*img));
-    img->name = lv_strdup(name);
+    img->name = lui_xml_arena_strdup(&scope->arena, name);
     if(lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) {
         char buf[LUI_XML_MAX_PATH_LENGTH];
         lv_snprintf(buf, sizeof(buf), "%s%s", xml_path_prefix, src);
-        img->src = lv_strdup(buf);
+        img->src = lui_xml_arena_strdup(&scope->arena, buf);
     }
     else {
         img->src = src;
@@ -684,9 +819,14 @@ lv_result_t lui_xml_register_event_cb(lui_xml_component_scope_t * scope, const c
         }
     }
 
+#if LUI_XML_USE_EVENT_CB_CACHE
+    /*The new callback can hide a cached global one*/
+    lui_xml_event_cache_invalidate();
+#endif
+
     e = lv_ll_ins_head(&scope->event_ll);
     lv_memzero(e, sizeof(*e));
-    e->name = lv_strdup(name);
+    e->name = lui_xml_arena_strdup(&scope->arena, name);
     e->cb = cb;
 
     return LV_RESULT_OK;
@@ -719,10 +859,65 @@ lv_event_cb_t lui_xml_get_event_cb(lui_xml_component_scope_t * scope, const char
     return NULL;
 }
 
+void lui_xml_view_resolve_attrs(lui_xml_parser_state_t * state, const char ** attrs)
+{
+    resolve_params(&state->scope, state->parent_scope, attrs, state->parent_attrs);
+    resolve_consts(attrs, &state->scope);
+}
+
+void lui_xml_view_start_element(void * user_data, const char * name, const char ** attrs)
+{
+    view_start_element_handler(user_data, name, attrs);
+}
+
+void lui_xml_view_end_element(void * user_data, const char * name)
+{
+    view_end_element_handler(user_data, name);
+}
+
+void lui_xml_create_timelines(lv_obj_t * view, lui_xml_component_scope_t * scope)
+{
+    lui_xml_parser_state_t state;
+    lui_xml_parser_state_init(&state);
+    state.scope = *scope;
+    state.view = view;
+
+    create_timeline_instances(&state);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Find a subject by name in a scope and then in the globals
+ * @param scope     the scope to start searching in or NULL to search only the global subjects
+ * @param name      name of the subject
+ * @return          the entry or NULL if not found
+ */
+static lui_xml_subject_t * find_subject_entry(lui_xml_component_scope_t * scope, const char * name)
+{
+    lui_xml_subject_t * s;
+    if(scope) {
+        LV_LL_READ(&scope->subjects_ll, s) {
+            if(lv_streq(s->name, name)) return s;
+        }
+    }
+
+    /*If not found in the component check the global space*/
+    if((scope == NULL || scope->name == NULL) || !lv_streq(scope->name, "globals")) {
+        scope = lui_xml_component_get_scope("globals");
+        if(scope) {
+            LV_LL_READ(&scope->subjects_ll, s) {
+                if(lv_streq(s->name, name)) return s;
+            }
+        }
+    }
+
+    LV_LOG_WARN("No subject was found with name \"%s\".", name);
+    return NULL;
+}
+
 static const char * get_param_type(lui_xml_component_scope_t * scope, const char * name)
 {
     lui_xml_param_t * p;
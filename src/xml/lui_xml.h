@@ -23,6 +23,7 @@ extern "C" {
 #include "lui_xml_component.h"
 #include "lui_xml_widget.h"
 #include "lui_xml_load.h"
+#include "lui_xml_memory.h"
 
 /*********************
  *      DEFINES
@@ -30,6 +31,28 @@ extern "C" {
 
 #define LUI_XML_MAX_PATH_LENGTH 256
 
+/** Size of the buffer used to read XML files chunk by chunk*/
+#ifndef LUI_XML_STREAM_BUF_SIZE
+#define LUI_XML_STREAM_BUF_SIZE 1024
+#endif
+
+/** Buffer size of string subjects declared without `max_length` and `growable`*/
+#ifndef LUI_XML_STRING_SUBJECT_DEFAULT_SIZE
+#define LUI_XML_STRING_SUBJECT_DEFAULT_SIZE 256
+#endif
+
+/** 1: size the buffer of string subjects declared without `max_length` to the initial value,
+ *  like `max_length="auto"`, instead of `LUI_XML_STRING_SUBJECT_DEFAULT_SIZE`*/
+#ifndef LUI_XML_STRING_SUBJECT_AUTO_SIZE
+#define LUI_XML_STRING_SUBJECT_AUTO_SIZE 0
+#endif
+
+/** Minimum initial buffer size of growable and auto sized string subjects.
+ *  Otherwise the buffer is sized to the initial value.*/
+#ifndef LUI_XML_STRING_SUBJECT_MIN_SIZE
+#define LUI_XML_STRING_SUBJECT_MIN_SIZE 16
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -109,6 +132,17 @@ lv_result_t lui_xml_register_subject(lui_xml_component_scope_t * scope, const ch
  */
 lv_subject_t * lui_xml_get_subject(lui_xml_component_scope_t * scope, const char * name);
 
+/**
+ * Copy a string to a string subject and notify the observers.
+ * If the subject was declared with `growable="true"` in XML
+ * its buffers are enlarged to fit the new string,
+ * otherwise the string is truncated to the size of the subject.
+ * @param subject   pointer to a string subject
+ * @param str       the string to copy
+ * @return          LV_RESULT_OK: the whole string was copied, LV_RESULT_INVALID: it was truncated
+ */
+lv_result_t lui_xml_subject_copy_string(lv_subject_t * subject, const char * str);
+
 lv_result_t lui_xml_register_const(lui_xml_component_scope_t * scope, const char * name, const char * value);
 
 const char * lui_xml_get_const(lui_xml_component_scope_t * scope, const char * name);
@@ -0,0 +1,161 @@
+/**
+ * @file lui_xml_arena.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_arena.h"
+#if LV_USE_XML
+
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ARENA_ALIGN         sizeof(void *)
+#define ALIGN_UP(x)         (((x) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lui_xml_arena_chunk_t {
+    struct _lui_xml_arena_chunk_t * next;
+    size_t size;
+    size_t used;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lui_xml_arena_chunk_t * chunk_create(lui_xml_arena_t * arena, size_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+#define CHUNK_DATA(c)   ((uint8_t *)(c) + ALIGN_UP(sizeof(lui_xml_arena_chunk_t)))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lui_xml_arena_init(lui_xml_arena_t * arena, uint32_t chunk_size)
+{
+    lv_memzero(arena, sizeof(lui_xml_arena_t));
+    arena->chunk_size = chunk_size ? chunk_size : LUI_XML_ARENA_CHUNK_SIZE;
+}
+
+void * lui_xml_arena_alloc(lui_xml_arena_t * arena, size_t size)
+{
+    if(size == 0) size = 1;
+    size = ALIGN_UP(size);
+
+    lui_xml_arena_chunk_t * chunk = arena->head;
+    if(chunk && chunk->size - chunk->used >= size) {
+        void * p = CHUNK_DATA(chunk) + chunk->used;
+        chunk->used += size;
+        arena->used_size += size;
+        arena->alloc_cnt++;
+        return p;
+    }
+
+    /*Large blocks get their own chunk. Link it behind the head
+     *so that the free space of the current chunk is not wasted*/
+    if(size > arena->chunk_size / 2) {
+        chunk = chunk_create(arena, size);
+        if(chunk == NULL) return NULL;
+
+        if(arena->head) {
+            chunk->next = arena->head->next;
+            arena->head->next = chunk;
+        }
+        else {
+            arena->head = chunk;
+        }
+    }
+    else {
+        chunk = chunk_create(arena, arena->chunk_size);
+        if(chunk == NULL) return NULL;
+
+        chunk->next = arena->head;
+        arena->head = chunk;
+    }
+
+    chunk->used = size;
+    arena->used_size += size;
+    arena->alloc_cnt++;
+    return CHUNK_DATA(chunk);
+}
+
+void * lui_xml_arena_zalloc(lui_xml_arena_t * arena, size_t size)
+{
+    void * p = lui_xml_arena_alloc(arena, size);
+    if(p) lv_memzero(p, size);
+    return p;
+}
+
+char * lui_xml_arena_strdup(lui_xml_arena_t * arena, const char * str)
+{
+    if(str == NULL) return NULL;
+    return lui_xml_arena_strndup(arena, str, lv_strlen(str));
+}
+
+char * lui_xml_arena_strndup(lui_xml_arena_t * arena, const char * str, size_t len)
+{
+    char * p = lui_xml_arena_alloc(arena, len + 1);
+    if(p == NULL) return NULL;
+
+    lv_memcpy(p, str, len);
+    p[len] = '\0';
+    return p;
+}
+
+void lui_xml_arena_destroy(lui_xml_arena_t * arena)
+{
+    lui_xml_arena_chunk_t * chunk = arena->head;
+    while(chunk) {
+        lui_xml_arena_chunk_t * next = chunk->next;
+        lv_free(chunk);
+        chunk = next;
+    }
+
+    uint32_t chunk_size = arena->chunk_size;
+    lui_xml_arena_init(arena, chunk_size);
+}
+
+void lui_xml_arena_get_stats(const lui_xml_arena_t * arena, lui_xml_arena_stats_t * stats)
+{
+    stats->chunk_cnt = arena->chunk_cnt;
+    stats->alloc_cnt = arena->alloc_cnt;
+    stats->total_size = arena->total_size;
+    stats->used_size = arena->used_size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lui_xml_arena_chunk_t * chunk_create(lui_xml_arena_t * arena, size_t size)
+{
+    lui_xml_arena_chunk_t * chunk = lv_malloc(ALIGN_UP(sizeof(lui_xml_arena_chunk_t)) + size);
+    LV_ASSERT_MALLOC(chunk);
+    if(chunk == NULL) return NULL;
+
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+
+    arena->chunk_cnt++;
+    arena->total_size += size;
+
+    return chunk;
+}
+
+#endif /* LV_USE_XML */
@@ -0,0 +1,125 @@
+/**
+ * @file lui_xml_arena.h
+ *
+ */
+
+#ifndef LUI_XML_ARENA_H
+#define LUI_XML_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#if LV_USE_XML
+
+#include LV_STDINT_INCLUDE
+#include LV_STDDEF_INCLUDE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Size of a regular arena chunk in bytes.
+ *  Larger allocations get a dedicated chunk of their own size.*/
+#ifndef LUI_XML_ARENA_CHUNK_SIZE
+#define LUI_XML_ARENA_CHUNK_SIZE 1024
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lui_xml_arena_chunk_t lui_xml_arena_chunk_t;
+
+/**
+ * A simple bump allocator. Memory can't be freed one-by-one,
+ * only all at once with `lui_xml_arena_destroy()`.
+ */
+typedef struct {
+    lui_xml_arena_chunk_t * head;   /**< The chunk which is being filled now (the newest regular chunk)*/
+    uint32_t chunk_size;            /**< Size of the regular chunks*/
+    uint32_t chunk_cnt;             /**< Number of allocated chunks*/
+    uint32_t alloc_cnt;             /**< Number of allocations served*/
+    size_t total_size;              /**< Bytes allocated from the heap for the chunks' data*/
+    size_t used_size;               /**< Bytes handed out, including alignment padding*/
+} lui_xml_arena_t;
+
+typedef struct {
+    uint32_t chunk_cnt;     /**< Number of heap blocks used by the arena*/
+    uint32_t alloc_cnt;     /**< Number of allocations served from the arena*/
+    size_t total_size;      /**< Bytes reserved from the heap*/
+    size_t used_size;       /**< Bytes actually used*/
+} lui_xml_arena_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an arena. No memory is allocated until the first `lui_xml_arena_alloc()`.
+ * @param arena         pointer to an arena
+ * @param chunk_size    size of the regular chunks, 0 to use `LUI_XML_ARENA_CHUNK_SIZE`
+ */
+void lui_xml_arena_init(lui_xml_arena_t * arena, uint32_t chunk_size);
+
+/**
+ * Allocate memory from an arena. The returned memory is aligned to pointer size.
+ * @param arena     pointer to an initialized arena
+ * @param size      number of bytes to allocate
+ * @return          pointer to the allocated memory or NULL on error
+ */
+void * lui_xml_arena_alloc(lui_xml_arena_t * arena, size_t size);
+
+/**
+ * Allocate zeroed memory from an arena.
+ * @param arena     pointer to an initialized arena
+ * @param size      number of bytes to allocate
+ * @return          pointer to the allocated memory or NULL on error
+ */
+void * lui_xml_arena_zalloc(lui_xml_arena_t * arena, size_t size);
+
+/**
+ * Copy a string into an arena.
+ * @param arena     pointer to an initialized arena
+ * @param str       the string to copy
+ * @return          pointer to the copy or NULL if `str` was NULL or on error
+ */
+char * lui_xml_arena_strdup(lui_xml_arena_t * arena, const char * str);
+
+/**
+ * Copy `len` characters of a string into an arena and NULL terminate it.
+ * @param arena     pointer to an initialized arena
+ * @param str       the string to copy
+ * @param len       number of characters to copy
+ * @return          pointer to the copy or NULL on error
+ */
+char * lui_xml_arena_strndup(lui_xml_arena_t * arena, const char * str, size_t len);
+
+/**
+ * Free all the memory of an arena at once. The arena can be reused after this.
+ * @param arena     pointer to an arena
+ */
+void lui_xml_arena_destroy(lui_xml_arena_t * arena);
+
+/**
+ * Get the memory usage of an arena
+ * @param arena     pointer to an arena
+ * @param stats     store the result here
+ */
+void lui_xml_arena_get_stats(const lui_xml_arena_t * arena, lui_xml_arena_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_ARENA_H*/
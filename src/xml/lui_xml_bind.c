@@ -0,0 +1,233 @@
+/**
+ * @file lui_xml_bind.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_bind_private.h"
+#if LV_USE_XML && LUI_XML_USE_SHARED_BINDINGS
+
+#include "../lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    TARGET_FLAG,
+    TARGET_STATE,
+} target_type_t;
+
+typedef struct {
+    lv_obj_t * obj;
+    uint32_t value;             /**< The flag or state to add or remove*/
+} member_t;
+
+/** The widgets bound by the same rule, updated by one observer*/
+typedef struct group_s {
+    struct group_s * next;
+    lv_subject_t * subject;
+    lv_observer_t * observer;
+    member_t * members;
+    uint32_t member_cnt;
+    uint32_t member_cap;
+    int32_t ref_value;
+    lui_xml_bind_op_t op;
+    target_type_t type;
+} group_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void bind(lv_obj_t * obj, lv_subject_t * subject, lui_xml_bind_op_t op, target_type_t type, uint32_t value,
+                 int32_t ref_value);
+static bool condition_met(const group_t * group);
+static void apply_member(const member_t * member, target_type_t type, bool met);
+static void group_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
+static void member_delete_event_cb(lv_event_t * e);
+static void group_delete(group_t * group);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static group_t * groups;        /**< The most recently created first, as the next widgets are likely to match it*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lui_xml_bind_flag_if(lv_obj_t * obj, lv_subject_t * subject, lui_xml_bind_op_t op, lv_obj_flag_t flag,
+                          int32_t ref_value)
+{
+    bind(obj, subject, op, TARGET_FLAG, flag, ref_value);
+}
+
+void lui_xml_bind_state_if(lv_obj_t * obj, lv_subject_t * subject, lui_xml_bind_op_t op, lv_state_t state,
+                           int32_t ref_value)
+{
+    bind(obj, subject, op, TARGET_STATE, state, ref_value);
+}
+
+void lui_xml_bind_remove_subject(lv_subject_t * subject)
+{
+    group_t * group = groups;
+    while(group) {
+        group_t * next = group->next;
+        if(group->subject == subject) group_delete(group);
+        group = next;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void bind(lv_obj_t * obj, lv_subject_t * subject, lui_xml_bind_op_t op, target_type_t type, uint32_t value,
+                 int32_t ref_value)
+{
+    if(subject->type != LV_SUBJECT_TYPE_INT) {
+        LV_LOG_WARN("Only int subjects can be bound to flags and states");
+        return;
+    }
+
+    group_t * group;
+    for(group = groups; group; group = group->next) {
+        if(group->subject == subject && group->op == op && group->type == type && group->ref_value == ref_value) break;
+    }
+
+    bool new_group = group == NULL;
+    if(new_group) {
+        group = lv_zalloc(sizeof(group_t));
+        LV_ASSERT_MALLOC(group);
+        if(group == NULL) return;
+
+        group->subject = subject;
+        group->op = op;
+        group->type = type;
+        group->ref_value = ref_value;
+    }
+
+    if(group->member_cnt == group->member_cap) {
+        uint32_t cap = group->member_cap ? group->member_cap * 2 : 4;
+        member_t * members_new = lv_realloc(group->members, cap * sizeof(member_t));
+        LV_ASSERT_MALLOC(members_new);
+        if(members_new == NULL) {
+            if(new_group) lv_free(group);
+            return;
+        }
+        group->members = members_new;
+        group->member_cap = cap;
+    }
+
+    member_t * member = &group->members[group->member_cnt];
+    member->obj = obj;
+    member->value = value;
+    group->member_cnt++;
+
+    lv_obj_add_event_cb(obj, member_delete_event_cb, LV_EVENT_DELETE, group);
+
+    if(new_group) {
+        /*Notifies the observer, which applies the condition to the new member too*/
+        group->observer = lv_subject_add_observer(subject, group_observer_cb, group);
+        group->next = groups;
+        groups = group;
+    }
+    else {
+        apply_member(member, type, condition_met(group));
+    }
+}
+
+static bool condition_met(const group_t * group)
+{
+    int32_t v = lv_subject_get_int(group->subject);
+    switch(group->op) {
+        case LUI_XML_BIND_OP_EQ:
+            return v == group->ref_value;
+        case LUI_XML_BIND_OP_NOT_EQ:
+            return v != group->ref_value;
+        case LUI_XML_BIND_OP_GT:
+            return v > group->ref_value;
+        case LUI_XML_BIND_OP_GE:
+            return v >= group->ref_value;
+        case LUI_XML_BIND_OP_LT:
+            return v < group->ref_value;
+        case LUI_XML_BIND_OP_LE:
+            return v <= group->ref_value;
+        default:
+            return false;
+    }
+}
+
+static void apply_member(const member_t * member, target_type_t type, bool met)
+{
+    if(type == TARGET_FLAG) {
+        if(met) lv_obj_add_flag(member->obj, member->value);
+        else lv_obj_remove_flag(member->obj, member->value);
+    }
+    else {
+        if(met) lv_obj_add_state(member->obj, member->value);
+        else lv_obj_remove_state(member->obj, member->value);
+    }
+}
+
+static void group_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    LV_UNUSED(subject);
+
+    group_t * group = lv_observer_get_user_data(observer);
+    bool met = condition_met(group);
+    uint32_t i;
+    for(i = 0; i < group->member_cnt; i++) {
+        apply_member(&group->members[i], group->type, met);
+    }
+}
+
+/**
+ * Remove a member of the deleted widget. A widget bound more times to the same group
+ * has an event callback for each, so one is removed per call.
+ */
+static void member_delete_event_cb(lv_event_t * e)
+{
+    group_t * group = lv_event_get_user_data(e);
+    lv_obj_t * obj = lv_event_get_current_target(e);
+
+    uint32_t i;
+    for(i = 0; i < group->member_cnt; i++) {
+        if(group->members[i].obj == obj) {
+            group->member_cnt--;
+            group->members[i] = group->members[group->member_cnt];
+            break;
+        }
+    }
+
+    if(group->member_cnt == 0) group_delete(group);
+}
+
+static void group_delete(group_t * group)
+{
+    uint32_t i;
+    for(i = 0; i < group->member_cnt; i++) {
+        lv_obj_remove_event_cb_with_user_data(group->members[i].obj, member_delete_event_cb, group);
+    }
+
+    if(group->observer) lv_observer_remove(group->observer);
+
+    group_t ** g = &groups;
+    while(*g != group) g = &(*g)->next;
+    *g = group->next;
+
+    lv_free(group->members);
+    lv_free(group);
+}
+
+#endif /*LV_USE_XML && LUI_XML_USE_SHARED_BINDINGS*/
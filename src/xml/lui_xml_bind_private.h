@@ -0,0 +1,84 @@
+/**
+ * @file lui_xml_bind_private.h
+ *
+ */
+
+#ifndef LUI_XML_BIND_PRIVATE_H
+#define LUI_XML_BIND_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_subject.h"
+#if LV_USE_XML && LUI_XML_USE_SHARED_BINDINGS
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    LUI_XML_BIND_OP_EQ,
+    LUI_XML_BIND_OP_NOT_EQ,
+    LUI_XML_BIND_OP_GT,
+    LUI_XML_BIND_OP_GE,
+    LUI_XML_BIND_OP_LT,
+    LUI_XML_BIND_OP_LE,
+    LUI_XML_BIND_OP_INVALID,
+} lui_xml_bind_op_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Add a flag of a widget if the value of a subject meets a condition, and remove it otherwise.
+ * Works like `lv_obj_bind_flag_if_eq()` and its pairs, but the widgets bound with the same
+ * subject, condition and reference value are updated by one observer.
+ * The binding is removed when the widget is deleted.
+ * @param obj       the widget
+ * @param subject   an int subject
+ * @param op        the condition
+ * @param flag      the flag to add or remove
+ * @param ref_value the value to compare the subject's value to
+ */
+void lui_xml_bind_flag_if(lv_obj_t * obj, lv_subject_t * subject, lui_xml_bind_op_t op, lv_obj_flag_t flag,
+                          int32_t ref_value);
+
+/**
+ * Add a state of a widget if the value of a subject meets a condition, and remove it otherwise.
+ * Works like `lui_xml_bind_flag_if()`.
+ * @param obj       the widget
+ * @param subject   an int subject
+ * @param op        the condition
+ * @param state     the state to add or remove
+ * @param ref_value the value to compare the subject's value to
+ */
+void lui_xml_bind_state_if(lv_obj_t * obj, lv_subject_t * subject, lui_xml_bind_op_t op, lv_state_t state,
+                           int32_t ref_value);
+
+/**
+ * Remove the shared bindings of a subject. Should be called before the subject is freed or deinitialized.
+ * @param subject   the subject
+ */
+void lui_xml_bind_remove_subject(lv_subject_t * subject);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML && LUI_XML_USE_SHARED_BINDINGS */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_BIND_PRIVATE_H*/
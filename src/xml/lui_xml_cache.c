@@ -0,0 +1,387 @@
+/**
+ * @file lui_xml_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_cache_private.h"
+#if LV_USE_XML && LUI_XML_USE_CACHE
+
+#include "lui_xml_private.h"
+#include "lui_xml_component_private.h"
+#include "lui_xml_load_private.h"
+#include "lui_xml_pack_private.h"
+#include "lui_xml_profile_private.h"
+#include "../misc/lv_fs.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../stdlib/lv_sprintf.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CACHE_MAGIC         "LXCA"
+#define CACHE_FILE_EXT      ".lxc"
+
+/** The cache files are invalid if any of these change*/
+#define CACHE_LVGL_VERSION  ((LVGL_VERSION_MAJOR << 16) | (LVGL_VERSION_MINOR << 8) | LVGL_VERSION_PATCH)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*
+ * Layout of a cache file: the header followed by a pack of one XML file.
+ * The file name is the key, so files with the same content share the cache file.
+ */
+typedef struct {
+    char magic[4];              /**< CACHE_MAGIC*/
+    uint32_t version;           /**< LUI_XML_CACHE_VERSION*/
+    uint32_t lvgl_version;      /**< CACHE_LVGL_VERSION*/
+    uint32_t pack_version;      /**< LUI_XML_PACK_VERSION*/
+    uint32_t key[2];            /**< Hash of the versions, the component's name and the XML*/
+    uint32_t pack_size;
+    uint32_t pack_hash;         /**< Hash of the pack to detect corruption*/
+} cache_header_t;
+
+/** A pack registered from the cache*/
+typedef struct _cache_pack_t {
+    lui_xml_pack_t * pack;
+    void * buf;
+    struct _cache_pack_t * next;
+} cache_pack_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void get_key(const char * name, const char * buf, uint32_t size, uint32_t key[2]);
+static void * read_cache_file(const char * cache_path, const uint32_t key[2], uint32_t * pack_size);
+static void write_cache_file(const char * cache_path, const uint32_t key[2], const void * pack, uint32_t pack_size);
+static bool register_pack(void * buf, uint32_t size);
+static const char * get_replaceable_name(const lui_xml_pack_t * pack);
+static void free_unused_packs(const char * name);
+static uint32_t hash32(const void * data, uint32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static char * cache_dir;
+static cache_pack_t * pack_head;
+static lui_xml_cache_stats_t cache_stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lui_xml_cache_set_path(const char * path)
+{
+    lv_free(cache_dir);
+    cache_dir = path ? lv_strdup(path) : NULL;
+}
+
+void lui_xml_cache_get_stats(lui_xml_cache_stats_t * stats)
+{
+    *stats = cache_stats;
+}
+
+void lui_xml_cache_reset_stats(void)
+{
+    lv_memzero(&cache_stats, sizeof(cache_stats));
+}
+
+bool lui_xml_cache_is_enabled(void)
+{
+    return cache_dir != NULL;
+}
+
+lv_result_t lui_xml_cache_load_file(const char * path)
+{
+    if(cache_dir == NULL) return LV_RESULT_INVALID;
+
+    /*The file needs to be read anyway to compute its key, but it's not parsed*/
+    uint32_t xml_size;
+    if(lv_fs_path_get_size(path, &xml_size) != LV_FS_RES_OK) return LV_RESULT_INVALID;
+
+    char * xml_buf = lv_malloc(xml_size + 1);
+    LV_ASSERT_MALLOC(xml_buf);
+    if(xml_buf == NULL) return LV_RESULT_INVALID;
+    LUI_XML_PROFILE_BEGIN(READ);
+    lv_fs_res_t fs_res = lv_fs_load_to_buf(xml_buf, xml_size, path);
+    LUI_XML_PROFILE_END();
+    if(fs_res != LV_FS_RES_OK) {
+        lv_free(xml_buf);
+        return LV_RESULT_INVALID;
+    }
+
+    char * name = lui_xml_load_get_component_name(path);
+    if(name == NULL) {
+        lv_free(xml_buf);
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t key[2];
+    get_key(name, xml_buf, xml_size, key);
+    lv_free(name);
+
+    char cache_path[LV_FS_MAX_PATH_LENGTH];
+    size_t dir_len = lv_strlen(cache_dir);
+    char last = dir_len ? cache_dir[dir_len - 1] : ':';
+    const char * sep = (last == '/' || last == '\\' || last == ':') ? "" : "/";
+    lv_snprintf(cache_path, sizeof(cache_path), "%s%s%08" LV_PRIx32 "%08" LV_PRIx32 CACHE_FILE_EXT, cache_dir, sep,
+                key[1], key[0]);
+
+    uint32_t pack_size;
+    LUI_XML_PROFILE_BEGIN(READ);
+    void * pack = read_cache_file(cache_path, key, &pack_size);
+    LUI_XML_PROFILE_END();
+    if(pack && register_pack(pack, pack_size)) {
+        LV_LOG_INFO("Registered %s from the cache", path);
+        cache_stats.hit_cnt++;
+        lv_free(xml_buf);
+        return LV_RESULT_OK;
+    }
+
+    /*Not in the cache or it was invalid: compile it and add it to the cache*/
+    LUI_XML_PROFILE_BEGIN(PARSE);
+    pack = lui_xml_pack_compile_buf(path, xml_buf, xml_size, &pack_size);
+    LUI_XML_PROFILE_END();
+    lv_free(xml_buf);
+    if(pack == NULL) return LV_RESULT_INVALID;
+
+    LV_LOG_INFO("%s is not in the cache, adding it", path);
+    cache_stats.miss_cnt++;
+    write_cache_file(cache_path, key, pack, pack_size);
+
+    if(!register_pack(pack, pack_size)) return LV_RESULT_INVALID;
+
+    return LV_RESULT_OK;
+}
+
+void lui_xml_cache_deinit(void)
+{
+    while(pack_head) {
+        cache_pack_t * next = pack_head->next;
+        lui_xml_unload_pack(pack_head->pack);
+        lv_free(pack_head->buf);
+        lv_free(pack_head);
+        pack_head = next;
+    }
+
+    lv_free(cache_dir);
+    cache_dir = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the key of a file: a 64 bit FNV-1a hash of everything the cached form depends on
+ * @param name      name of the component defined by the file
+ * @param buf       content of the file
+ * @param size      size of `buf`
+ * @param key       store the key here
+ */
+static void get_key(const char * name, const char * buf, uint32_t size, uint32_t key[2])
+{
+    const uint32_t versions[3] = {LUI_XML_CACHE_VERSION, CACHE_LVGL_VERSION, LUI_XML_PACK_VERSION};
+    const uint8_t * parts[3] = {(const uint8_t *)versions, (const uint8_t *)name, (const uint8_t *)buf};
+    uint32_t part_sizes[3] = {sizeof(versions), lv_strlen(name) + 1, size};
+
+    uint64_t hash = 14695981039346656037ull;
+    uint32_t p;
+    for(p = 0; p < 3; p++) {
+        uint32_t i;
+        for(i = 0; i < part_sizes[p]; i++) {
+            hash = (hash ^ parts[p][i]) * 1099511628211ull;
+        }
+    }
+
+    key[0] = (uint32_t)hash;
+    key[1] = (uint32_t)(hash >> 32);
+}
+
+/**
+ * Read and check a cache file
+ * @param cache_path    path to the cache file
+ * @param key           the expected key
+ * @param pack_size     store the size of the pack here
+ * @return              the pack (free with `lv_free()`) or NULL if missing or invalid
+ */
+static void * read_cache_file(const char * cache_path, const uint32_t key[2], uint32_t * pack_size)
+{
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, cache_path, LV_FS_MODE_RD) != LV_FS_RES_OK) return NULL;
+
+    cache_header_t header;
+    uint32_t rn = 0;
+    lv_fs_res_t res = lv_fs_read(&f, &header, sizeof(header), &rn);
+    if(res != LV_FS_RES_OK || rn != sizeof(header) || lv_memcmp(header.magic, CACHE_MAGIC, 4) != 0 ||
+       header.version != LUI_XML_CACHE_VERSION || header.lvgl_version != CACHE_LVGL_VERSION ||
+       header.pack_version != LUI_XML_PACK_VERSION || header.key[0] != key[0] || header.key[1] != key[1]) {
+        LV_LOG_WARN("Ignoring %s as it was written by another version or is corrupted", cache_path);
+        cache_stats.invalid_cnt++;
+        lv_fs_close(&f);
+        return NULL;
+    }
+
+    /*Check the size before allocating, a garbage size could make it fail or waste memory*/
+    uint32_t file_size = 0;
+    res = lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    if(res == LV_FS_RES_OK) res = lv_fs_tell(&f, &file_size);
+    if(res == LV_FS_RES_OK) res = lv_fs_seek(&f, sizeof(header), LV_FS_SEEK_SET);
+    if(res != LV_FS_RES_OK || file_size < sizeof(header) || header.pack_size != file_size - sizeof(header)) {
+        LV_LOG_WARN("Ignoring %s as it's truncated or corrupted", cache_path);
+        cache_stats.invalid_cnt++;
+        lv_fs_close(&f);
+        return NULL;
+    }
+
+    /*Allocated to be aligned to 4 bytes as the pack is used in place*/
+    uint8_t * pack = lv_malloc(header.pack_size + 1);
+    LV_ASSERT_MALLOC(pack);
+    if(pack == NULL) {
+        lv_fs_close(&f);
+        return NULL;
+    }
+
+    res = lv_fs_read(&f, pack, header.pack_size, &rn);
+    lv_fs_close(&f);
+    if(res != LV_FS_RES_OK || rn != header.pack_size || hash32(pack, header.pack_size) != header.pack_hash) {
+        LV_LOG_WARN("Ignoring %s as it's corrupted", cache_path);
+        cache_stats.invalid_cnt++;
+        lv_free(pack);
+        return NULL;
+    }
+
+    *pack_size = header.pack_size;
+    return pack;
+}
+
+static void write_cache_file(const char * cache_path, const uint32_t key[2], const void * pack, uint32_t pack_size)
+{
+    cache_header_t header;
+    lv_memzero(&header, sizeof(header));
+    lv_memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = LUI_XML_CACHE_VERSION;
+    header.lvgl_version = CACHE_LVGL_VERSION;
+    header.pack_version = LUI_XML_PACK_VERSION;
+    header.key[0] = key[0];
+    header.key[1] = key[1];
+    header.pack_size = pack_size;
+    header.pack_hash = hash32(pack, pack_size);
+
+    /*A partially written file is rejected next time by its size or hash*/
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, cache_path, LV_FS_MODE_WR) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't create %s", cache_path);
+        cache_stats.write_err_cnt++;
+        return;
+    }
+
+    uint32_t wn1 = 0;
+    uint32_t wn2 = 0;
+    lv_fs_res_t res1 = lv_fs_write(&f, &header, sizeof(header), &wn1);
+    lv_fs_res_t res2 = lv_fs_write(&f, pack, pack_size, &wn2);
+    lv_fs_close(&f);
+
+    if(res1 != LV_FS_RES_OK || res2 != LV_FS_RES_OK || wn1 != sizeof(header) || wn2 != pack_size) {
+        LV_LOG_WARN("Couldn't write %s", cache_path);
+        cache_stats.write_err_cnt++;
+    }
+}
+
+/**
+ * Register a pack of a single file and keep it as long as it's used
+ * @param buf       the pack allocated with `lv_malloc()`, it's freed on error
+ * @param size      size of the pack
+ * @return          true: registered, false: the pack is invalid
+ */
+static bool register_pack(void * buf, uint32_t size)
+{
+    cache_pack_t * node = lv_malloc(sizeof(cache_pack_t));
+    LV_ASSERT_MALLOC(node);
+    lui_xml_pack_t * pack = node ? lui_xml_load_pack(buf, size) : NULL;
+    if(pack == NULL) {
+        if(node) cache_stats.invalid_cnt++;
+        lv_free(node);
+        lv_free(buf);
+        return false;
+    }
+
+    /*E.g. a file with an unknown root element. Nothing references it.*/
+    if(pack->header->entry_cnt == 0) {
+        lui_xml_unload_pack(pack);
+        lv_free(node);
+        lv_free(buf);
+        return true;
+    }
+
+    node->pack = pack;
+    node->buf = buf;
+    node->next = pack_head;
+    pack_head = node;
+
+    /*The previous version of a component registered again, e.g. by reloading it, is not needed anymore*/
+    const char * name = get_replaceable_name(pack);
+    if(name) free_unused_packs(name);
+
+    return true;
+}
+
+/**
+ * Get the name of the component in a pack if it can be freed when not used.
+ * The globals and translations are merged into the global state, so their packs are kept.
+ * @param pack      a pack of a single file
+ * @return          name of the component or NULL
+ */
+static const char * get_replaceable_name(const lui_xml_pack_t * pack)
+{
+    if(pack->header->entry_cnt != 1) return NULL;
+    if(pack->entries[0].type != LUI_XML_PACK_ENTRY_COMPONENT) return NULL;
+
+    const char * name = lui_xml_pack_get_str(pack, pack->entries[0].name);
+    return lv_streq(name, "globals") ? NULL : name;
+}
+
+static void free_unused_packs(const char * name)
+{
+    cache_pack_t ** node_p = &pack_head;
+    while(*node_p) {
+        cache_pack_t * node = *node_p;
+        const char * node_name = get_replaceable_name(node->pack);
+        if(node_name && lv_streq(node_name, name) && !lui_xml_component_is_pack_used(node->pack)) {
+            *node_p = node->next;
+            lui_xml_unload_pack(node->pack);
+            lv_free(node->buf);
+            lv_free(node);
+        }
+        else {
+            node_p = &node->next;
+        }
+    }
+}
+
+/** FNV-1a*/
+static uint32_t hash32(const void * data, uint32_t size)
+{
+    const uint8_t * bytes = data;
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+#endif /* LV_USE_XML && LUI_XML_USE_CACHE */
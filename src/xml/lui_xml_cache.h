@@ -0,0 +1,80 @@
+/**
+ * @file lui_xml_cache.h
+ *
+ */
+
+#ifndef LUI_XML_CACHE_H
+#define LUI_XML_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: cache the compiled form of the loaded XML files in a directory to skip parsing them on the next boot*/
+#ifndef LUI_XML_USE_CACHE
+#define LUI_XML_USE_CACHE 0
+#endif
+
+/** Version of the cache file format. Cache files with other versions are ignored.*/
+#define LUI_XML_CACHE_VERSION 1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Files registered from the cache*/
+    uint32_t miss_cnt;      /**< Files parsed as they were not in the cache yet*/
+    uint32_t invalid_cnt;   /**< Cache files which were corrupted or written by another version*/
+    uint32_t write_err_cnt; /**< Cache files which couldn't be written*/
+} lui_xml_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_CACHE
+
+/**
+ * Set the directory where the compiled form of the XML files are cached.
+ * After this `lui_xml_load_all_from_path()` looks up every file in the cache by the hash
+ * of its content, and registers the cached form instead of parsing the XML.
+ * The files which are not in the cache yet are parsed and added to it.
+ * @param path      an existing directory, e.g. "A:cache", or NULL to disable the cache
+ */
+void lui_xml_cache_set_path(const char * path);
+
+/**
+ * Get how many files were found in the cache since the start or `lui_xml_cache_reset_stats()`
+ * @param stats     store the statistics here
+ */
+void lui_xml_cache_get_stats(lui_xml_cache_stats_t * stats);
+
+/**
+ * Clear the statistics of the cache
+ */
+void lui_xml_cache_reset_stats(void);
+
+#endif /*LUI_XML_USE_CACHE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_CACHE_H*/
@@ -0,0 +1,64 @@
+/**
+ * @file lui_xml_cache_private.h
+ *
+ */
+
+#ifndef LUI_XML_CACHE_PRIVATE_H
+#define LUI_XML_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_cache.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_CACHE
+
+/**
+ * Check if a cache directory is set
+ * @return      true: the files are loaded through the cache
+ */
+bool lui_xml_cache_is_enabled(void);
+
+/**
+ * Register a file from the cache, or parse it and add it to the cache
+ * @param path      path to the XML file
+ * @return          LV_RESULT_OK: registered, LV_RESULT_INVALID: the file needs to be registered from XML
+ */
+lv_result_t lui_xml_cache_load_file(const char * path);
+
+/**
+ * Free the packs loaded from the cache and forget the cache directory
+ */
+void lui_xml_cache_deinit(void);
+
+#endif /*LUI_XML_USE_CACHE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_XML*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_CACHE_PRIVATE_H*/
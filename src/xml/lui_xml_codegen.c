@@ -0,0 +1,1171 @@
+/**
+ * @file lui_xml_codegen.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_codegen.h"
+#if LV_USE_XML && LUI_XML_USE_CODEGEN
+
+#include "lui_xml_private.h"
+#include "lui_xml_component_private.h"
+#include "lui_xml_pack_private.h"
+#include "lui_xml_doc.h"
+#include "lui_xml_style.h"
+#include "lui_xml_base_types.h"
+#include "lui_xml_utils.h"
+#include "lui_xml_widget.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../stdlib/lv_sprintf.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+#include <stdarg.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CODEGEN_MAX_DEPTH   32
+#define CODEGEN_IDENT_SIZE  128
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A growable string*/
+typedef struct {
+    char * buf;
+    uint32_t len;
+    uint32_t cap;
+    bool error;
+} str_buf_t;
+
+/** A growable list of pointers*/
+typedef struct {
+    const void ** items;
+    uint32_t cnt;
+    uint32_t cap;
+} ptr_list_t;
+
+/** How an attribute's value is converted by the widget parsers*/
+typedef enum {
+    VALUE_SIZE,
+    VALUE_INT,
+    VALUE_BOOL,
+    VALUE_ALIGN,
+    VALUE_FLEX_FLOW,
+    VALUE_SCROLL_SNAP,
+    VALUE_SCROLLBAR_MODE,
+    VALUE_STRING,
+} value_type_t;
+
+/** An attribute handled by a widget's `apply_cb`*/
+typedef struct {
+    const char * widget;        /**< "lv_obj" for the attributes common for all widgets*/
+    const char * name;
+    value_type_t type;
+    const char * setter;        /**< The call with the object and the value, e.g. "lv_obj_set_x(%s, %s)"*/
+} attr_setter_t;
+
+typedef struct {
+    const char * name;
+    const char * create;
+} widget_t;
+
+/**
+ * An attribute value resolved as `lui_xml_create()` would resolve it.
+ * If both fields are NULL the attribute is not set.
+ */
+typedef struct {
+    const char * literal;           /**< The value if it's known when generating*/
+    const lui_xml_param_t * param;  /**< The property of the component which gives the value at runtime*/
+} attr_value_t;
+
+typedef struct {
+    const char * module;
+    ptr_list_t components;      /**< Scopes to generate. The used components are added while generating.*/
+    ptr_list_t styles;          /**< `lui_xml_style_t`s already generated*/
+    ptr_list_t subjects;        /**< `lv_subject_t`s already generated*/
+    str_buf_t styles_src;
+    str_buf_t subjects_src;
+    str_buf_t subjects_header;
+    str_buf_t init_src;
+    str_buf_t funcs_src;
+    bool uses_params;
+    bool uses_converters;
+    bool error;
+
+    /*State of the component being generated*/
+    lui_xml_component_scope_t * scope;
+    int32_t parent_stack[CODEGEN_MAX_DEPTH];   /**< Object indices, -1 is the `parent` argument*/
+    uint32_t depth;
+    uint32_t obj_cnt;
+    int32_t view_obj;
+} codegen_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void generate_component(codegen_t * gen, lui_xml_component_scope_t * scope);
+static void start_handler(void * user_data, const char * name, const char ** attrs);
+static void end_handler(void * user_data, const char * name);
+static int32_t add_widget(codegen_t * gen, const widget_t * widget, const char * parent, const char ** attrs,
+                          const attr_value_t * values, bool is_view);
+static int32_t add_component(codegen_t * gen, lui_xml_component_scope_t * scope, const char * parent,
+                             const char ** attrs, const attr_value_t * values, bool is_view);
+static void add_style_element(codegen_t * gen, const char * parent, const char ** attrs, const attr_value_t * values);
+static bool apply_attrs(codegen_t * gen, const char * obj, const char * widget, const char ** attrs,
+                        const attr_value_t * values, lui_xml_component_scope_t * instance_of, bool is_view);
+static void add_setter(codegen_t * gen, const char * obj, const attr_setter_t * setter, const attr_value_t * value);
+static void add_bind_text(codegen_t * gen, const char * obj, const char ** attrs, const attr_value_t * values,
+                          uint32_t index);
+static const char * add_style_def(codegen_t * gen, const lui_xml_style_t * xml_style, char * id);
+static const char * add_subject_def(codegen_t * gen, lv_subject_t * subject, const char * name, char * id);
+static bool resolve_value(codegen_t * gen, const char * name, const char * value, attr_value_t * res);
+static const attr_value_t * find_value(const char ** attrs, const attr_value_t * values, const char * name);
+static const lui_xml_param_t * find_param(lui_xml_component_scope_t * scope, const char * name);
+static const widget_t * get_widget(const char * name);
+static const char * get_base_widget(const char * extends);
+static bool prop_is_color(lv_style_prop_t prop);
+static bool prop_is_pointer(lv_style_prop_t prop);
+static char * build_source(codegen_t * gen);
+static char * build_header(codegen_t * gen);
+static void str_buf_printf(str_buf_t * sb, const char * fmt, ...);
+static void str_buf_add_c_str(str_buf_t * sb, const char * str);
+static void str_buf_add_buf(str_buf_t * sb, const str_buf_t * src);
+static bool str_buf_reserve(str_buf_t * sb, uint32_t len);
+static bool ptr_list_add_unique(ptr_list_t * list, const void * item);
+static const char * to_ident(char * buf, const char * prefix, const char * str, const char * suffix);
+static const char * obj_var(char * buf, int32_t index);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const widget_t widgets[] = {
+    {"lv_obj", "lv_obj_create"},
+#if LV_USE_BUTTON
+    {"lv_button", "lv_button_create"},
+#endif
+#if LV_USE_LABEL
+    {"lv_label", "lv_label_create"},
+#endif
+};
+
+#define FLAG_SETTER(attr, flag)     {"lv_obj", attr, VALUE_BOOL, "lv_obj_set_flag(%s, " #flag ", %s)"}
+#define STATE_SETTER(attr, state)   {"lv_obj", attr, VALUE_BOOL, "lv_obj_set_state(%s, " #state ", %s)"}
+
+/*The same as in `lui_xml_obj_apply()` and the widgets' `apply_cb`s*/
+static const attr_setter_t setters[] = {
+    {"lv_obj", "name", VALUE_STRING, "lv_obj_set_name(%s, %s)"},
+    {"lv_obj", "x", VALUE_SIZE, "lv_obj_set_x(%s, %s)"},
+    {"lv_obj", "y", VALUE_SIZE, "lv_obj_set_y(%s, %s)"},
+    {"lv_obj", "width", VALUE_SIZE, "lv_obj_set_width(%s, %s)"},
+    {"lv_obj", "height", VALUE_SIZE, "lv_obj_set_height(%s, %s)"},
+    {"lv_obj", "align", VALUE_ALIGN, "lv_obj_set_align(%s, %s)"},
+    {"lv_obj", "flex_flow", VALUE_FLEX_FLOW, "lv_obj_set_flex_flow(%s, %s)"},
+    {"lv_obj", "flex_grow", VALUE_INT, "lv_obj_set_flex_grow(%s, %s)"},
+    {"lv_obj", "ext_click_area", VALUE_INT, "lv_obj_set_ext_click_area(%s, %s)"},
+    {"lv_obj", "scroll_snap_x", VALUE_SCROLL_SNAP, "lv_obj_set_scroll_snap_x(%s, %s)"},
+    {"lv_obj", "scroll_snap_y", VALUE_SCROLL_SNAP, "lv_obj_set_scroll_snap_y(%s, %s)"},
+    {"lv_obj", "scrollbar_mode", VALUE_SCROLLBAR_MODE, "lv_obj_set_scrollbar_mode(%s, %s)"},
+
+    FLAG_SETTER("hidden", LV_OBJ_FLAG_HIDDEN),
+    FLAG_SETTER("clickable", LV_OBJ_FLAG_CLICKABLE),
+    FLAG_SETTER("click_focusable", LV_OBJ_FLAG_CLICK_FOCUSABLE),
+    FLAG_SETTER("checkable", LV_OBJ_FLAG_CHECKABLE),
+    FLAG_SETTER("scrollable", LV_OBJ_FLAG_SCROLLABLE),
+    FLAG_SETTER("scroll_elastic", LV_OBJ_FLAG_SCROLL_ELASTIC),
+    FLAG_SETTER("scroll_momentum", LV_OBJ_FLAG_SCROLL_MOMENTUM),
+    FLAG_SETTER("scroll_one", LV_OBJ_FLAG_SCROLL_ONE),
+    FLAG_SETTER("scroll_chain_hor", LV_OBJ_FLAG_SCROLL_CHAIN_HOR),
+    FLAG_SETTER("scroll_chain_ver", LV_OBJ_FLAG_SCROLL_CHAIN_VER),
+    FLAG_SETTER("scroll_chain", LV_OBJ_FLAG_SCROLL_CHAIN),
+    FLAG_SETTER("scroll_on_focus", LV_OBJ_FLAG_SCROLL_ON_FOCUS),
+    FLAG_SETTER("scroll_with_arrow", LV_OBJ_FLAG_SCROLL_WITH_ARROW),
+    FLAG_SETTER("snappable", LV_OBJ_FLAG_SNAPPABLE),
+    FLAG_SETTER("press_lock", LV_OBJ_FLAG_PRESS_LOCK),
+    FLAG_SETTER("event_bubble", LV_OBJ_FLAG_EVENT_BUBBLE),
+    FLAG_SETTER("event_trickle", LV_OBJ_FLAG_EVENT_TRICKLE),
+    FLAG_SETTER("state_trickle", LV_OBJ_FLAG_STATE_TRICKLE),
+    FLAG_SETTER("gesture_bubble", LV_OBJ_FLAG_GESTURE_BUBBLE),
+    FLAG_SETTER("adv_hittest", LV_OBJ_FLAG_ADV_HITTEST),
+    FLAG_SETTER("ignore_layout", LV_OBJ_FLAG_IGNORE_LAYOUT),
+    FLAG_SETTER("floating", LV_OBJ_FLAG_FLOATING),
+    FLAG_SETTER("send_draw_task_events", LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS),
+    FLAG_SETTER("overflow_visible", LV_OBJ_FLAG_OVERFLOW_VISIBLE),
+    FLAG_SETTER("radio_button", LV_OBJ_FLAG_RADIO_BUTTON),
+    FLAG_SETTER("flex_in_new_track", LV_OBJ_FLAG_FLEX_IN_NEW_TRACK),
+
+    STATE_SETTER("checked", LV_STATE_CHECKED),
+    STATE_SETTER("focused", LV_STATE_FOCUSED),
+    STATE_SETTER("focus_key", LV_STATE_FOCUS_KEY),
+    STATE_SETTER("edited", LV_STATE_EDITED),
+    STATE_SETTER("hovered", LV_STATE_HOVERED),
+    STATE_SETTER("pressed", LV_STATE_PRESSED),
+    STATE_SETTER("scrolled", LV_STATE_SCROLLED),
+    STATE_SETTER("disabled", LV_STATE_DISABLED),
+
+    {"lv_label", "text", VALUE_STRING, "lv_label_set_text(%s, %s)"},
+};
+
+/*The functions converting the properties of the components at runtime*/
+static const char * const converters[] = {
+    [VALUE_SIZE] = "lui_xml_to_size",
+    [VALUE_INT] = "lui_xml_atoi",
+    [VALUE_BOOL] = "lui_xml_to_bool",
+    [VALUE_ALIGN] = "lui_xml_align_to_enum",
+    [VALUE_FLEX_FLOW] = "lui_xml_flex_flow_to_enum",
+    [VALUE_SCROLL_SNAP] = "lui_xml_scroll_snap_to_enum",
+    [VALUE_SCROLLBAR_MODE] = "lui_xml_scrollbar_mode_to_enum",
+    [VALUE_STRING] = NULL,
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lui_xml_codegen(const char ** names, const char * module, char ** source, char ** header)
+{
+    *source = NULL;
+    *header = NULL;
+
+    codegen_t gen;
+    lv_memzero(&gen, sizeof(gen));
+    gen.module = module;
+
+    uint32_t i;
+    for(i = 0; names[i]; i++) {
+        lui_xml_component_scope_t * scope = lui_xml_component_get_scope(names[i]);
+        if(scope == NULL) {
+            LV_LOG_WARN("`%s` is not a registered component or screen", names[i]);
+            gen.error = true;
+            break;
+        }
+        if(!ptr_list_add_unique(&gen.components, scope)) gen.error = true;
+    }
+
+    /*The list grows while generating as the used components are added to it*/
+    for(i = 0; !gen.error && i < gen.components.cnt; i++) {
+        generate_component(&gen, (lui_xml_component_scope_t *)gen.components.items[i]);
+    }
+
+    if(!gen.error) {
+        *source = build_source(&gen);
+        *header = build_header(&gen);
+    }
+
+    lv_free(gen.components.items);
+    lv_free(gen.styles.items);
+    lv_free(gen.subjects.items);
+    lv_free(gen.styles_src.buf);
+    lv_free(gen.subjects_src.buf);
+    lv_free(gen.subjects_header.buf);
+    lv_free(gen.init_src.buf);
+    lv_free(gen.funcs_src.buf);
+
+    if(*source == NULL || *header == NULL) {
+        lv_free(*source);
+        lv_free(*header);
+        *source = NULL;
+        *header = NULL;
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void generate_component(codegen_t * gen, lui_xml_component_scope_t * scope)
+{
+    if(scope->is_widget) {
+        LV_LOG_WARN("`%s` is registered as a widget, which can't be generated", scope->name);
+        gen->error = true;
+        return;
+    }
+
+    if(!lv_ll_is_empty(&scope->timeline_ll)) {
+        LV_LOG_WARN("`%s` has timelines, which are not supported by the code generator", scope->name);
+        gen->error = true;
+        return;
+    }
+
+    if(scope->view_tokens == NULL && scope->view_def == NULL) {
+        LV_LOG_WARN("`%s` has no view", scope->name);
+        gen->error = true;
+        return;
+    }
+
+    gen->scope = scope;
+    gen->depth = 0;
+    gen->obj_cnt = 0;
+    gen->view_obj = -1;
+
+    str_buf_t * sb = &gen->funcs_src;
+    char func[CODEGEN_IDENT_SIZE];
+    to_ident(func, "", scope->name, "");
+
+    bool has_params = !lv_ll_is_empty(&scope->param_ll);
+    if(has_params) {
+        str_buf_printf(sb, "lv_obj_t * %s_create(lv_obj_t * parent, const %s_params_t * params)\n{\n", func, func);
+        gen->uses_params = true;
+
+        lui_xml_param_t * p;
+        LV_LL_READ(&scope->param_ll, p) {
+            /*The default value is resolved as a constant of the component*/
+            const char * def = p->def;
+            if(def && def[0] == '#' && def[1] != '\0') def = lui_xml_get_const(scope, &def[1]);
+
+            char prop[CODEGEN_IDENT_SIZE];
+            char field[CODEGEN_IDENT_SIZE];
+            str_buf_printf(sb, "    const char * %s = param_value(params ? params->%s : NULL, ",
+                           to_ident(prop, "prop_", p->name, ""), to_ident(field, "", p->name, ""));
+            if(def) str_buf_add_c_str(sb, def);
+            else str_buf_printf(sb, "NULL");
+            str_buf_printf(sb, ");\n");
+        }
+        str_buf_printf(sb, "\n");
+    }
+    else {
+        str_buf_printf(sb, "lv_obj_t * %s_create(lv_obj_t * parent)\n{\n", func);
+    }
+
+    if(scope->view_tokens) {
+        lui_xml_pack_replay(scope->pack, scope->view_tokens, scope->view_token_cnt, scope->view_token_attrs,
+                            start_handler, end_handler, gen);
+    }
+    else {
+        lui_xml_doc_t doc;
+        lui_xml_doc_init(&doc);
+        if(lui_xml_doc_tokenize(&doc, scope->view_def, scope->view_def_len, true) == LV_RESULT_OK) {
+            lui_xml_doc_replay(&doc, start_handler, end_handler, gen);
+        }
+        else {
+            LV_LOG_WARN("Couldn't parse the view of `%s`", scope->name);
+            gen->error = true;
+        }
+        lui_xml_doc_destroy(&doc);
+    }
+
+    if(gen->error) return;
+    if(gen->view_obj < 0) {
+        LV_LOG_WARN("`%s` has no view", scope->name);
+        gen->error = true;
+        return;
+    }
+
+    /*Name the object as `lui_xml_create()` does*/
+    char view[CODEGEN_IDENT_SIZE];
+    obj_var(view, gen->view_obj);
+    str_buf_printf(sb, "\n#if LV_USE_OBJ_NAME\n");
+    if(scope->is_screen) {
+        str_buf_printf(sb, "    lv_obj_set_name(%s, ", view);
+        str_buf_add_c_str(sb, scope->name);
+        str_buf_printf(sb, ");\n");
+    }
+    str_buf_printf(sb, "    if(parent) lv_obj_set_name(%s, \"%s_#\");\n", view, func);
+    str_buf_printf(sb, "#endif\n\n    return %s;\n}\n\n", view);
+}
+
+static void start_handler(void * user_data, const char * name, const char ** attrs)
+{
+    codegen_t * gen = user_data;
+    if(gen->error) return;
+
+    if(gen->depth >= CODEGEN_MAX_DEPTH) {
+        LV_LOG_WARN("The view of `%s` is nested too deep", gen->scope->name);
+        gen->error = true;
+        return;
+    }
+
+    bool is_view = false;
+    if(lv_streq(name, "view")) {
+        const char * extends = lui_xml_get_value_of(attrs, "extends");
+        name = extends ? extends : "lv_obj";
+        is_view = true;
+    }
+
+    uint32_t attr_cnt = 0;
+    while(attrs[attr_cnt * 2]) attr_cnt++;
+
+    attr_value_t * values = lv_malloc((attr_cnt + 1) * sizeof(attr_value_t));
+    LV_ASSERT_MALLOC(values);
+    if(values == NULL) {
+        gen->error = true;
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < attr_cnt; i++) {
+        if(!resolve_value(gen, attrs[i * 2], attrs[i * 2 + 1], &values[i])) {
+            lv_free(values);
+            gen->error = true;
+            return;
+        }
+    }
+
+    char parent[CODEGEN_IDENT_SIZE];
+    obj_var(parent, gen->depth ? gen->parent_stack[gen->depth - 1] : -1);
+
+    int32_t item = -1;
+    const widget_t * widget = get_widget(name);
+    lui_xml_component_scope_t * scope = NULL;
+    if(lv_streq(name, "style") || lv_streq(name, "lv_obj-style")) {
+        add_style_element(gen, parent, attrs, values);
+        item = gen->depth ? gen->parent_stack[gen->depth - 1] : -1;
+    }
+    else if(widget) {
+        item = add_widget(gen, widget, parent, attrs, values, is_view);
+    }
+    else if((scope = lui_xml_component_get_scope(name)) != NULL) {
+        item = add_component(gen, scope, parent, attrs, values, is_view);
+    }
+    else {
+        LV_LOG_WARN("`<%s>` in `%s` is not supported by the code generator", name, gen->scope->name);
+        gen->error = true;
+    }
+
+    lv_free(values);
+
+    gen->parent_stack[gen->depth] = item;
+    gen->depth++;
+    if(is_view) gen->view_obj = item;
+}
+
+static void end_handler(void * user_data, const char * name)
+{
+    LV_UNUSED(name);
+
+    codegen_t * gen = user_data;
+    if(gen->error) return;
+
+    gen->depth--;
+}
+
+static int32_t add_widget(codegen_t * gen, const widget_t * widget, const char * parent, const char ** attrs,
+                          const attr_value_t * values, bool is_view)
+{
+    int32_t index = gen->obj_cnt++;
+    char obj[CODEGEN_IDENT_SIZE];
+    obj_var(obj, index);
+
+    str_buf_printf(&gen->funcs_src, "    lv_obj_t * %s = %s(%s);\n", obj, widget->create, parent);
+    if(!apply_attrs(gen, obj, widget->name, attrs, values, NULL, is_view)) gen->error = true;
+
+    return index;
+}
+
+static int32_t add_component(codegen_t * gen, lui_xml_component_scope_t * scope, const char * parent,
+                             const char ** attrs, const attr_value_t * values, bool is_view)
+{
+    if(!ptr_list_add_unique(&gen->components, scope)) {
+        gen->error = true;
+        return -1;
+    }
+
+    str_buf_t * sb = &gen->funcs_src;
+    int32_t index = gen->obj_cnt++;
+    char obj[CODEGEN_IDENT_SIZE];
+    char func[CODEGEN_IDENT_SIZE];
+    obj_var(obj, index);
+    to_ident(func, "", scope->name, "");
+
+    if(!lv_ll_is_empty(&scope->param_ll)) {
+        /*Pass the properties of the component like the attributes of `lui_xml_create()`*/
+        str_buf_printf(sb, "    %s_params_t params%" LV_PRId32 ";\n", func, index);
+        str_buf_printf(sb, "    lv_memzero(&params%" LV_PRId32 ", sizeof(params%" LV_PRId32 "));\n", index, index);
+
+        uint32_t i;
+        for(i = 0; attrs[i * 2]; i++) {
+            const lui_xml_param_t * p = find_param(scope, attrs[i * 2]);
+            if(p == NULL) continue;
+            if(values[i].literal == NULL && values[i].param == NULL) continue;
+
+            char field[CODEGEN_IDENT_SIZE];
+            str_buf_printf(sb, "    params%" LV_PRId32 ".%s = ", index, to_ident(field, "", p->name, ""));
+            if(values[i].literal) {
+                str_buf_add_c_str(sb, values[i].literal);
+            }
+            else {
+                char prop[CODEGEN_IDENT_SIZE];
+                str_buf_printf(sb, "%s", to_ident(prop, "prop_", values[i].param->name, ""));
+            }
+            str_buf_printf(sb, ";\n");
+        }
+        str_buf_printf(sb, "    lv_obj_t * %s = %s_create(%s, &params%" LV_PRId32 ");\n", obj, func, parent, index);
+    }
+    else {
+        str_buf_printf(sb, "    lv_obj_t * %s = %s_create(%s);\n", obj, func, parent);
+    }
+
+    /*The attributes of the instance are applied by the widget the component extends*/
+    if(!apply_attrs(gen, obj, get_base_widget(scope->extends), attrs, values, scope, is_view)) gen->error = true;
+
+    return index;
+}
+
+static void add_style_element(codegen_t * gen, const char * parent, const char ** attrs, const attr_value_t * values)
+{
+    const attr_value_t * name = find_value(attrs, values, "name");
+    const attr_value_t * selector = find_value(attrs, values, "selector");
+    if((name && name->param) || (selector && selector->param)) {
+        LV_LOG_WARN("Styles set by properties in `%s` are not supported by the code generator", gen->scope->name);
+        gen->error = true;
+        return;
+    }
+
+    /*Ignored by `lv_obj_xml_style_apply()` too*/
+    if(name == NULL || name->literal == NULL) return;
+
+    const lui_xml_style_t * xml_style = lui_xml_get_style_by_name(gen->scope, name->literal);
+    if(xml_style == NULL) {
+        LV_LOG_WARN("`%s` style is not found", name->literal);
+        return;
+    }
+
+    char id[CODEGEN_IDENT_SIZE];
+    if(add_style_def(gen, xml_style, id) == NULL) return;
+
+    lv_style_selector_t sel = lui_xml_style_selector_text_to_enum(selector ? selector->literal : NULL);
+    str_buf_printf(&gen->funcs_src, "    lv_obj_add_style(%s, &%s, 0x%" LV_PRIx32 ");\n", parent, id, (uint32_t)sel);
+}
+
+/**
+ * Generate the calls the `apply_cb` of a widget would make for the attributes.
+ * Like the widget parsers, the common `lv_obj` attributes are applied first.
+ * @param gen           pointer to the generator
+ * @param obj           the variable of the object
+ * @param widget        name of the widget, e.g. "lv_label"
+ * @param attrs         the attributes from the XML
+ * @param values        the resolved values of the attributes
+ * @param instance_of   if an instance of a component, its scope to skip its properties
+ * @param is_view       the attributes are of a `<view>`
+ * @return              false if an attribute is not supported by the generator
+ */
+static bool apply_attrs(codegen_t * gen, const char * obj, const char * widget, const char ** attrs,
+                        const attr_value_t * values, lui_xml_component_scope_t * instance_of, bool is_view)
+{
+    const char * passes[2] = {"lv_obj", widget};
+    uint32_t pass_cnt = lv_streq(widget, "lv_obj") ? 1 : 2;
+    uint32_t pass;
+    for(pass = 0; pass < pass_cnt; pass++) {
+        uint32_t i;
+        for(i = 0; attrs[i * 2]; i++) {
+            /*Not set at all, e.g. a property without a default value*/
+            if(values[i].literal == NULL && values[i].param == NULL) continue;
+
+            if(lv_streq(passes[pass], "lv_label") && lv_streq(attrs[i * 2], "bind_text")) {
+                add_bind_text(gen, obj, attrs, values, i);
+                continue;
+            }
+
+            uint32_t s;
+            for(s = 0; s < sizeof(setters) / sizeof(setters[0]); s++) {
+                if(lv_streq(setters[s].widget, passes[pass]) && lv_streq(setters[s].name, attrs[i * 2])) {
+                    add_setter(gen, obj, &setters[s], &values[i]);
+                    break;
+                }
+            }
+        }
+    }
+
+    /*Check that nothing is left out*/
+    uint32_t i;
+    for(i = 0; attrs[i * 2]; i++) {
+        const char * name = attrs[i * 2];
+        if(is_view && lv_streq(name, "extends")) continue;
+        if(instance_of && find_param(instance_of, name)) continue;
+        if(lv_streq(widget, "lv_label") &&
+           (lv_streq(name, "bind_text") || lv_streq(name, "bind_text-fmt"))) continue;
+
+        bool found = false;
+        uint32_t s;
+        for(s = 0; s < sizeof(setters) / sizeof(setters[0]); s++) {
+            if((lv_streq(setters[s].widget, "lv_obj") || lv_streq(setters[s].widget, widget)) &&
+               lv_streq(setters[s].name, name)) {
+                found = true;
+                break;
+            }
+        }
+
+        if(!found) {
+            LV_LOG_WARN("The `%s` attribute of `%s` in `%s` is not supported by the code generator", name, widget,
+                        gen->scope->name);
+            return false;
+        }
+    }
+
+    return !gen->error;
+}
+
+static void add_setter(codegen_t * gen, const char * obj, const attr_setter_t * setter, const attr_value_t * value)
+{
+    str_buf_t * sb = &gen->funcs_src;
+    str_buf_t expr;
+    lv_memzero(&expr, sizeof(expr));
+
+    char prop[CODEGEN_IDENT_SIZE];
+    if(value->param) {
+        to_ident(prop, "prop_", value->param->name, "");
+        if(setter->type == VALUE_STRING) {
+            str_buf_printf(&expr, "%s", prop);
+        }
+        else {
+            str_buf_printf(&expr, "%s(%s)", converters[setter->type], prop);
+            gen->uses_converters = true;
+        }
+    }
+    else {
+        /*Fold the value using the same conversion as the parser*/
+        const char * v = value->literal;
+        switch(setter->type) {
+            case VALUE_SIZE:
+                str_buf_printf(&expr, "%" LV_PRId32, lui_xml_to_size(v));
+                break;
+            case VALUE_INT:
+                str_buf_printf(&expr, "%" LV_PRId32, lui_xml_atoi(v));
+                break;
+            case VALUE_BOOL:
+                str_buf_printf(&expr, "%s", lui_xml_to_bool(v) ? "true" : "false");
+                break;
+            case VALUE_ALIGN:
+                str_buf_printf(&expr, "%d", (int)lui_xml_align_to_enum(v));
+                break;
+            case VALUE_FLEX_FLOW:
+                str_buf_printf(&expr, "%d", (int)lui_xml_flex_flow_to_enum(v));
+                break;
+            case VALUE_SCROLL_SNAP:
+                str_buf_printf(&expr, "%d", (int)lui_xml_scroll_snap_to_enum(v));
+                break;
+            case VALUE_SCROLLBAR_MODE:
+                str_buf_printf(&expr, "%d", (int)lui_xml_scrollbar_mode_to_enum(v));
+                break;
+            case VALUE_STRING:
+                str_buf_add_c_str(&expr, v);
+                break;
+        }
+    }
+
+    if(expr.error) {
+        gen->error = true;
+        lv_free(expr.buf);
+        return;
+    }
+
+    bool is_name = lv_streq(setter->name, "name");
+    if(is_name) str_buf_printf(sb, "#if LV_USE_OBJ_NAME\n");
+    str_buf_printf(sb, "    ");
+    if(value->param) str_buf_printf(sb, "if(%s) ", prop);
+    str_buf_printf(sb, setter->setter, obj, expr.buf);
+    str_buf_printf(sb, ";\n");
+    if(is_name) str_buf_printf(sb, "#endif\n");
+
+    lv_free(expr.buf);
+}
+
+static void add_bind_text(codegen_t * gen, const char * obj, const char ** attrs, const attr_value_t * values,
+                          uint32_t index)
+{
+    const attr_value_t * fmt = find_value(attrs, values, "bind_text-fmt");
+    if(values[index].param || (fmt && fmt->param)) {
+        LV_LOG_WARN("Bindings set by properties in `%s` are not supported by the code generator", gen->scope->name);
+        gen->error = true;
+        return;
+    }
+
+    const char * name = values[index].literal;
+    lv_subject_t * subject = lui_xml_get_subject(gen->scope, name);
+    if(subject == NULL) {
+        /*Skipped by `lui_xml_label_apply()` too*/
+        LV_LOG_WARN("Subject \"%s\" doesn't exist in label bind_text", name);
+        return;
+    }
+
+    char id[CODEGEN_IDENT_SIZE];
+    if(add_subject_def(gen, subject, name, id) == NULL) return;
+
+    str_buf_t * sb = &gen->funcs_src;
+    str_buf_printf(sb, "    lv_label_bind_text(%s, &%s, ", obj, id);
+    if(fmt && fmt->literal) str_buf_add_c_str(sb, fmt->literal);
+    else str_buf_printf(sb, "NULL");
+    str_buf_printf(sb, ");\n");
+}
+
+/**
+ * Generate a constant style with the same properties as a registered style
+ * @param gen           pointer to the generator
+ * @param xml_style     the registered style
+ * @param id            store the name of the style's variable here (`CODEGEN_IDENT_SIZE` bytes)
+ * @return              `id` or NULL if the style can't be generated
+ */
+static const char * add_style_def(codegen_t * gen, const lui_xml_style_t * xml_style, char * id)
+{
+    to_ident(id, "style_", xml_style->long_name, "");
+
+    uint32_t i;
+    for(i = 0; i < gen->styles.cnt; i++) {
+        if(gen->styles.items[i] == xml_style) return id;
+    }
+
+    if(!ptr_list_add_unique(&gen->styles, xml_style)) {
+        gen->error = true;
+        return NULL;
+    }
+
+    str_buf_t * sb = &gen->styles_src;
+    str_buf_printf(sb, "static const lv_style_const_prop_t %s_props[] = {\n", id);
+
+    uint32_t prop;
+    for(prop = 1; prop < LV_STYLE_LAST_BUILT_IN_PROP; prop++) {
+        lv_style_value_t v;
+        if(lv_style_get_prop(&xml_style->style, prop, &v) != LV_STYLE_RES_FOUND) continue;
+
+        if(prop_is_pointer(prop)) {
+            LV_LOG_WARN("Style property %" LV_PRIu32 " of `%s` refers to an asset, which is not supported by "
+                        "the code generator", prop, xml_style->long_name);
+            gen->error = true;
+            return NULL;
+        }
+
+        if(prop_is_color(prop)) {
+            str_buf_printf(sb, "    {.prop = %" LV_PRIu32 ", .value = {.color = LV_COLOR_MAKE(0x%02x, 0x%02x, 0x%02x)}},\n",
+                           prop, v.color.red, v.color.green, v.color.blue);
+        }
+        else {
+            str_buf_printf(sb, "    {.prop = %" LV_PRIu32 ", .value = {.num = %" LV_PRId32 "}},\n", prop, v.num);
+        }
+    }
+
+    str_buf_printf(sb, "    LV_STYLE_CONST_PROPS_END\n};\n\n");
+    str_buf_printf(sb, "static LV_STYLE_CONST_INIT(%s, %s_props);\n\n", id, id);
+
+    return id;
+}
+
+/**
+ * Generate a static subject with the same type and value as a registered subject
+ * @param gen       pointer to the generator
+ * @param subject   the registered subject
+ * @param name      name of the subject
+ * @param id        store the name of the subject's variable here (`CODEGEN_IDENT_SIZE` bytes)
+ * @return          `id` or NULL if the subject can't be generated
+ */
+static const char * add_subject_def(codegen_t * gen, lv_subject_t * subject, const char * name, char * id)
+{
+    /*The subjects of a component are shared by its instances, just like in the registry*/
+    const char * owner = "globals";
+    lui_xml_subject_t * s;
+    LV_LL_READ(&gen->scope->subjects_ll, s) {
+        if(s->subject == subject) {
+            owner = gen->scope->name;
+            break;
+        }
+    }
+
+    char owner_id[CODEGEN_IDENT_SIZE];
+    char name_id[CODEGEN_IDENT_SIZE];
+    to_ident(owner_id, "", owner, "_");
+    to_ident(name_id, owner_id, name, "_subject");
+    lv_strlcpy(id, name_id, CODEGEN_IDENT_SIZE);
+
+    uint32_t i;
+    for(i = 0; i < gen->subjects.cnt; i++) {
+        if(gen->subjects.items[i] == subject) return id;
+    }
+
+    if(!ptr_list_add_unique(&gen->subjects, subject)) {
+        gen->error = true;
+        return NULL;
+    }
+
+    str_buf_t * sb = &gen->subjects_src;
+    str_buf_t * init = &gen->init_src;
+    if(subject->type == LV_SUBJECT_TYPE_INT) {
+        str_buf_printf(sb, "lv_subject_t %s;\n", id);
+        str_buf_printf(init, "    lv_subject_init_int(&%s, %" LV_PRId32 ");\n", id, lv_subject_get_int(subject));
+        str_buf_printf(init, "    lv_subject_set_min_value_int(&%s, %" LV_PRId32 ");\n", id, subject->min_value.num);
+        str_buf_printf(init, "    lv_subject_set_max_value_int(&%s, %" LV_PRId32 ");\n", id, subject->max_value.num);
+    }
+    else if(subject->type == LV_SUBJECT_TYPE_STRING) {
+        str_buf_printf(sb, "lv_subject_t %s;\n", id);
+        str_buf_printf(sb, "static char %s_buf[%" LV_PRIu32 "];\n", id, (uint32_t)subject->size);
+        str_buf_printf(sb, "static char %s_prev_buf[%" LV_PRIu32 "];\n", id, (uint32_t)subject->size);
+        str_buf_printf(init, "    lv_subject_init_string(&%s, %s_buf, %s_prev_buf, sizeof(%s_buf), ", id, id, id, id);
+        str_buf_add_c_str(init, lv_subject_get_string(subject));
+        str_buf_printf(init, ");\n");
+    }
+    else {
+        LV_LOG_WARN("The type of the `%s` subject is not supported by the code generator", name);
+        gen->error = true;
+        return NULL;
+    }
+
+    str_buf_printf(&gen->subjects_header, "extern lv_subject_t %s;\n", id);
+
+    return id;
+}
+
+/**
+ * Resolve a value as `resolve_params()` and `resolve_consts()` in `lui_xml.c` would
+ * @param gen       pointer to the generator
+ * @param name      name of the attribute
+ * @param value     value of the attribute
+ * @param res       store the result here
+ * @return          false if the value can't be generated
+ */
+static bool resolve_value(codegen_t * gen, const char * name, const char * value, attr_value_t * res)
+{
+    res->literal = NULL;
+    res->param = NULL;
+
+    if(value[0] == '$') {
+        res->param = find_param(gen->scope, &value[1]);
+        if(res->param == NULL) {
+            LV_LOG_WARN("'%s' parameter is not defined on '%s'", &value[1], gen->scope->name);
+            return false;
+        }
+        if(lv_streq(res->param->type, "style")) {
+            LV_LOG_WARN("Style properties of `%s` are not supported by the code generator", gen->scope->name);
+            return false;
+        }
+        return true;
+    }
+
+    if(!lv_streq(name, "styles") && value[0] == '#' && value[1] != '\0') {
+        /*If the constant is not found the attribute is not set*/
+        res->literal = lui_xml_get_const(gen->scope, &value[1]);
+        return true;
+    }
+
+    res->literal = value;
+    return true;
+}
+
+static const attr_value_t * find_value(const char ** attrs, const attr_value_t * values, const char * name)
+{
+    uint32_t i;
+    for(i = 0; attrs[i * 2]; i++) {
+        if(lv_streq(attrs[i * 2], name)) {
+            if(values[i].literal == NULL && values[i].param == NULL) return NULL;
+            return &values[i];
+        }
+    }
+    return NULL;
+}
+
+static const lui_xml_param_t * find_param(lui_xml_component_scope_t * scope, const char * name)
+{
+    lui_xml_param_t * p;
+    LV_LL_READ(&scope->param_ll, p) {
+        if(lv_streq(p->name, name)) return p;
+    }
+    return NULL;
+}
+
+static const widget_t * get_widget(const char * name)
+{
+    /*Only if the widget is really available*/
+    if(lui_xml_widget_get_processor(name) == NULL) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < sizeof(widgets) / sizeof(widgets[0]); i++) {
+        if(lv_streq(widgets[i].name, name)) return &widgets[i];
+    }
+    return NULL;
+}
+
+/**
+ * Find the widget a component extends, like `lui_xml_widget_get_extended_widget_processor()`
+ * @param extends   the `extends` of the component
+ * @return          name of the widget
+ */
+static const char * get_base_widget(const char * extends)
+{
+    while(extends) {
+        if(lui_xml_widget_get_processor(extends)) return extends;
+
+        lui_xml_component_scope_t * scope = lui_xml_component_get_scope(extends);
+        if(scope == NULL) break;
+        extends = scope->extends;
+    }
+
+    return "lv_obj";
+}
+
+static bool prop_is_color(lv_style_prop_t prop)
+{
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+        case LV_STYLE_BG_IMAGE_RECOLOR:
+        case LV_STYLE_BORDER_COLOR:
+        case LV_STYLE_OUTLINE_COLOR:
+        case LV_STYLE_SHADOW_COLOR:
+        case LV_STYLE_IMAGE_RECOLOR:
+        case LV_STYLE_LINE_COLOR:
+        case LV_STYLE_ARC_COLOR:
+        case LV_STYLE_TEXT_COLOR:
+        case LV_STYLE_RECOLOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool prop_is_pointer(lv_style_prop_t prop)
+{
+    switch(prop) {
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_BG_IMAGE_SRC:
+        case LV_STYLE_ARC_IMAGE_SRC:
+        case LV_STYLE_BG_GRAD:
+        case LV_STYLE_BITMAP_MASK_SRC:
+        case LV_STYLE_TRANSITION:
+        case LV_STYLE_COLOR_FILTER_DSC:
+        case LV_STYLE_ANIM:
+        case LV_STYLE_GRID_COLUMN_DSC_ARRAY:
+        case LV_STYLE_GRID_ROW_DSC_ARRAY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static char * build_source(codegen_t * gen)
+{
+    str_buf_t sb;
+    lv_memzero(&sb, sizeof(sb));
+
+    str_buf_printf(&sb, "/**\n * @file %s.c\n *\n * Generated by lui_xml_codegen(), don't edit it.\n */\n\n", gen->module);
+    str_buf_printf(&sb, "/*********************\n *      INCLUDES\n *********************/\n");
+    str_buf_printf(&sb, "#include \"%s.h\"\n", gen->module);
+    if(gen->uses_converters) {
+        str_buf_printf(&sb, "#include \"lui_xml_base_types.h\"\n#include \"lui_xml_utils.h\"\n");
+    }
+
+    /*The style properties are stored by their IDs*/
+    str_buf_printf(&sb, "\n#if LVGL_VERSION_MAJOR != %d || LVGL_VERSION_MINOR != %d\n", LVGL_VERSION_MAJOR,
+                   LVGL_VERSION_MINOR);
+    str_buf_printf(&sb, "#error \"Generated for LVGL v%d.%d, generate it again\"\n#endif\n\n", LVGL_VERSION_MAJOR,
+                   LVGL_VERSION_MINOR);
+
+    if(gen->uses_params) {
+        str_buf_printf(&sb, "/**********************\n *  STATIC PROTOTYPES\n **********************/\n");
+        str_buf_printf(&sb, "static const char * param_value(const char * value, const char * def);\n\n");
+    }
+
+    str_buf_printf(&sb, "/**********************\n *  STATIC VARIABLES\n **********************/\n\n");
+    str_buf_add_buf(&sb, &gen->styles_src);
+
+    str_buf_printf(&sb, "/**********************\n *  GLOBAL VARIABLES\n **********************/\n\n");
+    str_buf_add_buf(&sb, &gen->subjects_src);
+
+    str_buf_printf(&sb, "\n/**********************\n *   GLOBAL FUNCTIONS\n **********************/\n\n");
+    str_buf_printf(&sb, "void %s_init(void)\n{\n", gen->module);
+    str_buf_add_buf(&sb, &gen->init_src);
+    str_buf_printf(&sb, "}\n\n");
+    str_buf_add_buf(&sb, &gen->funcs_src);
+
+    if(gen->uses_params) {
+        str_buf_printf(&sb, "/**********************\n *   STATIC FUNCTIONS\n **********************/\n\n");
+        str_buf_printf(&sb, "static const char * param_value(const char * value, const char * def)\n{\n");
+        str_buf_printf(&sb, "    /*Unresolved references fall back to the default value too*/\n");
+        str_buf_printf(&sb, "    if(value == NULL || value[0] == '#' || value[0] == '$') return def;\n");
+        str_buf_printf(&sb, "    return value;\n}\n");
+    }
+
+    if(sb.error) {
+        lv_free(sb.buf);
+        return NULL;
+    }
+    return sb.buf;
+}
+
+static char * build_header(codegen_t * gen)
+{
+    str_buf_t sb;
+    lv_memzero(&sb, sizeof(sb));
+
+    char guard[CODEGEN_IDENT_SIZE];
+    to_ident(guard, "", gen->module, "_H");
+    char * c;
+    for(c = guard; *c; c++) {
+        if(*c >= 'a' && *c <= 'z') *c = *c - 'a' + 'A';
+    }
+
+    str_buf_printf(&sb, "/**\n * @file %s.h\n *\n * Generated by lui_xml_codegen(), don't edit it.\n */\n\n", gen->module);
+    str_buf_printf(&sb, "#ifndef %s\n#define %s\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n", guard, guard);
+    str_buf_printf(&sb, "/*********************\n *      INCLUDES\n *********************/\n");
+    str_buf_printf(&sb, "#include \"lvgl.h\"\n\n");
+
+    str_buf_printf(&sb, "/**********************\n *      TYPEDEFS\n **********************/\n\n");
+    uint32_t i;
+    for(i = 0; i < gen->components.cnt; i++) {
+        lui_xml_component_scope_t * scope = (lui_xml_component_scope_t *)gen->components.items[i];
+        if(lv_ll_is_empty(&scope->param_ll)) continue;
+
+        char func[CODEGEN_IDENT_SIZE];
+        to_ident(func, "", scope->name, "");
+        str_buf_printf(&sb, "/** The properties of `%s`. NULL means the default value.*/\ntypedef struct {\n", func);
+        lui_xml_param_t * p;
+        LV_LL_READ(&scope->param_ll, p) {
+            char field[CODEGEN_IDENT_SIZE];
+            str_buf_printf(&sb, "    const char * %s;\n", to_ident(field, "", p->name, ""));
+        }
+        str_buf_printf(&sb, "} %s_params_t;\n\n", func);
+    }
+
+    str_buf_printf(&sb, "/**********************\n * GLOBAL VARIABLES\n **********************/\n\n");
+    str_buf_add_buf(&sb, &gen->subjects_header);
+
+    str_buf_printf(&sb, "\n/**********************\n * GLOBAL PROTOTYPES\n **********************/\n\n");
+    str_buf_printf(&sb, "/**\n * Initialize the subjects. Call it before creating anything.\n */\n");
+    str_buf_printf(&sb, "void %s_init(void);\n\n", gen->module);
+
+    for(i = 0; i < gen->components.cnt; i++) {
+        lui_xml_component_scope_t * scope = (lui_xml_component_scope_t *)gen->components.items[i];
+        char func[CODEGEN_IDENT_SIZE];
+        to_ident(func, "", scope->name, "");
+        str_buf_printf(&sb, "/**\n * Create `%s` as `lui_xml_create()` would\n", scope->name);
+        str_buf_printf(&sb, " * @param parent      the parent, or NULL to create a screen\n");
+        if(lv_ll_is_empty(&scope->param_ll)) {
+            str_buf_printf(&sb, " * @return            the created object\n */\n");
+            str_buf_printf(&sb, "lv_obj_t * %s_create(lv_obj_t * parent);\n\n", func);
+        }
+        else {
+            str_buf_printf(&sb, " * @param params      the properties or NULL to use the default values\n");
+            str_buf_printf(&sb, " * @return            the created object\n */\n");
+            str_buf_printf(&sb, "lv_obj_t * %s_create(lv_obj_t * parent, const %s_params_t * params);\n\n", func, func);
+        }
+    }
+
+    str_buf_printf(&sb, "#ifdef __cplusplus\n} /*extern \"C\"*/\n#endif\n\n#endif /*%s*/\n", guard);
+
+    if(sb.error) {
+        lv_free(sb.buf);
+        return NULL;
+    }
+    return sb.buf;
+}
+
+static void str_buf_printf(str_buf_t * sb, const char * fmt, ...)
+{
+    if(sb->error) return;
+
+    va_list args;
+    va_start(args, fmt);
+    va_list args2;
+    va_copy(args2, args);
+    int len = lv_vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+
+    if(len < 0 || !str_buf_reserve(sb, len)) {
+        sb->error = true;
+        va_end(args2);
+        return;
+    }
+
+    lv_vsnprintf(sb->buf + sb->len, len + 1, fmt, args2);
+    va_end(args2);
+    sb->len += len;
+}
+
+/** Add a string as a C string literal*/
+static void str_buf_add_c_str(str_buf_t * sb, const char * str)
+{
+    str_buf_printf(sb, "\"");
+    for(; *str; str++) {
+        uint8_t c = *str;
+        if(c == '"' || c == '\\') str_buf_printf(sb, "\\%c", c);
+        else if(c == '\n') str_buf_printf(sb, "\\n");
+        /*Octal so that a following digit can't continue the escape sequence*/
+        else if(c < 0x20 || c >= 0x7f) str_buf_printf(sb, "\\%03o", c);
+        else str_buf_printf(sb, "%c", c);
+    }
+    str_buf_printf(sb, "\"");
+}
+
+static void str_buf_add_buf(str_buf_t * sb, const str_buf_t * src)
+{
+    if(src->error) sb->error = true;
+    if(src->len == 0) return;
+    str_buf_printf(sb, "%s", src->buf);
+}
+
+static bool str_buf_reserve(str_buf_t * sb, uint32_t len)
+{
+    if(sb->len + len + 1 <= sb->cap) return true;
+
+    uint32_t new_cap = LV_MAX(sb->cap * 2, sb->len + len + 1);
+    new_cap = LV_MAX(new_cap, 256);
+    char * new_buf = lv_realloc(sb->buf, new_cap);
+    LV_ASSERT_MALLOC(new_buf);
+    if(new_buf == NULL) return false;
+
+    sb->buf = new_buf;
+    sb->cap = new_cap;
+    return true;
+}
+
+static bool ptr_list_add_unique(ptr_list_t * list, const void * item)
+{
+    uint32_t i;
+    for(i = 0; i < list->cnt; i++) {
+        if(list->items[i] == item) return true;
+    }
+
+    if(list->cnt == list->cap) {
+        uint32_t new_cap = list->cap ? list->cap * 2 : 16;
+        const void ** new_items = lv_realloc(list->items, new_cap * sizeof(void *));
+        LV_ASSERT_MALLOC(new_items);
+        if(new_items == NULL) return false;
+        list->items = new_items;
+        list->cap = new_cap;
+    }
+
+    list->items[list->cnt++] = item;
+    return true;
+}
+
+/**
+ * Make a C identifier from a name
+ * @param buf       store the identifier here (`CODEGEN_IDENT_SIZE` bytes)
+ * @param prefix    added before the name as it is
+ * @param str       the name, characters not allowed in identifiers are replaced by `_`
+ * @param suffix    added after the name as it is
+ * @return          `buf`
+ */
+static const char * to_ident(char * buf, const char * prefix, const char * str, const char * suffix)
+{
+    uint32_t len = lv_strlcpy(buf, prefix, CODEGEN_IDENT_SIZE);
+    if(len == 0 && str[0] >= '0' && str[0] <= '9' && len < CODEGEN_IDENT_SIZE - 1) buf[len++] = '_';
+
+    for(; *str && len < CODEGEN_IDENT_SIZE - 1; str++) {
+        char c = *str;
+        bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        buf[len++] = valid ? c : '_';
+    }
+    buf[len] = '\0';
+
+    lv_strlcpy(buf + len, suffix, CODEGEN_IDENT_SIZE - len);
+    return buf;
+}
+
+static const char * obj_var(char * buf, int32_t index)
+{
+    if(index < 0) lv_strlcpy(buf, "parent", CODEGEN_IDENT_SIZE);
+    else lv_snprintf(buf, CODEGEN_IDENT_SIZE, "obj%" LV_PRId32, index);
+    return buf;
+}
+
+#endif /* LV_USE_XML && LUI_XML_USE_CODEGEN */
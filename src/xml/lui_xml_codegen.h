@@ -0,0 +1,65 @@
+/**
+ * @file lui_xml_codegen.h
+ *
+ */
+
+#ifndef LUI_XML_CODEGEN_H
+#define LUI_XML_CODEGEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Enable `lui_xml_codegen()`. Usually only needed on the host.*/
+#ifndef LUI_XML_USE_CODEGEN
+#define LUI_XML_USE_CODEGEN 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_CODEGEN
+/**
+ * Generate C code which creates registered components and screens by calling
+ * the LVGL functions directly, the same way `lui_xml_create()` would.
+ * For each component `<name>_create(parent, params)` is generated, where `params`
+ * holds the component's properties as strings (NULL means the default value).
+ * Constants are folded, styles become constant `lv_style_t`s and subjects
+ * static `lv_subject_t`s initialized by `<module>_init()`.
+ * The components used by the given ones are generated too.
+ * Generating fails if something is used which the generator doesn't support.
+ * @param names     NULL terminated list of component and screen names
+ * @param module    name of the generated module, e.g. "ui" for `ui.c` and `ui.h`
+ * @param source    store the generated source here (free with `lv_free()`)
+ * @param header    store the generated header here (free with `lv_free()`)
+ * @return          LV_RESULT_OK: generated successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_codegen(const char ** names, const char * module, char ** source, char ** header);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_CODEGEN_H*/
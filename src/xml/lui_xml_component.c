@@ -19,6 +19,13 @@
 #include "parsers/lui_xml_obj_parser.h"
 #include "../libs/expat/expat.h"
 #include "../misc/lv_fs.h"
+#include "lui_xml_pack_private.h"
+#include "lui_xml_load_private.h"
+#include "lui_xml_profile_private.h"
+#include "lui_xml_update_private.h"
+#include "lui_xml_subject_private.h"
+#include "lui_xml_derived_private.h"
+#include "lui_xml_event_private.h"
 #include "../core/lv_global.h"
 #include <string.h>
 
@@ -37,6 +44,22 @@ typedef enum {
     STYLE_PROP_TYPE_UNKNOWN
 } style_prop_anim_type_t;
 
+/*Context of registering a component from a file chunk by chunk*/
+typedef struct {
+    lui_xml_parser_state_t state;
+    XML_Parser parser;
+    char * view_buf;            /**< Collects the raw bytes from `<view` (heap)*/
+    size_t view_len;
+    size_t view_cap;
+    XML_Index view_start;       /**< Absolute byte index of `<view`*/
+    XML_Index view_end;         /**< Absolute byte index after the view, -1 until known*/
+    XML_Index captured_end;     /**< Absolute byte index until which the bytes are collected*/
+    int view_start_tag_len;
+    int32_t depth;
+    int32_t view_depth;         /**< Depth of `<view>`, -1 if not found yet*/
+    bool capture_error;
+} stream_ctx_t;
+
 typedef struct {
     lv_style_selector_t selector;
     lv_style_prop_t prop;
@@ -54,7 +77,19 @@ static void process_const_element(lui_xml_parser_state_t * state, const char **
 static void process_font_element(lui_xml_parser_state_t * state, const char * type, const char ** attrs);
 static void process_image_element(lui_xml_parser_state_t * state, const char * type, const char ** attrs);
 static void process_prop_element(lui_xml_parser_state_t * state, const char * name, const char ** attrs);
-static char * extract_view_content(const char * xml_definition);
+static const char * find_view_content(const char * xml_definition, size_t len, size_t * view_len);
+static const char * mem_find(const char * buf, size_t len, const char * needle);
+static void scope_free_content(lui_xml_component_scope_t * scope);
+static bool register_state_init(lui_xml_parser_state_t * state, const char * name);
+static XML_Parser metadata_parser_create(void);
+static void register_abort(lui_xml_parser_state_t * state, bool globals);
+static lv_result_t register_finish(lui_xml_parser_state_t * state, const char * name, bool globals,
+                                   const char * view, size_t view_len, bool is_static);
+static lui_xml_component_scope_t * scope_add(lui_xml_parser_state_t * state, const char * name);
+static void stream_start_handler(void * user_data, const char * name, const char ** attrs);
+static void stream_end_handler(void * user_data, const char * name);
+static void stream_chunk_cb(const char * buf, uint32_t len, uint32_t offset, void * user_data);
+static void stream_view_append(stream_ctx_t * ctx, const char * buf, size_t len);
 static style_prop_anim_type_t style_prop_anim_get_type(lv_style_prop_t prop);
 static void anim_exec_cb(lv_anim_t * a, int32_t v);
 
@@ -80,11 +115,18 @@ void lui_xml_component_init(void)
     lv_memzero(global_scope, sizeof(lui_xml_component_scope_t));
 
     lui_xml_component_scope_init(global_scope);
-    global_scope->name = lv_strdup("globals");
+    global_scope->name = lui_xml_arena_strdup(&global_scope->arena, "globals");
+#if LUI_XML_USE_SUBJECT_CACHE
+    global_scope->subject_cache = lui_xml_subject_cache_create();
+#endif
+#if LUI_XML_USE_EVENT_CB_CACHE
+    global_scope->event_cache = lui_xml_event_cache_create();
+#endif
 }
 
 void lui_xml_component_scope_init(lui_xml_component_scope_t * scope)
 {
+    lui_xml_arena_init(&scope->arena, 0);
     lv_ll_init(&scope->style_ll, sizeof(lui_xml_style_t));
     lv_ll_init(&scope->const_ll, sizeof(lui_xml_const_t));
     lv_ll_init(&scope->param_ll, sizeof(lui_xml_param_t));
@@ -122,6 +164,7 @@ lv_obj_t * lui_xml_component_process(lui_xml_parser_state_t * state, const char
             lv_snprintf(name_buf, sizeof(name_buf), "%s_#", scope->name);
             lv_obj_set_name(state->item, name_buf);
         }
+        LUI_XML_UPDATE_INDEX_ADD(state->item);
     }
 #endif
     return item;
@@ -131,6 +174,19 @@ lui_xml_component_scope_t * lui_xml_component_get_scope(const char * component_n
 {
     if(component_name == NULL) return NULL;
 
+    lui_xml_component_scope_t * scope = lui_xml_component_find_scope(component_name);
+    if(scope) return scope;
+
+    /*Register it now if it was only indexed by a lazy load*/
+    if(lui_xml_load_register_indexed(component_name) != LV_RESULT_OK) return NULL;
+
+    return lui_xml_component_find_scope(component_name);
+}
+
+lui_xml_component_scope_t * lui_xml_component_find_scope(const char * component_name)
+{
+    if(component_name == NULL) return NULL;
+
     lui_xml_component_scope_t * scope;
     LV_LL_READ(&component_scope_ll, scope) {
         if(lv_streq(scope->name, component_name)) return scope;
@@ -141,63 +197,39 @@ lui_xml_component_scope_t * lui_xml_component_get_scope(const char * component_n
 
 lv_result_t lui_xml_register_component_from_data(const char * name, const char * xml_def)
 {
-    bool globals = false;
-    if(lv_streq(name, "globals")) globals = true;
+    return lui_xml_component_register_from_buf(name, xml_def, lv_strlen(xml_def), false);
+}
 
+lv_result_t lui_xml_component_register_from_buf(const char * name, const char * xml_def, size_t len, bool is_static)
+{
     /* Create a temporary parser state to extract styles/params/consts */
     lui_xml_parser_state_t state;
-    if(globals) {
-        lui_xml_component_scope_t * global_scope = lui_xml_component_get_scope("globals");
-        state.scope = *global_scope;
-    }
-    else {
-        lui_xml_parser_state_init(&state);
-        state.scope.name = name;
-    }
+    bool globals = register_state_init(&state, name);
 
     /* Parse the XML to extract metadata */
-    XML_Memory_Handling_Suite mem_handlers;
-    mem_handlers.malloc_fcn = lv_malloc;
-    mem_handlers.realloc_fcn = lv_realloc;
-    mem_handlers.free_fcn = lv_free;
-    XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+    XML_Parser parser = metadata_parser_create();
     XML_SetUserData(parser, &state);
     XML_SetElementHandler(parser, start_metadata_handler, end_metadata_handler);
 
-    if(XML_Parse(parser, xml_def, lv_strlen(xml_def), XML_TRUE) == XML_STATUS_ERROR) {
+    LUI_XML_PROFILE_BEGIN(PARSE);
+    enum XML_Status status = XML_Parse(parser, xml_def, len, XML_TRUE);
+    LUI_XML_PROFILE_END();
+    if(status == XML_STATUS_ERROR) {
         LV_LOG_ERROR("XML parsing error; %s on line %lu",
                      XML_ErrorString(XML_GetErrorCode(parser)),
                      (unsigned long)XML_GetCurrentLineNumber(parser));
         XML_ParserFree(parser);
-        lv_free((char *)state.scope.extends);
+        register_abort(&state, globals);
         return LV_RESULT_INVALID;
     }
 
     XML_ParserFree(parser);
 
+    /* Extract view content directly instead of using XML parser */
+    size_t view_len = 0;
+    const char * view = globals ? NULL : find_view_content(xml_def, len, &view_len);
 
-    /* Copy extracted metadata to component processor */
-    if(globals) {
-        lui_xml_component_scope_t * global_scope = lui_xml_component_get_scope("globals");
-        lv_memcpy(global_scope, &state.scope, sizeof(lui_xml_component_scope_t));
-    }
-    else {
-        lui_xml_component_scope_t * scope = lv_ll_ins_head(&component_scope_ll);
-        lv_memzero(scope, sizeof(lui_xml_component_scope_t));
-        lv_memcpy(scope, &state.scope, sizeof(lui_xml_component_scope_t));
-
-        /* Extract view content directly instead of using XML parser */
-        scope->view_def = extract_view_content(xml_def);
-        scope->name = lv_strdup(name);
-        if(!scope->view_def) {
-            LV_LOG_WARN("Failed to extract view content");
-            /* Clean up and return error */
-            lui_xml_unregister_component(name);
-            return LV_RESULT_INVALID;
-        }
-    }
-
-    return LV_RESULT_OK;
+    return register_finish(&state, name, globals, view, view_len, is_static);
 }
 
 
@@ -207,142 +239,210 @@ lv_result_t lui_xml_register_component_from_file(const char * path)
     /* Create a copy of the filename to modify */
     char * filename = lv_strdup(lv_fs_get_last(path));
     const char * ext = lv_fs_get_ext(filename);
-    filename[lv_strlen(filename) - lv_strlen(ext) - 1] = '\0'; /*Trim the extension*/
-
-    lv_fs_res_t fs_res;
-    lv_fs_file_t f;
-    fs_res = lv_fs_open(&f, path, LV_FS_MODE_RD);
-    if(fs_res != LV_FS_RES_OK) {
-        LV_LOG_WARN("Couldn't open %s", path);
-        lv_free(filename);
-        return LV_RESULT_INVALID;
-    }
+    if(ext[0]) filename[lv_strlen(filename) - lv_strlen(ext) - 1] = '\0'; /*Trim the extension*/
 
-    /* Determine file size */
-    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
-    uint32_t file_size = 0;
-    lv_fs_tell(&f, &file_size);
-    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    lv_result_t res = lui_xml_component_register_from_file_with_name(filename, path);
 
-    /* Create the buffer */
-    char * xml_buf = lv_malloc(file_size + 1);
-    if(xml_buf == NULL) {
-        LV_LOG_WARN("Memory allocation failed for file %s (%" LV_PRIu32 " bytes)", path, file_size + 1);
-        lv_free(filename);
-        lv_fs_close(&f);
-        return LV_RESULT_INVALID;
-    }
+    lv_free(filename);
 
-    /* Read the file content  */
-    uint32_t rn;
-    lv_fs_read(&f, xml_buf, file_size, &rn);
-    if(rn != file_size) {
-        LV_LOG_WARN("Couldn't read %s fully", path);
-        lv_free(filename);
-        lv_free(xml_buf);
-        lv_fs_close(&f);
-        return LV_RESULT_INVALID;
+    return res;
+}
+
+lv_result_t lui_xml_component_register_from_file_with_name(const char * name, const char * path)
+{
+    LUI_XML_PROFILE_FILE_BEGIN(path);
+
+    lui_xml_stream_t stream;
+    lv_result_t res = lui_xml_stream_open(&stream, path);
+    if(res == LV_RESULT_OK) {
+        res = lui_xml_component_register_from_stream(name, &stream);
+        lui_xml_stream_close(&stream);
     }
 
-    /* Null-terminate the buffer */
-    xml_buf[rn] = '\0';
+    LUI_XML_PROFILE_FILE_END();
+
+    return res;
+}
+
+lv_result_t lui_xml_component_register_from_stream(const char * name, lui_xml_stream_t * stream)
+{
+    /* The file is parsed chunk by chunk so only the raw <view> is collected in RAM */
+    stream_ctx_t ctx;
+    lv_memzero(&ctx, sizeof(ctx));
+    ctx.view_depth = -1;
+    ctx.view_end = -1;
+    bool globals = register_state_init(&ctx.state, name);
+
+    XML_Parser parser = metadata_parser_create();
+    ctx.parser = parser;
+    XML_SetUserData(parser, &ctx);
+    XML_SetElementHandler(parser, stream_start_handler, stream_end_handler);
+
+    lv_result_t res = lui_xml_stream_parse(stream, parser, stream_chunk_cb, &ctx);
+    XML_ParserFree(parser);
 
-    /* Register the component */
-    lv_result_t res = lui_xml_register_component_from_data(filename, xml_buf);
+    if(res == LV_RESULT_OK && ctx.capture_error) {
+        LV_LOG_WARN("Couldn't collect the view of %s", stream->path);
+        res = LV_RESULT_INVALID;
+    }
+
+    if(res != LV_RESULT_OK) {
+        register_abort(&ctx.state, globals);
+    }
+    else {
+        const char * view = NULL;
+        size_t view_len = 0;
+        if(ctx.view_end >= 0) {
+            view = ctx.view_buf;
+            view_len = (size_t)(ctx.view_end - ctx.view_start);
+        }
+        res = register_finish(&ctx.state, name, globals, view, view_len, false);
+    }
 
     /* Housekeeping */
-    lv_free(filename);
-    lv_free(xml_buf);
-    lv_fs_close(&f);
+    lv_free(ctx.view_buf);
 
     return res;
 }
 
-lv_result_t lui_xml_unregister_component(const char * name)
+lv_result_t lui_xml_component_register_from_doc(const char * name, const lui_xml_doc_t * doc)
 {
-    lui_xml_component_scope_t * scope = lui_xml_component_get_scope(name);
-    if(scope == NULL) return LV_RESULT_INVALID;
+    if(doc->error) return LV_RESULT_INVALID;
 
-    lv_ll_remove(&component_scope_ll, scope);
+    lui_xml_parser_state_t state;
+    bool globals = register_state_init(&state, name);
 
-    lv_free((char *)scope->name);
-    lv_free((char *)scope->view_def);
-    lv_free((char *)scope->extends);
+    lui_xml_doc_replay(doc, start_metadata_handler, end_metadata_handler, &state);
 
-    lui_xml_const_t * cnst;
-    LV_LL_READ(&scope->const_ll, cnst) {
-        lv_free((char *)cnst->name);
-        lv_free((char *)cnst->value);
-    }
-    lv_ll_clear(&scope->const_ll);
+    return register_finish(&state, name, globals, globals ? NULL : doc->view, doc->view_len, doc->view_static);
+}
 
-    lui_xml_param_t * param;
-    LV_LL_READ(&scope->param_ll, param) {
-        lv_free((char *)param->name);
-        lv_free((char *)param->def);
-        lv_free((char *)param->type);
-    }
-    lv_ll_clear(&scope->param_ll);
+lv_result_t lui_xml_component_register_from_pack(const char * name, const lui_xml_pack_t * pack,
+                                                 uint32_t entry_index)
+{
+    const lui_xml_pack_entry_t * entry = &pack->entries[entry_index];
 
-    lui_xml_font_t * font;
-    LV_LL_READ(&scope->font_ll, font) {
-        lv_free((char *)font->name);
+    lui_xml_parser_state_t state;
+    bool globals = register_state_init(&state, name);
+
+    /*The view is replayed for every instance, so allocate the attribute array only once.
+     *A component can't contain itself, so its view is never replayed recursively.
+     *The globals have no view and their arena is kept, so they just use a temporary array.*/
+    const uint32_t * words = &pack->tokens[entry->token_start];
+    const char ** attrs = NULL;
+    if(!globals) {
+        uint32_t attrs_size = lui_xml_pack_get_attrs_size(words, entry->token_word_cnt);
+        attrs = lui_xml_arena_alloc(&state.scope.arena, attrs_size * sizeof(const char *));
+        LV_ASSERT_MALLOC(attrs);
+        if(attrs == NULL) {
+            register_abort(&state, globals);
+            return LV_RESULT_INVALID;
+        }
     }
-    lv_ll_clear(&scope->font_ll);
 
-    lui_xml_image_t * image;
-    LV_LL_READ(&scope->image_ll, image) {
-        lv_free((char *)image->name);
-        lv_free((char *)image->src);
-    }
-    lv_ll_clear(&scope->image_ll);
+    lui_xml_pack_replay(pack, words, entry->token_word_cnt, attrs, start_metadata_handler, end_metadata_handler,
+                        &state);
 
-    lui_xml_style_t * style;
-    LV_LL_READ(&scope->style_ll, style) {
-        lv_free((char *)style->name);
-        lv_free((char *)style->long_name);
-        lv_style_reset(&style->style);
+    if(globals) return register_finish(&state, name, globals, NULL, 0, false);
+
+    if(entry->view_start == LUI_XML_PACK_NO_VIEW) {
+        LV_LOG_WARN("No view found in `%s`", name);
+        register_abort(&state, globals);
+        return LV_RESULT_INVALID;
     }
-    lv_ll_clear(&scope->style_ll);
 
+    lui_xml_component_scope_t * scope = scope_add(&state, name);
+    scope->pack = pack;
+    scope->view_tokens = &pack->tokens[entry->view_start];
+    scope->view_token_attrs = attrs;
+    scope->view_token_cnt = entry->view_word_cnt;
 
-    lui_xml_grad_t * grad;
-    LV_LL_READ(&scope->gradient_ll, grad) {
-        lv_free((char *)grad->name);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lui_xml_unregister_component(const char * name)
+{
+    /*Don't parse an indexed component just to remove it*/
+    lui_xml_component_scope_t * scope = lui_xml_component_find_scope(name);
+    if(scope == NULL) return lui_xml_load_remove_indexed(name);
+
+    /*The global scope always exists, so only empty it to allow registering the globals again*/
+    if(scope == lui_xml_component_find_scope("globals")) {
+        scope_free_content(scope);
+        lv_memzero(scope, sizeof(lui_xml_component_scope_t));
+        lui_xml_component_scope_init(scope);
+        scope->name = lui_xml_arena_strdup(&scope->arena, "globals");
+#if LUI_XML_USE_SUBJECT_CACHE
+        scope->subject_cache = lui_xml_subject_cache_create();
+#endif
+#if LUI_XML_USE_EVENT_CB_CACHE
+        scope->event_cache = lui_xml_event_cache_create();
+#endif
+        return LV_RESULT_OK;
     }
-    lv_ll_clear(&scope->gradient_ll);
 
-    lui_xml_subject_t * subject;
-    LV_LL_READ(&scope->subjects_ll, subject) {
-        lv_free((char *)subject->name);
-        if(subject->subject->type == LV_SUBJECT_TYPE_STRING) {
-            lv_free((char *)subject->subject->prev_value.pointer);
-            lv_free((char *)subject->subject->value.pointer);
+    lv_ll_remove(&component_scope_ll, scope);
+    scope_free_content(scope);
+    lv_free(scope);
+
+    return LV_RESULT_OK;
+}
+
+lui_xml_subject_t * lui_xml_component_find_subject(const lv_subject_t * subject)
+{
+    lui_xml_component_scope_t * scope;
+    LV_LL_READ(&component_scope_ll, scope) {
+        lui_xml_subject_t * s;
+        LV_LL_READ(&scope->subjects_ll, s) {
+            if(s->subject == subject) return s;
         }
-        lv_free(subject->subject);
     }
-    lv_ll_clear(&scope->subjects_ll);
 
-    lui_xml_timeline_t * timeline;
-    LV_LL_READ(&scope->timeline_ll, timeline) {
-        lui_xml_anim_timeline_child_t * child;
-        LV_LL_READ(&timeline->anims_ll, child) {
-            if(child->is_anim) {
-                lv_free(child->data.anim.user_data); /*It was anim_data_t*/
-                lv_free(child->data.anim.var); /*It was the name of the target object*/
+    return NULL;
+}
+
+bool lui_xml_component_is_pack_used(const lui_xml_pack_t * pack)
+{
+    lui_xml_component_scope_t * scope;
+    LV_LL_READ(&component_scope_ll, scope) {
+        if(scope->pack == pack) return true;
+    }
+
+    return false;
+}
+
+uint32_t lui_xml_component_create_pending_fonts(uint32_t max_cnt)
+{
+    uint32_t created_cnt = 0;
+    uint32_t pending_cnt = 0;
+    lui_xml_component_scope_t * scope;
+    LV_LL_READ(&component_scope_ll, scope) {
+        lui_xml_font_t * f;
+        LV_LL_READ(&scope->font_ll, f) {
+            if(f->src_path == NULL) continue;
+
+            if(max_cnt == 0 || created_cnt < max_cnt) {
+                lui_xml_font_create(f);
+                created_cnt++;
             }
             else {
-                lv_free((void *) child->data.incl.target_name);
-                lv_free((void *) child->data.incl.timeline_name);
+                pending_cnt++;
             }
         }
-        lv_ll_clear(&timeline->anims_ll);
-        lv_free((char *)timeline->name);
     }
-    lv_ll_clear(&scope->timeline_ll);
 
-    lv_free(scope);
+    return pending_cnt;
+}
+
+lv_result_t lui_xml_component_get_arena_stats(const char * name, lui_xml_arena_stats_t * stats)
+{
+    lui_xml_component_scope_t * scope = lui_xml_component_get_scope(name);
+    if(scope == NULL) {
+        LV_LOG_WARN("No component found with name `%s`", name);
+        return LV_RESULT_INVALID;
+    }
 
+    lui_xml_arena_get_stats(&scope->arena, stats);
     return LV_RESULT_OK;
 }
 
@@ -350,6 +450,190 @@ lv_result_t lui_xml_unregister_component(const char * name)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Prepare a parser state to collect the metadata of a component
+ * @param state     the state to initialize
+ * @param name      name of the component
+ * @return          true: `name` is "globals" so the global scope is extended
+ */
+static bool register_state_init(lui_xml_parser_state_t * state, const char * name)
+{
+    lui_xml_parser_state_init(state);
+
+    if(lv_streq(name, "globals")) {
+        lui_xml_component_scope_t * global_scope = lui_xml_component_find_scope("globals");
+        state->scope = *global_scope;
+        return true;
+    }
+
+    state->scope.name = name;
+    return false;
+}
+
+static XML_Parser metadata_parser_create(void)
+{
+    XML_Memory_Handling_Suite mem_handlers;
+    mem_handlers.malloc_fcn = lv_malloc;
+    mem_handlers.realloc_fcn = lv_realloc;
+    mem_handlers.free_fcn = lv_free;
+    return XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+}
+
+static void register_abort(lui_xml_parser_state_t * state, bool globals)
+{
+    if(globals) {
+        /*Keep what was registered before the error as the nodes and the arena are shared with the globals*/
+        lui_xml_component_scope_t * global_scope = lui_xml_component_find_scope("globals");
+        lv_memcpy(global_scope, &state->scope, sizeof(lui_xml_component_scope_t));
+    }
+    else {
+        scope_free_content(&state->scope);
+    }
+}
+
+/**
+ * Copy the extracted metadata to the component list
+ * @param state         the state used to collect the metadata
+ * @param name          name of the component
+ * @param globals       true if the global scope was extended
+ * @param view          the raw `<view>` element, not necessarily NULL terminated
+ * @param view_len      length of `view`
+ * @param is_static     reference `view` instead of copying it
+ * @return              LV_RESULT_OK: registered successfully, LV_RESULT_INVALID: otherwise
+ */
+static lv_result_t register_finish(lui_xml_parser_state_t * state, const char * name, bool globals,
+                                   const char * view, size_t view_len, bool is_static)
+{
+    if(globals) {
+        lui_xml_component_scope_t * global_scope = lui_xml_component_find_scope("globals");
+        lv_memcpy(global_scope, &state->scope, sizeof(lui_xml_component_scope_t));
+        return LV_RESULT_OK;
+    }
+
+    LUI_XML_PROFILE_BEGIN(REGISTER);
+    lui_xml_component_scope_t * scope = scope_add(state, name);
+    if(view && is_static) {
+        scope->view_def = view;
+        scope->view_def_static = 1;
+    }
+    else if(view) {
+        scope->view_def = lui_xml_arena_strndup(&scope->arena, view, view_len);
+    }
+    scope->view_def_len = view_len;
+    LUI_XML_PROFILE_END();
+
+    if(!scope->view_def) {
+        LV_LOG_WARN("Failed to extract view content");
+        /* Clean up and return error */
+        lui_xml_unregister_component(name);
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Add a new scope to the component list with the collected metadata
+ * @param state     the state used to collect the metadata
+ * @param name      name of the component
+ * @return          the new scope
+ */
+static lui_xml_component_scope_t * scope_add(lui_xml_parser_state_t * state, const char * name)
+{
+    lui_xml_component_scope_t * scope = lv_ll_ins_head(&component_scope_ll);
+    lv_memzero(scope, sizeof(lui_xml_component_scope_t));
+    lv_memcpy(scope, &state->scope, sizeof(lui_xml_component_scope_t));
+
+    scope->name = lui_xml_arena_strdup(&scope->arena, name);
+#if LUI_XML_USE_SUBJECT_CACHE
+    /*Created only now as the scope is copied when it's instantiated, but the copies share the cache*/
+    scope->subject_cache = lui_xml_subject_cache_create();
+#endif
+#if LUI_XML_USE_EVENT_CB_CACHE
+    scope->event_cache = lui_xml_event_cache_create();
+#endif
+
+    return scope;
+}
+
+static void stream_start_handler(void * user_data, const char * name, const char ** attrs)
+{
+    stream_ctx_t * ctx = user_data;
+    ctx->depth++;
+
+    if(ctx->view_depth < 0 && lv_streq(name, "view")) {
+        ctx->view_depth = ctx->depth;
+        ctx->view_start = XML_GetCurrentByteIndex(ctx->parser);
+        ctx->view_start_tag_len = XML_GetCurrentByteCount(ctx->parser);
+        ctx->captured_end = ctx->view_start;
+
+        /*The start tag might have arrived in an earlier chunk,
+         *so copy it and everything after it from expat's buffer*/
+        int offset = 0;
+        int size = 0;
+        const char * buf = XML_GetInputContext(ctx->parser, &offset, &size);
+        if(buf == NULL) ctx->capture_error = true;
+        else stream_view_append(ctx, buf + offset, size - offset);
+    }
+
+    start_metadata_handler(&ctx->state, name, attrs);
+}
+
+static void stream_end_handler(void * user_data, const char * name)
+{
+    stream_ctx_t * ctx = user_data;
+
+    if(ctx->depth == ctx->view_depth && ctx->view_end < 0) {
+        int count = XML_GetCurrentByteCount(ctx->parser);
+        /*The count is 0 for empty elements like <view/>*/
+        if(count == 0) ctx->view_end = ctx->view_start + ctx->view_start_tag_len;
+        else ctx->view_end = XML_GetCurrentByteIndex(ctx->parser) + count;
+    }
+    ctx->depth--;
+
+    end_metadata_handler(&ctx->state, name);
+}
+
+static void stream_chunk_cb(const char * buf, uint32_t len, uint32_t offset, void * user_data)
+{
+    stream_ctx_t * ctx = user_data;
+
+    /*Not in the view yet or already collected it*/
+    if(ctx->view_depth < 0 || ctx->capture_error) return;
+    if(ctx->view_end >= 0 && ctx->captured_end >= ctx->view_end) return;
+
+    XML_Index chunk_end = (XML_Index)offset + len;
+    if(ctx->captured_end >= chunk_end) return;
+    if(ctx->captured_end < (XML_Index)offset) {
+        ctx->capture_error = true;
+        return;
+    }
+
+    uint32_t skip = (uint32_t)(ctx->captured_end - offset);
+    stream_view_append(ctx, buf + skip, len - skip);
+}
+
+static void stream_view_append(stream_ctx_t * ctx, const char * buf, size_t len)
+{
+    if(len == 0) return;
+
+    if(ctx->view_len + len > ctx->view_cap) {
+        size_t new_cap = LV_MAX(ctx->view_cap * 2, ctx->view_len + len);
+        char * new_buf = lv_realloc(ctx->view_buf, new_cap);
+        LV_ASSERT_MALLOC(new_buf);
+        if(new_buf == NULL) {
+            ctx->capture_error = true;
+            return;
+        }
+        ctx->view_buf = new_buf;
+        ctx->view_cap = new_cap;
+    }
+
+    lv_memcpy(ctx->view_buf + ctx->view_len, buf, len);
+    ctx->view_len += len;
+    ctx->captured_end += len;
+}
+
 static void process_const_element(lui_xml_parser_state_t * state, const char ** attrs)
 {
     const char * name = lui_xml_get_value_of(attrs, "name");
@@ -387,9 +671,6 @@ static void process_font_element(lui_xml_parser_state_t * state, const char * ty
         return;
     }
 
-    char src_path_full[LUI_XML_MAX_PATH_LENGTH];
-    lv_snprintf(src_path_full, sizeof(src_path_full), "%s%s", xml_path_prefix, src_path);
-
     lui_xml_font_t * f;
     LV_LL_READ(&state->scope.font_ll, f) {
         if(lv_streq(f->name, name)) {
@@ -398,6 +679,9 @@ static void process_font_element(lui_xml_parser_state_t * state, const char * ty
         }
     }
 
+    lui_xml_font_type_t font_type;
+    int32_t font_size = 0;
+
     /*E.g. <tiny_ttf name="inter_xl" src_path="fonts/Inter-SemiBold.ttf" size="22"/> */
     if(lv_streq(type, "tiny_ttf")) {
         const char * size = lui_xml_get_value_of(attrs, "size");
@@ -406,56 +690,41 @@ static void process_font_element(lui_xml_parser_state_t * state, const char * ty
             return;
         }
 #if LV_TINY_TTF_FILE_SUPPORT
-        lv_font_t * font = lv_tiny_ttf_create_file(src_path_full, lui_xml_atoi(size));
-        if(font == NULL) {
-            LV_LOG_WARN("Couldn't load  `%s` tiny_ttf font", name);
-            return;
-        }
-        lv_result_t res = lui_xml_register_font(&state->scope, name, font);
-        if(res == LV_RESULT_INVALID) {
-            LV_LOG_WARN("Failed to register `%s` tiny_ttf font", name);
-            lv_tiny_ttf_destroy(font);
-            return;
-        }
-
-        /*Get the font which was just created and add a destroy_cb*/
-        lui_xml_font_t * new_font;
-        LV_LL_READ(&state->scope.font_ll, new_font) {
-            if(lv_streq(new_font->name, name))  {
-                new_font->font_destroy_cb = lv_tiny_ttf_destroy;
-                break;
-            }
-        }
-
+        font_type = LUI_XML_FONT_TYPE_TINY_TTF;
+        font_size = lui_xml_atoi(size);
 #else
         LV_LOG_WARN("LV_TINY_TTF_FILE_SUPPORT is not enabled for `%s` font", name);
-
+        return;
 #endif
     }
     else if(lv_streq(type, "bin")) {
-        lv_font_t * font = lv_binfont_create(src_path_full);
-        if(font == NULL) {
-            LV_LOG_WARN("Couldn't load `%s` bin font", name);
-            return;
-        }
-
-        lv_result_t res = lui_xml_register_font(&state->scope, name, font);
-        if(res == LV_RESULT_INVALID) {
-            LV_LOG_WARN("Failed to register `%s` bin font", name);
-            lv_binfont_destroy(font);
-            return;
-        }
-
-        lui_xml_font_t * new_font;
-        LV_LL_READ(&state->scope.font_ll, new_font) {
-            if(lv_streq(new_font->name, name))  {
-                new_font->font_destroy_cb = lv_binfont_destroy;
-                break;
-            }
-        }
+        font_type = LUI_XML_FONT_TYPE_BIN;
     }
     else {
         LV_LOG_WARN("`%s` is a not supported font type", type);
+        return;
+    }
+
+    if(lui_xml_register_font(&state->scope, name, NULL) != LV_RESULT_OK) {
+        LV_LOG_WARN("Failed to register `%s` font", name);
+        return;
+    }
+
+    /*The font was just added to the head of the list*/
+    f = lv_ll_get_head(&state->scope.font_ll);
+
+    char src_path_full[LUI_XML_MAX_PATH_LENGTH];
+    lv_snprintf(src_path_full, sizeof(src_path_full), "%s%s", xml_path_prefix, src_path);
+    f->src_path = lui_xml_arena_strdup(&state->scope.arena, src_path_full);
+    f->size = font_size;
+    f->type = font_type;
+
+    /*Only the path is stored now if the font is created on its first use*/
+    if(lui_xml_load_get_lazy_fonts()) return;
+
+    if(lui_xml_font_create(f) != LV_RESULT_OK) {
+        lv_ll_remove(&state->scope.font_ll, f);
+        lv_free(f);
     }
 }
 
@@ -487,6 +756,10 @@ static void process_subject_element(lui_xml_parser_state_t * state, const char *
     const char * name = lui_xml_get_value_of(attrs, "name");
     const char * value = lui_xml_get_value_of(attrs, "value");
 
+    /*E.g. <int name="temp_f" expr="temp_c * 9 / 5 + 32"/>*/
+    const char * expr = lui_xml_get_value_of(attrs, "expr");
+    if(expr && value == NULL) value = "0";
+
     if(name == NULL) {
         LV_LOG_WARN("'name' is missing from a subject");
         return;
@@ -496,9 +769,24 @@ static void process_subject_element(lui_xml_parser_state_t * state, const char *
         return;
     }
 
-    lv_subject_t * subject = lv_zalloc(sizeof(lv_subject_t));
+    lui_xml_subject_t * s;
+    LV_LL_READ(&state->scope.subjects_ll, s) {
+        if(lv_streq(s->name, name)) {
+            LV_LOG_INFO("Subject `%s` is already registered. Don't register it again.", name);
+            return;
+        }
+    }
+
+    lv_subject_t * subject = lui_xml_arena_zalloc(&state->scope.arena, sizeof(lv_subject_t));
+    LV_ASSERT_MALLOC(subject);
+    if(subject == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory for subject `%s`", name);
+        return;
+    }
+
     const char * min_value_str = lui_xml_get_value_of(attrs, "min_value");
     const char * max_value_str = lui_xml_get_value_of(attrs, "max_value");
+    bool growable = false;
 
     if(lv_streq(type, "int")) {
         lv_subject_init_int(subject, lui_xml_atoi(value));
@@ -514,13 +802,95 @@ static void process_subject_element(lui_xml_parser_state_t * state, const char *
 #endif
     else if(lv_streq(type, "color")) lv_subject_init_color(subject, lui_xml_to_color(value));
     else if(lv_streq(type, "string")) {
-        /*Simple solution for now. Will be improved later*/
-        char * buf_prev = lv_malloc(256);
-        char * buf_act = lv_malloc(256);
-        lv_subject_init_string(subject, buf_act, buf_prev, 256, value);
+        /*E.g. <string name="status" value="Idle" max_length="32" growable="false"/>*/
+        const char * max_length_str = lui_xml_get_value_of(attrs, "max_length");
+        const char * growable_str = lui_xml_get_value_of(attrs, "growable");
+        growable = growable_str && lui_xml_to_bool(growable_str);
+
+        /*E.g. <string name="title" value="Settings" max_length="auto"/>*/
+        bool auto_size = max_length_str ? lv_streq(max_length_str, "auto") : LUI_XML_STRING_SUBJECT_AUTO_SIZE;
+
+        size_t value_size = lv_strlen(value) + 1;
+        size_t buf_size;
+        if(max_length_str && !auto_size) {
+            buf_size = lui_xml_atoi(max_length_str) + 1;
+            if(buf_size < value_size && !growable) {
+                LV_LOG_WARN("The initial value of the `%s` string subject is longer than `max_length` and "
+                            "will be truncated", name);
+            }
+            if(buf_size < value_size && growable) buf_size = value_size;
+        }
+        else if(growable || auto_size) {
+            buf_size = LV_MAX(value_size, LUI_XML_STRING_SUBJECT_MIN_SIZE);
+        }
+        else {
+            /*Strings set later are truncated to this size, so keep the same default as before*/
+            buf_size = LV_MAX(value_size, LUI_XML_STRING_SUBJECT_DEFAULT_SIZE);
+        }
+
+        char * buf_prev;
+        char * buf_act;
+        if(growable) {
+            /*Freed in `lui_xml_unregister_component()` as `lui_xml_subject_copy_string()` can reallocate them*/
+            buf_prev = lv_malloc(buf_size);
+            buf_act = lv_malloc(buf_size);
+            if(buf_prev == NULL || buf_act == NULL) {
+                lv_free(buf_prev);
+                lv_free(buf_act);
+                buf_prev = NULL;
+                buf_act = NULL;
+            }
+        }
+        else {
+            buf_prev = lui_xml_arena_alloc(&state->scope.arena, buf_size);
+            buf_act = lui_xml_arena_alloc(&state->scope.arena, buf_size);
+        }
+
+        LV_ASSERT_MALLOC(buf_act);
+        LV_ASSERT_MALLOC(buf_prev);
+        if(buf_prev == NULL || buf_act == NULL) {
+            LV_LOG_WARN("Couldn't allocate memory for the `%s` string subject", name);
+            return;
+        }
+
+        lv_subject_init_string(subject, buf_act, buf_prev, buf_size, value);
     }
 
     lui_xml_register_subject(&state->scope, name, subject);
+
+    /*E.g. <int name="speed" value="0" deferred="true"/>*/
+    const char * deferred_str = lui_xml_get_value_of(attrs, "deferred");
+    bool deferred = deferred_str && lui_xml_to_bool(deferred_str);
+#if LUI_XML_USE_DEFERRED_SUBJECTS == 0
+    if(deferred) {
+        LV_LOG_WARN("`%s` is not deferred as LUI_XML_USE_DEFERRED_SUBJECTS is disabled", name);
+        deferred = false;
+    }
+#endif
+
+#if LUI_XML_USE_DERIVED_SUBJECTS == 0
+    if(expr) {
+        LV_LOG_WARN("`%s` is not computed from `%s` as LUI_XML_USE_DERIVED_SUBJECTS is disabled", name, expr);
+        expr = NULL;
+    }
+#endif
+
+    if(growable || deferred || expr) {
+        /*Get the subject which was just registered and set its options*/
+        LV_LL_READ(&state->scope.subjects_ll, s) {
+            if(s->subject == subject)  {
+                s->growable = growable;
+#if LUI_XML_USE_DERIVED_SUBJECTS
+                /*Compute the value before a deferred subject copies it to its relay*/
+                if(expr) lui_xml_derived_create(&state->scope, s, expr);
+#endif
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+                if(deferred) lui_xml_subject_defer(s);
+#endif
+                break;
+            }
+        }
+    }
 }
 
 static void process_timeline_element(lui_xml_parser_state_t * state, const char ** attrs)
@@ -626,7 +996,7 @@ static void process_animation_element(lui_xml_parser_state_t * state, const char
     child->is_anim = true;
     lv_anim_t * a = &child->data.anim;
 
-    anim_data_t * anim_data = lv_malloc(sizeof(anim_data_t));
+    anim_data_t * anim_data = lui_xml_arena_alloc(&state->scope.arena, sizeof(anim_data_t));
     anim_data->selector = selector;
     anim_data->prop = prop;
     anim_data->prop_type = prop_type;
@@ -652,7 +1022,7 @@ static void process_animation_element(lui_xml_parser_state_t * state, const char
         lv_anim_set_custom_exec_cb(a, anim_exec_cb);
     }
 
-    lv_anim_set_var(a, lv_strdup(target_str));
+    lv_anim_set_var(a, lui_xml_arena_strdup(&state->scope.arena, target_str));
     lv_anim_set_duration(a, lui_xml_atoi(duration_str));
     lv_anim_set_delay(a, lui_xml_atoi(delay_str));
     lv_anim_set_early_apply(a, lui_xml_to_bool(early_apply_str));
@@ -701,16 +1071,15 @@ static void process_include_timeline_element(lui_xml_parser_state_t * state, con
 
     child->is_anim = false;
     child->data.incl.delay = lui_xml_atoi(delay_str);
-    child->data.incl.target_name = lv_strdup(target_str);
+    child->data.incl.target_name = lui_xml_arena_strdup(&state->scope.arena, target_str);
     LV_ASSERT_MALLOC(child->data.incl.target_name);
-    child->data.incl.timeline_name = lv_strdup(timeline_str);
+    child->data.incl.timeline_name = lui_xml_arena_strdup(&state->scope.arena, timeline_str);
     LV_ASSERT_MALLOC(child->data.incl.timeline_name);
 
     if(child->data.incl.target_name == NULL || child->data.incl.timeline_name == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
-        lv_free((void *)child->data.incl.target_name);
-        lv_free((void *)child->data.incl.timeline_name);
         lv_ll_remove(&at->anims_ll, child);
+        lv_free(child);
     }
 }
 
@@ -719,7 +1088,7 @@ static void process_grad_element(lui_xml_parser_state_t * state, const char * ta
     lui_xml_grad_t * grad = lv_ll_ins_tail(&state->scope.gradient_ll);
     lv_memzero(grad, sizeof(lui_xml_grad_t));
 
-    grad->name = lv_strdup(lui_xml_get_value_of(attrs, "name"));
+    grad->name = lui_xml_arena_strdup(&state->scope.arena, lui_xml_get_value_of(attrs, "name"));
     lv_grad_dsc_t * dsc = &grad->grad_dsc;
     lv_memzero(dsc, sizeof(lv_grad_dsc_t));
     dsc->extend = LV_GRAD_EXTEND_PAD;
@@ -877,20 +1246,21 @@ static void process_prop_element(lui_xml_parser_state_t * state, const char * na
     lui_xml_param_t * prop = lv_ll_ins_tail(&state->scope.param_ll);
     lv_memzero(prop, sizeof(lui_xml_param_t));
 
-    prop->name = lv_strdup(lui_xml_get_value_of(attrs, "name"));
+    prop->name = lui_xml_arena_strdup(&state->scope.arena, lui_xml_get_value_of(attrs, "name"));
     const char * def = lui_xml_get_value_of(attrs, "default");
-    if(def) prop->def = lv_strdup(def);
+    if(def) prop->def = lui_xml_arena_strdup(&state->scope.arena, def);
     else prop->def = NULL;
 
     const char * type = lui_xml_get_value_of(attrs, "type");
     if(type == NULL) type = "compound"; /*If there in no type it means there are <param>s*/
-    prop->type = lv_strdup(type);
+    prop->type = lui_xml_arena_strdup(&state->scope.arena, type);
 }
 
 
 static void start_metadata_handler(void * user_data, const char * name, const char ** attrs)
 {
     lui_xml_parser_state_t * state = (lui_xml_parser_state_t *)user_data;
+    LUI_XML_PROFILE_BEGIN(REGISTER);
 
     lui_xml_parser_section_t old_section = state->section;
     lui_xml_parser_start_section(state, name);
@@ -898,7 +1268,7 @@ static void start_metadata_handler(void * user_data, const char * name, const ch
         const char * extends = lui_xml_get_value_of(attrs, "extends");
         if(extends == NULL) extends = "lv_obj";
 
-        state->scope.extends = lv_strdup(extends);
+        state->scope.extends = lui_xml_arena_strdup(&state->scope.arena, extends);
     }
 
     if(lv_streq(name, "widget")) state->scope.is_widget = 1;
@@ -907,17 +1277,17 @@ static void start_metadata_handler(void * user_data, const char * name, const ch
     /* Process elements based on current context */
     switch(state->section) {
         case LUI_XML_PARSER_SECTION_API:
-            if(old_section != state->section) return;   /*Ignore the section opening, e.g. <api>*/
+            if(old_section != state->section) break;    /*Ignore the section opening, e.g. <api>*/
             process_prop_element(state, name, attrs);
             break;
 
         case LUI_XML_PARSER_SECTION_CONSTS:
-            if(old_section != state->section) return;   /*Ignore the section opening, e.g. <consts>*/
+            if(old_section != state->section) break;    /*Ignore the section opening, e.g. <consts>*/
             process_const_element(state, attrs);
             break;
 
         case LUI_XML_PARSER_SECTION_GRAD:
-            if(old_section != state->section) return;   /*Ignore the section opening, e.g. <gradients>*/
+            if(old_section != state->section) break;    /*Ignore the section opening, e.g. <gradients>*/
             process_grad_element(state, name, attrs);
             break;
 
@@ -926,22 +1296,28 @@ static void start_metadata_handler(void * user_data, const char * name, const ch
             break;
 
         case LUI_XML_PARSER_SECTION_STYLES:
-            if(old_section != state->section) return;   /*Ignore the section opening, e.g. <styles>*/
+            if(old_section != state->section) break;    /*Ignore the section opening, e.g. <styles>*/
+            LUI_XML_PROFILE_BEGIN(STYLES);
             lui_xml_register_style(&state->scope, attrs);
+            LUI_XML_PROFILE_END();
             break;
 
         case LUI_XML_PARSER_SECTION_FONTS:
-            if(old_section != state->section) return;   /*Ignore the section opening, e.g. <styles>*/
+            if(old_section != state->section) break;    /*Ignore the section opening, e.g. <styles>*/
+            LUI_XML_PROFILE_BEGIN(FONTS);
             process_font_element(state, name, attrs);
+            LUI_XML_PROFILE_END();
             break;
 
         case LUI_XML_PARSER_SECTION_IMAGES:
-            if(old_section != state->section) return;   /*Ignore the section opening, e.g. <styles>*/
+            if(old_section != state->section) break;    /*Ignore the section opening, e.g. <styles>*/
+            LUI_XML_PROFILE_BEGIN(IMAGES);
             process_image_element(state, name, attrs);
+            LUI_XML_PROFILE_END();
             break;
 
         case LUI_XML_PARSER_SECTION_SUBJECTS:
-            if(old_section != state->section) return;   /*Ignore the section opening, e.g. <subjects>*/
+            if(old_section != state->section) break;    /*Ignore the section opening, e.g. <subjects>*/
             process_subject_element(state, name, attrs);
             break;
         case LUI_XML_PARSER_SECTION_TIMELINE:
@@ -956,6 +1332,8 @@ static void start_metadata_handler(void * user_data, const char * name, const ch
         default:
             break;
     }
+
+    LUI_XML_PROFILE_END();
 }
 
 static void end_metadata_handler(void * user_data, const char * name)
@@ -964,36 +1342,95 @@ static void end_metadata_handler(void * user_data, const char * name)
     lui_xml_parser_end_section(state, name);
 }
 
-static char * extract_view_content(const char * xml_definition)
+static const char * find_view_content(const char * xml_definition, size_t len, size_t * view_len)
 {
     if(!xml_definition) return NULL;
 
     /* Find start of view tag */
-    const char * start = strstr(xml_definition, "<view");
+    const char * start = mem_find(xml_definition, len, "<view");
     if(!start) return NULL;
 
     /* Find end of view tag */
-    const char * end = strstr(xml_definition, "</view>");
+    size_t remaining = len - (start - xml_definition);
+    const char * end = mem_find(start, remaining, "</view>");
     if(end) {
         end += 7; /* Include "</view>" in result */
     }
     else {
         /*If there is no "</view> maybe it's like <view ... />"*/
-        end = strstr(start, "/>");
+        end = mem_find(start, remaining, "/>");
         if(!end) return NULL;
         end += 2; /* Include "/>" in result */
     }
 
-    /* Calculate and allocate length */
-    size_t len = end - start;
-    char * view_content = lv_malloc(len + 1);
-    if(!view_content) return NULL;
+    *view_len = end - start;
+    return start;
+}
+
+/**
+ * Like `strstr` but the buffer is not necessarily NULL terminated
+ */
+static const char * mem_find(const char * buf, size_t len, const char * needle)
+{
+    size_t needle_len = lv_strlen(needle);
+    if(needle_len > len) return NULL;
+
+    size_t i;
+    for(i = 0; i <= len - needle_len; i++) {
+        if(buf[i] == needle[0] && lv_memcmp(&buf[i], needle, needle_len) == 0) return &buf[i];
+    }
+
+    return NULL;
+}
+
+static void scope_free_content(lui_xml_component_scope_t * scope)
+{
+    /*The strings and data are in the arena, only the styles and
+     *the linked lists have memory allocated outside of it*/
+    lui_xml_style_t * style;
+    LV_LL_READ(&scope->style_ll, style) {
+        lv_style_reset(&style->style);
+    }
+
+    lui_xml_timeline_t * timeline;
+    LV_LL_READ(&scope->timeline_ll, timeline) {
+        lv_ll_clear(&timeline->anims_ll);
+    }
+
+    /*Growable string subjects can be reallocated so they are not in the arena.
+     *Their handles and relays are also freed.*/
+    lui_xml_subject_t * subject;
+    LV_LL_READ(&scope->subjects_ll, subject) {
+        lui_xml_subject_release(subject);
+        if(subject->growable) {
+            lv_free((void *)subject->subject->value.pointer);
+            lv_free((void *)subject->subject->prev_value.pointer);
+        }
+    }
 
-    /* Copy content and null terminate */
-    lv_memcpy(view_content, start, len);
-    view_content[len] = '\0';
+    lv_ll_clear(&scope->style_ll);
+    lv_ll_clear(&scope->const_ll);
+    lv_ll_clear(&scope->param_ll);
+    lv_ll_clear(&scope->gradient_ll);
+    lv_ll_clear(&scope->subjects_ll);
+    lv_ll_clear(&scope->timeline_ll);
+    lv_ll_clear(&scope->font_ll);
+    lv_ll_clear(&scope->image_ll);
+    lv_ll_clear(&scope->event_ll);
+
+#if LUI_XML_USE_SUBJECT_CACHE
+    lui_xml_subject_cache_delete(scope->subject_cache);
+    scope->subject_cache = NULL;
+#endif
+
+#if LUI_XML_USE_EVENT_CB_CACHE
+    lui_xml_event_cache_delete(scope->event_cache);
+    scope->event_cache = NULL;
+    /*Other components could have cached the removed global callbacks*/
+    if(scope->name && lv_streq(scope->name, "globals")) lui_xml_event_cache_invalidate();
+#endif
 
-    return view_content;
+    lui_xml_arena_destroy(&scope->arena);
 }
 
 
@@ -16,6 +16,8 @@ extern "C" {
 #include "../misc/lv_types.h"
 #if LV_USE_XML
 
+#include "lui_xml_arena.h"
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -63,6 +65,15 @@ lui_xml_component_scope_t * lui_xml_component_get_scope(const char * component_n
  */
 lv_result_t lui_xml_unregister_component(const char * name);
 
+/**
+ * Get how much memory the metadata (names, constants, subjects, etc.) of a component uses.
+ * All these are stored in one arena which is freed at once on unregistration.
+ * @param name      the name of the component
+ * @param stats     store the result here
+ * @return          LV_RESULT_OK if the component was found, LV_RESULT_INVALID otherwise.
+ */
+lv_result_t lui_xml_component_get_arena_stats(const char * name, lui_xml_arena_stats_t * stats);
+
 /**********************
  *      MACROS
  **********************/
@@ -17,6 +17,12 @@ extern "C" {
 #if LV_USE_XML
 
 #include "lui_xml_utils.h"
+#include "lui_xml_arena.h"
+#include "lui_xml_doc.h"
+#include "lui_xml_stream.h"
+#include "lui_xml_pack.h"
+#include "lui_xml_subject.h"
+#include "lui_xml_event.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_style.h"
 #include "../core/lv_observer.h"
@@ -28,6 +34,7 @@ extern "C" {
 typedef  void * (*lui_xml_component_process_cb_t)(lv_obj_t * parent, const char * data, const char ** attrs);
 
 struct _lui_xml_component_scope_t {
+    lui_xml_arena_t arena;      /**< All the strings and data of the scope are allocated here*/
     const char * name;
     lv_ll_t style_ll;
     lv_ll_t const_ll;
@@ -38,10 +45,26 @@ struct _lui_xml_component_scope_t {
     lv_ll_t font_ll;
     lv_ll_t image_ll;
     lv_ll_t event_ll;
-    const char * view_def;
+    const char * view_def;          /**< The `<view>` element. Not NULL terminated if `view_def_static`*/
     const char * extends;
+    uint32_t view_def_len;
+    const lui_xml_pack_t * pack;    /**< The pack of `view_tokens`*/
+    const struct _lui_xml_load_t * load;    /**< The loaded data blob which registered the component or NULL*/
+    const uint32_t * view_tokens;   /**< The compiled `<view>` in a pack, used instead of `view_def`*/
+    const char ** view_token_attrs; /**< Array to replay `view_tokens` with, allocated once in the arena*/
+    uint32_t view_token_cnt;
     uint32_t is_widget : 1;
     uint32_t is_screen : 1;
+    uint32_t view_def_static : 1;   /**< `view_def` points into a buffer which outlives the component*/
+    uint32_t instance_cnt;          /**< Number of instances created so far*/
+    uint32_t instance_obj_size;     /**< Widget bytes of the last instance*/
+    uint32_t instance_style_size;   /**< Style bytes of the last instance*/
+#if LUI_XML_USE_SUBJECT_CACHE
+    struct _lui_xml_subject_cache_t * subject_cache;    /**< Shared by the copies of the scope*/
+#endif
+#if LUI_XML_USE_EVENT_CB_CACHE
+    struct _lui_xml_event_cache_t * event_cache;        /**< Shared by the copies of the scope*/
+#endif
     struct _lui_xml_component_scope_t * next;
 };
 
@@ -50,9 +73,20 @@ typedef struct {
     const char * value;
 } lui_xml_const_t;
 
-typedef struct {
+typedef struct _lui_xml_subject_t {
     const char * name;
     lv_subject_t * subject;
+    uint32_t handle_slot;                   /**< Slot of the handle + 1 or 0 if the subject has no handle*/
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+    lv_subject_t * relay;                   /**< The widgets are bound to it if the subject is deferred*/
+    lv_observer_t * observer;               /**< Notes the changes of `subject` to flush them*/
+    struct _lui_xml_subject_t * next_dirty; /**< Next subject with a pending change*/
+    uint32_t dirty : 1;                     /**< The subject changed since the last flush*/
+#endif
+#if LUI_XML_USE_DERIVED_SUBJECTS
+    struct _lui_xml_derived_t * derived;    /**< The expression computing the subject or NULL*/
+#endif
+    uint32_t growable : 1;      /**< The string buffers are on the heap and can be reallocated*/
 } lui_xml_subject_t;
 
 typedef struct {
@@ -86,6 +120,84 @@ void lui_xml_component_init(void);
  */
 void lui_xml_component_scope_init(lui_xml_component_scope_t * scope);
 
+/**
+ * Find a registered component without registering the components indexed
+ * by a lazy load. Use it where a component shouldn't be parsed just to be looked up.
+ * @param component_name    name of the component
+ * @return                  pointer to the scope or NULL if not registered
+ */
+lui_xml_component_scope_t * lui_xml_component_find_scope(const char * component_name);
+
+/**
+ * Register a component from a buffer which is not necessarily NULL terminated.
+ * @param name          name of the component
+ * @param xml_def       the XML definition of the component
+ * @param len           length of `xml_def` in bytes
+ * @param is_static     true: `xml_def` stays valid until the component is unregistered,
+ *                      so the view definition is not copied but referenced directly
+ * @return              LV_RESULT_OK: loaded successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_component_register_from_buf(const char * name, const char * xml_def, size_t len, bool is_static);
+
+/**
+ * Register a component from a file with a given name.
+ * The file is read chunk by chunk, only the view definition is collected in RAM.
+ * @param name      name of the component
+ * @param path      path to the XML file
+ * @return          LV_RESULT_OK: loaded successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_component_register_from_file_with_name(const char * name, const char * path);
+
+/**
+ * Register a component from an opened stream.
+ * Parsing starts with the chunk which was read when the stream was opened.
+ * @param name      name of the component
+ * @param stream    an opened stream, it's not closed by this function
+ * @return          LV_RESULT_OK: loaded successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_component_register_from_stream(const char * name, lui_xml_stream_t * stream);
+
+/**
+ * Register a component from a loaded binary pack. The view is not copied,
+ * the pack needs to stay valid until the component is unregistered.
+ * @param name          name of the component
+ * @param pack          a loaded pack
+ * @param entry_index   index of the component's entry in the pack
+ * @return              LV_RESULT_OK: loaded successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_component_register_from_pack(const char * name, const lui_xml_pack_t * pack,
+                                                 uint32_t entry_index);
+
+/**
+ * Register a component from an already tokenized document.
+ * Only this step touches the global state, so the tokenizing can be done on other threads.
+ * @param name      name of the component
+ * @param doc       a tokenized document
+ * @return          LV_RESULT_OK: loaded successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_component_register_from_doc(const char * name, const lui_xml_doc_t * doc);
+
+/**
+ * Find the registry entry of a subject in all the registered components
+ * @param subject   pointer to a subject
+ * @return          the entry or NULL if the subject is not registered
+ */
+lui_xml_subject_t * lui_xml_component_find_subject(const lv_subject_t * subject);
+
+/**
+ * Check if any registered component, even a shadowed one, references a pack
+ * @param pack      a loaded pack
+ * @return          true: the pack needs to stay valid
+ */
+bool lui_xml_component_is_pack_used(const lui_xml_pack_t * pack);
+
+/**
+ * Create the fonts of all components which are not created yet as they are loaded lazily
+ * @param max_cnt   create at most this many fonts, 0 to create all
+ * @return          number of fonts which are still not created
+ */
+uint32_t lui_xml_component_create_pending_fonts(uint32_t max_cnt);
+
 /**********************
  *      MACROS
  **********************/
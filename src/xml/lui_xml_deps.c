@@ -0,0 +1,336 @@
+/**
+ * @file lui_xml_deps.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_deps.h"
+#if LV_USE_XML
+
+#include "lui_xml_utils.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../stdlib/lv_sprintf.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define NO_NODE         0xFFFFFFFF
+#define CYCLE_BUF_SIZE  256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _deps_edge_t {
+    uint32_t to;
+    struct _deps_edge_t * next;
+} deps_edge_t;
+
+typedef enum {
+    NODE_NEW,
+    NODE_VISITING,      /**< On the path of the depth first search*/
+    NODE_DONE,
+} node_state_t;
+
+typedef struct {
+    const char * name;
+    deps_edge_t * edge_head;
+    deps_edge_t * edge_tail;
+    node_state_t state;
+} deps_node_t;
+
+typedef struct {
+    deps_node_t * nodes;
+    uint32_t node_cnt;
+    uint32_t * table;           /**< Open addressing hash table of the last node index + 1 by name*/
+    uint32_t table_size;
+    lui_xml_arena_t arena;      /**< The edges are allocated here*/
+    uint32_t * path;            /**< The nodes being visited, to print the cycles*/
+    uint32_t path_len;
+    uint32_t * order;
+    uint32_t order_cnt;
+    uint32_t cycle_cnt;
+} deps_graph_t;
+
+typedef struct {
+    deps_graph_t * graph;
+    uint32_t node;
+    uint32_t depth;
+    uint32_t view_depth;        /**< Depth of the `<view>` + 1 while in it*/
+} deps_collect_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t find_node(const deps_graph_t * graph, const char * name, size_t len);
+static void add_edge(deps_graph_t * graph, uint32_t from, uint32_t to);
+static void add_style_edges(deps_collect_t * ctx, const char * value);
+static void collect_start_handler(void * user_data, const char * name, const char ** attrs);
+static void collect_end_handler(void * user_data, const char * name);
+static void visit(deps_graph_t * graph, uint32_t node);
+static void report_cycle(const deps_graph_t * graph, uint32_t node);
+static uint32_t name_hash(const char * name, size_t len);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint32_t lui_xml_deps_sort(const char * const * names, const lui_xml_doc_t * const * docs, uint32_t cnt,
+                           uint32_t * order)
+{
+    deps_graph_t graph;
+    lv_memzero(&graph, sizeof(graph));
+    lui_xml_arena_init(&graph.arena, 0);
+    graph.node_cnt = cnt;
+    graph.order = order;
+
+    graph.table_size = 16;
+    while(graph.table_size < cnt * 2) graph.table_size *= 2;
+
+    graph.nodes = lv_zalloc(cnt * sizeof(deps_node_t));
+    graph.table = lv_zalloc(graph.table_size * sizeof(uint32_t));
+    graph.path = lv_malloc(cnt * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(graph.nodes);
+    LV_ASSERT_MALLOC(graph.table);
+    LV_ASSERT_MALLOC(graph.path);
+
+    uint32_t i;
+    if(graph.nodes == NULL || graph.table == NULL || graph.path == NULL) {
+        /*Keep the original order*/
+        for(i = 0; i < cnt; i++) order[i] = i;
+        graph.order_cnt = cnt;
+    }
+    else {
+        for(i = 0; i < cnt; i++) {
+            graph.nodes[i].name = names[i];
+            if(names[i] == NULL) continue;
+
+            /*The later file defining the same component needs to stay later to shadow the earlier*/
+            uint32_t prev = find_node(&graph, names[i], lv_strlen(names[i]));
+            if(prev != NO_NODE) add_edge(&graph, i, prev);
+
+            uint32_t mask = graph.table_size - 1;
+            uint32_t slot = name_hash(names[i], lv_strlen(names[i])) & mask;
+            while(graph.table[slot] && !lv_streq(graph.nodes[graph.table[slot] - 1].name, names[i])) {
+                slot = (slot + 1) & mask;
+            }
+            graph.table[slot] = i + 1;
+        }
+
+        for(i = 0; i < cnt; i++) {
+            if(names[i] == NULL || docs[i] == NULL) continue;
+
+            deps_collect_t ctx;
+            lv_memzero(&ctx, sizeof(ctx));
+            ctx.graph = &graph;
+            ctx.node = i;
+            lui_xml_doc_replay(docs[i], collect_start_handler, collect_end_handler, &ctx);
+        }
+
+        for(i = 0; i < cnt; i++) {
+            if(graph.nodes[i].state == NODE_NEW) visit(&graph, i);
+        }
+    }
+
+    lv_free(graph.nodes);
+    lv_free(graph.table);
+    lv_free(graph.path);
+    lui_xml_arena_destroy(&graph.arena);
+
+    return graph.cycle_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Find the last file defining a component
+ * @param graph     the graph
+ * @param name      name of the component, not necessarily NULL terminated
+ * @param len       length of `name`
+ * @return          index of the node or `NO_NODE`
+ */
+static uint32_t find_node(const deps_graph_t * graph, const char * name, size_t len)
+{
+    uint32_t mask = graph->table_size - 1;
+    uint32_t slot = name_hash(name, len) & mask;
+    while(graph->table[slot]) {
+        uint32_t node = graph->table[slot] - 1;
+        const char * node_name = graph->nodes[node].name;
+        if(lv_strncmp(node_name, name, len) == 0 && node_name[len] == '\0') return node;
+        slot = (slot + 1) & mask;
+    }
+
+    return NO_NODE;
+}
+
+static void add_edge(deps_graph_t * graph, uint32_t from, uint32_t to)
+{
+    /*A component using itself*/
+    if(from == to) {
+        graph->cycle_cnt++;
+        LV_LOG_WARN("Dependency cycle: %s -> %s", graph->nodes[from].name, graph->nodes[to].name);
+        return;
+    }
+
+    deps_edge_t * edge = lui_xml_arena_alloc(&graph->arena, sizeof(deps_edge_t));
+    if(edge == NULL) return;
+    edge->to = to;
+    edge->next = NULL;
+
+    /*Keep the order of the references to visit them in document order*/
+    deps_node_t * node = &graph->nodes[from];
+    if(node->edge_tail) node->edge_tail->next = edge;
+    else node->edge_head = edge;
+    node->edge_tail = edge;
+}
+
+/**
+ * Add the components referenced in a list of style names, e.g. "style1 my_button.style2"
+ * @param ctx       the collecting context
+ * @param value     the list of style names
+ */
+static void add_style_edges(deps_collect_t * ctx, const char * value)
+{
+    while(*value) {
+        while(*value == ' ') value++;
+        const char * word = value;
+        while(*value && *value != ' ') value++;
+
+        /*The component's name is before the last dot*/
+        const char * dot = NULL;
+        const char * c;
+        for(c = word; c < value; c++) {
+            if(*c == '.') dot = c;
+        }
+
+        /*Its own styles can be referenced with the component's name too*/
+        if(dot) {
+            uint32_t to = find_node(ctx->graph, word, dot - word);
+            if(to != NO_NODE && to != ctx->node) add_edge(ctx->graph, ctx->node, to);
+        }
+    }
+}
+
+static void collect_start_handler(void * user_data, const char * name, const char ** attrs)
+{
+    deps_collect_t * ctx = user_data;
+    ctx->depth++;
+
+    if(ctx->view_depth == 0) {
+        if(!lv_streq(name, "view")) return;
+        ctx->view_depth = ctx->depth;
+
+        const char * extends = lui_xml_get_value_of(attrs, "extends");
+        if(extends) {
+            uint32_t to = find_node(ctx->graph, extends, lv_strlen(extends));
+            if(to != NO_NODE) add_edge(ctx->graph, ctx->node, to);
+        }
+    }
+    else {
+        /*A widget or a component*/
+        uint32_t to = find_node(ctx->graph, name, lv_strlen(name));
+        if(to != NO_NODE) add_edge(ctx->graph, ctx->node, to);
+    }
+
+    bool is_style = lv_streq(name, "style") || lv_streq(name, "lv_obj-style");
+    uint32_t i;
+    for(i = 0; attrs[i]; i += 2) {
+        const char * attr_name = attrs[i];
+        size_t len = lv_strlen(attr_name);
+        if(lv_streq(attr_name, "styles") || (len >= 6 && lv_streq(&attr_name[len - 6], "_style")) ||
+           (is_style && lv_streq(attr_name, "name"))) {
+            add_style_edges(ctx, attrs[i + 1]);
+        }
+    }
+}
+
+static void collect_end_handler(void * user_data, const char * name)
+{
+    LV_UNUSED(name);
+
+    deps_collect_t * ctx = user_data;
+    if(ctx->view_depth == ctx->depth) ctx->view_depth = 0;
+    ctx->depth--;
+}
+
+/**
+ * Add a node to the order after its dependencies (depth first search)
+ * @param graph     the graph
+ * @param node      index of the node
+ */
+static void visit(deps_graph_t * graph, uint32_t node)
+{
+    deps_node_t * n = &graph->nodes[node];
+    n->state = NODE_VISITING;
+    graph->path[graph->path_len++] = node;
+
+    deps_edge_t * edge;
+    for(edge = n->edge_head; edge; edge = edge->next) {
+        node_state_t state = graph->nodes[edge->to].state;
+        if(state == NODE_NEW) {
+            visit(graph, edge->to);
+        }
+        else if(state == NODE_VISITING) {
+            graph->cycle_cnt++;
+            report_cycle(graph, edge->to);
+        }
+    }
+
+    graph->path_len--;
+    n->state = NODE_DONE;
+    graph->order[graph->order_cnt++] = node;
+}
+
+/**
+ * Log a dependency cycle, e.g. "a -> b -> a"
+ * @param graph     the graph
+ * @param node      the node on the path which is referenced again
+ */
+static void report_cycle(const deps_graph_t * graph, uint32_t node)
+{
+    char buf[CYCLE_BUF_SIZE];
+    buf[0] = '\0';
+
+    uint32_t start = graph->path_len;
+    while(start > 0 && graph->path[start - 1] != node) start--;
+    if(start > 0) start--;
+
+    size_t len = 0;
+    uint32_t i;
+    for(i = start; i < graph->path_len && len < sizeof(buf); i++) {
+        len += lv_snprintf(&buf[len], sizeof(buf) - len, "%s -> ", graph->nodes[graph->path[i]].name);
+    }
+    if(len < sizeof(buf)) lv_snprintf(&buf[len], sizeof(buf) - len, "%s", graph->nodes[node].name);
+
+    LV_LOG_WARN("Dependency cycle: %s", buf);
+}
+
+/** FNV-1a*/
+static uint32_t name_hash(const char * name, size_t len)
+{
+    uint32_t hash = 2166136261u;
+    size_t i;
+    for(i = 0; i < len; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#endif /* LV_USE_XML */
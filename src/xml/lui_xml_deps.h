@@ -0,0 +1,58 @@
+/**
+ * @file lui_xml_deps.h
+ *
+ */
+
+#ifndef LUI_XML_DEPS_H
+#define LUI_XML_DEPS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+#include "lui_xml_doc.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Find the order in which tokenized files need to be registered so that every component
+ * comes after the components it depends on. A component depends on the components
+ * it extends, uses in its view, or whose styles it references as `component.style`.
+ * Otherwise the original order is kept, also between the files defining the same component.
+ * The dependency cycles are logged.
+ * @param names     name of the component of each file or NULL if it's not a component
+ * @param docs      the tokenized files
+ * @param cnt       number of files
+ * @param order     store the indices of the files in registration order here (`cnt` elements)
+ * @return          number of dependency cycles found
+ */
+uint32_t lui_xml_deps_sort(const char * const * names, const lui_xml_doc_t * const * docs, uint32_t cnt,
+                           uint32_t * order);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_DEPS_H*/
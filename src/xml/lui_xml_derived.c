@@ -0,0 +1,946 @@
+/**
+ * @file lui_xml_derived.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_derived_private.h"
+#if LV_USE_XML && LUI_XML_USE_DERIVED_SUBJECTS
+
+#include "../lvgl.h"
+#include "lui_xml_private.h"
+#include "lui_xml_subject_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Limits of an expression. Constants and inputs are bounded by the code length.*/
+#define MAX_CODE_LEN    64
+#define STACK_SIZE      16
+#define MAX_NAME_LEN    64
+#define MAX_NESTING     32      /**< Parentheses, operands of `?:` and functions, and unary operators*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    OP_CONST,
+    OP_INPUT,
+    OP_NEG,
+    OP_NOT,
+    OP_MUL,
+    OP_DIV,
+    OP_MOD,
+    OP_ADD,
+    OP_SUB,
+    OP_LT,
+    OP_LE,
+    OP_GT,
+    OP_GE,
+    OP_EQ,
+    OP_NE,
+    OP_AND,
+    OP_OR,
+    OP_SELECT,
+    OP_MIN,
+    OP_MAX,
+    OP_ABS,
+} op_t;
+
+typedef struct {
+    uint8_t op;
+    uint8_t arg;                /**< Index of the constant or input*/
+} instr_t;
+
+typedef struct {
+    int32_t i;
+#if LV_USE_FLOAT
+    float f;
+#endif
+} const_t;
+
+/** A subject used in expressions. One observer queues all the derived subjects using it
+ *  before any of them is updated.*/
+typedef struct source_s {
+    struct source_s * next;
+    lv_subject_t * subject;
+    lv_observer_t * observer;
+    lui_xml_derived_t ** dependents;
+    uint32_t dependent_cnt;
+    uint32_t dependent_cap;
+} source_t;
+
+struct _lui_xml_derived_t {
+    lui_xml_derived_t * next;
+    lui_xml_derived_t * next_dirty;
+    lv_subject_t * subject;
+    lv_subject_t ** inputs;
+    source_t ** sources;        /**< The source of each input, NULL if it's not updated anymore*/
+    const_t * consts;
+    instr_t * code;
+    uint32_t level;             /**< 1 + the highest level of the inputs, 0 for plain subjects*/
+    uint8_t input_cnt;
+    uint8_t code_len;
+    uint8_t is_float : 1;       /**< Computed in float as a float is involved*/
+    uint8_t dirty : 1;
+};
+
+typedef struct {
+    const char * expr;
+    const char * p;
+    lui_xml_component_scope_t * scope;
+    lui_xml_subject_t * self;
+    instr_t code[MAX_CODE_LEN];
+    const_t consts[MAX_CODE_LEN];
+    lui_xml_subject_t * inputs[MAX_CODE_LEN];
+    uint32_t code_len;
+    uint32_t const_cnt;
+    uint32_t input_cnt;
+    int32_t depth;
+    uint32_t nesting;           /**< The recursion depth of the parser*/
+    bool is_float;
+    bool error;
+} compiler_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void parse_expr(compiler_t * c);
+static void parse_binary(compiler_t * c, uint32_t prec);
+static void parse_unary(compiler_t * c);
+static void parse_primary(compiler_t * c);
+static void parse_number(compiler_t * c);
+static void parse_name(compiler_t * c);
+static bool accept(compiler_t * c, const char * token);
+static bool accept_word(compiler_t * c, const char * word);
+static void expect(compiler_t * c, const char * token);
+static void emit(compiler_t * c, op_t op, uint32_t arg, int32_t stack_change);
+static bool nesting_enter(compiler_t * c);
+static void error(compiler_t * c, const char * msg);
+static lv_result_t source_add_dependent(lv_subject_t * subject, lui_xml_derived_t * derived, source_t ** source_out);
+static void source_remove_dependent(source_t * source, lui_xml_derived_t * derived);
+static void source_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
+static void mark_dirty(lui_xml_derived_t * derived);
+static void propagate(void);
+static void update(lui_xml_derived_t * derived);
+static int32_t eval_int(const lui_xml_derived_t * derived);
+#if LV_USE_FLOAT
+static float eval_float(const lui_xml_derived_t * derived);
+#endif
+static void detach(lui_xml_derived_t * derived);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lui_xml_derived_t * derived_head;    /**< All the derived subjects*/
+static source_t * sources;
+static lui_xml_derived_t * dirty_head;      /**< The derived subjects to update, sorted by level*/
+static uint32_t pause_cnt;
+static bool propagating;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lui_xml_derived_create(lui_xml_component_scope_t * scope, lui_xml_subject_t * entry, const char * expr)
+{
+    lv_subject_t * subject = entry->subject;
+    if(subject->type != LV_SUBJECT_TYPE_INT && subject->type != LV_SUBJECT_TYPE_FLOAT) {
+        LV_LOG_WARN("Only int and float subjects can have an expression (`%s`)", entry->name);
+        return LV_RESULT_INVALID;
+    }
+
+    compiler_t * c = lv_zalloc(sizeof(compiler_t));
+    LV_ASSERT_MALLOC(c);
+    if(c == NULL) return LV_RESULT_INVALID;
+
+    c->expr = expr;
+    c->p = expr;
+    c->scope = scope;
+    c->self = entry;
+    c->is_float = subject->type == LV_SUBJECT_TYPE_FLOAT;
+
+    parse_expr(c);
+    if(!c->error && *c->p != '\0') error(c, "unexpected character");
+
+    if(c->error) {
+        LV_LOG_WARN("The expression of `%s` is invalid", entry->name);
+        lv_free(c);
+        return LV_RESULT_INVALID;
+    }
+
+    /*Allocate everything in one block, the pointers first to keep them aligned*/
+    size_t size = sizeof(lui_xml_derived_t) + c->input_cnt * (sizeof(lv_subject_t *) + sizeof(source_t *)) +
+                  c->const_cnt * sizeof(const_t) + c->code_len * sizeof(instr_t);
+    lui_xml_derived_t * derived = lv_zalloc(size);
+    LV_ASSERT_MALLOC(derived);
+    if(derived == NULL) {
+        lv_free(c);
+        return LV_RESULT_INVALID;
+    }
+
+    derived->inputs = (lv_subject_t **)(derived + 1);
+    derived->sources = (source_t **)(derived->inputs + c->input_cnt);
+    derived->consts = (const_t *)(derived->sources + c->input_cnt);
+    derived->code = (instr_t *)(derived->consts + c->const_cnt);
+    derived->subject = subject;
+    derived->input_cnt = c->input_cnt;
+    derived->code_len = c->code_len;
+    derived->is_float = c->is_float;
+
+    uint32_t i;
+    for(i = 0; i < c->input_cnt; i++) {
+        derived->inputs[i] = c->inputs[i]->subject;
+        uint32_t level = c->inputs[i]->derived ? c->inputs[i]->derived->level : 0;
+        if(level + 1 > derived->level) derived->level = level + 1;
+    }
+    lv_memcpy(derived->consts, c->consts, c->const_cnt * sizeof(const_t));
+    lv_memcpy(derived->code, c->code, c->code_len * sizeof(instr_t));
+    lv_free(c);
+
+    for(i = 0; i < derived->input_cnt; i++) {
+        if(source_add_dependent(derived->inputs[i], derived, &derived->sources[i]) != LV_RESULT_OK) {
+            detach(derived);
+            lv_free(derived);
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    derived->next = derived_head;
+    derived_head = derived;
+    entry->derived = derived;
+
+    mark_dirty(derived);
+    propagate();
+
+    return LV_RESULT_OK;
+}
+
+void lui_xml_derived_remove_subject(lui_xml_subject_t * entry)
+{
+    lui_xml_derived_t * derived = entry->derived;
+    if(derived) {
+        detach(derived);
+        lui_xml_derived_t ** prev = &derived_head;
+        while(*prev != derived) prev = &(*prev)->next;
+        *prev = derived->next;
+        lv_free(derived);
+        entry->derived = NULL;
+    }
+
+    /*The subjects computed from this one keep their last value.
+     *The source is freed when its last dependent is detached.*/
+    source_t * source = sources;
+    while(source && source->subject != entry->subject) source = source->next;
+    if(source == NULL) return;
+
+    while(source->dependent_cnt > 1) detach(source->dependents[source->dependent_cnt - 1]);
+    detach(source->dependents[0]);
+}
+
+void lui_xml_derived_pause(void)
+{
+    pause_cnt++;
+}
+
+void lui_xml_derived_resume(void)
+{
+    if(pause_cnt == 0) return;
+    pause_cnt--;
+    propagate();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Precedence climbing, from the lowest precedence:
+ *  a ? b : c
+ *  ||  &&  == !=  < <= > >=  + -  * / %
+ *  unary - !
+ *  numbers, subjects, min(a, b), max(a, b), abs(a), (a)*/
+
+static void parse_expr(compiler_t * c)
+{
+    if(!nesting_enter(c)) return;
+
+    parse_binary(c, 0);
+
+    if(accept(c, "?")) {
+        parse_expr(c);
+        expect(c, ":");
+        parse_expr(c);
+        emit(c, OP_SELECT, 0, -2);
+    }
+
+    c->nesting--;
+}
+
+static void parse_binary(compiler_t * c, uint32_t prec)
+{
+    if(prec == 6) {
+        parse_unary(c);
+        return;
+    }
+
+    parse_binary(c, prec + 1);
+
+    while(!c->error) {
+        op_t op;
+        switch(prec) {
+            case 0:
+                if(accept(c, "||") || accept_word(c, "or")) op = OP_OR;
+                else return;
+                break;
+            case 1:
+                if(accept(c, "&&") || accept_word(c, "and")) op = OP_AND;
+                else return;
+                break;
+            case 2:
+                if(accept(c, "==")) op = OP_EQ;
+                else if(accept(c, "!=")) op = OP_NE;
+                else return;
+                break;
+            case 3:
+                if(accept(c, "<=")) op = OP_LE;
+                else if(accept(c, ">=")) op = OP_GE;
+                else if(accept(c, "<")) op = OP_LT;
+                else if(accept(c, ">")) op = OP_GT;
+                else return;
+                break;
+            case 4:
+                if(accept(c, "+")) op = OP_ADD;
+                else if(accept(c, "-")) op = OP_SUB;
+                else return;
+                break;
+            default:
+                if(accept(c, "*")) op = OP_MUL;
+                else if(accept(c, "/")) op = OP_DIV;
+                else if(accept(c, "%")) op = OP_MOD;
+                else return;
+                break;
+        }
+
+        parse_binary(c, prec + 1);
+        emit(c, op, 0, -1);
+    }
+}
+
+static void parse_unary(compiler_t * c)
+{
+    if(!nesting_enter(c)) return;
+
+    if(accept(c, "-")) {
+        parse_unary(c);
+        emit(c, OP_NEG, 0, 0);
+    }
+    else if(accept(c, "!") || accept_word(c, "not")) {
+        parse_unary(c);
+        emit(c, OP_NOT, 0, 0);
+    }
+    else {
+        parse_primary(c);
+    }
+
+    c->nesting--;
+}
+
+static void parse_primary(compiler_t * c)
+{
+    if(c->error) return;
+
+    if(accept(c, "(")) {
+        parse_expr(c);
+        expect(c, ")");
+    }
+    else if((*c->p >= '0' && *c->p <= '9') || *c->p == '.') {
+        parse_number(c);
+    }
+    else if((*c->p >= 'a' && *c->p <= 'z') || (*c->p >= 'A' && *c->p <= 'Z') || *c->p == '_') {
+        parse_name(c);
+    }
+    else {
+        error(c, *c->p == '\0' ? "unexpected end" : "unexpected character");
+    }
+}
+
+static void parse_number(compiler_t * c)
+{
+    int64_t int_part = 0;
+    while(*c->p >= '0' && *c->p <= '9') {
+        int_part = int_part * 10 + (*c->p - '0');
+        if(int_part > INT32_MAX) {
+            error(c, "too large number");
+            return;
+        }
+        c->p++;
+    }
+
+    const_t value;
+    value.i = (int32_t)int_part;
+#if LV_USE_FLOAT
+    value.f = (float)int_part;
+    if(*c->p == '.') {
+        c->p++;
+        float scale = 0.1f;
+        while(*c->p >= '0' && *c->p <= '9') {
+            value.f += (*c->p - '0') * scale;
+            scale *= 0.1f;
+            c->p++;
+        }
+        c->is_float = true;
+    }
+#else
+    if(*c->p == '.') {
+        error(c, "floats are not supported as LV_USE_FLOAT is disabled");
+        return;
+    }
+#endif
+
+    emit(c, OP_CONST, c->const_cnt, 1);
+    if(!c->error) c->consts[c->const_cnt++] = value;
+}
+
+static void parse_name(compiler_t * c)
+{
+    char name[MAX_NAME_LEN];
+    uint32_t len = 0;
+    while((*c->p >= 'a' && *c->p <= 'z') || (*c->p >= 'A' && *c->p <= 'Z') ||
+          (*c->p >= '0' && *c->p <= '9') || *c->p == '_') {
+        if(len == MAX_NAME_LEN - 1) {
+            error(c, "too long name");
+            return;
+        }
+        name[len++] = *c->p;
+        c->p++;
+    }
+    name[len] = '\0';
+
+    op_t func = OP_CONST;
+    if(lv_streq(name, "min")) func = OP_MIN;
+    else if(lv_streq(name, "max")) func = OP_MAX;
+    else if(lv_streq(name, "abs")) func = OP_ABS;
+
+    if(func != OP_CONST && accept(c, "(")) {
+        parse_expr(c);
+        if(func != OP_ABS) {
+            expect(c, ",");
+            parse_expr(c);
+        }
+        expect(c, ")");
+        emit(c, func, 0, func == OP_ABS ? 0 : -1);
+        return;
+    }
+
+    if(lv_streq(name, "true") || lv_streq(name, "false")) {
+        const_t value;
+        value.i = lv_streq(name, "true") ? 1 : 0;
+#if LV_USE_FLOAT
+        value.f = (float)value.i;
+#endif
+        emit(c, OP_CONST, c->const_cnt, 1);
+        if(!c->error) c->consts[c->const_cnt++] = value;
+        return;
+    }
+
+    lui_xml_subject_t * input = lui_xml_find_subject_entry(c->scope, name);
+    if(input == NULL) {
+        error(c, "unknown subject");
+        return;
+    }
+    if(input == c->self) {
+        error(c, "a subject can't be computed from itself");
+        return;
+    }
+
+    if(input->subject->type == LV_SUBJECT_TYPE_FLOAT) c->is_float = true;
+    else if(input->subject->type != LV_SUBJECT_TYPE_INT) {
+        error(c, "only int and float subjects can be used");
+        return;
+    }
+
+    /*Observe each subject once, even if it's used more times*/
+    uint32_t i;
+    for(i = 0; i < c->input_cnt; i++) {
+        if(c->inputs[i] == input) break;
+    }
+    emit(c, OP_INPUT, i, 1);
+    if(!c->error && i == c->input_cnt) c->inputs[c->input_cnt++] = input;
+}
+
+static bool accept(compiler_t * c, const char * token)
+{
+    while(*c->p == ' ' || *c->p == '\t' || *c->p == '\n' || *c->p == '\r') c->p++;
+
+    size_t len = lv_strlen(token);
+    if(lv_strncmp(c->p, token, len) != 0) return false;
+
+    /*Don't take `<` from `<=` or `!` from `!=`*/
+    if(len == 1 && (token[0] == '<' || token[0] == '>' || token[0] == '!') && c->p[1] == '=') return false;
+
+    c->p += len;
+    return true;
+}
+
+static bool accept_word(compiler_t * c, const char * word)
+{
+    while(*c->p == ' ' || *c->p == '\t' || *c->p == '\n' || *c->p == '\r') c->p++;
+
+    size_t len = lv_strlen(word);
+    if(lv_strncmp(c->p, word, len) != 0) return false;
+
+    char next = c->p[len];
+    if((next >= 'a' && next <= 'z') || (next >= 'A' && next <= 'Z') || (next >= '0' && next <= '9') ||
+       next == '_') return false;
+
+    c->p += len;
+    return true;
+}
+
+static void expect(compiler_t * c, const char * token)
+{
+    if(c->error) return;
+    if(!accept(c, token)) error(c, "missing token");
+}
+
+static void emit(compiler_t * c, op_t op, uint32_t arg, int32_t stack_change)
+{
+    if(c->error) return;
+
+    if(c->code_len == MAX_CODE_LEN) {
+        error(c, "too long expression");
+        return;
+    }
+
+    c->depth += stack_change;
+    if(c->depth > STACK_SIZE) {
+        error(c, "too deeply nested expression");
+        return;
+    }
+
+    c->code[c->code_len].op = (uint8_t)op;
+    c->code[c->code_len].arg = (uint8_t)arg;
+    c->code_len++;
+}
+
+/**
+ * Go one level deeper in the recursive parser, so that a long chain of
+ * parentheses or unary operators can't overflow the C stack
+ * @param c     the compiler
+ * @return      true: go on; false: too deep, the error is reported
+ */
+static bool nesting_enter(compiler_t * c)
+{
+    if(c->error) return false;
+
+    if(c->nesting == MAX_NESTING) {
+        error(c, "too deeply nested expression");
+        return false;
+    }
+
+    c->nesting++;
+    return true;
+}
+
+static void error(compiler_t * c, const char * msg)
+{
+    if(c->error) return;
+    c->error = true;
+    LV_LOG_WARN("%s at column %d of `%s`", msg, (int)(c->p - c->expr) + 1, c->expr);
+}
+
+/**
+ * Add a derived subject to the ones computed from a subject
+ * @param subject       the input subject
+ * @param derived       the derived subject
+ * @param source_out    store the source of the subject here
+ * @return              LV_RESULT_OK: added; LV_RESULT_INVALID: out of memory
+ */
+static lv_result_t source_add_dependent(lv_subject_t * subject, lui_xml_derived_t * derived, source_t ** source_out)
+{
+    source_t * source = sources;
+    while(source && source->subject != subject) source = source->next;
+
+    if(source == NULL) {
+        source = lv_zalloc(sizeof(source_t));
+        LV_ASSERT_MALLOC(source);
+        if(source == NULL) return LV_RESULT_INVALID;
+
+        /*Adding the observer notifies it at once, but it has no dependents yet*/
+        source->subject = subject;
+        source->observer = lv_subject_add_observer(subject, source_observer_cb, source);
+        source->next = sources;
+        sources = source;
+    }
+
+    if(source->dependent_cnt == source->dependent_cap) {
+        uint32_t cap = source->dependent_cap ? source->dependent_cap * 2 : 4;
+        lui_xml_derived_t ** dependents = lv_realloc(source->dependents, cap * sizeof(lui_xml_derived_t *));
+        LV_ASSERT_MALLOC(dependents);
+        if(dependents == NULL) {
+            if(source->dependent_cnt == 0) source_remove_dependent(source, NULL);
+            return LV_RESULT_INVALID;
+        }
+        source->dependents = dependents;
+        source->dependent_cap = cap;
+    }
+
+    source->dependents[source->dependent_cnt++] = derived;
+    *source_out = source;
+    return LV_RESULT_OK;
+}
+
+/**
+ * Remove a derived subject from the ones computed from a subject, and free the source
+ * when it has no dependents left
+ * @param source    the source
+ * @param derived   the derived subject or NULL to only free the source if unused
+ */
+static void source_remove_dependent(source_t * source, lui_xml_derived_t * derived)
+{
+    uint32_t i;
+    for(i = 0; i < source->dependent_cnt; i++) {
+        if(source->dependents[i] == derived) {
+            source->dependents[i] = source->dependents[source->dependent_cnt - 1];
+            source->dependent_cnt--;
+            break;
+        }
+    }
+
+    if(source->dependent_cnt) return;
+
+    source_t ** prev = &sources;
+    while(*prev != source) prev = &(*prev)->next;
+    *prev = source->next;
+    lv_observer_remove(source->observer);
+    lv_free(source->dependents);
+    lv_free(source);
+}
+
+static void source_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    LV_UNUSED(subject);
+
+    /*Queue all the dependents first, so that none of them is computed
+     *while another input of it is still going to change*/
+    source_t * source = lv_observer_get_user_data(observer);
+    uint32_t i;
+    for(i = 0; i < source->dependent_cnt; i++) mark_dirty(source->dependents[i]);
+
+    propagate();
+}
+
+/**
+ * Queue a derived subject to be updated after the lower levels,
+ * and after the subjects of its level which were queued earlier
+ * @param derived   the derived subject
+ */
+static void mark_dirty(lui_xml_derived_t * derived)
+{
+    if(derived->dirty) return;
+    derived->dirty = 1;
+
+    lui_xml_derived_t ** prev = &dirty_head;
+    while(*prev && (*prev)->level <= derived->level) prev = &(*prev)->next_dirty;
+    derived->next_dirty = *prev;
+    *prev = derived;
+}
+
+/**
+ * Update the queued derived subjects by levels. Setting a derived subject queues the
+ * ones computed from it on a higher level, so every subject is computed once from the
+ * final values of its inputs.
+ */
+static void propagate(void)
+{
+    if(pause_cnt || propagating) return;
+    propagating = true;
+
+    while(dirty_head) {
+        lui_xml_derived_t * derived = dirty_head;
+        dirty_head = derived->next_dirty;
+        derived->next_dirty = NULL;
+        derived->dirty = 0;
+        update(derived);
+    }
+
+    propagating = false;
+}
+
+/**
+ * Compute a derived subject and set it if its value changes
+ * @param derived   the derived subject
+ */
+static void update(lui_xml_derived_t * derived)
+{
+    lv_subject_t * subject = derived->subject;
+
+#if LV_USE_FLOAT
+    if(derived->is_float) {
+        float value = eval_float(derived);
+        if(subject->type == LV_SUBJECT_TYPE_FLOAT) {
+            if(lv_subject_get_float(subject) != value) lv_subject_set_float(subject, value);
+            return;
+        }
+
+        /*Truncate like a cast in C, but without overflowing*/
+        int32_t value_int;
+        if(value != value) value_int = 0;
+        else if(value >= 2147483648.0f) value_int = INT32_MAX;
+        else if(value <= -2147483648.0f) value_int = INT32_MIN;
+        else value_int = (int32_t)value;
+
+        if(lv_subject_get_int(subject) != value_int) lv_subject_set_int(subject, value_int);
+        return;
+    }
+#endif
+
+    int32_t value = eval_int(derived);
+    if(lv_subject_get_int(subject) != value) lv_subject_set_int(subject, value);
+}
+
+/**
+ * Run the bytecode in int32. The arithmetic wraps around instead of overflowing,
+ * and dividing by 0 gives 0.
+ * @param derived   the derived subject
+ * @return          the value of the expression
+ */
+static int32_t eval_int(const lui_xml_derived_t * derived)
+{
+    int32_t stack[STACK_SIZE];
+    uint32_t sp = 0;
+
+    uint32_t i;
+    for(i = 0; i < derived->code_len; i++) {
+        instr_t instr = derived->code[i];
+
+        if(instr.op == OP_CONST) {
+            stack[sp++] = derived->consts[instr.arg].i;
+            continue;
+        }
+        if(instr.op == OP_INPUT) {
+            stack[sp++] = lv_subject_get_int(derived->inputs[instr.arg]);
+            continue;
+        }
+
+        int32_t a;
+        int32_t b = stack[sp - 1];
+        switch(instr.op) {
+            case OP_NEG:
+                stack[sp - 1] = (int32_t)(0u - (uint32_t)b);
+                continue;
+            case OP_NOT:
+                stack[sp - 1] = !b;
+                continue;
+            case OP_ABS:
+                stack[sp - 1] = b < 0 ? (int32_t)(0u - (uint32_t)b) : b;
+                continue;
+            case OP_SELECT:
+                sp -= 2;
+                stack[sp - 1] = stack[sp - 1] ? stack[sp] : b;
+                continue;
+            default:
+                break;
+        }
+
+        sp--;
+        a = stack[sp - 1];
+        int32_t res;
+        switch(instr.op) {
+            case OP_MUL:
+                res = (int32_t)((uint32_t)a * (uint32_t)b);
+                break;
+            case OP_DIV:
+                res = (b == 0 || (a == INT32_MIN && b == -1)) ? 0 : a / b;
+                break;
+            case OP_MOD:
+                res = (b == 0 || b == -1) ? 0 : a % b;
+                break;
+            case OP_ADD:
+                res = (int32_t)((uint32_t)a + (uint32_t)b);
+                break;
+            case OP_SUB:
+                res = (int32_t)((uint32_t)a - (uint32_t)b);
+                break;
+            case OP_LT:
+                res = a < b;
+                break;
+            case OP_LE:
+                res = a <= b;
+                break;
+            case OP_GT:
+                res = a > b;
+                break;
+            case OP_GE:
+                res = a >= b;
+                break;
+            case OP_EQ:
+                res = a == b;
+                break;
+            case OP_NE:
+                res = a != b;
+                break;
+            case OP_AND:
+                res = a && b;
+                break;
+            case OP_OR:
+                res = a || b;
+                break;
+            case OP_MIN:
+                res = LV_MIN(a, b);
+                break;
+            case OP_MAX:
+                res = LV_MAX(a, b);
+                break;
+            default:
+                res = 0;
+                break;
+        }
+        stack[sp - 1] = res;
+    }
+
+    return sp ? stack[0] : 0;
+}
+
+#if LV_USE_FLOAT
+/**
+ * Run the bytecode in float. The int inputs are converted to float and dividing by 0 gives 0.
+ * @param derived   the derived subject
+ * @return          the value of the expression
+ */
+static float eval_float(const lui_xml_derived_t * derived)
+{
+    float stack[STACK_SIZE];
+    uint32_t sp = 0;
+
+    uint32_t i;
+    for(i = 0; i < derived->code_len; i++) {
+        instr_t instr = derived->code[i];
+
+        if(instr.op == OP_CONST) {
+            stack[sp++] = derived->consts[instr.arg].f;
+            continue;
+        }
+        if(instr.op == OP_INPUT) {
+            lv_subject_t * input = derived->inputs[instr.arg];
+            stack[sp++] = input->type == LV_SUBJECT_TYPE_FLOAT ? lv_subject_get_float(input) :
+                          (float)lv_subject_get_int(input);
+            continue;
+        }
+
+        float a;
+        float b = stack[sp - 1];
+        switch(instr.op) {
+            case OP_NEG:
+                stack[sp - 1] = -b;
+                continue;
+            case OP_NOT:
+                stack[sp - 1] = b == 0.0f ? 1.0f : 0.0f;
+                continue;
+            case OP_ABS:
+                stack[sp - 1] = b < 0.0f ? -b : b;
+                continue;
+            case OP_SELECT:
+                sp -= 2;
+                stack[sp - 1] = stack[sp - 1] != 0.0f ? stack[sp] : b;
+                continue;
+            default:
+                break;
+        }
+
+        sp--;
+        a = stack[sp - 1];
+        float res;
+        switch(instr.op) {
+            case OP_MUL:
+                res = a * b;
+                break;
+            case OP_DIV:
+                res = b == 0.0f ? 0.0f : a / b;
+                break;
+            case OP_MOD:
+                /*Truncated like fmodf()*/
+                if(b == 0.0f) res = 0.0f;
+                else {
+                    float q = a / b;
+                    if(q < 2147483648.0f && q > -2147483648.0f) q = (float)(int32_t)q;
+                    res = a - q * b;
+                }
+                break;
+            case OP_ADD:
+                res = a + b;
+                break;
+            case OP_SUB:
+                res = a - b;
+                break;
+            case OP_LT:
+                res = a < b;
+                break;
+            case OP_LE:
+                res = a <= b;
+                break;
+            case OP_GT:
+                res = a > b;
+                break;
+            case OP_GE:
+                res = a >= b;
+                break;
+            case OP_EQ:
+                res = a == b;
+                break;
+            case OP_NE:
+                res = a != b;
+                break;
+            case OP_AND:
+                res = a != 0.0f && b != 0.0f;
+                break;
+            case OP_OR:
+                res = a != 0.0f || b != 0.0f;
+                break;
+            case OP_MIN:
+                res = LV_MIN(a, b);
+                break;
+            case OP_MAX:
+                res = LV_MAX(a, b);
+                break;
+            default:
+                res = 0.0f;
+                break;
+        }
+        stack[sp - 1] = res;
+    }
+
+    return sp ? stack[0] : 0.0f;
+}
+#endif
+
+/**
+ * Stop updating a derived subject: remove it from its sources and take it out of the queue
+ * @param derived   the derived subject
+ */
+static void detach(lui_xml_derived_t * derived)
+{
+    uint32_t i;
+    for(i = 0; i < derived->input_cnt; i++) {
+        if(derived->sources[i]) source_remove_dependent(derived->sources[i], derived);
+        derived->sources[i] = NULL;
+    }
+
+    if(derived->dirty) {
+        lui_xml_derived_t ** prev = &dirty_head;
+        while(*prev != derived) prev = &(*prev)->next_dirty;
+        *prev = derived->next_dirty;
+        derived->next_dirty = NULL;
+        derived->dirty = 0;
+    }
+}
+
+#endif /* LV_USE_XML && LUI_XML_USE_DERIVED_SUBJECTS */
@@ -0,0 +1,77 @@
+/**
+ * @file lui_xml_derived_private.h
+ *
+ */
+
+#ifndef LUI_XML_DERIVED_PRIVATE_H
+#define LUI_XML_DERIVED_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_subject.h"
+#if LV_USE_XML && LUI_XML_USE_DERIVED_SUBJECTS
+
+#include "lui_xml_component_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lui_xml_derived_t lui_xml_derived_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Compile an expression and compute a registered subject from it whenever one of the
+ * subjects it refers to changes. The referred subjects are looked up when compiling,
+ * so they need to be registered before. On error the subject keeps its value.
+ * @param scope     the scope to look up the referred subjects in, see `lui_xml_get_subject()`
+ * @param entry     the registry entry of an int or float subject
+ * @param expr      the expression, e.g. "temp_c * 9 / 5 + 32"
+ * @return          LV_RESULT_OK: the subject is computed from now on; LV_RESULT_INVALID: syntax error,
+ *                  unknown subject or out of memory
+ */
+lv_result_t lui_xml_derived_create(lui_xml_component_scope_t * scope, lui_xml_subject_t * entry, const char * expr);
+
+/**
+ * Delete the expression of a subject and stop updating the derived subjects depending on it.
+ * Should be called before the subject is freed.
+ * @param entry     the registry entry of the subject
+ */
+void lui_xml_derived_remove_subject(lui_xml_subject_t * entry);
+
+/**
+ * Collect the changes of the inputs without updating the derived subjects,
+ * until the same number of `lui_xml_derived_resume()` calls
+ */
+void lui_xml_derived_pause(void);
+
+/**
+ * Update the derived subjects whose inputs changed since `lui_xml_derived_pause()`.
+ * Each is computed once, after all of its inputs.
+ */
+void lui_xml_derived_resume(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML && LUI_XML_USE_DERIVED_SUBJECTS */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_DERIVED_PRIVATE_H*/
@@ -0,0 +1,316 @@
+/**
+ * @file lui_xml_doc.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_doc.h"
+#include "lui_xml_profile_private.h"
+#if LV_USE_XML
+
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/lv_log.h"
+#include "../misc/lv_assert.h"
+#include "lui_xml_stream.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Most files are a few kB so start with larger chunks than the component scopes*/
+#define DOC_ARENA_CHUNK_SIZE    4096
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lui_xml_doc_token_t {
+    struct _lui_xml_doc_token_t * next;
+    const char * name;
+    const char ** attrs;    /**< NULL terminated name-value pairs, NULL for end elements*/
+};
+
+typedef struct {
+    lui_xml_doc_t * doc;
+    XML_Parser parser;
+    const char * buf;       /**< The whole XML or NULL when tokenizing a file chunk by chunk*/
+    int32_t depth;
+    int32_t view_depth;     /**< Depth of `<view>`, -1 if not found yet*/
+    XML_Index view_start;
+    XML_Index view_end;     /**< Absolute byte index after the view, -1 until known*/
+    int view_start_tag_len;
+
+    /*Only used when tokenizing chunk by chunk*/
+    char * view_buf;        /**< Collects the raw bytes from `<view` (heap)*/
+    size_t view_buf_len;
+    size_t view_buf_cap;
+    XML_Index captured_end; /**< Absolute byte index until which the bytes are collected*/
+    bool capture_error;
+} tokenize_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void start_handler(void * user_data, const char * name, const char ** attrs);
+static void end_handler(void * user_data, const char * name);
+static lui_xml_doc_token_t * token_add(tokenize_ctx_t * ctx, const char * name);
+static XML_Parser tokenize_parser_create(tokenize_ctx_t * ctx, lui_xml_doc_t * doc, const char * buf);
+static void chunk_cb(const char * buf, uint32_t len, uint32_t offset, void * user_data);
+static void view_append(tokenize_ctx_t * ctx, const char * buf, size_t len);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lui_xml_doc_init(lui_xml_doc_t * doc)
+{
+    lv_memzero(doc, sizeof(lui_xml_doc_t));
+    lui_xml_arena_init(&doc->arena, DOC_ARENA_CHUNK_SIZE);
+}
+
+lv_result_t lui_xml_doc_tokenize(lui_xml_doc_t * doc, const char * buf, size_t len, bool is_static)
+{
+    tokenize_ctx_t ctx;
+    XML_Parser parser = tokenize_parser_create(&ctx, doc, buf);
+    if(parser == NULL) return LV_RESULT_INVALID;
+
+    LUI_XML_PROFILE_BEGIN(PARSE);
+    if(XML_Parse(parser, buf, (int)len, XML_TRUE) == XML_STATUS_ERROR) {
+        doc->error_msg = XML_ErrorString(XML_GetErrorCode(parser));
+        doc->error_line = (uint32_t)XML_GetCurrentLineNumber(parser);
+        doc->error = 1;
+    }
+    XML_ParserFree(parser);
+    LUI_XML_PROFILE_END();
+
+    if(doc->error) return LV_RESULT_INVALID;
+
+    /*The view was only referenced in `buf` so far*/
+    if(doc->view && !is_static) {
+        doc->view = lui_xml_arena_strndup(&doc->arena, doc->view, doc->view_len);
+        if(doc->view == NULL) {
+            doc->error = 1;
+            return LV_RESULT_INVALID;
+        }
+    }
+    doc->view_static = doc->view && is_static;
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lui_xml_doc_tokenize_file(lui_xml_doc_t * doc, const char * path)
+{
+    tokenize_ctx_t ctx;
+    XML_Parser parser = tokenize_parser_create(&ctx, doc, NULL);
+    if(parser == NULL) return LV_RESULT_INVALID;
+
+    lv_result_t res = lui_xml_parse_file_stream(parser, path, chunk_cb, &ctx);
+    XML_ParserFree(parser);
+
+    if(res == LV_RESULT_OK && ctx.capture_error) {
+        LV_LOG_WARN("Couldn't collect the view of %s", path);
+        res = LV_RESULT_INVALID;
+    }
+
+    /*Keep only the view itself, the bytes after it might have been collected too*/
+    if(res == LV_RESULT_OK && ctx.view_end >= 0) {
+        doc->view_len = (size_t)(ctx.view_end - ctx.view_start);
+        doc->view = lui_xml_arena_strndup(&doc->arena, ctx.view_buf, doc->view_len);
+        if(doc->view == NULL) res = LV_RESULT_INVALID;
+    }
+
+    lv_free(ctx.view_buf);
+
+    if(res != LV_RESULT_OK) doc->error = 1;
+    return doc->error ? LV_RESULT_INVALID : LV_RESULT_OK;
+}
+
+void lui_xml_doc_replay(const lui_xml_doc_t * doc, XML_StartElementHandler start_cb, XML_EndElementHandler end_cb,
+                        void * user_data)
+{
+    const lui_xml_doc_token_t * token;
+    for(token = doc->head; token; token = token->next) {
+        if(token->attrs) start_cb(user_data, token->name, token->attrs);
+        else end_cb(user_data, token->name);
+    }
+}
+
+void lui_xml_doc_destroy(lui_xml_doc_t * doc)
+{
+    lui_xml_arena_destroy(&doc->arena);
+    lui_xml_arena_t arena = doc->arena;
+    lv_memzero(doc, sizeof(lui_xml_doc_t));
+    doc->arena = arena;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void start_handler(void * user_data, const char * name, const char ** attrs)
+{
+    tokenize_ctx_t * ctx = user_data;
+    lui_xml_doc_t * doc = ctx->doc;
+    ctx->depth++;
+
+    if(ctx->view_depth < 0 && lv_streq(name, "view")) {
+        ctx->view_depth = ctx->depth;
+        ctx->view_start = XML_GetCurrentByteIndex(ctx->parser);
+        ctx->view_start_tag_len = XML_GetCurrentByteCount(ctx->parser);
+
+        if(ctx->buf == NULL) {
+            /*The start tag might have arrived in an earlier chunk,
+             *so copy it and everything after it from expat's buffer*/
+            ctx->captured_end = ctx->view_start;
+            int offset = 0;
+            int size = 0;
+            const char * buf = XML_GetInputContext(ctx->parser, &offset, &size);
+            if(buf == NULL) ctx->capture_error = true;
+            else view_append(ctx, buf + offset, size - offset);
+        }
+    }
+
+    lui_xml_doc_token_t * token = token_add(ctx, name);
+    if(token == NULL) return;
+    if(doc->root == NULL) doc->root = token->name;
+
+    uint32_t attr_cnt = 0;
+    while(attrs[attr_cnt]) attr_cnt++;
+
+    token->attrs = lui_xml_arena_alloc(&doc->arena, (attr_cnt + 1) * sizeof(const char *));
+    if(token->attrs == NULL) {
+        doc->error = 1;
+        XML_StopParser(ctx->parser, XML_FALSE);
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < attr_cnt; i++) {
+        token->attrs[i] = lui_xml_arena_strdup(&doc->arena, attrs[i]);
+        if(token->attrs[i] == NULL) {
+            doc->error = 1;
+            XML_StopParser(ctx->parser, XML_FALSE);
+            return;
+        }
+    }
+    token->attrs[attr_cnt] = NULL;
+}
+
+static void end_handler(void * user_data, const char * name)
+{
+    tokenize_ctx_t * ctx = user_data;
+    lui_xml_doc_t * doc = ctx->doc;
+
+    if(ctx->depth == ctx->view_depth && ctx->view_end < 0) {
+        int count = XML_GetCurrentByteCount(ctx->parser);
+        /*The count is 0 for empty elements like <view/>*/
+        if(count == 0) ctx->view_end = ctx->view_start + ctx->view_start_tag_len;
+        else ctx->view_end = XML_GetCurrentByteIndex(ctx->parser) + count;
+
+        /*When tokenizing chunk by chunk the view is still being collected*/
+        if(ctx->buf) {
+            doc->view = ctx->buf + ctx->view_start;
+            doc->view_len = (size_t)(ctx->view_end - ctx->view_start);
+        }
+    }
+    ctx->depth--;
+
+    token_add(ctx, name);
+}
+
+static lui_xml_doc_token_t * token_add(tokenize_ctx_t * ctx, const char * name)
+{
+    lui_xml_doc_t * doc = ctx->doc;
+    lui_xml_doc_token_t * token = lui_xml_arena_zalloc(&doc->arena, sizeof(lui_xml_doc_token_t));
+    if(token) token->name = lui_xml_arena_strdup(&doc->arena, name);
+
+    if(token == NULL || token->name == NULL) {
+        doc->error = 1;
+        XML_StopParser(ctx->parser, XML_FALSE);
+        return NULL;
+    }
+
+    if(doc->tail) doc->tail->next = token;
+    else doc->head = token;
+    doc->tail = token;
+    doc->token_cnt++;
+
+    return token;
+}
+
+static XML_Parser tokenize_parser_create(tokenize_ctx_t * ctx, lui_xml_doc_t * doc, const char * buf)
+{
+    lv_memzero(ctx, sizeof(tokenize_ctx_t));
+    ctx->doc = doc;
+    ctx->buf = buf;
+    ctx->view_depth = -1;
+    ctx->view_end = -1;
+
+    XML_Memory_Handling_Suite mem_handlers;
+    mem_handlers.malloc_fcn = lv_malloc;
+    mem_handlers.realloc_fcn = lv_realloc;
+    mem_handlers.free_fcn = lv_free;
+    XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+    if(parser == NULL) {
+        doc->error = 1;
+        return NULL;
+    }
+
+    ctx->parser = parser;
+    XML_SetUserData(parser, ctx);
+    XML_SetElementHandler(parser, start_handler, end_handler);
+
+    return parser;
+}
+
+static void chunk_cb(const char * buf, uint32_t len, uint32_t offset, void * user_data)
+{
+    tokenize_ctx_t * ctx = user_data;
+
+    /*Not in the view yet or already collected it*/
+    if(ctx->view_depth < 0 || ctx->capture_error) return;
+    if(ctx->view_end >= 0 && ctx->captured_end >= ctx->view_end) return;
+
+    XML_Index chunk_end = (XML_Index)offset + len;
+    if(ctx->captured_end >= chunk_end) return;
+    if(ctx->captured_end < (XML_Index)offset) {
+        ctx->capture_error = true;
+        return;
+    }
+
+    uint32_t skip = (uint32_t)(ctx->captured_end - offset);
+    view_append(ctx, buf + skip, len - skip);
+}
+
+static void view_append(tokenize_ctx_t * ctx, const char * buf, size_t len)
+{
+    if(len == 0) return;
+
+    if(ctx->view_buf_len + len > ctx->view_buf_cap) {
+        size_t new_cap = LV_MAX(ctx->view_buf_cap * 2, ctx->view_buf_len + len);
+        char * new_buf = lv_realloc(ctx->view_buf, new_cap);
+        LV_ASSERT_MALLOC(new_buf);
+        if(new_buf == NULL) {
+            ctx->capture_error = true;
+            return;
+        }
+        ctx->view_buf = new_buf;
+        ctx->view_buf_cap = new_cap;
+    }
+
+    lv_memcpy(ctx->view_buf + ctx->view_buf_len, buf, len);
+    ctx->view_buf_len += len;
+    ctx->captured_end += len;
+}
+
+#endif /* LV_USE_XML */
@@ -0,0 +1,107 @@
+/**
+ * @file lui_xml_doc.h
+ *
+ */
+
+#ifndef LUI_XML_DOC_H
+#define LUI_XML_DOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+#include "lui_xml_arena.h"
+#include "../libs/expat/expat.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lui_xml_doc_token_t lui_xml_doc_token_t;
+
+/**
+ * A tokenized XML document: the start and end elements in document order.
+ * Tokenizing a buffer doesn't touch any global state, not even the log, so it can be done
+ * on any thread, and the tokens can be replayed into the expat handlers later.
+ */
+typedef struct {
+    lui_xml_arena_t arena;          /**< The tokens, names and attributes are allocated here*/
+    lui_xml_doc_token_t * head;
+    lui_xml_doc_token_t * tail;
+    uint32_t token_cnt;
+    const char * root;              /**< Name of the root element or NULL*/
+    const char * view;              /**< The raw `<view>` element, not NULL terminated*/
+    size_t view_len;
+    const char * error_msg;         /**< Description of the syntax error or NULL*/
+    uint32_t error_line;            /**< Line of the syntax error*/
+    uint32_t view_static : 1;       /**< `view` points into the source buffer*/
+    uint32_t error : 1;             /**< Tokenizing failed*/
+} lui_xml_doc_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a document. No memory is allocated until tokenizing.
+ * @param doc       pointer to a document
+ */
+void lui_xml_doc_init(lui_xml_doc_t * doc);
+
+/**
+ * Tokenize an XML buffer. The raw `<view>` element is kept too.
+ * A syntax error is not logged but stored in `error_msg` and `error_line`.
+ * @param doc           pointer to an initialized document
+ * @param buf           the XML data, not necessarily NULL terminated
+ * @param len           length of `buf`
+ * @param is_static     true: `buf` outlives the document so the view can be referenced in it
+ * @return              LV_RESULT_OK: tokenized successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_doc_tokenize(lui_xml_doc_t * doc, const char * buf, size_t len, bool is_static);
+
+/**
+ * Tokenize an XML file chunk by chunk, so only the tokens and the raw `<view>`
+ * are kept in RAM, not the whole file.
+ * @param doc           pointer to an initialized document
+ * @param path          path to the XML file
+ * @return              LV_RESULT_OK: tokenized successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_doc_tokenize_file(lui_xml_doc_t * doc, const char * path);
+
+/**
+ * Call the handlers for the tokens as expat would while parsing the original XML
+ * @param doc           pointer to a tokenized document
+ * @param start_cb      called for the start elements
+ * @param end_cb        called for the end elements
+ * @param user_data     passed to the handlers as `user_data`
+ */
+void lui_xml_doc_replay(const lui_xml_doc_t * doc, XML_StartElementHandler start_cb, XML_EndElementHandler end_cb,
+                        void * user_data);
+
+/**
+ * Free all the memory of a document. It can be reused after this.
+ * @param doc       pointer to a document
+ */
+void lui_xml_doc_destroy(lui_xml_doc_t * doc);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_DOC_H*/
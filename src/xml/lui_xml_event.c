@@ -0,0 +1,199 @@
+/**
+ * @file lui_xml_event.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_event_private.h"
+#if LV_USE_XML && LUI_XML_USE_EVENT_CB_CACHE
+
+#include "../lvgl.h"
+#include "lui_xml.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    char * name;            /**< NULL if the slot is free*/
+    uint32_t hash;
+    uint32_t gen;           /**< `cb` is valid only if it's the current generation*/
+    lv_event_cb_t cb;
+} name_slot_t;
+
+typedef struct {
+    name_slot_t * slots;    /**< Open addressing, at most half of them is used*/
+    uint32_t cnt;
+    uint32_t cap;           /**< 0 or a power of 2*/
+} name_table_t;
+
+struct _lui_xml_event_cache_t {
+    name_table_t table;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static name_slot_t * table_get(name_table_t * table, const char * name, bool add);
+static lv_result_t table_grow(name_table_t * table);
+static void table_clear(name_table_t * table);
+static uint32_t name_hash(const char * name);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t event_cb_gen = 1;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lui_xml_event_cache_t * lui_xml_event_cache_create(void)
+{
+    lui_xml_event_cache_t * cache = lv_zalloc(sizeof(lui_xml_event_cache_t));
+    LV_ASSERT_MALLOC(cache);
+    return cache;
+}
+
+void lui_xml_event_cache_delete(lui_xml_event_cache_t * cache)
+{
+    if(cache == NULL) return;
+
+    table_clear(&cache->table);
+    lv_free(cache);
+}
+
+lv_event_cb_t lui_xml_event_cache_get_cb(lui_xml_component_scope_t * scope, const char * name)
+{
+    /*Only registered components have a cache, the scopes being parsed don't*/
+    if(scope == NULL || scope->event_cache == NULL) return lui_xml_get_event_cb(scope, name);
+
+    name_table_t * table = &scope->event_cache->table;
+    name_slot_t * slot = table_get(table, name, false);
+    if(slot && slot->gen == event_cb_gen) return slot->cb;
+
+    /*Missing callbacks are not cached to warn about them at every instance*/
+    lv_event_cb_t cb = lui_xml_get_event_cb(scope, name);
+    if(cb == NULL) return NULL;
+
+    if(slot == NULL) slot = table_get(table, name, true);
+    if(slot) {
+        slot->cb = cb;
+        slot->gen = event_cb_gen;
+    }
+
+    return cb;
+}
+
+void lui_xml_event_cache_invalidate(void)
+{
+    event_cb_gen++;
+    /*0 is the generation of the new slots*/
+    if(event_cb_gen == 0) event_cb_gen = 1;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Find a name in a table
+ * @param table     the table
+ * @param name      the name to find
+ * @param add       true: add the name if it's not in the table yet
+ * @return          the slot of the name, or NULL if not found or out of memory
+ */
+static name_slot_t * table_get(name_table_t * table, const char * name, bool add)
+{
+    if(table->cnt == 0 && !add) return NULL;
+    if(add && (table->cnt + 1) * 2 > table->cap && table_grow(table) != LV_RESULT_OK) return NULL;
+
+    uint32_t hash = name_hash(name);
+    uint32_t mask = table->cap - 1;
+    uint32_t i;
+    for(i = hash & mask; table->slots[i].name; i = (i + 1) & mask) {
+        name_slot_t * slot = &table->slots[i];
+        if(slot->hash == hash && lv_streq(slot->name, name)) return slot;
+    }
+
+    if(!add) return NULL;
+
+    name_slot_t * slot = &table->slots[i];
+    slot->name = lv_strdup(name);
+    LV_ASSERT_MALLOC(slot->name);
+    if(slot->name == NULL) return NULL;
+    slot->hash = hash;
+    slot->gen = 0;
+    slot->cb = NULL;
+    table->cnt++;
+
+    return slot;
+}
+
+/**
+ * Double the slots of a table and move the names to them
+ * @param table     the table
+ * @return          LV_RESULT_OK: grown; LV_RESULT_INVALID: out of memory
+ */
+static lv_result_t table_grow(name_table_t * table)
+{
+    uint32_t cap = table->cap ? table->cap * 2 : 16;
+    name_slot_t * slots = lv_zalloc(cap * sizeof(name_slot_t));
+    LV_ASSERT_MALLOC(slots);
+    if(slots == NULL) return LV_RESULT_INVALID;
+
+    uint32_t i;
+    for(i = 0; i < table->cap; i++) {
+        if(table->slots[i].name == NULL) continue;
+        uint32_t j = table->slots[i].hash & (cap - 1);
+        while(slots[j].name) j = (j + 1) & (cap - 1);
+        slots[j] = table->slots[i];
+    }
+
+    lv_free(table->slots);
+    table->slots = slots;
+    table->cap = cap;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Free the names and the slots of a table
+ * @param table     the table
+ */
+static void table_clear(name_table_t * table)
+{
+    uint32_t i;
+    for(i = 0; i < table->cap; i++) lv_free(table->slots[i].name);
+
+    lv_free(table->slots);
+    lv_memzero(table, sizeof(name_table_t));
+}
+
+/**
+ * FNV-1a hash of a name
+ * @param name      the name
+ * @return          the hash
+ */
+static uint32_t name_hash(const char * name)
+{
+    uint32_t hash = 2166136261u;
+    while(*name) {
+        hash ^= (uint8_t)*name;
+        hash *= 16777619u;
+        name++;
+    }
+    return hash;
+}
+
+#endif /* LV_USE_XML && LUI_XML_USE_EVENT_CB_CACHE */
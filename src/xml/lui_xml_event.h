@@ -0,0 +1,47 @@
+/**
+ * @file lui_xml_event.h
+ *
+ */
+
+#ifndef LUI_XML_EVENT_H
+#define LUI_XML_EVENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: every registered component resolves the names of its `<event_cb>` callbacks only once
+ *  and its instances share the `user_data` strings instead of copying them*/
+#ifndef LUI_XML_USE_EVENT_CB_CACHE
+#define LUI_XML_USE_EVENT_CB_CACHE 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_EVENT_H*/
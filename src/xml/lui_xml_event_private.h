@@ -0,0 +1,73 @@
+/**
+ * @file lui_xml_event_private.h
+ *
+ */
+
+#ifndef LUI_XML_EVENT_PRIVATE_H
+#define LUI_XML_EVENT_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_event.h"
+#if LV_USE_XML && LUI_XML_USE_EVENT_CB_CACHE
+
+#include "lui_xml_component_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lui_xml_event_cache_t lui_xml_event_cache_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create an empty cache for the event callbacks found by name in a scope
+ * @return          the cache or NULL if out of memory
+ */
+lui_xml_event_cache_t * lui_xml_event_cache_create(void);
+
+/**
+ * Delete an event callback cache
+ * @param cache     the cache or NULL
+ */
+void lui_xml_event_cache_delete(lui_xml_event_cache_t * cache);
+
+/**
+ * Get an event callback like `lui_xml_get_event_cb()`, but look it up only once in the
+ * scopes having a cache
+ * @param scope     the scope to look up the callback in
+ * @param name      name of the callback
+ * @return          the callback or NULL if not found
+ */
+lv_event_cb_t lui_xml_event_cache_get_cb(lui_xml_component_scope_t * scope, const char * name);
+
+/**
+ * Make all the caches look up their callbacks again,
+ * e.g. because a callback was registered or unregistered
+ */
+void lui_xml_event_cache_invalidate(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML && LUI_XML_USE_EVENT_CB_CACHE */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_EVENT_PRIVATE_H*/
@@ -0,0 +1,496 @@
+/**
+ * @file lui_xml_fmt.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_fmt_private.h"
+#if LV_USE_XML && LUI_XML_USE_COMPILED_FMT
+
+#include "../lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define FLAG_LEFT       0x01    /**< `-`*/
+#define FLAG_PLUS       0x02    /**< `+`*/
+#define FLAG_SPACE      0x04    /**< ` `*/
+#define FLAG_ZERO       0x08    /**< `0`*/
+
+#define WIDTH_MAX       64
+#define FIXED_PREC_MAX  9       /**< Larger float precisions are formatted by `lv_snprintf()`*/
+#define NO_PRECISION    0xFF
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A compiled format: a literal prefix, at most one conversion and a literal suffix.
+ * The literals are unescaped (`%%` is stored as `%`).
+ */
+struct _lui_xml_fmt_t {
+    struct _lui_xml_fmt_t * next;
+    uint32_t hash;
+    const char * prefix;        /**< Points into `str` after the format string*/
+    const char * suffix;        /**< Points into `str` after the prefix*/
+    uint16_t prefix_len;
+    uint16_t suffix_len;
+    char conv;                  /**< The conversion, e.g. 'd', or 0 if there is none*/
+    uint8_t flags;
+    uint8_t width;
+    uint8_t precision;          /**< NO_PRECISION if not set*/
+    uint8_t compiled : 1;       /**< 0: format everything with `lv_snprintf()`*/
+    char str[];                 /**< The format string, then the prefix and the suffix*/
+};
+
+/** Writes to a buffer, counting also the characters which don't fit*/
+typedef struct {
+    char * buf;
+    uint32_t size;
+    uint32_t len;
+} writer_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool compile(lui_xml_fmt_t * fmt, const char * src);
+static void put_char(writer_t * w, char c);
+static void put_str(writer_t * w, const char * s, uint32_t len);
+static void put_pad(writer_t * w, char c, int32_t cnt);
+static void put_number(writer_t * w, const lui_xml_fmt_t * fmt, char sign, const char * digits, uint32_t digit_cnt,
+                       uint32_t precision);
+static uint32_t finish(writer_t * w);
+static uint32_t fmt_hash(const char * str);
+static void label_text_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lui_xml_fmt_t * fmts;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+const lui_xml_fmt_t * lui_xml_fmt_get(const char * fmt)
+{
+    uint32_t hash = fmt_hash(fmt);
+    lui_xml_fmt_t * f;
+    for(f = fmts; f; f = f->next) {
+        if(f->hash == hash && lv_streq(f->str, fmt)) return f;
+    }
+
+    /*The format string and the unescaped literals, which are never longer than the format*/
+    size_t len = lv_strlen(fmt);
+    f = lv_malloc(sizeof(lui_xml_fmt_t) + 2 * (len + 1));
+    LV_ASSERT_MALLOC(f);
+    if(f == NULL) return NULL;
+
+    lv_memzero(f, sizeof(lui_xml_fmt_t));
+    lv_memcpy(f->str, fmt, len + 1);
+    f->hash = hash;
+    f->compiled = compile(f, f->str);
+
+    f->next = fmts;
+    fmts = f;
+
+    return f;
+}
+
+uint32_t lui_xml_fmt_int(const lui_xml_fmt_t * fmt, int32_t value, char * buf, uint32_t buf_size)
+{
+    bool is_int = fmt->conv == 'd' || fmt->conv == 'i' || fmt->conv == 'u' || fmt->conv == 'x' || fmt->conv == 'X' ||
+                  fmt->conv == 'c' || fmt->conv == 0;
+    if(!fmt->compiled || !is_int) {
+        int len = lv_snprintf(buf, buf_size, fmt->str, value);
+        return len < 0 ? 0 : len;
+    }
+
+    writer_t w = {buf, buf_size, 0};
+    put_str(&w, fmt->prefix, fmt->prefix_len);
+
+    if(fmt->conv == 'c') {
+        int32_t pad = fmt->width > 1 ? fmt->width - 1 : 0;
+        if(!(fmt->flags & FLAG_LEFT)) put_pad(&w, ' ', pad);
+        put_char(&w, (char)value);
+        if(fmt->flags & FLAG_LEFT) put_pad(&w, ' ', pad);
+    }
+    else if(fmt->conv) {
+        char digits[12];
+        uint32_t digit_cnt = 0;
+        char sign = 0;
+        uint32_t v = (uint32_t)value;
+        if(fmt->conv == 'd' || fmt->conv == 'i') {
+            if(value < 0) {
+                sign = '-';
+                v = 0 - (uint32_t)value;
+            }
+            else if(fmt->flags & FLAG_PLUS) sign = '+';
+            else if(fmt->flags & FLAG_SPACE) sign = ' ';
+        }
+
+        /*The digits in reverse order*/
+        if(fmt->conv == 'x' || fmt->conv == 'X') {
+            const char * hex = fmt->conv == 'x' ? "0123456789abcdef" : "0123456789ABCDEF";
+            while(v) {
+                digits[digit_cnt++] = hex[v & 0xF];
+                v >>= 4;
+            }
+        }
+        else {
+            while(v) {
+                digits[digit_cnt++] = (char)('0' + v % 10);
+                v /= 10;
+            }
+        }
+
+        /*0 is printed as "0" unless the precision is 0*/
+        if(digit_cnt == 0 && fmt->precision != 0) digits[digit_cnt++] = '0';
+
+        uint32_t precision = fmt->precision == NO_PRECISION ? 0 : fmt->precision;
+        put_number(&w, fmt, sign, digits, digit_cnt, precision);
+    }
+
+    put_str(&w, fmt->suffix, fmt->suffix_len);
+    return finish(&w);
+}
+
+#if LV_USE_FLOAT
+uint32_t lui_xml_fmt_float(const lui_xml_fmt_t * fmt, float value, char * buf, uint32_t buf_size)
+{
+    static const uint32_t pow10[FIXED_PREC_MAX + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+                                                       100000000, 1000000000
+                                                      };
+
+    uint32_t precision = fmt->precision == NO_PRECISION ? 6 : fmt->precision;
+    double a = value < 0 ? -(double)value : (double)value;
+
+    /*Not compiled, or NaN, infinity, too large or too precise*/
+    if(!fmt->compiled || (fmt->conv != 'f' && fmt->conv != 0) ||
+       (fmt->conv && (value != value || precision > FIXED_PREC_MAX || a * pow10[precision] >= 1e18))) {
+        int len = lv_snprintf(buf, buf_size, fmt->str, (double)value);
+        return len < 0 ? 0 : len;
+    }
+
+    writer_t w = {buf, buf_size, 0};
+    put_str(&w, fmt->prefix, fmt->prefix_len);
+
+    if(fmt->conv) {
+        char sign = 0;
+        if(value < 0 || (value == 0 && 1.0f / value < 0)) sign = '-';
+        else if(fmt->flags & FLAG_PLUS) sign = '+';
+        else if(fmt->flags & FLAG_SPACE) sign = ' ';
+
+        /*Fixed-point: scale, then round half to even as printf does*/
+        double scaled = a * pow10[precision];
+        uint64_t fixed = (uint64_t)scaled;
+        double frac = scaled - (double)fixed;
+        if(frac > 0.5 || (frac == 0.5 && (fixed & 1))) fixed++;
+
+        /*The digits in reverse order with the decimal point*/
+        char digits[32];
+        uint32_t digit_cnt = 0;
+        uint32_t i;
+        for(i = 0; i < precision; i++) {
+            digits[digit_cnt++] = (char)('0' + fixed % 10);
+            fixed /= 10;
+        }
+        if(precision) digits[digit_cnt++] = '.';
+        do {
+            digits[digit_cnt++] = (char)('0' + fixed % 10);
+            fixed /= 10;
+        } while(fixed);
+
+        put_number(&w, fmt, sign, digits, digit_cnt, 0);
+    }
+
+    put_str(&w, fmt->suffix, fmt->suffix_len);
+    return finish(&w);
+}
+#endif
+
+uint32_t lui_xml_fmt_str(const lui_xml_fmt_t * fmt, const char * value, char * buf, uint32_t buf_size)
+{
+    if(!fmt->compiled || (fmt->conv != 's' && fmt->conv != 0)) {
+        int len = lv_snprintf(buf, buf_size, fmt->str, value);
+        return len < 0 ? 0 : len;
+    }
+
+    writer_t w = {buf, buf_size, 0};
+    put_str(&w, fmt->prefix, fmt->prefix_len);
+
+    if(fmt->conv) {
+        if(value == NULL) value = "(null)";
+        uint32_t len = lv_strlen(value);
+        if(fmt->precision != NO_PRECISION && len > fmt->precision) len = fmt->precision;
+
+        int32_t pad = fmt->width > len ? fmt->width - len : 0;
+        if(!(fmt->flags & FLAG_LEFT)) put_pad(&w, ' ', pad);
+        put_str(&w, value, len);
+        if(fmt->flags & FLAG_LEFT) put_pad(&w, ' ', pad);
+    }
+
+    put_str(&w, fmt->suffix, fmt->suffix_len);
+    return finish(&w);
+}
+
+void lui_xml_fmt_bind_label(lv_obj_t * label, lv_subject_t * subject, const lui_xml_fmt_t * fmt)
+{
+    bool match;
+    switch(subject->type) {
+        case LV_SUBJECT_TYPE_INT:
+            match = fmt->conv != 'f' && fmt->conv != 's';
+            break;
+#if LV_USE_FLOAT
+        case LV_SUBJECT_TYPE_FLOAT:
+            match = fmt->conv == 'f' || fmt->conv == 0;
+            break;
+#endif
+        case LV_SUBJECT_TYPE_STRING:
+            match = fmt->conv == 's' || fmt->conv == 0;
+            break;
+        default:
+            match = false;
+            break;
+    }
+
+    if(!fmt->compiled || !match) {
+        lv_label_bind_text(label, subject, fmt->str);
+        return;
+    }
+
+    /*Removed with the label*/
+    lv_subject_add_observer_obj(subject, label_text_observer_cb, label, (void *)fmt);
+}
+
+const char * lui_xml_fmt_get_str(const lui_xml_fmt_t * fmt)
+{
+    return fmt->str;
+}
+
+void lui_xml_fmt_deinit(void)
+{
+    while(fmts) {
+        lui_xml_fmt_t * next = fmts->next;
+        lv_free(fmts);
+        fmts = next;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Split a format to a prefix, a conversion and a suffix
+ * @param fmt       store the result here. The literals are written after the format string.
+ * @param src       the format string
+ * @return          true: compiled; false: the format needs to be formatted by `lv_snprintf()`
+ */
+static bool compile(lui_xml_fmt_t * fmt, const char * src)
+{
+    char * lit = fmt->str + lv_strlen(src) + 1;
+    fmt->prefix = lit;
+    fmt->precision = NO_PRECISION;
+
+    while(*src) {
+        if(src[0] != '%') {
+            *lit++ = *src++;
+            continue;
+        }
+        if(src[1] == '%') {
+            *lit++ = '%';
+            src += 2;
+            continue;
+        }
+
+        /*A second conversion would read a missing argument*/
+        if(fmt->conv) return false;
+
+        src++;
+        while(*src == '-' || *src == '+' || *src == ' ' || *src == '0') {
+            if(*src == '-') fmt->flags |= FLAG_LEFT;
+            else if(*src == '+') fmt->flags |= FLAG_PLUS;
+            else if(*src == ' ') fmt->flags |= FLAG_SPACE;
+            else fmt->flags |= FLAG_ZERO;
+            src++;
+        }
+
+        uint32_t width = 0;
+        while(*src >= '0' && *src <= '9') {
+            width = width * 10 + (*src - '0');
+            if(width > WIDTH_MAX) return false;
+            src++;
+        }
+        fmt->width = (uint8_t)width;
+
+        if(*src == '.') {
+            src++;
+            uint32_t precision = 0;
+            while(*src >= '0' && *src <= '9') {
+                precision = precision * 10 + (*src - '0');
+                if(precision > WIDTH_MAX) return false;
+                src++;
+            }
+            fmt->precision = (uint8_t)precision;
+        }
+
+        /*Length modifiers, `*`, `#`, `%e`, `%p`, etc. are left to `lv_snprintf()`*/
+        switch(*src) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'c':
+            case 'f':
+            case 's':
+                fmt->conv = *src;
+                break;
+            default:
+                return false;
+        }
+        src++;
+
+        fmt->prefix_len = (uint16_t)(lit - fmt->prefix);
+        fmt->suffix = lit;
+    }
+
+    if(fmt->conv) {
+        fmt->suffix_len = (uint16_t)(lit - fmt->suffix);
+    }
+    else {
+        fmt->prefix_len = (uint16_t)(lit - fmt->prefix);
+        fmt->suffix = lit;
+    }
+
+    return true;
+}
+
+static void put_char(writer_t * w, char c)
+{
+    if(w->len + 1 < w->size) w->buf[w->len] = c;
+    w->len++;
+}
+
+static void put_str(writer_t * w, const char * s, uint32_t len)
+{
+    if(w->len + 1 < w->size) {
+        uint32_t fit = LV_MIN(len, w->size - 1 - w->len);
+        lv_memcpy(w->buf + w->len, s, fit);
+    }
+    w->len += len;
+}
+
+static void put_pad(writer_t * w, char c, int32_t cnt)
+{
+    while(cnt > 0) {
+        put_char(w, c);
+        cnt--;
+    }
+}
+
+/**
+ * Write a number with its sign and padding
+ * @param w         the writer
+ * @param fmt       the format with the flags and the width
+ * @param sign      '-', '+', ' ' or 0
+ * @param digits    the digits in reverse order
+ * @param digit_cnt number of digits
+ * @param precision minimal number of digits, padded with zeros
+ */
+static void put_number(writer_t * w, const lui_xml_fmt_t * fmt, char sign, const char * digits, uint32_t digit_cnt,
+                       uint32_t precision)
+{
+    int32_t zeros = precision > digit_cnt ? precision - digit_cnt : 0;
+    int32_t len = (sign ? 1 : 0) + zeros + digit_cnt;
+    int32_t pad = fmt->width > len ? fmt->width - len : 0;
+
+    /*The `0` flag is ignored with `-`, and with the precision of integers*/
+    bool zero_pad = (fmt->flags & FLAG_ZERO) && !(fmt->flags & FLAG_LEFT) &&
+                    (fmt->conv == 'f' || fmt->precision == NO_PRECISION);
+    if(zero_pad) {
+        zeros += pad;
+        pad = 0;
+    }
+
+    if(!(fmt->flags & FLAG_LEFT)) put_pad(w, ' ', pad);
+    if(sign) put_char(w, sign);
+    put_pad(w, '0', zeros);
+    while(digit_cnt) {
+        digit_cnt--;
+        put_char(w, digits[digit_cnt]);
+    }
+    if(fmt->flags & FLAG_LEFT) put_pad(w, ' ', pad);
+}
+
+static uint32_t finish(writer_t * w)
+{
+    if(w->size) w->buf[LV_MIN(w->len, w->size - 1)] = '\0';
+    return w->len;
+}
+
+/** FNV-1a*/
+static uint32_t fmt_hash(const char * str)
+{
+    uint32_t hash = 2166136261u;
+    while(*str) {
+        hash ^= (uint8_t)*str;
+        hash *= 16777619u;
+        str++;
+    }
+    return hash;
+}
+
+static void label_text_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    lv_obj_t * label = lv_observer_get_target_obj(observer);
+    const lui_xml_fmt_t * fmt = lv_observer_get_user_data(observer);
+
+    char buf[LUI_XML_FMT_BUF_SIZE];
+    char * text = buf;
+    uint32_t len = 0;
+    uint32_t i;
+
+    /*Once with the stack buffer, and again with an allocated one if it was too small*/
+    for(i = 0; i < 2; i++) {
+        uint32_t size = text == buf ? sizeof(buf) : len + 1;
+        switch(subject->type) {
+            case LV_SUBJECT_TYPE_INT:
+                len = lui_xml_fmt_int(fmt, lv_subject_get_int(subject), text, size);
+                break;
+#if LV_USE_FLOAT
+            case LV_SUBJECT_TYPE_FLOAT:
+                len = lui_xml_fmt_float(fmt, lv_subject_get_float(subject), text, size);
+                break;
+#endif
+            default:
+                len = lui_xml_fmt_str(fmt, lv_subject_get_string(subject), text, size);
+                break;
+        }
+
+        if(len < size) break;
+
+        text = lv_malloc(len + 1);
+        LV_ASSERT_MALLOC(text);
+        if(text == NULL) {
+            text = buf;
+            break;
+        }
+    }
+
+    /*Setting the same text would only invalidate the label*/
+    if(!lv_streq(lv_label_get_text(label), text)) lv_label_set_text(label, text);
+
+    if(text != buf) lv_free(text);
+}
+
+#endif /*LV_USE_XML && LUI_XML_USE_COMPILED_FMT*/
@@ -0,0 +1,101 @@
+/**
+ * @file lui_xml_fmt.h
+ *
+ */
+
+#ifndef LUI_XML_FMT_H
+#define LUI_XML_FMT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: parse the `bind_text-fmt` formats once, share them among the instances and
+ *  format the values of the subjects without `printf`*/
+#ifndef LUI_XML_USE_COMPILED_FMT
+#define LUI_XML_USE_COMPILED_FMT 0
+#endif
+
+/** Size of the stack buffer the bound texts are formatted into. Longer texts are allocated.*/
+#ifndef LUI_XML_FMT_BUF_SIZE
+#define LUI_XML_FMT_BUF_SIZE 64
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lui_xml_fmt_t lui_xml_fmt_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_COMPILED_FMT
+
+/**
+ * Get the compiled form of a format string. The formats are compiled once and kept
+ * until `lui_xml_deinit()`, so the same format string always returns the same format.
+ * Literals and one `%d`, `%i`, `%u`, `%x`, `%X`, `%c`, `%f` or `%s` conversion with the
+ * `-`, `+`, ` ` and `0` flags, width and precision are compiled. Other formats are
+ * formatted by `lv_snprintf()`.
+ * @param fmt       a printf-like format string, e.g. "%d °C"
+ * @return          the format or NULL if out of memory
+ */
+const lui_xml_fmt_t * lui_xml_fmt_get(const char * fmt);
+
+/**
+ * Format an integer like `lv_snprintf(buf, buf_size, fmt, value)`
+ * @param fmt       a format from `lui_xml_fmt_get()`
+ * @param value     the value to format
+ * @param buf       store the NULL terminated text here. It's truncated if it doesn't fit.
+ * @param buf_size  size of `buf`
+ * @return          length of the whole text without the terminating NULL, even if it was truncated
+ */
+uint32_t lui_xml_fmt_int(const lui_xml_fmt_t * fmt, int32_t value, char * buf, uint32_t buf_size);
+
+#if LV_USE_FLOAT
+/**
+ * Format a float like `lv_snprintf(buf, buf_size, fmt, value)`, see `lui_xml_fmt_int()`
+ * @param fmt       a format from `lui_xml_fmt_get()`
+ * @param value     the value to format
+ * @param buf       store the NULL terminated text here
+ * @param buf_size  size of `buf`
+ * @return          length of the whole text without the terminating NULL
+ */
+uint32_t lui_xml_fmt_float(const lui_xml_fmt_t * fmt, float value, char * buf, uint32_t buf_size);
+#endif
+
+/**
+ * Format a string like `lv_snprintf(buf, buf_size, fmt, value)`, see `lui_xml_fmt_int()`
+ * @param fmt       a format from `lui_xml_fmt_get()`
+ * @param value     the string to format
+ * @param buf       store the NULL terminated text here
+ * @param buf_size  size of `buf`
+ * @return          length of the whole text without the terminating NULL
+ */
+uint32_t lui_xml_fmt_str(const lui_xml_fmt_t * fmt, const char * value, char * buf, uint32_t buf_size);
+
+#endif /*LUI_XML_USE_COMPILED_FMT*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_FMT_H*/
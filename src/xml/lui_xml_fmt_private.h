@@ -0,0 +1,64 @@
+/**
+ * @file lui_xml_fmt_private.h
+ *
+ */
+
+#ifndef LUI_XML_FMT_PRIVATE_H
+#define LUI_XML_FMT_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_fmt.h"
+#if LV_USE_XML && LUI_XML_USE_COMPILED_FMT
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Bind the text of a label to a subject through a compiled format.
+ * Falls back to `lv_label_bind_text()` with the shared format string if the
+ * conversion doesn't match the type of the subject.
+ * @param label     the label
+ * @param subject   the subject
+ * @param fmt       a format from `lui_xml_fmt_get()`
+ */
+void lui_xml_fmt_bind_label(lv_obj_t * label, lv_subject_t * subject, const lui_xml_fmt_t * fmt);
+
+/**
+ * Get the format string of a compiled format
+ * @param fmt       a format from `lui_xml_fmt_get()`
+ * @return          the format string, valid as long as the format
+ */
+const char * lui_xml_fmt_get_str(const lui_xml_fmt_t * fmt);
+
+/**
+ * Free the compiled formats
+ */
+void lui_xml_fmt_deinit(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML && LUI_XML_USE_COMPILED_FMT */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_FMT_PRIVATE_H*/
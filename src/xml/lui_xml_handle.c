@@ -0,0 +1,118 @@
+/**
+ * @file lui_xml_handle.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_handle.h"
+#if LV_USE_XML
+
+#include "../stdlib/lv_mem.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lui_xml_handle_table_init(lui_xml_handle_table_t * table)
+{
+    table->slots = NULL;
+    table->cnt = 0;
+    table->cap = 0;
+    table->free_slot = LUI_XML_HANDLE_NO_SLOT;
+}
+
+void lui_xml_handle_table_destroy(lui_xml_handle_table_t * table)
+{
+    lv_free(table->slots);
+    lui_xml_handle_table_init(table);
+}
+
+uint32_t lui_xml_handle_table_add(lui_xml_handle_table_t * table, void * ptr)
+{
+    uint32_t slot = table->free_slot;
+    if(slot != LUI_XML_HANDLE_NO_SLOT) {
+        table->free_slot = table->slots[slot].next_free;
+    }
+    else {
+        if(table->cnt == LUI_XML_HANDLE_SLOT_MASK) return LUI_XML_HANDLE_NO_SLOT;
+
+        if(table->cnt == table->cap) {
+            uint32_t cap = table->cap ? LV_MIN(table->cap * 2, LUI_XML_HANDLE_SLOT_MASK) : 16;
+            lui_xml_handle_slot_t * slots_new = lv_realloc(table->slots, cap * sizeof(lui_xml_handle_slot_t));
+            LV_ASSERT_MALLOC(slots_new);
+            if(slots_new == NULL) return LUI_XML_HANDLE_NO_SLOT;
+
+            table->slots = slots_new;
+            table->cap = cap;
+        }
+
+        slot = table->cnt;
+        table->cnt++;
+        table->slots[slot].gen = 0;
+    }
+
+    table->slots[slot].ptr = ptr;
+    table->slots[slot].user_data = 0;
+    return slot;
+}
+
+void lui_xml_handle_table_remove(lui_xml_handle_table_t * table, uint32_t slot)
+{
+    lui_xml_handle_slot_t * s = &table->slots[slot];
+    s->ptr = NULL;
+    s->gen++;
+
+    /*Retire the slot instead of wrapping its generation around,
+     *else a stale handle could resolve to the next pointer of the slot*/
+    if(s->gen > LUI_XML_HANDLE_GEN_MASK) return;
+
+    s->next_free = table->free_slot;
+    table->free_slot = slot;
+}
+
+uint32_t lui_xml_handle_table_get_handle(const lui_xml_handle_table_t * table, uint32_t slot)
+{
+    return (table->slots[slot].gen << LUI_XML_HANDLE_SLOT_BITS) | (slot + 1);
+}
+
+lui_xml_handle_slot_t * lui_xml_handle_table_get_slot(const lui_xml_handle_table_t * table, uint32_t handle)
+{
+    uint32_t slot = (handle & LUI_XML_HANDLE_SLOT_MASK) - 1;
+    if(slot >= table->cnt) return NULL;
+
+    lui_xml_handle_slot_t * s = &table->slots[slot];
+    if(s->ptr == NULL) return NULL;
+    if(s->gen != (handle >> LUI_XML_HANDLE_SLOT_BITS)) return NULL;
+
+    return s;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /* LV_USE_XML */
@@ -0,0 +1,116 @@
+/**
+ * @file lui_xml_handle.h
+ *
+ */
+
+#ifndef LUI_XML_HANDLE_H
+#define LUI_XML_HANDLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#if LV_USE_XML
+
+#include LV_STDINT_INCLUDE
+#include LV_STDBOOL_INCLUDE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*A handle is `(generation << LUI_XML_HANDLE_SLOT_BITS) | (slot index + 1)`.
+ *Bit 31 is always 0 so that the callers can use it as a flag.*/
+#define LUI_XML_HANDLE_SLOT_BITS    20
+#define LUI_XML_HANDLE_SLOT_MASK    ((1u << LUI_XML_HANDLE_SLOT_BITS) - 1)
+#define LUI_XML_HANDLE_GEN_MASK     ((1u << (31 - LUI_XML_HANDLE_SLOT_BITS)) - 1)
+
+/** Returned instead of a slot index on error*/
+#define LUI_XML_HANDLE_NO_SLOT      UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    void * ptr;                 /**< NULL if the slot is free*/
+    uint32_t gen;               /**< Incremented when the slot is released to invalidate its handles*/
+    uint32_t next_free;
+    uint32_t user_data;         /**< Free to use by the owner of the table*/
+} lui_xml_handle_slot_t;
+
+/**
+ * Map small integer handles to pointers. A released slot is reused
+ * with the next generation so the old handles of the slot become invalid.
+ * A slot whose generation would not fit into a handle anymore is never reused,
+ * therefore a stale handle is never resolved to a new pointer.
+ */
+typedef struct {
+    lui_xml_handle_slot_t * slots;
+    uint32_t cnt;
+    uint32_t cap;
+    uint32_t free_slot;
+} lui_xml_handle_table_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty handle table
+ * @param table     pointer to a handle table
+ */
+void lui_xml_handle_table_init(lui_xml_handle_table_t * table);
+
+/**
+ * Free the slots of a handle table. The table can be reused after this.
+ * @param table     pointer to a handle table
+ */
+void lui_xml_handle_table_destroy(lui_xml_handle_table_t * table);
+
+/**
+ * Store a pointer in a free slot of a handle table
+ * @param table     pointer to an initialized handle table
+ * @param ptr       the pointer to store, not NULL
+ * @return          index of the slot or `LUI_XML_HANDLE_NO_SLOT` if out of slots or memory
+ */
+uint32_t lui_xml_handle_table_add(lui_xml_handle_table_t * table, void * ptr);
+
+/**
+ * Free a slot and invalidate all of its handles
+ * @param table     pointer to a handle table
+ * @param slot      index of a used slot
+ */
+void lui_xml_handle_table_remove(lui_xml_handle_table_t * table, uint32_t slot);
+
+/**
+ * Get the handle of the current generation of a slot
+ * @param table     pointer to a handle table
+ * @param slot      index of a used slot
+ * @return          the handle, never 0
+ */
+uint32_t lui_xml_handle_table_get_handle(const lui_xml_handle_table_t * table, uint32_t slot);
+
+/**
+ * Get the slot of a handle
+ * @param table     pointer to a handle table
+ * @param handle    a handle returned by `lui_xml_handle_table_get_handle()`
+ * @return          the slot or NULL if the handle is invalid or its slot was released
+ */
+lui_xml_handle_slot_t * lui_xml_handle_table_get_slot(const lui_xml_handle_table_t * table, uint32_t handle);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_HANDLE_H*/
@@ -11,11 +11,21 @@
 #if LV_USE_XML
 
 #include "lui_xml_private.h"
+#include "lui_xml_component_private.h"
+#include "lui_xml_reload_private.h"
+#include "lui_xml_cache_private.h"
+#include "lui_xml_profile_private.h"
+#include "lui_xml_deps.h"
 #include "../core/lv_global.h"
 #include "../misc/lv_fs.h"
 #include "../libs/fsdrv/lv_fsdrv.h"
 #include "../misc/lv_ll.h"
-#include "../libs/expat/expat.h"
+#if LV_USE_FS_FROGFS
+    #include "../libs/frogfs/include/frogfs/frogfs.h"
+#endif
+#if LV_USE_OS != LV_OS_NONE
+    #include "../osal/lv_os_private.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -25,6 +35,20 @@
 #define PATH_PREFIX_BUF_SIZE 32
 #define PATH_PREFIX_FMT      "__LUI_XML_%p"
 
+/*The files are not tokenized on threads with the cache as most of them are not parsed at all*/
+#if LUI_XML_USE_CACHE
+    #define cache_is_enabled() lui_xml_cache_is_enabled()
+#else
+    #define cache_is_enabled() false
+#endif
+
+/*The phases of the files can't be told apart if they are tokenized on threads*/
+#if LUI_XML_USE_PROFILE
+    #define profile_is_active() lui_xml_profile_is_active()
+#else
+    #define profile_is_active() false
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,27 +59,126 @@ typedef enum {
     LUI_XML_TYPE_TRANSLATIONS,
 } lui_xml_type_t;
 
+/*Used while parsing a file only up to its root element*/
 typedef struct {
     XML_Parser parser;
     lui_xml_type_t type;
-} load_from_path_parser_data_t;
+} sniff_ctx_t;
+
+typedef struct _lui_xml_load_component_t {
+    const char * name;
+    struct _lui_xml_load_component_t * next;
+} lui_xml_load_component_t;
+
+/*A component indexed by a lazy load*/
+typedef struct _load_index_entry_t {
+    const char * name;
+    const char * path;
+    const char * asset_path;            /**< The default asset path when the file was indexed*/
+#if LV_USE_FS_FROGFS
+    lui_xml_load_t * load;              /**< The blob the file is in or NULL*/
+#endif
+    struct _load_index_entry_t * next;
+} load_index_entry_t;
+
+/*A file to load*/
+typedef struct {
+    const char * path;
+    lui_xml_doc_t doc;      /**< Only used when tokenizing on multiple threads*/
+    const char * xml_buf;   /**< The file read by the calling thread for the loader threads or NULL*/
+    uint32_t xml_size;
+    bool xml_static;        /**< `xml_buf` is in a blob, not allocated*/
+    bool read_error;
+} load_job_t;
+
+typedef struct {
+    load_job_t * jobs;
+    uint32_t job_cnt;
+    uint32_t job_cap;
+    lui_xml_arena_t arena;  /**< The paths are allocated here*/
+} load_list_t;
+
+#if LV_USE_OS != LV_OS_NONE
+typedef struct _load_pool_t load_pool_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;  /**< Signaled when a new batch is ready or on exit*/
+    load_pool_t * pool;
+} load_worker_t;
+
+struct _load_pool_t {
+    load_list_t * list;
+    load_worker_t * workers;
+    uint32_t worker_cnt;
+    lv_mutex_t lock;        /**< Protects the fields below*/
+    uint32_t next_job;      /**< Index of the next job to tokenize in the batch*/
+    uint32_t batch_end;
+    uint32_t done_cnt;      /**< Number of tokenized jobs in the batch*/
+    bool exit;
+    lv_thread_sync_t done_sync; /**< Signaled when a job is tokenized*/
+};
+#endif
 
 struct _lui_xml_load_t {
     const void * blob;
+#if LV_USE_FS_FROGFS
+    frogfs_fs_t * fs;                       /**< Own handle to the blob to access the files in place*/
+#endif
+    lui_xml_arena_t arena;                  /**< The component list and names are allocated here*/
+    lui_xml_load_component_t * components;  /**< Components registered from this data*/
 };
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
-static lv_result_t load_all_recursive(char * path_buf, const char * path);
+static lv_result_t load_all_recursive(char * path_buf, const char * path, load_list_t * list);
+static void load_list_add(load_list_t * list, const char * path);
+static void load_list_sort(load_list_t * list);
+static bool load_job_is_before(const load_job_t * a, const load_job_t * b);
 static void load_from_path(const char * path);
+static void register_file(const char * path);
+static void load_lazy(const char * path, const char * asset_path);
+static lui_xml_type_t sniff_file(const char * path);
+static lui_xml_type_t sniff_file_parse(const char * path);
+static void sniff_start_element_cb(void * user_data, const char * name, const char ** attrs);
+static load_index_entry_t * index_take(const char * name);
+static lv_result_t index_register(load_index_entry_t * entry);
+static void index_clear(void);
+static lui_xml_type_t get_type_of_root(const char * name);
+static lv_result_t load_ordered(load_list_t * list);
+#if LV_USE_OS != LV_OS_NONE
+    static void load_parallel(load_list_t * list, uint32_t thread_cnt, bool commit);
+    static void load_pool_work(load_pool_t * pool);
+    static void load_worker_cb(void * user_data);
+    static void load_job_read(load_job_t * job);
+#endif
+static void load_job_tokenize(load_job_t * job);
+static void load_job_commit(load_job_t * job);
+static lui_xml_type_t sniff_xml_type(const char * buf, uint32_t len);
+static const char * skip_past(const char * buf, const char * end, const char * token);
+static const char * skip_doctype(const char * buf, const char * end);
+static bool starts_with(const char * buf, const char * end, const char * token);
 static char * path_filename_without_extension(const char * path);
-static void load_from_path_start_element_handler(void * user_data, const char * name, const char ** attrs);
+#if LV_USE_FS_FROGFS
+    static void load_add_component(lui_xml_load_t * load, const char * name);
+    static const char * load_access_in_place(lui_xml_load_t * load, const char * path, uint32_t * size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_FS_FROGFS
+    static lui_xml_load_t * load_act;   /**< The load whose data is being processed*/
+#endif
+static uint32_t load_thread_cnt = LUI_XML_LOAD_THREAD_CNT;
+static bool load_lazy_en = LUI_XML_LOAD_LAZY;
+static bool load_dep_order_en = LUI_XML_LOAD_DEP_ORDER;
+static bool load_lazy_fonts_en = LUI_XML_LOAD_LAZY_FONTS;
+static load_index_entry_t * index_head;     /**< The most recently indexed entry first, like the registry*/
+static lui_xml_arena_t index_arena;         /**< The entries and their strings are allocated here*/
+static uint32_t index_cnt;
 
 /**********************
  *      MACROS
@@ -68,12 +191,23 @@ static void load_from_path_start_element_handler(void * user_data, const char *
 void lui_xml_load_init(void)
 {
     lv_ll_init(&xml_loads, sizeof(lui_xml_load_t));
+    lui_xml_arena_init(&index_arena, 0);
 }
 
 void lui_xml_load_deinit(void)
 {
 #if LV_USE_FS_FROGFS
     lui_xml_unload(NULL);
+#endif
+    index_clear();
+#if LUI_XML_USE_RELOAD
+    lui_xml_reload_deinit();
+#endif
+#if LUI_XML_USE_CACHE
+    lui_xml_cache_deinit();
+#endif
+#if LUI_XML_USE_PROFILE
+    lui_xml_profile_deinit();
 #endif
 }
 
@@ -81,6 +215,95 @@ lv_result_t lui_xml_load_all_from_path(const char * path)
 {
     char path_buf[LV_FS_MAX_PATH_LENGTH];
 
+    lui_xml_load_set_asset_path_to_dir(path);
+
+    /*Collect the files first to register them in a well defined order*/
+    load_list_t list;
+    lv_memzero(&list, sizeof(list));
+    lui_xml_arena_init(&list.arena, 0);
+
+    lv_result_t res = load_all_recursive(path_buf, path, &list);
+    load_list_sort(&list);
+
+    if(load_lazy_en) {
+        /*The entries need it as they can be registered after loading other directories.
+         *Copy the one set above.*/
+        const char * asset_path_copy = lui_xml_arena_strdup(&index_arena, LV_GLOBAL_DEFAULT()->xml_path_prefix);
+        uint32_t i;
+        for(i = 0; i < list.job_cnt; i++) {
+            load_lazy(list.jobs[i].path, asset_path_copy);
+        }
+        if(index_cnt == 0) index_clear();
+    }
+    else if(load_dep_order_en && !cache_is_enabled()) {
+        if(load_ordered(&list) != LV_RESULT_OK) res = LV_RESULT_INVALID;
+    }
+#if LV_USE_OS != LV_OS_NONE
+    else if(load_thread_cnt > 1 && list.job_cnt > 1 && !cache_is_enabled() && !profile_is_active()) {
+        load_parallel(&list, load_thread_cnt, true);
+    }
+#endif
+    else {
+        uint32_t i;
+        for(i = 0; i < list.job_cnt; i++) {
+            load_from_path(list.jobs[i].path);
+        }
+    }
+
+#if LUI_XML_USE_RELOAD
+    uint32_t j;
+    for(j = 0; j < list.job_cnt; j++) {
+        lui_xml_reload_track(list.jobs[j].path);
+    }
+#endif
+
+    lv_free(list.jobs);
+    lui_xml_arena_destroy(&list.arena);
+
+    return res;
+}
+
+lv_result_t lui_xml_load_for_each_file(const char * path, lui_xml_load_file_cb_t cb, void * user_data)
+{
+    char path_buf[LV_FS_MAX_PATH_LENGTH];
+
+    load_list_t list;
+    lv_memzero(&list, sizeof(list));
+    lui_xml_arena_init(&list.arena, 0);
+
+    lv_result_t res = load_all_recursive(path_buf, path, &list);
+    load_list_sort(&list);
+
+    uint32_t i;
+    for(i = 0; i < list.job_cnt; i++) {
+        cb(list.jobs[i].path, user_data);
+    }
+
+    lv_free(list.jobs);
+    lui_xml_arena_destroy(&list.arena);
+
+    return res;
+}
+
+char * lui_xml_load_get_component_name(const char * path)
+{
+    return path_filename_without_extension(path);
+}
+
+void lui_xml_load_file(const char * path)
+{
+    load_from_path(path);
+}
+
+bool lui_xml_load_file_is_component(const char * path)
+{
+    return sniff_file(path) == LUI_XML_TYPE_COMPONENT;
+}
+
+void lui_xml_load_set_asset_path_to_dir(const char * path)
+{
+    char path_buf[LV_FS_MAX_PATH_LENGTH];
+
     /* set the default asset path to the pack path so XML asset paths are relative to it */
     const char * asset_path = path;
     /* end the asset path with a '/' */
@@ -91,8 +314,82 @@ lv_result_t lui_xml_load_all_from_path(const char * path)
         asset_path = path_buf;
     }
     lui_xml_set_default_asset_path(asset_path);
+}
+
+void lui_xml_load_set_thread_count(uint32_t thread_cnt)
+{
+#if LV_USE_OS == LV_OS_NONE
+    if(thread_cnt > 1) {
+        LV_LOG_WARN("LV_USE_OS is not enabled, the files will be loaded on one thread");
+    }
+#endif
+
+    load_thread_cnt = thread_cnt;
+}
+
+void lui_xml_load_set_lazy(bool en)
+{
+    load_lazy_en = en;
+}
+
+void lui_xml_load_set_dep_order(bool en)
+{
+    load_dep_order_en = en;
+}
+
+lv_result_t lui_xml_load_component(const char * name)
+{
+    if(name) return lui_xml_component_get_scope(name) ? LV_RESULT_OK : LV_RESULT_INVALID;
+
+    lv_result_t res = LV_RESULT_OK;
+    while(index_head) {
+        if(lui_xml_load_register_indexed(index_head->name) != LV_RESULT_OK) res = LV_RESULT_INVALID;
+    }
+
+    return res;
+}
+
+uint32_t lui_xml_load_get_indexed_count(void)
+{
+    return index_cnt;
+}
+
+void lui_xml_load_set_lazy_fonts(bool en)
+{
+    load_lazy_fonts_en = en;
+}
+
+uint32_t lui_xml_load_pending_fonts(uint32_t max_cnt)
+{
+    return lui_xml_component_create_pending_fonts(max_cnt);
+}
+
+lv_result_t lui_xml_load_register_indexed(const char * name)
+{
+    load_index_entry_t * entry = index_take(name);
+    if(entry == NULL) return LV_RESULT_INVALID;
+
+    return index_register(entry);
+}
+
+lv_result_t lui_xml_load_remove_indexed(const char * name)
+{
+    return index_take(name) ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+bool lui_xml_load_is_indexed(const char * name)
+{
+    load_index_entry_t * entry;
+    for(entry = index_head; entry; entry = entry->next) {
+        if(lv_streq(entry->name, name)) return true;
+    }
+
+    return false;
+}
 
-    return load_all_recursive(path_buf, path);
+bool lui_xml_load_get_lazy_fonts(void)
+{
+    return load_lazy_fonts_en;
 }
 
 #if LV_USE_FS_FROGFS
@@ -104,6 +401,7 @@ lui_xml_load_t * lui_xml_load_all_from_data(const void * buf, uint32_t buf_size)
     LV_ASSERT_MALLOC(load);
     if(load == NULL) return NULL;
     lv_memzero(load, sizeof(*load));
+    lui_xml_arena_init(&load->arena, 256);
 
     char path_prefix_with_letter[PATH_PREFIX_BUF_SIZE];
     lv_snprintf(path_prefix_with_letter, sizeof(path_prefix_with_letter), "%c:"PATH_PREFIX_FMT, LV_FS_FROGFS_LETTER, load);
@@ -117,11 +415,17 @@ lui_xml_load_t * lui_xml_load_all_from_data(const void * buf, uint32_t buf_size)
         return NULL;
     }
 
+    /*Open the blob directly too so that uncompressed files can be used in place
+     *without copying them to RAM. If it fails the files are read through lv_fs.*/
+    frogfs_config_t frogfs_config = {0};
+    frogfs_config.addr = buf;
+    load->fs = frogfs_init(&frogfs_config);
+
+    load_act = load;
     res = lui_xml_load_all_from_path(path_prefix_with_letter);
+    load_act = NULL;
     if(res != LV_RESULT_OK) {
-        lv_fs_frogfs_unregister_blob(path_prefix);
-        lv_ll_remove(&xml_loads, load);
-        lv_free(load);
+        lui_xml_unload(load);
         return NULL;
     }
 
@@ -174,19 +478,46 @@ void lui_xml_unload(lui_xml_load_t * load)
     char path_prefix[PATH_PREFIX_BUF_SIZE];
     lv_snprintf(path_prefix, sizeof(path_prefix), PATH_PREFIX_FMT, load);
 
+    lui_xml_load_component_t * comp;
+    for(comp = load->components; comp; comp = comp->next) {
+        /*Don't remove a component with the same name registered from somewhere else later*/
+        lui_xml_component_scope_t * scope = lui_xml_component_find_scope(comp->name);
+        if(scope && scope->load == load) lui_xml_unregister_component(comp->name);
+    }
+
+    /*The files of the blob won't be accessible anymore*/
+    load_index_entry_t ** entry_p = &index_head;
+    while(*entry_p) {
+        if((*entry_p)->load == load) {
+            *entry_p = (*entry_p)->next;
+            index_cnt--;
+        }
+        else {
+            entry_p = &(*entry_p)->next;
+        }
+    }
+    if(index_cnt == 0) index_clear();
+
     lv_fs_frogfs_unregister_blob(path_prefix);
 
+    if(load->fs) frogfs_deinit(load->fs);
     lv_free((void *) load->blob); /* it may be NULL */
+    lui_xml_arena_destroy(&load->arena);
     lv_ll_remove(&xml_loads, load);
     lv_free(load);
 }
+
+void lui_xml_load_get_arena_stats(const lui_xml_load_t * load, lui_xml_arena_stats_t * stats)
+{
+    lui_xml_arena_get_stats(&load->arena, stats);
+}
 #endif /*LV_USE_FS_FROGFS*/
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_result_t load_all_recursive(char * path_buf, const char * path)
+static lv_result_t load_all_recursive(char * path_buf, const char * path, load_list_t * list)
 {
     lv_result_t ret = LV_RESULT_OK;
     lv_fs_res_t fs_res;
@@ -216,10 +547,13 @@ static lv_result_t load_all_recursive(char * path_buf, const char * path)
         lv_fs_path_join(full_path, full_path_len + 1, path, path_buf);
 
         if(path_buf[0] == '/') {
-            ret = load_all_recursive(path_buf, full_path);
+            ret = load_all_recursive(path_buf, full_path, list);
+        }
+        else if(lv_streq(lv_fs_get_ext(full_path), "xml")) {
+            load_list_add(list, full_path);
         }
         else {
-            load_from_path(full_path);
+            LV_LOG_INFO("Did not use '%s' from XML pack.", full_path);
         }
 
         lv_free(full_path);
@@ -239,96 +573,427 @@ dir_close_out:
     return ret;
 }
 
-static void load_from_path(const char * path)
+static void load_list_add(load_list_t * list, const char * path)
 {
-    const char * ext = lv_fs_get_ext(path);
-
-    if(lv_streq(ext, "xml")) {
-        lv_fs_res_t fs_res;
-        lv_fs_file_t f;
-        fs_res = lv_fs_open(&f, path, LV_FS_MODE_RD);
-        if(fs_res != LV_FS_RES_OK) {
-            LV_LOG_WARN("Couldn't open %s", path);
+    if(list->job_cnt == list->job_cap) {
+        uint32_t new_cap = list->job_cap ? list->job_cap * 2 : 16;
+        load_job_t * new_jobs = lv_realloc(list->jobs, new_cap * sizeof(load_job_t));
+        LV_ASSERT_MALLOC(new_jobs);
+        if(new_jobs == NULL) {
+            LV_LOG_WARN("Couldn't add %s to the files to load", path);
             return;
         }
+        list->jobs = new_jobs;
+        list->job_cap = new_cap;
+    }
 
-        /* Determine file size */
-        lv_fs_seek(&f, 0, LV_FS_SEEK_END);
-        uint32_t file_size = 0;
-        lv_fs_tell(&f, &file_size);
-        lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
-
-        /* Create the buffer */
-        char * xml_buf = lv_malloc(file_size + 1);
-        if(xml_buf == NULL) {
-            LV_LOG_WARN("Memory allocation failed for file %s (%" LV_PRIu32 " bytes)", path, file_size + 1);
-            lv_fs_close(&f);
-            return;
-        }
+    const char * path_copy = lui_xml_arena_strdup(&list->arena, path);
+    if(path_copy == NULL) return;
 
-        /* Read the file content  */
-        uint32_t rn;
-        fs_res = lv_fs_read(&f, xml_buf, file_size, &rn);
-        if(fs_res != LV_FS_RES_OK || rn != file_size) {
-            LV_LOG_WARN("Couldn't read %s fully", path);
-            lv_free(xml_buf);
-            lv_fs_close(&f);
-            return;
+    load_job_t * job = &list->jobs[list->job_cnt];
+    lv_memzero(job, sizeof(load_job_t));
+    job->path = path_copy;
+    list->job_cnt++;
+}
+
+/**
+ * Sort the files by their paths. The directories are usually
+ * read in order already, so insertion sort is fast enough.
+ * @param list      the collected files
+ */
+static void load_list_sort(load_list_t * list)
+{
+    uint32_t i;
+    for(i = 1; i < list->job_cnt; i++) {
+        load_job_t job = list->jobs[i];
+        uint32_t j = i;
+        while(j > 0 && load_job_is_before(&job, &list->jobs[j - 1])) {
+            list->jobs[j] = list->jobs[j - 1];
+            j--;
         }
+        list->jobs[j] = job;
+    }
+}
 
-        lv_fs_close(&f);
+static bool load_job_is_before(const load_job_t * a, const load_job_t * b)
+{
+    /*The globals are registered first as the other components might use them*/
+    bool a_globals = lv_streq(lv_fs_get_last(a->path), "globals.xml");
+    bool b_globals = lv_streq(lv_fs_get_last(b->path), "globals.xml");
+    if(a_globals != b_globals) return a_globals;
 
-        /* Null-terminate the buffer */
-        xml_buf[rn] = '\0';
-
-        load_from_path_parser_data_t parser_data;
-
-        XML_Memory_Handling_Suite mem_handlers;
-        mem_handlers.malloc_fcn = lv_malloc;
-        mem_handlers.realloc_fcn = lv_realloc;
-        mem_handlers.free_fcn = lv_free;
-        XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
-        parser_data.parser = parser;
-        parser_data.type = LUI_XML_TYPE_UNKNOWN;
-        XML_SetUserData(parser, &parser_data);
-        XML_SetStartElementHandler(parser, load_from_path_start_element_handler);
-
-        /* Parse the XML */
-        enum XML_Status parser_res = XML_Parse(parser, xml_buf, file_size, XML_TRUE);
-        enum XML_Error parser_error = XML_GetErrorCode(parser);
-        if(parser_res == XML_STATUS_ERROR && parser_error != XML_ERROR_ABORTED) {
-            LV_LOG_WARN("XML parsing error: %s on line %lu", XML_ErrorString(parser_error),
-                        XML_GetCurrentLineNumber(parser));
-            XML_ParserFree(parser);
-            lv_free(xml_buf);
-            return;
-        }
-        XML_ParserFree(parser);
+    return lv_strcmp(a->path, b->path) < 0;
+}
 
-        switch(parser_data.type) {
+static void load_from_path(const char * path)
+{
+    LUI_XML_PROFILE_FILE_BEGIN(path);
+    register_file(path);
+    LUI_XML_PROFILE_FILE_END();
+}
+
+/**
+ * Register a component, screen, globals or translations file
+ * @param path      path to the file
+ */
+static void register_file(const char * path)
+{
+#if LUI_XML_USE_CACHE
+    /*Not the files of a blob as the components registered from the cache couldn't be unloaded with it*/
+#if LV_USE_FS_FROGFS
+    if(load_act == NULL && lui_xml_cache_load_file(path) == LV_RESULT_OK) return;
+#else
+    if(lui_xml_cache_load_file(path) == LV_RESULT_OK) return;
+#endif
+#endif
+
+#if LV_USE_FS_FROGFS
+    /*Use the data directly in the blob if possible*/
+    uint32_t xml_size = 0;
+    const char * xml_buf = load_act ? load_access_in_place(load_act, path, &xml_size) : NULL;
+    if(xml_buf) {
+        switch(sniff_xml_type(xml_buf, xml_size)) {
             case LUI_XML_TYPE_COMPONENT: {
+                    /*The data is in the blob so the component can reference it until it's unloaded*/
                     char * component_name = path_filename_without_extension(path);
-                    lui_xml_register_component_from_data(component_name, xml_buf);
+                    lv_result_t res = lui_xml_component_register_from_buf(component_name, xml_buf, xml_size, true);
+                    if(res == LV_RESULT_OK) load_add_component(load_act, component_name);
                     lv_free(component_name);
-                    break;
+                    return;
                 }
             case LUI_XML_TYPE_TRANSLATIONS:
-#if LV_USE_TRANSLATION
-                lui_xml_register_translation_from_data(xml_buf);
-#else
-                LV_LOG_WARN("Translation XML found but translations not enabled");
-#endif
+                /*Parsed below from the file*/
                 break;
             default:
-                LV_LOG_WARN("Unknown XML type found in pack");
-                break;
+                LV_LOG_WARN("Unknown XML type found in pack: %s", path);
+                return;
         }
+    }
+#endif
 
-        lv_free(xml_buf);
+    /*The first chunk is read when opening the file. It's used both
+     *to find out the type and as the first chunk of the registration.*/
+    lui_xml_stream_t stream;
+    if(lui_xml_stream_open(&stream, path) != LV_RESULT_OK) return;
+
+    lui_xml_type_t type = sniff_xml_type(stream.buf, stream.buf_len);
+    /*The root element can be beyond the first chunk, e.g. after a long license comment*/
+    if(type == LUI_XML_TYPE_UNKNOWN && stream.buf_len == LUI_XML_STREAM_BUF_SIZE) type = sniff_file_parse(path);
+
+    switch(type) {
+        case LUI_XML_TYPE_COMPONENT: {
+                char * component_name = path_filename_without_extension(path);
+                lv_result_t res = lui_xml_component_register_from_stream(component_name, &stream);
+#if LV_USE_FS_FROGFS
+                if(res == LV_RESULT_OK && load_act) load_add_component(load_act, component_name);
+#else
+                LV_UNUSED(res);
+#endif
+                lv_free(component_name);
+                break;
+            }
+        case LUI_XML_TYPE_TRANSLATIONS:
+#if LV_USE_TRANSLATION
+            lui_xml_translation_register_from_stream(&stream);
+#else
+            LV_LOG_WARN("Translation XML found but translations not enabled");
+#endif
+            break;
+        default:
+            LV_LOG_WARN("Unknown XML type found in pack: %s", path);
+            break;
+    }
+
+    lui_xml_stream_close(&stream);
+}
+
+/**
+ * Index a file of a lazy load. Everything but the components are registered right away.
+ * @param path          path to the file
+ * @param asset_path    the default asset path to use when the file is registered
+ */
+static void load_lazy(const char * path, const char * asset_path)
+{
+    /*The globals are merged into the global scope, they can't be looked up by name*/
+    if(lv_streq(lv_fs_get_last(path), "globals.xml") || sniff_file(path) != LUI_XML_TYPE_COMPONENT) {
+        load_from_path(path);
+        return;
+    }
+
+    char * name = path_filename_without_extension(path);
+
+    /*A file indexed earlier with the same name would be replaced by this one*/
+    index_take(name);
+
+    /*Replace an already registered component right away as eager loading would*/
+    if(lui_xml_component_find_scope(name)) {
+        lv_free(name);
+        load_from_path(path);
+        return;
+    }
+
+    load_index_entry_t * entry = lui_xml_arena_alloc(&index_arena, sizeof(load_index_entry_t));
+    LV_ASSERT_MALLOC(entry);
+    if(entry) {
+        entry->name = lui_xml_arena_strdup(&index_arena, name);
+        entry->path = lui_xml_arena_strdup(&index_arena, path);
+        entry->asset_path = asset_path;
+#if LV_USE_FS_FROGFS
+        entry->load = load_act;
+#endif
+    }
+
+    if(entry == NULL || entry->name == NULL || entry->path == NULL) {
+        LV_LOG_WARN("Couldn't index %s, registering it now", path);
+        load_from_path(path);
     }
     else {
-        LV_LOG_INFO("Did not use '%s' from XML pack.", path);
+        entry->next = index_head;
+        index_head = entry;
+        index_cnt++;
+    }
+
+    lv_free(name);
+}
+
+/**
+ * Find out the type of a file from its beginning
+ * @param path      path to the file
+ * @return          the type of the file, `LUI_XML_TYPE_UNKNOWN` if it couldn't be found out
+ */
+static lui_xml_type_t sniff_file(const char * path)
+{
+#if LV_USE_FS_FROGFS
+    uint32_t xml_size = 0;
+    const char * xml_buf = load_act ? load_access_in_place(load_act, path, &xml_size) : NULL;
+    if(xml_buf) return sniff_xml_type(xml_buf, xml_size);
+#endif
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return LUI_XML_TYPE_UNKNOWN;
+
+    char buf[LUI_XML_LOAD_SNIFF_SIZE];
+    uint32_t rn = 0;
+    lv_fs_res_t res = lv_fs_read(&f, buf, sizeof(buf), &rn);
+    lv_fs_close(&f);
+    if(res != LV_FS_RES_OK) return LUI_XML_TYPE_UNKNOWN;
+
+    lui_xml_type_t type = sniff_xml_type(buf, rn);
+    /*The root element can be beyond the beginning, e.g. after a long license comment*/
+    if(type == LUI_XML_TYPE_UNKNOWN && rn == sizeof(buf)) type = sniff_file_parse(path);
+
+    return type;
+}
+
+/**
+ * Find out the type of a file by parsing it chunk by chunk until its root element.
+ * Slower than `sniff_xml_type()` but the root element can be anywhere in the file.
+ * @param path      path to the file
+ * @return          the type of the file, `LUI_XML_TYPE_UNKNOWN` if it couldn't be found out
+ */
+static lui_xml_type_t sniff_file_parse(const char * path)
+{
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return LUI_XML_TYPE_UNKNOWN;
+
+    XML_Memory_Handling_Suite mem_handlers;
+    mem_handlers.malloc_fcn = lv_malloc;
+    mem_handlers.realloc_fcn = lv_realloc;
+    mem_handlers.free_fcn = lv_free;
+    sniff_ctx_t ctx;
+    ctx.parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+    ctx.type = LUI_XML_TYPE_UNKNOWN;
+    if(ctx.parser == NULL) {
+        lv_fs_close(&f);
+        return LUI_XML_TYPE_UNKNOWN;
+    }
+
+    XML_SetUserData(ctx.parser, &ctx);
+    XML_SetStartElementHandler(ctx.parser, sniff_start_element_cb);
+
+    char buf[LUI_XML_LOAD_SNIFF_SIZE];
+    while(1) {
+        uint32_t rn = 0;
+        if(lv_fs_read(&f, buf, sizeof(buf), &rn) != LV_FS_RES_OK) break;
+
+        /*Returns with an error after the root element too as the parser is stopped there*/
+        bool is_final = rn == 0;
+        if(XML_Parse(ctx.parser, buf, (int)rn, is_final) == XML_STATUS_ERROR || is_final) break;
     }
+
+    XML_ParserFree(ctx.parser);
+    lv_fs_close(&f);
+
+    return ctx.type;
+}
+
+static void sniff_start_element_cb(void * user_data, const char * name, const char ** attrs)
+{
+    LV_UNUSED(attrs);
+    sniff_ctx_t * ctx = user_data;
+    ctx->type = get_type_of_root(name);
+    XML_StopParser(ctx->parser, XML_FALSE);
+}
+
+/**
+ * Remove an entry from the index of the lazy loads.
+ * The memory of the entry is kept until the index gets empty.
+ * @param name      name of the component
+ * @return          the entry or NULL if not indexed
+ */
+static load_index_entry_t * index_take(const char * name)
+{
+    load_index_entry_t ** entry_p;
+    for(entry_p = &index_head; *entry_p; entry_p = &(*entry_p)->next) {
+        load_index_entry_t * entry = *entry_p;
+        if(lv_streq(entry->name, name)) {
+            *entry_p = entry->next;
+            index_cnt--;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Register an entry taken from the index, the same way as if it was loaded eagerly
+ * @param entry     an entry returned by `index_take()`
+ * @return          LV_RESULT_OK: registered, LV_RESULT_INVALID: otherwise
+ */
+static lv_result_t index_register(load_index_entry_t * entry)
+{
+    /*The fonts and images of the component are relative to the path it was loaded from*/
+    char * asset_path_prev = lv_strdup(LV_GLOBAL_DEFAULT()->xml_path_prefix);
+    lui_xml_set_default_asset_path(entry->asset_path);
+
+#if LV_USE_FS_FROGFS
+    lui_xml_load_t * load_prev = load_act;
+    load_act = entry->load;
+#endif
+
+    load_from_path(entry->path);
+
+#if LV_USE_FS_FROGFS
+    load_act = load_prev;
+#endif
+
+    lui_xml_set_default_asset_path(asset_path_prev);
+    lv_free(asset_path_prev);
+
+    lv_result_t res = lui_xml_component_find_scope(entry->name) ? LV_RESULT_OK : LV_RESULT_INVALID;
+
+    /*The strings of the entry are not needed anymore*/
+    if(index_cnt == 0) index_clear();
+
+    return res;
+}
+
+static void index_clear(void)
+{
+    index_head = NULL;
+    index_cnt = 0;
+    lui_xml_arena_destroy(&index_arena);
+    lui_xml_arena_init(&index_arena, 0);
+}
+
+/**
+ * Find out the type of an XML file from the name of its root element without
+ * running a parser. The XML declaration, processing instructions, comments and
+ * the DOCTYPE are skipped.
+ * @param buf       the content of the file or its beginning
+ * @param len       length of `buf`
+ * @return          the type of the XML, `LUI_XML_TYPE_UNKNOWN` if the root element is not in `buf`
+ */
+static lui_xml_type_t sniff_xml_type(const char * buf, uint32_t len)
+{
+    const char * p = buf;
+    const char * end = buf + len;
+
+    /*Skip the UTF-8 BOM*/
+    if(starts_with(p, end, "\xEF\xBB\xBF")) p += 3;
+
+    while(p && p < end) {
+        if(*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            p++;
+        }
+        else if(*p != '<') {
+            return LUI_XML_TYPE_UNKNOWN;
+        }
+        else if(starts_with(p, end, "<?")) {
+            p = skip_past(p + 2, end, "?>");
+        }
+        else if(starts_with(p, end, "<!--")) {
+            p = skip_past(p + 4, end, "-->");
+        }
+        else if(starts_with(p, end, "<!")) {
+            p = skip_doctype(p + 2, end);
+        }
+        else {
+            /*The root element. The longest known name is "translations"*/
+            char name[16];
+            uint32_t name_len = 0;
+            p++;
+            while(p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' && *p != '>' && *p != '/') {
+                if(name_len == sizeof(name) - 1) return LUI_XML_TYPE_UNKNOWN;
+                name[name_len++] = *p;
+                p++;
+            }
+            /*The name might continue in the next chunk*/
+            if(p == end) return LUI_XML_TYPE_UNKNOWN;
+
+            name[name_len] = '\0';
+            return get_type_of_root(name);
+        }
+    }
+
+    return LUI_XML_TYPE_UNKNOWN;
+}
+
+/**
+ * Find a token and step over it
+ * @param buf       the buffer to search in
+ * @param end       end of the buffer
+ * @param token     the token to find
+ * @return          pointer after the token or NULL if not found
+ */
+static const char * skip_past(const char * buf, const char * end, const char * token)
+{
+    for(; buf < end; buf++) {
+        if(starts_with(buf, end, token)) return buf + lv_strlen(token);
+    }
+
+    return NULL;
+}
+
+/**
+ * Step over a `<!DOCTYPE ...>` including its internal subset, e.g. `[<!ENTITY ...>]`
+ * @param buf       pointer after `<!`
+ * @param end       end of the buffer
+ * @return          pointer after the closing `>` or NULL if not found
+ */
+static const char * skip_doctype(const char * buf, const char * end)
+{
+    int32_t depth = 0;
+    char quote = '\0';
+    for(; buf < end; buf++) {
+        if(quote) {
+            if(*buf == quote) quote = '\0';
+        }
+        else if(*buf == '"' || *buf == '\'') quote = *buf;
+        else if(*buf == '[') depth++;
+        else if(*buf == ']') depth--;
+        else if(*buf == '>' && depth <= 0) return buf + 1;
+    }
+
+    return NULL;
+}
+
+static bool starts_with(const char * buf, const char * end, const char * token)
+{
+    size_t token_len = lv_strlen(token);
+    if((size_t)(end - buf) < token_len) return false;
+    return lv_memcmp(buf, token, token_len) == 0;
 }
 
 static char * path_filename_without_extension(const char * path)
@@ -343,19 +1008,399 @@ static char * path_filename_without_extension(const char * path)
     return filename;
 }
 
-static void load_from_path_start_element_handler(void * user_data, const char * name, const char ** attrs)
+static lui_xml_type_t get_type_of_root(const char * name)
 {
-    LV_UNUSED(attrs);
-    load_from_path_parser_data_t * data = user_data;
-
     if(lv_streq(name, "component") || lv_streq(name, "screen") || lv_streq(name, "globals")) {
-        data->type = LUI_XML_TYPE_COMPONENT;
+        return LUI_XML_TYPE_COMPONENT;
     }
     else if(lv_streq(name, "translations")) {
-        data->type = LUI_XML_TYPE_TRANSLATIONS;
+        return LUI_XML_TYPE_TRANSLATIONS;
+    }
+
+    return LUI_XML_TYPE_UNKNOWN;
+}
+
+/**
+ * Tokenize all the files and register them so that the components come after their dependencies
+ * @param list      the sorted list of files
+ * @return          LV_RESULT_OK: registered, LV_RESULT_INVALID: there were dependency cycles
+ */
+static lv_result_t load_ordered(load_list_t * list)
+{
+    if(list->job_cnt == 0) return LV_RESULT_OK;
+
+    char ** names = lv_zalloc(list->job_cnt * sizeof(char *));
+    const lui_xml_doc_t ** docs = lv_zalloc(list->job_cnt * sizeof(lui_xml_doc_t *));
+    uint32_t * order = lv_malloc(list->job_cnt * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(names);
+    LV_ASSERT_MALLOC(docs);
+    LV_ASSERT_MALLOC(order);
+    if(names == NULL || docs == NULL || order == NULL) {
+        lv_free(names);
+        lv_free(docs);
+        lv_free(order);
+        return LV_RESULT_INVALID;
+    }
+
+#if LV_USE_OS != LV_OS_NONE
+    if(load_thread_cnt > 1 && list->job_cnt > 1 && !profile_is_active()) {
+        load_parallel(list, load_thread_cnt, false);
+    }
+    else
+#endif
+    {
+        uint32_t i;
+        for(i = 0; i < list->job_cnt; i++) {
+            load_job_tokenize(&list->jobs[i]);
+        }
+    }
+
+    uint32_t i;
+    for(i = 0; i < list->job_cnt; i++) {
+        load_job_t * job = &list->jobs[i];
+        docs[i] = &job->doc;
+        if(job->doc.error || job->doc.root == NULL) continue;
+        if(get_type_of_root(job->doc.root) != LUI_XML_TYPE_COMPONENT) continue;
+
+        /*The globals are merged into the global scope, they can't be referenced by name*/
+        if(lv_streq(lv_fs_get_last(job->path), "globals.xml")) continue;
+        names[i] = path_filename_without_extension(job->path);
+    }
+
+    uint32_t cycle_cnt = lui_xml_deps_sort((const char * const *)names, docs, list->job_cnt, order);
+
+    for(i = 0; i < list->job_cnt; i++) {
+        load_job_commit(&list->jobs[order[i]]);
+    }
+
+    for(i = 0; i < list->job_cnt; i++) {
+        lui_xml_doc_destroy(&list->jobs[i].doc);
+        lv_free(names[i]);
+    }
+
+    lv_free(names);
+    lv_free(docs);
+    lv_free(order);
+
+    if(cycle_cnt) {
+        LV_LOG_WARN("%" LV_PRIu32 " dependency cycles found", cycle_cnt);
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+#if LV_USE_OS != LV_OS_NONE
+/**
+ * Tokenize the files on multiple threads batch by batch
+ * and register them on the calling thread in the order of the list.
+ * @param list          the sorted list of files
+ * @param thread_cnt    number of threads including the calling thread
+ * @param commit        false: tokenize all the files in one batch but don't register them
+ */
+static void load_parallel(load_list_t * list, uint32_t thread_cnt, bool commit)
+{
+    load_pool_t pool;
+    lv_memzero(&pool, sizeof(pool));
+    pool.list = list;
+    lv_mutex_init(&pool.lock);
+    lv_thread_sync_init(&pool.done_sync);
+
+    pool.workers = lv_zalloc((thread_cnt - 1) * sizeof(load_worker_t));
+    LV_ASSERT_MALLOC(pool.workers);
+
+    uint32_t i;
+    for(i = 0; pool.workers && i < thread_cnt - 1; i++) {
+        load_worker_t * worker = &pool.workers[i];
+        worker->pool = &pool;
+        lv_thread_sync_init(&worker->sync);
+        lv_result_t res = lv_thread_init(&worker->thread, "lui_xml_load", LV_THREAD_PRIO_MID, load_worker_cb,
+                                         LUI_XML_LOAD_THREAD_STACK_SIZE, worker);
+        if(res != LV_RESULT_OK) {
+            LV_LOG_WARN("Couldn't create a loader thread, continuing with %" LV_PRIu32 " threads", i + 1);
+            lv_thread_sync_delete(&worker->sync);
+            break;
+        }
+        pool.worker_cnt++;
+    }
+
+    uint32_t batch_size = commit ? LUI_XML_LOAD_BATCH_SIZE : list->job_cnt;
+    uint32_t batch_start;
+    for(batch_start = 0; batch_start < list->job_cnt; batch_start += batch_size) {
+        uint32_t batch_end = LV_MIN(batch_start + batch_size, list->job_cnt);
+
+        /*The file system is not thread-safe so only the parsing is left for the threads*/
+        for(i = batch_start; i < batch_end; i++) {
+            load_job_read(&list->jobs[i]);
+        }
+
+        lv_mutex_lock(&pool.lock);
+        pool.next_job = batch_start;
+        pool.batch_end = batch_end;
+        pool.done_cnt = 0;
+        lv_mutex_unlock(&pool.lock);
+
+        for(i = 0; i < pool.worker_cnt; i++) {
+            lv_thread_sync_signal(&pool.workers[i].sync);
+        }
+
+        /*Help the workers and wait for the rest of the batch*/
+        load_pool_work(&pool);
+
+        lv_mutex_lock(&pool.lock);
+        while(pool.done_cnt < batch_end - batch_start) {
+            lv_mutex_unlock(&pool.lock);
+            lv_thread_sync_wait(&pool.done_sync);
+            lv_mutex_lock(&pool.lock);
+        }
+        lv_mutex_unlock(&pool.lock);
+
+        /*Only this thread touches the registry*/
+        for(i = batch_start; commit && i < batch_end; i++) {
+            load_job_commit(&list->jobs[i]);
+            lui_xml_doc_destroy(&list->jobs[i].doc);
+        }
+    }
+
+    lv_mutex_lock(&pool.lock);
+    pool.exit = true;
+    lv_mutex_unlock(&pool.lock);
+
+    for(i = 0; i < pool.worker_cnt; i++) {
+        lv_thread_sync_signal(&pool.workers[i].sync);
+        lv_thread_delete(&pool.workers[i].thread);
+        lv_thread_sync_delete(&pool.workers[i].sync);
+    }
+
+    lv_free(pool.workers);
+    lv_thread_sync_delete(&pool.done_sync);
+    lv_mutex_delete(&pool.lock);
+}
+
+/**
+ * Tokenize the jobs of the current batch until there are no more left
+ * @param pool      the loader pool
+ */
+static void load_pool_work(load_pool_t * pool)
+{
+    while(1) {
+        lv_mutex_lock(&pool->lock);
+        if(pool->next_job >= pool->batch_end) {
+            lv_mutex_unlock(&pool->lock);
+            return;
+        }
+        uint32_t job_index = pool->next_job;
+        pool->next_job++;
+        lv_mutex_unlock(&pool->lock);
+
+        load_job_tokenize(&pool->list->jobs[job_index]);
+
+        lv_mutex_lock(&pool->lock);
+        pool->done_cnt++;
+        lv_mutex_unlock(&pool->lock);
+        lv_thread_sync_signal(&pool->done_sync);
     }
+}
+
+static void load_worker_cb(void * user_data)
+{
+    load_worker_t * worker = user_data;
+    load_pool_t * pool = worker->pool;
 
-    XML_StopParser(data->parser, XML_FALSE);
+    while(1) {
+        lv_thread_sync_wait(&worker->sync);
+
+        lv_mutex_lock(&pool->lock);
+        bool do_exit = pool->exit;
+        lv_mutex_unlock(&pool->lock);
+        if(do_exit) break;
+
+        load_pool_work(pool);
+    }
 }
 
+/**
+ * Read a file to a buffer, or find it in the blob, to tokenize it on a loader thread
+ * @param job       the file to read
+ */
+static void load_job_read(load_job_t * job)
+{
+#if LV_USE_FS_FROGFS
+    if(load_act) {
+        job->xml_buf = load_access_in_place(load_act, job->path, &job->xml_size);
+        job->xml_static = job->xml_buf != NULL;
+        if(job->xml_buf) return;
+    }
+#endif
+
+    uint32_t xml_size;
+    if(lv_fs_path_get_size(job->path, &xml_size) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't read %s", job->path);
+        job->read_error = true;
+        return;
+    }
+
+    char * xml_buf = lv_malloc(xml_size + 1);
+    LV_ASSERT_MALLOC(xml_buf);
+    if(xml_buf == NULL) {
+        LV_LOG_WARN("Memory allocation failed for reading %s", job->path);
+        job->read_error = true;
+        return;
+    }
+
+    if(lv_fs_load_to_buf(xml_buf, xml_size, job->path) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't read %s", job->path);
+        lv_free(xml_buf);
+        job->read_error = true;
+        return;
+    }
+
+    job->xml_buf = xml_buf;
+    job->xml_size = xml_size;
+}
+
+#endif /*LV_USE_OS != LV_OS_NONE*/
+
+/**
+ * Read and tokenize a file. If the file was already read by `load_job_read()`
+ * only the buffer is tokenized, which can be done on any thread.
+ * @param job       the file to tokenize
+ */
+static void load_job_tokenize(load_job_t * job)
+{
+    lui_xml_doc_init(&job->doc);
+
+    if(job->read_error) {
+        job->doc.error = 1;
+        return;
+    }
+
+    if(job->xml_buf) {
+        lui_xml_doc_tokenize(&job->doc, job->xml_buf, job->xml_size, job->xml_static);
+        if(!job->xml_static) lv_free((void *)job->xml_buf);
+        job->xml_buf = NULL;
+        return;
+    }
+
+    LUI_XML_PROFILE_FILE_BEGIN(job->path);
+
+    const char * xml_buf = NULL;
+    uint32_t xml_size = 0;
+
+#if LV_USE_FS_FROGFS
+    /*Use the data directly in the blob if possible*/
+    if(load_act) xml_buf = load_access_in_place(load_act, job->path, &xml_size);
+#endif
+
+    if(xml_buf) {
+        lui_xml_doc_tokenize(&job->doc, xml_buf, xml_size, true);
+    }
+    else {
+        /*Stream the file so that the memory usage doesn't depend on the size of the files on the threads*/
+        lui_xml_doc_tokenize_file(&job->doc, job->path);
+    }
+
+    LUI_XML_PROFILE_FILE_END();
+}
+
+/**
+ * Register a tokenized file
+ * @param job       a tokenized file
+ */
+static void load_job_commit(load_job_t * job)
+{
+    /*Syntax errors of buffers are logged here as the buffer might have been tokenized on another thread.
+     *The other reasons were already logged.*/
+    if(job->doc.error) {
+        if(job->doc.error_msg) {
+            LV_LOG_WARN("XML parsing error: %s on line %" LV_PRIu32 " in %s", job->doc.error_msg, job->doc.error_line,
+                        job->path);
+        }
+        return;
+    }
+
+    LUI_XML_PROFILE_FILE_BEGIN(job->path);
+    lui_xml_type_t type = job->doc.root ? get_type_of_root(job->doc.root) : LUI_XML_TYPE_UNKNOWN;
+    switch(type) {
+        case LUI_XML_TYPE_COMPONENT: {
+                char * component_name = path_filename_without_extension(job->path);
+                lv_result_t res = lui_xml_component_register_from_doc(component_name, &job->doc);
+#if LV_USE_FS_FROGFS
+                if(res == LV_RESULT_OK && load_act) load_add_component(load_act, component_name);
+#else
+                LV_UNUSED(res);
+#endif
+                lv_free(component_name);
+                break;
+            }
+        case LUI_XML_TYPE_TRANSLATIONS:
+#if LV_USE_TRANSLATION
+            lui_xml_translation_register_from_doc(&job->doc);
+#else
+            LV_LOG_WARN("Translation XML found but translations not enabled");
+#endif
+            break;
+        default:
+            LV_LOG_WARN("Unknown XML type found in pack");
+            break;
+    }
+    LUI_XML_PROFILE_FILE_END();
+}
+
+#if LV_USE_FS_FROGFS
+static void load_add_component(lui_xml_load_t * load, const char * name)
+{
+    /*The globals are merged into the global scope and can't be unregistered*/
+    if(lv_streq(name, "globals")) return;
+
+    lui_xml_component_scope_t * scope = lui_xml_component_find_scope(name);
+    if(scope) scope->load = load;
+
+    lui_xml_load_component_t * comp = lui_xml_arena_alloc(&load->arena, sizeof(lui_xml_load_component_t));
+    LV_ASSERT_MALLOC(comp);
+    if(comp == NULL) return;
+
+    comp->name = lui_xml_arena_strdup(&load->arena, name);
+    comp->next = load->components;
+    load->components = comp;
+}
+
+/**
+ * Get a pointer to the content of a file in the blob of a load.
+ * @param load      the load which is being processed
+ * @param path      lv_fs path of the file, e.g. "F:__LUI_XML_0x1234/buttons/button.xml"
+ * @param size      store the size of the file here
+ * @return          pointer into the blob or NULL if the file is compressed or not found
+ */
+static const char * load_access_in_place(lui_xml_load_t * load, const char * path, uint32_t * size)
+{
+    if(load->fs == NULL) return NULL;
+
+    char path_prefix[PATH_PREFIX_BUF_SIZE];
+    lv_snprintf(path_prefix, sizeof(path_prefix), "%c:"PATH_PREFIX_FMT, LV_FS_FROGFS_LETTER, load);
+    size_t prefix_len = lv_strlen(path_prefix);
+    if(lv_strlen(path) < prefix_len || lv_memcmp(path, path_prefix, prefix_len) != 0) return NULL;
+
+    const char * entry_path = path + prefix_len;
+    while(entry_path[0] == '/') entry_path++;
+
+    const frogfs_entry_t * entry = frogfs_get_entry(load->fs, entry_path);
+    if(entry == NULL) return NULL;
+
+    frogfs_stat_t st;
+    frogfs_stat(load->fs, entry, &st);
+    if(st.type != FROGFS_ENTRY_TYPE_FILE || st.compression != FROGFS_COMP_ALGO_NONE) return NULL;
+
+    frogfs_fh_t * fh = frogfs_open(load->fs, entry, 0);
+    if(fh == NULL) return NULL;
+
+    const void * data = NULL;
+    size_t data_size = frogfs_access(fh, &data);
+    frogfs_close(fh);
+
+    *size = data_size;
+    return data;
+}
+#endif
+
 #endif /*LV_USE_XML*/
@@ -17,10 +17,48 @@ extern "C" {
 #include "../misc/lv_types.h"
 #if LV_USE_XML
 
+#include "lui_xml_arena.h"
+
 /*********************
  *      DEFINES
  *********************/
 
+/** Default number of threads used to tokenize the files when loading a directory.
+ *  1 means the files are parsed one by one on the calling thread.*/
+#ifndef LUI_XML_LOAD_THREAD_CNT
+#define LUI_XML_LOAD_THREAD_CNT 1
+#endif
+
+/** Number of files tokenized in parallel before registering them*/
+#ifndef LUI_XML_LOAD_BATCH_SIZE
+#define LUI_XML_LOAD_BATCH_SIZE 32
+#endif
+
+#ifndef LUI_XML_LOAD_THREAD_STACK_SIZE
+#define LUI_XML_LOAD_THREAD_STACK_SIZE (16 * 1024)
+#endif
+
+/** 1: only index the components when loading a directory and register them on first use*/
+#ifndef LUI_XML_LOAD_LAZY
+#define LUI_XML_LOAD_LAZY 0
+#endif
+
+/** 1: register the components of a directory after the components they depend on*/
+#ifndef LUI_XML_LOAD_DEP_ORDER
+#define LUI_XML_LOAD_DEP_ORDER 0
+#endif
+
+/** 1: store only the paths of the font files while registering and create the fonts on first use*/
+#ifndef LUI_XML_LOAD_LAZY_FONTS
+#define LUI_XML_LOAD_LAZY_FONTS 0
+#endif
+
+/** Number of bytes read from the beginning of a file to find its type when indexing it.
+ *  If the root element is not in them the file is parsed until the root element.*/
+#ifndef LUI_XML_LOAD_SNIFF_SIZE
+#define LUI_XML_LOAD_SNIFF_SIZE 256
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -32,12 +70,72 @@ extern "C" {
 /**
  * Recurse into a directory, loading all XML components,
  * screens, globals, and translations.
+ * The files are registered in the order of their paths, `globals.xml` files first.
  * @param path   the path to a directory to load files from
  * @return       `LV_RESULT_OK` if there were no issues or
  *               `LV_RESULT_INVALID` otherwise.
  */
 lv_result_t lui_xml_load_all_from_path(const char * path);
 
+/**
+ * Set how many threads to use to read and tokenize the files when loading a directory.
+ * The registration always happens on the calling thread in a deterministic order.
+ * Requires `LV_USE_OS`, without it the files are always loaded one by one.
+ * @param thread_cnt    number of threads including the calling thread, 0 or 1 to disable
+ */
+void lui_xml_load_set_thread_count(uint32_t thread_cnt);
+
+/**
+ * Enable or disable lazy loading. In lazy mode loading a directory registers only
+ * `globals.xml` and the translations. The components and screens are just indexed
+ * by name and registered when they are used the first time,
+ * e.g. by `lui_xml_create()` or `lui_xml_component_get_scope()`.
+ * @param en        true: index the components, false: register them right away
+ */
+void lui_xml_load_set_lazy(bool en);
+
+/**
+ * Enable or disable registering the components in dependency order when loading a directory.
+ * In this mode all the files are tokenized first (on multiple threads if enabled)
+ * and every component is registered after the components it extends, uses in its view
+ * or whose styles it references. Dependency cycles are logged and make loading fail.
+ * All the files are kept in RAM until they are registered.
+ * @param en        true: register in dependency order, false: in the order of the paths
+ */
+void lui_xml_load_set_dep_order(bool en);
+
+/**
+ * Register an indexed component or screen now, so it's not parsed when it's used
+ * the first time. Useful for latency critical screens.
+ * @param name      name of the component, or NULL to register all the indexed components
+ * @return          LV_RESULT_OK: the component is registered, LV_RESULT_INVALID: it's not found
+ *                  or couldn't be registered
+ */
+lv_result_t lui_xml_load_component(const char * name);
+
+/**
+ * Get the number of components which are indexed but not registered yet
+ * @return          the number of indexed components
+ */
+uint32_t lui_xml_load_get_indexed_count(void);
+
+/**
+ * Enable or disable creating the fonts lazily. In lazy mode registering a `<tiny_ttf>`
+ * or `<bin>` font only stores its path, and the font is created when it's used the first
+ * time, e.g. by a style or `lui_xml_get_font()`. Therefore the font files need to stay
+ * accessible after loading.
+ * @param en        true: create the fonts on first use, false: create them while registering
+ */
+void lui_xml_load_set_lazy_fonts(bool en);
+
+/**
+ * Create the lazily loaded fonts which are not used yet, e.g. a few at a time from a timer
+ * while the UI is idle, so that they are not created when a screen is opened.
+ * @param max_cnt   create at most this many fonts, 0 to create all
+ * @return          number of fonts which are still not created
+ */
+uint32_t lui_xml_load_pending_fonts(uint32_t max_cnt);
+
 #if LV_USE_FS_FROGFS
 /**
  * Mount a data blob and recurse through it, loading all XML components,
@@ -58,10 +156,18 @@ lui_xml_load_t * lui_xml_load_all_from_file(const char * file_path);
 
 /**
  * Unload XML data that was loaded by a function that returned `lui_xml_load_t *`.
+ * The components and screens registered from the data are unregistered too.
  * Any assets in the loaded data will not be accessible anymore.
  * @param load       a loaded XML data handle, or `NULL` to unload all.
  */
 void lui_xml_unload(lui_xml_load_t * load);
+
+/**
+ * Get how much memory the bookkeeping of a loaded XML data blob uses.
+ * @param load      a loaded XML data handle
+ * @param stats     store the result here
+ */
+void lui_xml_load_get_arena_stats(const lui_xml_load_t * load, lui_xml_arena_stats_t * stats);
 #endif /*LV_USE_FS_FROGFS*/
 
 /**********************
@@ -25,6 +25,8 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef void (*lui_xml_load_file_cb_t)(const char * path, void * user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -33,6 +35,70 @@ void lui_xml_load_init(void);
 
 void lui_xml_load_deinit(void);
 
+/**
+ * Call a function for each XML file of a directory tree in the order
+ * `lui_xml_load_all_from_path()` registers them
+ * @param path          the path to a directory
+ * @param cb            called with the path of each XML file
+ * @param user_data     passed to `cb`
+ * @return              LV_RESULT_OK: the directories could be read, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_load_for_each_file(const char * path, lui_xml_load_file_cb_t cb, void * user_data);
+
+/**
+ * Register a single file of a directory as `lui_xml_load_all_from_path()` would
+ * @param path      path to the file
+ */
+void lui_xml_load_file(const char * path);
+
+/**
+ * Find out from its beginning if a file defines a component or screen
+ * @param path      path to the file
+ * @return          true: it's a component or screen, false: it's something else or it couldn't be read
+ */
+bool lui_xml_load_file_is_component(const char * path);
+
+/**
+ * Set the default asset path to a directory as `lui_xml_load_all_from_path()` does
+ * @param path      path to the directory
+ */
+void lui_xml_load_set_asset_path_to_dir(const char * path);
+
+/**
+ * Register a component indexed by a lazy load. It's removed from the index
+ * even if the registration fails.
+ * @param name      name of the component
+ * @return          LV_RESULT_OK: registered, LV_RESULT_INVALID: not indexed or couldn't be registered
+ */
+lv_result_t lui_xml_load_register_indexed(const char * name);
+
+/**
+ * Remove a component from the index of the lazy loads without registering it
+ * @param name      name of the component
+ * @return          LV_RESULT_OK: removed, LV_RESULT_INVALID: it wasn't indexed
+ */
+lv_result_t lui_xml_load_remove_indexed(const char * name);
+
+/**
+ * Check if a component is indexed by a lazy load and not registered yet
+ * @param name      name of the component
+ * @return          true: it's indexed
+ */
+bool lui_xml_load_is_indexed(const char * name);
+
+/**
+ * Check if the fonts are created on first use
+ * @return          true: only the paths of the fonts are stored while registering
+ */
+bool lui_xml_load_get_lazy_fonts(void);
+
+/**
+ * Get the name under which a file is registered as a component
+ * @param path      path to an XML file
+ * @return          the file name without extension (free with `lv_free()`)
+ */
+char * lui_xml_load_get_component_name(const char * path);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,166 @@
+/**
+ * @file lui_xml_memory.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_memory_private.h"
+#if LV_USE_XML
+
+#include "lui_xml_private.h"
+#include "lui_xml_component_private.h"
+#include "lui_xml_load_private.h"
+#include "../core/lv_obj_private.h"
+#include "../core/lv_obj_class_private.h"
+#include "../misc/lv_event_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Linked list nodes store the next and prev pointers after the data*/
+#define LL_NODE_META_SIZE   (2 * sizeof(void *))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static size_t ll_size(const lv_ll_t * ll);
+static size_t style_props_size(const lv_style_t * style);
+#if LUI_XML_USE_INSTANCE_STATS
+    static void count_obj(lv_obj_t * obj, size_t * obj_size, size_t * style_size);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lui_xml_get_memory_stats(const char * name, lui_xml_memory_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lui_xml_memory_stats_t));
+
+    /*Don't register the components which are only indexed by a lazy load*/
+    lui_xml_component_scope_t * scope = lui_xml_component_find_scope(name);
+    if(scope == NULL) {
+        if(lui_xml_load_is_indexed(name)) LV_LOG_WARN("`%s` is not registered yet, it's only indexed", name);
+        else LV_LOG_WARN("No component found with name `%s`", name);
+        return LV_RESULT_INVALID;
+    }
+
+    /*The scope itself is a node of the component list*/
+    size_t size = sizeof(lui_xml_component_scope_t) + LL_NODE_META_SIZE;
+    size += scope->arena.used_size;
+    size += ll_size(&scope->style_ll);
+    size += ll_size(&scope->const_ll);
+    size += ll_size(&scope->param_ll);
+    size += ll_size(&scope->gradient_ll);
+    size += ll_size(&scope->subjects_ll);
+    size += ll_size(&scope->timeline_ll);
+    size += ll_size(&scope->font_ll);
+    size += ll_size(&scope->image_ll);
+    size += ll_size(&scope->event_ll);
+
+    lui_xml_style_t * style;
+    LV_LL_READ(&scope->style_ll, style) {
+        size += style_props_size(&style->style);
+    }
+
+    lui_xml_timeline_t * timeline;
+    LV_LL_READ(&scope->timeline_ll, timeline) {
+        size += ll_size(&timeline->anims_ll);
+    }
+
+    /*Growable string subjects are not in the arena*/
+    lui_xml_subject_t * subject;
+    LV_LL_READ(&scope->subjects_ll, subject) {
+        if(subject->growable) size += 2 * subject->subject->size;
+    }
+
+    /*The view definition is in the arena but it's reported separately.
+     *If it's referenced from a blob it takes no RAM.*/
+    if(scope->view_def && !scope->view_def_static) {
+        stats->view_def_size = scope->view_def_len + 1;
+        if(size > stats->view_def_size) size -= stats->view_def_size;
+    }
+
+    stats->metadata_size = size;
+    stats->instance_cnt = scope->instance_cnt;
+    stats->instance_obj_size = scope->instance_obj_size;
+    stats->instance_style_size = scope->instance_style_size;
+
+    return LV_RESULT_OK;
+}
+
+void lui_xml_memory_count_instance(lui_xml_component_scope_t * scope, lv_obj_t * obj)
+{
+    if(obj == NULL) return;
+
+    scope->instance_cnt++;
+
+#if LUI_XML_USE_INSTANCE_STATS
+    size_t obj_size = 0;
+    size_t style_size = 0;
+    count_obj(obj, &obj_size, &style_size);
+
+    scope->instance_obj_size = obj_size;
+    scope->instance_style_size = style_size;
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static size_t ll_size(const lv_ll_t * ll)
+{
+    return lv_ll_get_len(ll) * (ll->n_size + LL_NODE_META_SIZE);
+}
+
+static size_t style_props_size(const lv_style_t * style)
+{
+    /*Constant styles are not allocated*/
+    if(style->prop_cnt == 0 || style->prop_cnt == 255) return 0;
+    return style->prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+}
+
+#if LUI_XML_USE_INSTANCE_STATS
+static void count_obj(lv_obj_t * obj, size_t * obj_size, size_t * style_size)
+{
+    *obj_size += obj->class_p->instance_size;
+
+    if(obj->spec_attr) {
+        *obj_size += sizeof(lv_obj_spec_attr_t);
+        *obj_size += obj->spec_attr->child_cnt * sizeof(lv_obj_t *);
+        *obj_size += lv_obj_get_event_count(obj) * (sizeof(lv_event_dsc_t) + sizeof(lv_event_dsc_t *));
+    }
+
+    *style_size += obj->style_cnt * sizeof(lv_obj_style_t);
+    uint32_t i;
+    for(i = 0; i < obj->style_cnt; i++) {
+        lv_obj_style_t * obj_style = &obj->styles[i];
+        /*Shared styles are accounted at their component*/
+        if(!obj_style->is_local && !obj_style->is_trans) continue;
+        *style_size += sizeof(lv_style_t) + style_props_size(obj_style->style);
+    }
+
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        count_obj(lv_obj_get_child(obj, i), obj_size, style_size);
+    }
+}
+#endif
+
+#endif /* LV_USE_XML */
@@ -0,0 +1,69 @@
+/**
+ * @file lui_xml_memory.h
+ *
+ */
+
+#ifndef LUI_XML_MEMORY_H
+#define LUI_XML_MEMORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: measure the widget tree of every created instance for `lui_xml_get_memory_stats()`.
+ *  The whole tree is walked after each creation, so enable it only while profiling.*/
+#ifndef LUI_XML_USE_INSTANCE_STATS
+#define LUI_XML_USE_INSTANCE_STATS 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    size_t metadata_size;       /**< Scope, used arena bytes, list nodes and style properties of the registered component*/
+    size_t view_def_size;       /**< The stored view definition (not included in `metadata_size`)*/
+    uint32_t instance_cnt;      /**< Number of instances created so far*/
+    size_t instance_obj_size;   /**< Widgets, children arrays and event descriptors of the last instance.
+                                 *   0 if `LUI_XML_USE_INSTANCE_STATS` is disabled.*/
+    size_t instance_style_size; /**< Style lists and local style properties of the last instance.
+                                 *   0 if `LUI_XML_USE_INSTANCE_STATS` is disabled.*/
+} lui_xml_memory_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get how much RAM a component or screen uses.
+ * The instance sizes are measured on the widget tree of the last created instance,
+ * including the nested components, if `LUI_XML_USE_INSTANCE_STATS` is enabled.
+ * @param name      name of a registered component or screen
+ * @param stats     store the result here
+ * @return          LV_RESULT_OK if the component was found, LV_RESULT_INVALID otherwise,
+ *                  also if it's only indexed by a lazy load and not registered yet.
+ */
+lv_result_t lui_xml_get_memory_stats(const char * name, lui_xml_memory_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_XML*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_MEMORY_H*/
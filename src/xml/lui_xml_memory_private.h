@@ -0,0 +1,50 @@
+/**
+ * @file lui_xml_memory_private.h
+ *
+ */
+
+#ifndef LUI_XML_MEMORY_PRIVATE_H
+#define LUI_XML_MEMORY_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_memory.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Count a newly created instance, and if `LUI_XML_USE_INSTANCE_STATS` is enabled
+ * measure its widget tree and save the result in the component's scope.
+ * @param scope     the scope of the instantiated component
+ * @param obj       the root of the instance
+ */
+void lui_xml_memory_count_instance(lui_xml_component_scope_t * scope, lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_XML*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_MEMORY_PRIVATE_H*/
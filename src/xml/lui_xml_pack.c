@@ -0,0 +1,280 @@
+/**
+ * @file lui_xml_pack.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_pack_private.h"
+#if LV_USE_XML
+
+#include "lui_xml_private.h"
+#include "lui_xml_component_private.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool pack_is_valid(const lui_xml_pack_t * pack, uint32_t size);
+static bool section_is_valid(uint32_t offset, uint32_t item_cnt, uint32_t item_size, uint32_t size);
+static bool entry_is_valid(const lui_xml_pack_t * pack, const lui_xml_pack_entry_t * entry);
+static bool tokens_are_valid(const lui_xml_pack_t * pack, uint32_t start, uint32_t word_cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lui_xml_pack_t * lui_xml_load_pack(const void * buf, uint32_t size)
+{
+    if(buf == NULL || ((lv_uintptr_t)buf & 0x3) != 0) {
+        LV_LOG_WARN("The pack needs to be aligned to 4 bytes");
+        return NULL;
+    }
+
+    lui_xml_pack_t * pack = lv_malloc(sizeof(lui_xml_pack_t));
+    LV_ASSERT_MALLOC(pack);
+    if(pack == NULL) return NULL;
+
+    pack->buf = buf;
+    pack->header = buf;
+
+    if(!pack_is_valid(pack, size)) {
+        lv_free(pack);
+        return NULL;
+    }
+
+    const lui_xml_pack_header_t * header = pack->header;
+    pack->entries = (const lui_xml_pack_entry_t *)(pack->buf + header->entries);
+    pack->str_offsets = (const uint32_t *)(pack->buf + header->str_offsets);
+    pack->tokens = (const uint32_t *)(pack->buf + header->tokens);
+    pack->str_data = (const char *)(pack->buf + header->str_data);
+
+    uint32_t i;
+    for(i = 0; i < header->entry_cnt; i++) {
+        if(!entry_is_valid(pack, &pack->entries[i])) {
+            LV_LOG_WARN("Invalid pack entry %" LV_PRIu32, i);
+            lv_free(pack);
+            return NULL;
+        }
+    }
+
+    /*The entries are stored in the order they need to be registered*/
+    for(i = 0; i < header->entry_cnt; i++) {
+        const lui_xml_pack_entry_t * entry = &pack->entries[i];
+        switch(entry->type) {
+            case LUI_XML_PACK_ENTRY_COMPONENT:
+                lui_xml_component_register_from_pack(lui_xml_pack_get_str(pack, entry->name), pack, i);
+                break;
+            case LUI_XML_PACK_ENTRY_TRANSLATIONS:
+#if LV_USE_TRANSLATION
+                lui_xml_translation_register_from_pack(pack, i);
+#else
+                LV_LOG_WARN("Translations found in the pack but translations are not enabled");
+#endif
+                break;
+            default:
+                LV_LOG_WARN("Unknown entry type in pack: %" LV_PRIu32, entry->type);
+                break;
+        }
+    }
+
+    return pack;
+}
+
+void lui_xml_unload_pack(lui_xml_pack_t * pack)
+{
+    if(pack == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < pack->header->entry_cnt; i++) {
+        const lui_xml_pack_entry_t * entry = &pack->entries[i];
+        if(entry->type != LUI_XML_PACK_ENTRY_COMPONENT) continue;
+
+        /*The globals are merged into the global scope and can't be unregistered*/
+        const char * name = lui_xml_pack_get_str(pack, entry->name);
+        if(lv_streq(name, "globals")) continue;
+
+        /*Don't remove a component with the same name registered from somewhere else*/
+        lui_xml_component_scope_t * scope = lui_xml_component_find_scope(name);
+        if(scope && scope->pack == pack) lui_xml_unregister_component(name);
+    }
+
+    lv_free(pack);
+}
+
+const char * lui_xml_pack_get_str(const lui_xml_pack_t * pack, uint32_t index)
+{
+    return pack->str_data + pack->str_offsets[index];
+}
+
+uint32_t lui_xml_pack_get_attrs_size(const uint32_t * words, uint32_t word_cnt)
+{
+    uint32_t max_attr_cnt = 0;
+    uint32_t i = 0;
+    while(i < word_cnt) {
+        uint32_t w = words[i++];
+        if(w & LUI_XML_PACK_TOKEN_END) continue;
+
+        uint32_t attr_cnt = words[i++];
+        max_attr_cnt = LV_MAX(max_attr_cnt, attr_cnt);
+        i += attr_cnt * 2;
+    }
+
+    return max_attr_cnt * 2 + 1;
+}
+
+void lui_xml_pack_replay(const lui_xml_pack_t * pack, const uint32_t * words, uint32_t word_cnt, const char ** attrs,
+                         XML_StartElementHandler start_cb, XML_EndElementHandler end_cb, void * user_data)
+{
+    const char ** attrs_alloc = NULL;
+    if(attrs == NULL) {
+        attrs_alloc = lv_malloc((pack->header->max_attr_cnt * 2 + 1) * sizeof(const char *));
+        LV_ASSERT_MALLOC(attrs_alloc);
+        if(attrs_alloc == NULL) return;
+        attrs = attrs_alloc;
+    }
+
+    uint32_t i = 0;
+    while(i < word_cnt) {
+        uint32_t w = words[i++];
+        const char * name = lui_xml_pack_get_str(pack, LUI_XML_PACK_TOKEN_STR(w));
+        if(w & LUI_XML_PACK_TOKEN_END) {
+            end_cb(user_data, name);
+            continue;
+        }
+
+        uint32_t attr_cnt = words[i++];
+        uint32_t a;
+        for(a = 0; a < attr_cnt * 2; a++) {
+            attrs[a] = lui_xml_pack_get_str(pack, words[i++]);
+        }
+        attrs[attr_cnt * 2] = NULL;
+
+        start_cb(user_data, name, attrs);
+    }
+
+    lv_free(attrs_alloc);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool pack_is_valid(const lui_xml_pack_t * pack, uint32_t size)
+{
+    const lui_xml_pack_header_t * header = pack->header;
+
+    if(size < sizeof(lui_xml_pack_header_t) || lv_memcmp(header->magic, LUI_XML_PACK_MAGIC, 4) != 0) {
+        LV_LOG_WARN("Not a Lui-XML pack");
+        return false;
+    }
+
+    if(header->byte_order != LUI_XML_PACK_BYTE_ORDER) {
+        LV_LOG_WARN("The pack was compiled for a different byte order");
+        return false;
+    }
+
+    if(header->version != LUI_XML_PACK_VERSION) {
+        LV_LOG_WARN("Pack version %" LV_PRIu32 " is not supported (expected %d)", header->version,
+                    LUI_XML_PACK_VERSION);
+        return false;
+    }
+
+    if(header->size > size ||
+       !section_is_valid(header->entries, header->entry_cnt, sizeof(lui_xml_pack_entry_t), header->size) ||
+       !section_is_valid(header->str_offsets, header->str_cnt, sizeof(uint32_t), header->size) ||
+       !section_is_valid(header->tokens, header->token_word_cnt, sizeof(uint32_t), header->size) ||
+       !section_is_valid(header->str_data, header->str_data_size, 1, header->size) ||
+       header->max_attr_cnt > header->token_word_cnt / 2) {
+        LV_LOG_WARN("The pack is truncated or corrupted");
+        return false;
+    }
+
+    /*If the string data ends with '\0' all the strings are terminated inside it*/
+    const char * str_data = (const char *)(pack->buf + header->str_data);
+    if(header->str_data_size == 0 || str_data[header->str_data_size - 1] != '\0') {
+        LV_LOG_WARN("Invalid string data in pack");
+        return false;
+    }
+
+    const uint32_t * str_offsets = (const uint32_t *)(pack->buf + header->str_offsets);
+    uint32_t i;
+    for(i = 0; i < header->str_cnt; i++) {
+        if(str_offsets[i] >= header->str_data_size) {
+            LV_LOG_WARN("Invalid string offset in pack");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool section_is_valid(uint32_t offset, uint32_t item_cnt, uint32_t item_size, uint32_t size)
+{
+    if(item_size > 1 && (offset & 0x3) != 0) return false;
+    if(offset > size) return false;
+    return (uint64_t)item_cnt * item_size <= size - offset;
+}
+
+static bool entry_is_valid(const lui_xml_pack_t * pack, const lui_xml_pack_entry_t * entry)
+{
+    if(entry->name >= pack->header->str_cnt) return false;
+    if(!tokens_are_valid(pack, entry->token_start, entry->token_word_cnt)) return false;
+    if(entry->view_start == LUI_XML_PACK_NO_VIEW) return true;
+
+    return tokens_are_valid(pack, entry->view_start, entry->view_word_cnt);
+}
+
+/**
+ * Check the tokens once on load so that replaying them doesn't need to
+ * @param pack          pointer to a pack with a valid header
+ * @param start         index of the first word
+ * @param word_cnt      number of words
+ * @return              true: the tokens can be replayed safely
+ */
+static bool tokens_are_valid(const lui_xml_pack_t * pack, uint32_t start, uint32_t word_cnt)
+{
+    const lui_xml_pack_header_t * header = pack->header;
+    if(start > header->token_word_cnt || word_cnt > header->token_word_cnt - start) return false;
+
+    const uint32_t * words = &pack->tokens[start];
+    uint32_t i = 0;
+    while(i < word_cnt) {
+        uint32_t w = words[i++];
+        if(LUI_XML_PACK_TOKEN_STR(w) >= header->str_cnt) return false;
+        if(w & LUI_XML_PACK_TOKEN_END) continue;
+
+        if(i >= word_cnt) return false;
+        uint32_t attr_cnt = words[i++];
+        if(attr_cnt > header->max_attr_cnt || attr_cnt * 2 > word_cnt - i) return false;
+
+        uint32_t a;
+        for(a = 0; a < attr_cnt * 2; a++) {
+            if(words[i++] >= header->str_cnt) return false;
+        }
+    }
+
+    return true;
+}
+
+#endif /* LV_USE_XML */
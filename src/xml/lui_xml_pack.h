@@ -0,0 +1,79 @@
+/**
+ * @file lui_xml_pack.h
+ *
+ */
+
+#ifndef LUI_XML_PACK_H
+#define LUI_XML_PACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Version of the binary pack format. Packs with other versions are rejected.*/
+#define LUI_XML_PACK_VERSION 1
+
+/** Enable `lui_xml_pack_compile()`. Usually only needed on the host.*/
+#ifndef LUI_XML_USE_PACK_COMPILER
+#define LUI_XML_USE_PACK_COMPILER 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lui_xml_pack_t lui_xml_pack_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register all the components, screens, globals and translations of a binary pack
+ * created by `lui_xml_pack_compile()` or the `lui_xml_packc` tool.
+ * The pack is used in place, so `buf` needs to stay valid until `lui_xml_unload_pack()`.
+ * @param buf       the pack, aligned to 4 bytes
+ * @param size      size of the pack in bytes
+ * @return          a handle to unload the pack later or NULL on error
+ */
+lui_xml_pack_t * lui_xml_load_pack(const void * buf, uint32_t size);
+
+/**
+ * Unregister the components and screens of a pack.
+ * Globals and translations can't be unregistered.
+ * @param pack      a handle returned by `lui_xml_load_pack()`
+ */
+void lui_xml_unload_pack(lui_xml_pack_t * pack);
+
+#if LUI_XML_USE_PACK_COMPILER
+/**
+ * Compile the XML files of a directory to a binary pack.
+ * The files are processed the same way as by `lui_xml_load_all_from_path()`.
+ * @param path      the path to a directory
+ * @param size      store the size of the pack here
+ * @return          the pack (free with `lv_free()`) or NULL on error
+ */
+void * lui_xml_pack_compile(const char * path, uint32_t * size);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_PACK_H*/
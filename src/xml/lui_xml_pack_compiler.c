@@ -0,0 +1,410 @@
+/**
+ * @file lui_xml_pack_compiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_pack_private.h"
+#if LV_USE_XML && (LUI_XML_USE_PACK_COMPILER || LUI_XML_USE_CACHE)
+
+#include "lui_xml_doc.h"
+#include "lui_xml_load_private.h"
+#include "../misc/lv_fs.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define STR_TABLE_MIN_SIZE  256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A growable array of 32 bit words*/
+typedef struct {
+    uint32_t * data;
+    uint32_t cnt;
+    uint32_t cap;
+} word_buf_t;
+
+typedef struct {
+    word_buf_t entries;             /**< `lui_xml_pack_entry_t`s as words*/
+    word_buf_t tokens;
+    word_buf_t str_offsets;
+    char * str_data;
+    uint32_t str_data_size;
+    uint32_t str_data_cap;
+    uint32_t * str_table;           /**< Open addressing hash table of string index + 1*/
+    uint32_t str_table_size;
+    uint32_t max_attr_cnt;
+
+    /*State of the file being compiled*/
+    uint32_t depth;
+    uint32_t view_depth;            /**< Depth of the `<view>` + 1 while in it*/
+    lui_xml_pack_entry_t entry;
+    bool error;
+} pack_writer_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LUI_XML_USE_PACK_COMPILER
+    static void compile_file(const char * path, void * user_data);
+#endif
+static void compile_buf(pack_writer_t * writer, const char * path, const char * name, const char * buf,
+                        uint32_t size);
+static void start_handler(void * user_data, const char * name, const char ** attrs);
+static void end_handler(void * user_data, const char * name);
+static uint32_t add_str(pack_writer_t * writer, const char * str);
+static bool str_table_grow(pack_writer_t * writer);
+static uint32_t str_hash(const char * str);
+static bool word_buf_add(word_buf_t * wb, uint32_t word);
+static void * write_pack(pack_writer_t * writer, uint32_t * size);
+static void writer_free(pack_writer_t * writer);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LUI_XML_USE_PACK_COMPILER
+void * lui_xml_pack_compile(const char * path, uint32_t * size)
+{
+    pack_writer_t writer;
+    lv_memzero(&writer, sizeof(writer));
+
+    /*Index 0 is the empty string so that even an empty pack has string data*/
+    add_str(&writer, "");
+
+    lv_result_t res = lui_xml_load_for_each_file(path, compile_file, &writer);
+    if(res != LV_RESULT_OK || writer.error) {
+        LV_LOG_WARN("Couldn't compile `%s`", path);
+        writer_free(&writer);
+        return NULL;
+    }
+
+    void * pack = write_pack(&writer, size);
+    writer_free(&writer);
+    return pack;
+}
+#endif
+
+void * lui_xml_pack_compile_buf(const char * path, const char * buf, uint32_t buf_size, uint32_t * size)
+{
+    pack_writer_t writer;
+    lv_memzero(&writer, sizeof(writer));
+
+    /*Index 0 is the empty string so that even an empty pack has string data*/
+    add_str(&writer, "");
+
+    char * name = lui_xml_load_get_component_name(path);
+    compile_buf(&writer, path, name, buf, buf_size);
+    lv_free(name);
+
+    if(writer.error) {
+        writer_free(&writer);
+        return NULL;
+    }
+
+    void * pack = write_pack(&writer, size);
+    writer_free(&writer);
+    return pack;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LUI_XML_USE_PACK_COMPILER
+static void compile_file(const char * path, void * user_data)
+{
+    pack_writer_t * writer = user_data;
+    if(writer->error) return;
+
+    uint32_t file_size;
+    if(lv_fs_path_get_size(path, &file_size) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't get the size of `%s`", path);
+        writer->error = true;
+        return;
+    }
+
+    char * buf = lv_malloc(file_size);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL || lv_fs_load_to_buf(buf, file_size, path) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't read `%s`", path);
+        lv_free(buf);
+        writer->error = true;
+        return;
+    }
+
+    char * name = lui_xml_load_get_component_name(path);
+    compile_buf(writer, path, name, buf, file_size);
+    lv_free(name);
+    lv_free(buf);
+}
+#endif
+
+/**
+ * Add the elements of an XML file to the pack
+ * @param writer    pointer to a pack writer
+ * @param path      path of the file, used in the logs
+ * @param name      name of the component defined by the file. NULL is an error if it's a component.
+ * @param buf       content of the file
+ * @param size      size of `buf`
+ */
+static void compile_buf(pack_writer_t * writer, const char * path, const char * name, const char * buf,
+                        uint32_t size)
+{
+    lui_xml_doc_t doc;
+    lui_xml_doc_init(&doc);
+    if(lui_xml_doc_tokenize(&doc, buf, size, false) != LV_RESULT_OK || doc.root == NULL) {
+        if(doc.error_msg) {
+            LV_LOG_WARN("XML parsing error: %s on line %" LV_PRIu32 " in %s", doc.error_msg, doc.error_line, path);
+        }
+        else {
+            LV_LOG_WARN("Couldn't parse `%s`", path);
+        }
+        lui_xml_doc_destroy(&doc);
+        writer->error = true;
+        return;
+    }
+
+    lv_memzero(&writer->entry, sizeof(writer->entry));
+    writer->entry.view_start = LUI_XML_PACK_NO_VIEW;
+    writer->entry.token_start = writer->tokens.cnt;
+    writer->depth = 0;
+    writer->view_depth = 0;
+
+    bool skip = false;
+    if(lv_streq(doc.root, "component") || lv_streq(doc.root, "screen") || lv_streq(doc.root, "globals")) {
+        writer->entry.type = LUI_XML_PACK_ENTRY_COMPONENT;
+        if(name) {
+            writer->entry.name = add_str(writer, name);
+        }
+        else {
+            writer->error = true;
+        }
+    }
+    else if(lv_streq(doc.root, "translations")) {
+        writer->entry.type = LUI_XML_PACK_ENTRY_TRANSLATIONS;
+        writer->entry.name = add_str(writer, "");
+    }
+    else {
+        /*The loader skips these files too*/
+        LV_LOG_INFO("Skipping `%s` with unknown root element `%s`", path, doc.root);
+        skip = true;
+    }
+
+    if(!skip) {
+        lui_xml_doc_replay(&doc, start_handler, end_handler, writer);
+        writer->entry.token_word_cnt = writer->tokens.cnt - writer->entry.token_start;
+
+        const uint32_t * entry_words = (const uint32_t *)&writer->entry;
+        uint32_t i;
+        for(i = 0; i < sizeof(lui_xml_pack_entry_t) / sizeof(uint32_t); i++) {
+            if(!word_buf_add(&writer->entries, entry_words[i])) writer->error = true;
+        }
+    }
+
+    lui_xml_doc_destroy(&doc);
+}
+
+static void start_handler(void * user_data, const char * name, const char ** attrs)
+{
+    pack_writer_t * writer = user_data;
+    writer->depth++;
+
+    if(writer->view_depth == 0 && writer->entry.view_start == LUI_XML_PACK_NO_VIEW && lv_streq(name, "view")) {
+        writer->view_depth = writer->depth;
+        writer->entry.view_start = writer->tokens.cnt;
+    }
+
+    uint32_t attr_cnt = 0;
+    while(attrs[attr_cnt * 2]) attr_cnt++;
+    if(attr_cnt > writer->max_attr_cnt) writer->max_attr_cnt = attr_cnt;
+
+    bool ok = word_buf_add(&writer->tokens, add_str(writer, name) << 1);
+    ok = ok && word_buf_add(&writer->tokens, attr_cnt);
+    uint32_t i;
+    for(i = 0; ok && i < attr_cnt * 2; i++) {
+        ok = word_buf_add(&writer->tokens, add_str(writer, attrs[i]));
+    }
+
+    if(!ok) writer->error = true;
+}
+
+static void end_handler(void * user_data, const char * name)
+{
+    pack_writer_t * writer = user_data;
+
+    if(!word_buf_add(&writer->tokens, (add_str(writer, name) << 1) | LUI_XML_PACK_TOKEN_END)) {
+        writer->error = true;
+    }
+
+    if(writer->view_depth == writer->depth) {
+        writer->entry.view_word_cnt = writer->tokens.cnt - writer->entry.view_start;
+        writer->view_depth = 0;
+    }
+
+    writer->depth--;
+}
+
+/**
+ * Get the index of a string, adding it to the string data if it's new
+ * @param writer    pointer to a pack writer
+ * @param str       the string to add
+ * @return          index of the string
+ */
+static uint32_t add_str(pack_writer_t * writer, const char * str)
+{
+    if(writer->str_offsets.cnt * 2 >= writer->str_table_size) {
+        if(!str_table_grow(writer)) {
+            writer->error = true;
+            return 0;
+        }
+    }
+
+    uint32_t mask = writer->str_table_size - 1;
+    uint32_t slot = str_hash(str) & mask;
+    while(writer->str_table[slot]) {
+        uint32_t index = writer->str_table[slot] - 1;
+        if(lv_streq(writer->str_data + writer->str_offsets.data[index], str)) return index;
+        slot = (slot + 1) & mask;
+    }
+
+    uint32_t len = lv_strlen(str) + 1;
+    if(writer->str_data_size + len > writer->str_data_cap) {
+        uint32_t new_cap = LV_MAX(writer->str_data_cap * 2, writer->str_data_size + len);
+        char * new_data = lv_realloc(writer->str_data, new_cap);
+        LV_ASSERT_MALLOC(new_data);
+        if(new_data == NULL) {
+            writer->error = true;
+            return 0;
+        }
+        writer->str_data = new_data;
+        writer->str_data_cap = new_cap;
+    }
+
+    uint32_t index = writer->str_offsets.cnt;
+    if(!word_buf_add(&writer->str_offsets, writer->str_data_size)) {
+        writer->error = true;
+        return 0;
+    }
+
+    lv_memcpy(writer->str_data + writer->str_data_size, str, len);
+    writer->str_data_size += len;
+    writer->str_table[slot] = index + 1;
+
+    return index;
+}
+
+static bool str_table_grow(pack_writer_t * writer)
+{
+    uint32_t new_size = writer->str_table_size ? writer->str_table_size * 2 : STR_TABLE_MIN_SIZE;
+    uint32_t * new_table = lv_zalloc(new_size * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(new_table);
+    if(new_table == NULL) return false;
+
+    uint32_t mask = new_size - 1;
+    uint32_t i;
+    for(i = 0; i < writer->str_offsets.cnt; i++) {
+        uint32_t slot = str_hash(writer->str_data + writer->str_offsets.data[i]) & mask;
+        while(new_table[slot]) slot = (slot + 1) & mask;
+        new_table[slot] = i + 1;
+    }
+
+    lv_free(writer->str_table);
+    writer->str_table = new_table;
+    writer->str_table_size = new_size;
+    return true;
+}
+
+/** FNV-1a*/
+static uint32_t str_hash(const char * str)
+{
+    uint32_t hash = 2166136261u;
+    while(*str) {
+        hash ^= (uint8_t) * str;
+        hash *= 16777619u;
+        str++;
+    }
+    return hash;
+}
+
+static bool word_buf_add(word_buf_t * wb, uint32_t word)
+{
+    if(wb->cnt == wb->cap) {
+        uint32_t new_cap = wb->cap ? wb->cap * 2 : 64;
+        uint32_t * new_data = lv_realloc(wb->data, new_cap * sizeof(uint32_t));
+        LV_ASSERT_MALLOC(new_data);
+        if(new_data == NULL) return false;
+        wb->data = new_data;
+        wb->cap = new_cap;
+    }
+
+    wb->data[wb->cnt++] = word;
+    return true;
+}
+
+/**
+ * Lay out the collected data: header, entries, string offsets, tokens, string data
+ * @param writer    pointer to a pack writer
+ * @param size      store the size of the pack here
+ * @return          the pack allocated with `lv_malloc()`
+ */
+static void * write_pack(pack_writer_t * writer, uint32_t * size)
+{
+    lui_xml_pack_header_t header;
+    lv_memzero(&header, sizeof(header));
+    lv_memcpy(header.magic, LUI_XML_PACK_MAGIC, 4);
+    header.version = LUI_XML_PACK_VERSION;
+    header.byte_order = LUI_XML_PACK_BYTE_ORDER;
+    header.entry_cnt = writer->entries.cnt / (sizeof(lui_xml_pack_entry_t) / sizeof(uint32_t));
+    header.entries = sizeof(header);
+    header.str_cnt = writer->str_offsets.cnt;
+    header.str_offsets = header.entries + writer->entries.cnt * sizeof(uint32_t);
+    header.token_word_cnt = writer->tokens.cnt;
+    header.tokens = header.str_offsets + writer->str_offsets.cnt * sizeof(uint32_t);
+    header.str_data_size = writer->str_data_size;
+    header.str_data = header.tokens + writer->tokens.cnt * sizeof(uint32_t);
+    header.max_attr_cnt = writer->max_attr_cnt;
+    header.size = (header.str_data + header.str_data_size + 3) & ~0x3u;
+
+    uint8_t * pack = lv_zalloc(header.size);
+    LV_ASSERT_MALLOC(pack);
+    if(pack == NULL) return NULL;
+
+    lv_memcpy(pack, &header, sizeof(header));
+    lv_memcpy(pack + header.entries, writer->entries.data, writer->entries.cnt * sizeof(uint32_t));
+    lv_memcpy(pack + header.str_offsets, writer->str_offsets.data, writer->str_offsets.cnt * sizeof(uint32_t));
+    lv_memcpy(pack + header.tokens, writer->tokens.data, writer->tokens.cnt * sizeof(uint32_t));
+    lv_memcpy(pack + header.str_data, writer->str_data, writer->str_data_size);
+
+    *size = header.size;
+    return pack;
+}
+
+static void writer_free(pack_writer_t * writer)
+{
+    lv_free(writer->entries.data);
+    lv_free(writer->tokens.data);
+    lv_free(writer->str_offsets.data);
+    lv_free(writer->str_data);
+    lv_free(writer->str_table);
+}
+
+#endif /* LV_USE_XML && (LUI_XML_USE_PACK_COMPILER || LUI_XML_USE_CACHE) */
@@ -0,0 +1,147 @@
+/**
+ * @file lui_xml_pack_private.h
+ *
+ */
+
+#ifndef LUI_XML_PACK_PRIVATE_H
+#define LUI_XML_PACK_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_pack.h"
+#if LV_USE_XML
+
+#include "lui_xml_cache.h"
+#include "../libs/expat/expat.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LUI_XML_PACK_MAGIC          "LXPK"
+#define LUI_XML_PACK_BYTE_ORDER     0x01020304
+
+/** Set in the first word of a token if it's an end element*/
+#define LUI_XML_PACK_TOKEN_END      0x1
+#define LUI_XML_PACK_TOKEN_STR(w)   ((w) >> 1)
+
+#define LUI_XML_PACK_NO_VIEW        0xFFFFFFFF
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*
+ * Layout of a pack. All offsets are from the beginning of the pack
+ * and all the fields are 32 bit words in the byte order of the target.
+ *
+ * - header
+ * - entries: one for each XML file
+ * - string offsets: `str_cnt` offsets of the NULL terminated strings
+ * - tokens: the elements of all the XML files in document order
+ *   - start element: `(string index << 1)`, attribute count, name-value string index pairs
+ *   - end element: `(string index << 1) | LUI_XML_PACK_TOKEN_END`
+ * - string data: all the names and values, each stored once
+ */
+
+typedef struct {
+    char magic[4];              /**< LUI_XML_PACK_MAGIC*/
+    uint32_t version;           /**< LUI_XML_PACK_VERSION*/
+    uint32_t byte_order;        /**< LUI_XML_PACK_BYTE_ORDER as written by the compiler*/
+    uint32_t size;              /**< Size of the whole pack*/
+    uint32_t entry_cnt;
+    uint32_t entries;           /**< Offset of the entries*/
+    uint32_t str_cnt;
+    uint32_t str_offsets;       /**< Offset of the string offsets*/
+    uint32_t str_data;          /**< Offset of the string data*/
+    uint32_t str_data_size;
+    uint32_t tokens;            /**< Offset of the tokens*/
+    uint32_t token_word_cnt;
+    uint32_t max_attr_cnt;      /**< Maximum number of attributes of an element*/
+} lui_xml_pack_header_t;
+
+typedef enum {
+    LUI_XML_PACK_ENTRY_COMPONENT,
+    LUI_XML_PACK_ENTRY_TRANSLATIONS,
+} lui_xml_pack_entry_type_t;
+
+typedef struct {
+    uint32_t type;              /**< A `lui_xml_pack_entry_type_t`*/
+    uint32_t name;              /**< String index of the component's name*/
+    uint32_t token_start;       /**< Index of the first word in the tokens*/
+    uint32_t token_word_cnt;
+    uint32_t view_start;        /**< Index of the first word of `<view>` or `LUI_XML_PACK_NO_VIEW`*/
+    uint32_t view_word_cnt;
+} lui_xml_pack_entry_t;
+
+struct _lui_xml_pack_t {
+    const uint8_t * buf;
+    const lui_xml_pack_header_t * header;
+    const lui_xml_pack_entry_t * entries;
+    const uint32_t * str_offsets;
+    const uint32_t * tokens;
+    const char * str_data;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get a string of a pack
+ * @param pack      pointer to a loaded pack
+ * @param index     index of the string
+ * @return          the string, stored in the pack
+ */
+const char * lui_xml_pack_get_str(const lui_xml_pack_t * pack, uint32_t index);
+
+/**
+ * Get the size of the attribute array needed to replay some tokens
+ * @param words         the first word of the tokens
+ * @param word_cnt      number of words
+ * @return              number of elements: twice the most attributes of an element plus the terminating NULL
+ */
+uint32_t lui_xml_pack_get_attrs_size(const uint32_t * words, uint32_t word_cnt);
+
+/**
+ * Call the handlers for the tokens as expat would while parsing the original XML
+ * @param pack          pointer to a loaded pack
+ * @param words         the first word of the tokens
+ * @param word_cnt      number of words
+ * @param attrs         array of `lui_xml_pack_get_attrs_size()` elements to pass the attributes in
+ *                      or NULL to allocate one for this call
+ * @param start_cb      called for the start elements
+ * @param end_cb        called for the end elements
+ * @param user_data     passed to the handlers as `user_data`
+ */
+void lui_xml_pack_replay(const lui_xml_pack_t * pack, const uint32_t * words, uint32_t word_cnt, const char ** attrs,
+                         XML_StartElementHandler start_cb, XML_EndElementHandler end_cb, void * user_data);
+
+#if LUI_XML_USE_PACK_COMPILER || LUI_XML_USE_CACHE
+/**
+ * Compile the content of a single XML file to a binary pack
+ * @param path          path of the file, the component's name is derived from it
+ * @param buf           content of the file
+ * @param buf_size      size of `buf`
+ * @param size          store the size of the pack here
+ * @return              the pack (free with `lv_free()`) or NULL on error
+ */
+void * lui_xml_pack_compile_buf(const char * path, const char * buf, uint32_t buf_size, uint32_t * size);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_PACK_PRIVATE_H*/
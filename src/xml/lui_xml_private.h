@@ -21,6 +21,9 @@ extern "C" {
 #include "lui_xml_base_types.h"
 #include "lui_xml_utils.h"
 #include "lui_xml_style.h"
+#include "lui_xml_doc.h"
+#include "lui_xml_stream.h"
+#include "../libs/expat/expat.h"
 
 /*********************
  *      DEFINES
@@ -30,10 +33,19 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef enum {
+    LUI_XML_FONT_TYPE_NONE,         /**< The font was passed to `lui_xml_register_font()`*/
+    LUI_XML_FONT_TYPE_TINY_TTF,
+    LUI_XML_FONT_TYPE_BIN,
+} lui_xml_font_type_t;
+
 typedef struct {
     const char * name;
-    const lv_font_t * font;
+    const lv_font_t * font;         /**< NULL until it's created if the font is created lazily*/
     void (*font_destroy_cb)(lv_font_t *);
+    const char * src_path;          /**< The file to create the font from, NULL once it's created*/
+    int32_t size;                   /**< Size of a TinyTTF font*/
+    lui_xml_font_type_t type;
 } lui_xml_font_t;
 
 typedef struct {
@@ -67,6 +79,68 @@ typedef struct {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Create a font from the file set in its `src_path`. On failure `src_path` is
+ * cleared too, so it's not attempted again.
+ * @param font      a registered font whose `src_path` is set
+ * @return          LV_RESULT_OK: the font is created, LV_RESULT_INVALID: it couldn't be created
+ */
+lv_result_t lui_xml_font_create(lui_xml_font_t * font);
+
+#if LV_USE_TRANSLATION
+/**
+ * Register translations from an already tokenized document
+ * @param doc       a tokenized document
+ * @return          LV_RESULT_OK: no error
+ */
+lv_result_t lui_xml_translation_register_from_doc(const lui_xml_doc_t * doc);
+
+/**
+ * Register translations from an opened stream
+ * @param stream    an opened stream, it's not closed by this function
+ * @return          LV_RESULT_OK: no error
+ */
+lv_result_t lui_xml_translation_register_from_stream(lui_xml_stream_t * stream);
+
+/**
+ * Register translations from a loaded binary pack
+ * @param pack          a loaded pack
+ * @param entry_index   index of the translations' entry in the pack
+ * @return              LV_RESULT_OK: no error
+ */
+lv_result_t lui_xml_translation_register_from_pack(const lui_xml_pack_t * pack, uint32_t entry_index);
+#endif
+
+/**
+ * Resolve the `$param` and `#const` values of an element of a `<view>` as its creation does.
+ * The resolved values are written back to `attrs`.
+ * @param state     the state of the component's creation (`scope`, `parent_scope`, and `parent_attrs`)
+ * @param attrs     attributes of the element
+ */
+void lui_xml_view_resolve_attrs(lui_xml_parser_state_t * state, const char ** attrs);
+
+/**
+ * Create an element of a `<view>` and push it as the parent of the next elements
+ * @param user_data the state of the component's creation
+ * @param name      name of the element
+ * @param attrs     attributes of the element, the `$param` and `#const` values are not resolved yet
+ */
+void lui_xml_view_start_element(void * user_data, const char * name, const char ** attrs);
+
+/**
+ * Close an element of a `<view>` opened by `lui_xml_view_start_element()`
+ * @param user_data the state of the component's creation
+ * @param name      name of the element
+ */
+void lui_xml_view_end_element(void * user_data, const char * name);
+
+/**
+ * Create the timelines of a component's instance
+ * @param view      the instance whose children are already created
+ * @param scope     scope of the component
+ */
+void lui_xml_create_timelines(lv_obj_t * view, lui_xml_component_scope_t * scope);
+
 /**********************
  *      MACROS
  **********************/
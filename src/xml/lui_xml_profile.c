@@ -0,0 +1,361 @@
+/**
+ * @file lui_xml_profile.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_profile_private.h"
+#if LV_USE_XML && LUI_XML_USE_PROFILE
+
+#include "lui_xml_arena.h"
+#include "../misc/lv_fs.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../stdlib/lv_sprintf.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+#include <stdarg.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    char * buf;         /**< NULL to only measure the length*/
+    uint32_t buf_size;
+    uint32_t len;       /**< Length of the whole output, even if it didn't fit*/
+} json_writer_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void account_phase(void);
+static uint32_t get_tick(void);
+static lui_xml_profile_file_t * find_file(const char * path);
+static void json_printf(json_writer_t * w, const char * fmt, ...);
+static void json_print_string(json_writer_t * w, const char * str);
+static void json_print_phases(json_writer_t * w, const lui_xml_profile_phase_stats_t * phases);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static bool profile_active;
+static lv_tick_get_cb_t profile_tick_cb;
+static uint32_t profile_tick_per_sec = 1000;
+static lui_xml_arena_t profile_arena;       /**< The files and their paths are allocated here*/
+static lui_xml_profile_file_t * file_head;
+static lui_xml_profile_file_t * file_tail;
+static uint32_t file_cnt;
+static lui_xml_profile_file_t * file_act;   /**< The file being measured or NULL*/
+static uint32_t file_nesting;
+static lui_xml_profile_phase_t phase_stack[LUI_XML_PROFILE_MAX_DEPTH];
+static uint32_t phase_depth;
+static uint32_t phase_overflow;             /**< Number of phases not measured as they were nested too deep*/
+static uint32_t phase_start;                /**< When the phase on the top of the stack was (re)started*/
+#if LUI_XML_PROFILE_MEM
+    static uint32_t mem_used_cnt;
+    static size_t mem_used_size;
+#endif
+
+static const char * const phase_names[LUI_XML_PROFILE_PHASE_NUM] = {
+    "other", "read", "parse", "register", "styles", "fonts", "images",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lui_xml_profile_start(void)
+{
+    lui_xml_profile_deinit();
+    lui_xml_arena_init(&profile_arena, 0);
+    profile_active = true;
+}
+
+void lui_xml_profile_stop(void)
+{
+    /*Close the file being measured to not lose its time*/
+    if(file_act) {
+        file_nesting = 1;
+        lui_xml_profile_file_end();
+    }
+
+    profile_active = false;
+}
+
+void lui_xml_profile_set_tick_cb(lv_tick_get_cb_t tick_get_cb, uint32_t tick_per_sec)
+{
+    profile_tick_cb = tick_get_cb;
+    profile_tick_per_sec = tick_get_cb ? tick_per_sec : 1000;
+}
+
+void lui_xml_profile_get_report(lui_xml_profile_report_t * report)
+{
+    lv_memzero(report, sizeof(lui_xml_profile_report_t));
+    report->files = file_head;
+    report->file_cnt = file_cnt;
+    report->tick_per_sec = profile_tick_per_sec;
+
+    const lui_xml_profile_file_t * file;
+    for(file = file_head; file; file = file->next) {
+        report->time += file->time;
+
+        uint32_t i;
+        for(i = 0; i < LUI_XML_PROFILE_PHASE_NUM; i++) {
+            report->phases[i].time += file->phases[i].time;
+            report->phases[i].cnt += file->phases[i].cnt;
+            report->phases[i].alloc_cnt += file->phases[i].alloc_cnt;
+            report->phases[i].alloc_size += file->phases[i].alloc_size;
+        }
+    }
+}
+
+uint32_t lui_xml_profile_to_json(char * buf, uint32_t buf_size)
+{
+    json_writer_t w;
+    w.buf = buf_size ? buf : NULL;
+    w.buf_size = buf_size;
+    w.len = 0;
+    if(w.buf) w.buf[0] = '\0';
+
+    lui_xml_profile_report_t report;
+    lui_xml_profile_get_report(&report);
+
+    json_printf(&w, "{\"tick_per_sec\":%" LV_PRIu32 ",\"time\":%" LV_PRIu32 ",\"file_cnt\":%" LV_PRIu32 ",\"phases\":",
+                report.tick_per_sec, report.time, report.file_cnt);
+    json_print_phases(&w, report.phases);
+    json_printf(&w, ",\"files\":[");
+
+    const lui_xml_profile_file_t * file;
+    for(file = report.files; file; file = file->next) {
+        json_printf(&w, "%s\n{\"path\":", file == report.files ? "" : ",");
+        json_print_string(&w, file->path);
+        json_printf(&w, ",\"time\":%" LV_PRIu32 ",\"phases\":", file->time);
+        json_print_phases(&w, file->phases);
+        json_printf(&w, "}");
+    }
+
+    json_printf(&w, "]}\n");
+
+    return w.len;
+}
+
+lv_result_t lui_xml_profile_save_json(const char * path)
+{
+    uint32_t len = lui_xml_profile_to_json(NULL, 0);
+    char * buf = lv_malloc(len + 1);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) {
+        LV_LOG_WARN("Memory allocation failed for the profile (%" LV_PRIu32 " bytes)", len + 1);
+        return LV_RESULT_INVALID;
+    }
+    lui_xml_profile_to_json(buf, len + 1);
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_WR) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't open %s", path);
+        lv_free(buf);
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t wn = 0;
+    lv_fs_res_t fs_res = lv_fs_write(&f, buf, len, &wn);
+    lv_fs_close(&f);
+    lv_free(buf);
+
+    if(fs_res != LV_FS_RES_OK || wn != len) {
+        LV_LOG_WARN("Couldn't write %s", path);
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+bool lui_xml_profile_is_active(void)
+{
+    return profile_active;
+}
+
+void lui_xml_profile_file_begin(const char * path)
+{
+    if(!profile_active) return;
+
+    file_nesting++;
+    if(file_nesting > 1) return;
+
+    file_act = find_file(path);
+    if(file_act == NULL) {
+        file_act = lui_xml_arena_zalloc(&profile_arena, sizeof(lui_xml_profile_file_t));
+        if(file_act == NULL) return;
+
+        file_act->path = lui_xml_arena_strdup(&profile_arena, path);
+        if(file_tail) file_tail->next = file_act;
+        else file_head = file_act;
+        file_tail = file_act;
+        file_cnt++;
+    }
+
+    phase_stack[0] = LUI_XML_PROFILE_PHASE_OTHER;
+    phase_depth = 1;
+    phase_overflow = 0;
+    file_act->phases[LUI_XML_PROFILE_PHASE_OTHER].cnt++;
+
+#if LUI_XML_PROFILE_MEM
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    mem_used_cnt = mon.used_cnt;
+    mem_used_size = mon.total_size - mon.free_size;
+#endif
+
+    phase_start = get_tick();
+}
+
+void lui_xml_profile_file_end(void)
+{
+    if(file_nesting == 0) return;
+
+    file_nesting--;
+    if(file_nesting > 0 || file_act == NULL) return;
+
+    account_phase();
+    file_act = NULL;
+    phase_depth = 0;
+}
+
+void lui_xml_profile_phase_begin(lui_xml_profile_phase_t phase)
+{
+    if(file_act == NULL) return;
+
+    if(phase_depth == LUI_XML_PROFILE_MAX_DEPTH) {
+        phase_overflow++;
+        return;
+    }
+
+    account_phase();
+    phase_stack[phase_depth] = phase;
+    phase_depth++;
+    file_act->phases[phase].cnt++;
+    phase_start = get_tick();
+}
+
+void lui_xml_profile_phase_end(void)
+{
+    if(file_act == NULL) return;
+
+    if(phase_overflow) {
+        phase_overflow--;
+        return;
+    }
+
+    /*The base phase of the file is ended by `lui_xml_profile_file_end()`*/
+    if(phase_depth <= 1) return;
+
+    account_phase();
+    phase_depth--;
+    phase_start = get_tick();
+}
+
+void lui_xml_profile_deinit(void)
+{
+    lui_xml_arena_destroy(&profile_arena);
+    file_head = NULL;
+    file_tail = NULL;
+    file_cnt = 0;
+    file_act = NULL;
+    file_nesting = 0;
+    phase_depth = 0;
+    phase_overflow = 0;
+    profile_active = false;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add the time (and allocations) since the last phase change to the current phase.
+ * The time spent on measuring the memory is not added to any phase.
+ */
+static void account_phase(void)
+{
+    uint32_t elapsed = get_tick() - phase_start;
+
+    lui_xml_profile_phase_stats_t * stats = &file_act->phases[phase_stack[phase_depth - 1]];
+    stats->time += elapsed;
+    file_act->time += elapsed;
+
+#if LUI_XML_PROFILE_MEM
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    size_t used_size = mon.total_size - mon.free_size;
+    stats->alloc_cnt += (int32_t)(mon.used_cnt - mem_used_cnt);
+    stats->alloc_size += (int32_t)(used_size - mem_used_size);
+    mem_used_cnt = mon.used_cnt;
+    mem_used_size = used_size;
+#endif
+}
+
+static uint32_t get_tick(void)
+{
+    return profile_tick_cb ? profile_tick_cb() : lv_tick_get();
+}
+
+static lui_xml_profile_file_t * find_file(const char * path)
+{
+    lui_xml_profile_file_t * file;
+    for(file = file_head; file; file = file->next) {
+        if(lv_streq(file->path, path)) return file;
+    }
+
+    return NULL;
+}
+
+static void json_printf(json_writer_t * w, const char * fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+
+    uint32_t avail = w->buf && w->len < w->buf_size ? w->buf_size - w->len : 0;
+    int len = lv_vsnprintf(avail ? &w->buf[w->len] : NULL, avail, fmt, args);
+    if(len > 0) w->len += len;
+
+    va_end(args);
+}
+
+static void json_print_string(json_writer_t * w, const char * str)
+{
+    json_printf(w, "\"");
+    for(; *str; str++) {
+        if(*str == '"' || *str == '\\') json_printf(w, "\\%c", *str);
+        else if((uint8_t)*str < 0x20) json_printf(w, "\\u%04x", (unsigned)(uint8_t)*str);
+        else json_printf(w, "%c", *str);
+    }
+    json_printf(w, "\"");
+}
+
+static void json_print_phases(json_writer_t * w, const lui_xml_profile_phase_stats_t * phases)
+{
+    json_printf(w, "{");
+
+    uint32_t i;
+    for(i = 0; i < LUI_XML_PROFILE_PHASE_NUM; i++) {
+        json_printf(w, "%s\"%s\":{\"time\":%" LV_PRIu32 ",\"cnt\":%" LV_PRIu32 ",\"alloc_cnt\":%" LV_PRId32
+                    ",\"alloc_size\":%" LV_PRId32 "}",
+                    i == 0 ? "" : ",", phase_names[i], phases[i].time, phases[i].cnt,
+                    phases[i].alloc_cnt, phases[i].alloc_size);
+    }
+
+    json_printf(w, "}");
+}
+
+#endif /* LV_USE_XML && LUI_XML_USE_PROFILE */
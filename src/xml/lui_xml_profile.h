@@ -0,0 +1,136 @@
+/**
+ * @file lui_xml_profile.h
+ *
+ */
+
+#ifndef LUI_XML_PROFILE_H
+#define LUI_XML_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+#include "../tick/lv_tick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: measure where the time goes while loading the XML files*/
+#ifndef LUI_XML_USE_PROFILE
+#define LUI_XML_USE_PROFILE 0
+#endif
+
+/** 1: also count the allocations of each phase. It needs `lv_mem_monitor()` so only works with the built-in heap.*/
+#ifndef LUI_XML_PROFILE_MEM
+#define LUI_XML_PROFILE_MEM (LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN)
+#endif
+
+/** Maximal nesting of the phases*/
+#ifndef LUI_XML_PROFILE_MAX_DEPTH
+#define LUI_XML_PROFILE_MAX_DEPTH 8
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    LUI_XML_PROFILE_PHASE_OTHER,    /**< Everything not in the other phases, e.g. finding the files*/
+    LUI_XML_PROFILE_PHASE_READ,     /**< Reading the files*/
+    LUI_XML_PROFILE_PHASE_PARSE,    /**< Tokenizing the XML*/
+    LUI_XML_PROFILE_PHASE_REGISTER, /**< Processing the elements, e.g. consts, subjects, storing the view*/
+    LUI_XML_PROFILE_PHASE_STYLES,   /**< Registering the styles*/
+    LUI_XML_PROFILE_PHASE_FONTS,    /**< Loading the fonts*/
+    LUI_XML_PROFILE_PHASE_IMAGES,   /**< Registering the images*/
+    LUI_XML_PROFILE_PHASE_NUM,
+} lui_xml_profile_phase_t;
+
+typedef struct {
+    uint32_t time;          /**< Time spent in the phase but not in the phases nested into it, in ticks*/
+    uint32_t cnt;           /**< How many times the phase was entered*/
+    int32_t alloc_cnt;      /**< Change of the number of allocated blocks (only with `LUI_XML_PROFILE_MEM`)*/
+    int32_t alloc_size;     /**< Change of the allocated bytes (only with `LUI_XML_PROFILE_MEM`)*/
+} lui_xml_profile_phase_stats_t;
+
+typedef struct _lui_xml_profile_file_t {
+    const char * path;
+    uint32_t time;          /**< Sum of the times of the phases*/
+    lui_xml_profile_phase_stats_t phases[LUI_XML_PROFILE_PHASE_NUM];
+    struct _lui_xml_profile_file_t * next;
+} lui_xml_profile_file_t;
+
+typedef struct {
+    const lui_xml_profile_file_t * files;   /**< The profiled files in the order they were loaded first*/
+    uint32_t file_cnt;
+    uint32_t time;                          /**< Sum of the times of the files*/
+    uint32_t tick_per_sec;                  /**< Unit of the times*/
+    lui_xml_profile_phase_stats_t phases[LUI_XML_PROFILE_PHASE_NUM];  /**< Sum of all files*/
+} lui_xml_profile_report_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_PROFILE
+
+/**
+ * Clear the previous results and start profiling the files loaded by `lui_xml_load_all_from_path()`,
+ * `lui_xml_load_all_from_data()`, `lui_xml_load_all_from_file()` and `lui_xml_register_component_from_file()`.
+ * While profiling the files are loaded on one thread.
+ */
+void lui_xml_profile_start(void);
+
+/**
+ * Stop profiling. The results are kept until the next `lui_xml_profile_start()`.
+ */
+void lui_xml_profile_stop(void);
+
+/**
+ * Set a more precise time source than `lv_tick_get()`. Call it before `lui_xml_profile_start()`.
+ * @param tick_get_cb   return the current time, e.g. in microseconds, or NULL to use `lv_tick_get()`
+ * @param tick_per_sec  number of ticks in a second, e.g. 1000000
+ */
+void lui_xml_profile_set_tick_cb(lv_tick_get_cb_t tick_get_cb, uint32_t tick_per_sec);
+
+/**
+ * Get the results. The report points to the profiler's data so it's valid until the next
+ * `lui_xml_profile_start()`.
+ * @param report    store the results here
+ */
+void lui_xml_profile_get_report(lui_xml_profile_report_t * report);
+
+/**
+ * Print the results as JSON
+ * @param buf       store the JSON here or NULL to get only its length
+ * @param buf_size  size of `buf`. The JSON is truncated if it's not enough.
+ * @return          length of the whole JSON without the terminating `'\0'`
+ */
+uint32_t lui_xml_profile_to_json(char * buf, uint32_t buf_size);
+
+/**
+ * Write the results to a file as JSON
+ * @param path      path to the file, e.g. "A:profile.json"
+ * @return          LV_RESULT_OK: written, LV_RESULT_INVALID: the file couldn't be written
+ */
+lv_result_t lui_xml_profile_save_json(const char * path);
+
+#endif /*LUI_XML_USE_PROFILE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_PROFILE_H*/
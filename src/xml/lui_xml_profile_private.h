@@ -0,0 +1,93 @@
+/**
+ * @file lui_xml_profile_private.h
+ *
+ */
+
+#ifndef LUI_XML_PROFILE_PRIVATE_H
+#define LUI_XML_PROFILE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_profile.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_PROFILE
+
+/**
+ * Check if profiling is running
+ * @return      true: `lui_xml_profile_start()` was called
+ */
+bool lui_xml_profile_is_active(void);
+
+/**
+ * Start measuring a file. The time until `lui_xml_profile_file_end()` is added to its
+ * results. If the file was already profiled, the new results are added to the old ones.
+ * Nested calls are ignored.
+ * @param path      path to the file
+ */
+void lui_xml_profile_file_begin(const char * path);
+
+/**
+ * Stop measuring the file
+ */
+void lui_xml_profile_file_end(void);
+
+/**
+ * Start a phase in the current file. Outside of a file it's ignored.
+ * @param phase     the phase
+ */
+void lui_xml_profile_phase_begin(lui_xml_profile_phase_t phase);
+
+/**
+ * End the last started phase and continue the one it was nested into
+ */
+void lui_xml_profile_phase_end(void);
+
+/**
+ * Free the results
+ */
+void lui_xml_profile_deinit(void);
+
+#endif /*LUI_XML_USE_PROFILE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#if LUI_XML_USE_PROFILE
+#define LUI_XML_PROFILE_FILE_BEGIN(path)    lui_xml_profile_file_begin(path)
+#define LUI_XML_PROFILE_FILE_END()          lui_xml_profile_file_end()
+#define LUI_XML_PROFILE_BEGIN(phase)        lui_xml_profile_phase_begin(LUI_XML_PROFILE_PHASE_##phase)
+#define LUI_XML_PROFILE_END()               lui_xml_profile_phase_end()
+#else
+#define LUI_XML_PROFILE_FILE_BEGIN(path)
+#define LUI_XML_PROFILE_FILE_END()
+#define LUI_XML_PROFILE_BEGIN(phase)
+#define LUI_XML_PROFILE_END()
+#endif
+
+#endif /*LV_USE_XML*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_PROFILE_PRIVATE_H*/
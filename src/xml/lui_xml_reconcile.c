@@ -0,0 +1,1021 @@
+/**
+ * @file lui_xml_reconcile.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_reconcile.h"
+#if LV_USE_XML
+
+#include "../lvgl.h"
+#include "lui_xml_component.h"
+#include "lui_xml_component_private.h"
+#include "lui_xml_widget.h"
+#include "lui_xml_parser.h"
+#include "lui_xml_private.h"
+#include "lui_xml_pack_private.h"
+#include "lui_xml_update_private.h"
+#include "../libs/expat/expat.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    NODE_KIND_WIDGET,       /**< A widget, e.g. `<lv_slider>`*/
+    NODE_KIND_COMPONENT,    /**< An instance of a component*/
+    NODE_KIND_SUB,          /**< A sub-element applied on its parent, e.g. `<lv_obj-style>`*/
+    NODE_KIND_SLOT,         /**< A slot of the parent component, e.g. `<my_card-content>`*/
+} node_kind_t;
+
+typedef struct _node_t node_t;
+
+/** An element of a rendered view*/
+struct _node_t {
+    node_t * parent;
+    node_t * next;                      /**< Next sibling*/
+    node_t * child;                     /**< First child*/
+    node_t * last_child;
+    node_t * match;                     /**< The node of the previous render matched to this one*/
+    node_t * view;                      /**< The `<view>` of a component instance*/
+    lui_xml_component_scope_t * scope;  /**< Scope of a component instance*/
+    const char * tag;                   /**< For a `<view>` the type it extends*/
+    const char ** raw_attrs;            /**< The attributes as written in the view, to create the element*/
+    const char ** attrs;                /**< Resolved attributes. For a `<view>` the instance's attributes too.*/
+    const char * name;                  /**< The resolved `name` attribute or NULL*/
+    lv_obj_t * obj;
+    uint32_t attr_cnt;
+    node_kind_t kind;
+    bool matched;                       /**< Matched to a node of the new render*/
+};
+
+/** Tells the node of a child widget that the widget was deleted, e.g. by the application.
+ *  Allocated for each child widget and freed when the widget is deleted.*/
+typedef struct {
+    node_t * node;                      /**< The node of the last render using the widget or NULL*/
+} node_link_t;
+
+/** The last render of a component, stored on the root widget*/
+typedef struct {
+    lui_xml_arena_t arena;              /**< All the nodes and their strings are allocated here*/
+    const char * name;                  /**< Name of the rendered component*/
+    node_t * view;
+} render_t;
+
+/** The scope in which the elements of a view are created*/
+typedef struct {
+    lui_xml_component_scope_t * scope;
+    lui_xml_component_scope_t * parent_scope;
+    const char ** attrs;                /**< Attributes of the instance*/
+} view_ctx_t;
+
+typedef struct {
+    lui_xml_parser_state_t state;       /**< To resolve the values as the creation does*/
+    lui_xml_arena_t * arena;
+    lui_xml_component_scope_t * scope;
+    node_t * view;
+    node_t * cur;                       /**< The element being built*/
+    bool error;
+} build_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static node_t * build_view(lui_xml_arena_t * arena, lui_xml_component_scope_t * scope,
+                           lui_xml_component_scope_t * parent_scope, const char ** attrs);
+static void build_start_element_handler(void * user_data, const char * name, const char ** attrs);
+static void build_end_element_handler(void * user_data, const char * name);
+static const char ** copy_attrs(lui_xml_arena_t * arena, const char ** attrs, uint32_t attr_cnt);
+static bool merge_instance_attrs(lui_xml_arena_t * arena, node_t * view, const char ** attrs);
+static node_kind_t get_kind(const char * tag);
+
+static lv_result_t render_view(view_ctx_t * ctx, node_t * view, lv_obj_t * obj);
+static lv_result_t update_view(view_ctx_t * ctx, node_t * old_view, node_t * new_view, lv_obj_t * obj);
+static lv_result_t update_node(view_ctx_t * ctx, node_t * old_node, node_t * new_node);
+static lv_result_t update_widget(view_ctx_t * ctx, node_t * old_node, node_t * new_node, int32_t * prev_index);
+static lv_result_t update_children(view_ctx_t * ctx, node_t * old_node, node_t * new_node, int32_t * prev_index);
+static bool attrs_removed(const node_t * old_node, const node_t * new_node);
+static void apply_changed_attrs(view_ctx_t * ctx, const node_t * old_node, const node_t * new_node);
+static bool subs_equal(const node_t * a, const node_t * b);
+static bool node_equal(const node_t * a, const node_t * b);
+static void create_node(view_ctx_t * ctx, node_t * node, lv_obj_t * parent);
+static lv_obj_t * replay_node(lui_xml_parser_state_t * state, const node_t * node);
+static void attach_node(node_t * node, lv_obj_t * obj);
+static void attach_children(node_t * node, lv_obj_t * obj, uint32_t tail_skip);
+static lv_obj_t * get_slot_obj(const node_t * slot, lv_obj_t * obj);
+static void clear_objs(node_t * node);
+static void link_nodes(node_t * node);
+static void unlink_nodes(node_t * node);
+static void take_objs(const node_t * old_node, node_t * new_node);
+static uint32_t get_obj_child_count(const node_t * node);
+static uint32_t count_attrs(const node_t * node);
+static void keep_order(lv_obj_t * obj, int32_t * prev_index);
+static bool str_equal(const char * a, const char * b);
+
+static render_t * get_render(lv_obj_t * obj);
+static void render_delete_event_cb(lv_event_t * e);
+static node_link_t * get_link(lv_obj_t * obj);
+static void node_delete_event_cb(lv_event_t * e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static lui_xml_reconcile_stats_t last_stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lui_xml_reconcile(lv_obj_t * root_obj, const char * name, const char ** attrs)
+{
+    lv_memzero(&last_stats, sizeof(last_stats));
+
+    lui_xml_component_scope_t * scope = lui_xml_component_get_scope(name);
+    if(scope == NULL) {
+        LV_LOG_WARN("'%s' is not a registered component", name);
+        return LV_RESULT_INVALID;
+    }
+
+    render_t * render = lv_malloc(sizeof(render_t));
+    LV_ASSERT_MALLOC(render);
+    if(render == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory");
+        return LV_RESULT_INVALID;
+    }
+
+    lui_xml_arena_init(&render->arena, 0);
+    render->name = lui_xml_arena_strdup(&render->arena, name);
+    render->view = build_view(&render->arena, scope, NULL, attrs);
+    if(render->name == NULL || render->view == NULL || !merge_instance_attrs(&render->arena, render->view, attrs)) {
+        LV_LOG_WARN("Couldn't build the view of '%s'", name);
+        lui_xml_arena_destroy(&render->arena);
+        lv_free(render);
+        return LV_RESULT_INVALID;
+    }
+
+    if(render->view->kind != NODE_KIND_WIDGET) {
+        LV_LOG_WARN("'%s' extends a component, it can't be reconciled", name);
+        lui_xml_arena_destroy(&render->arena);
+        lv_free(render);
+        return LV_RESULT_INVALID;
+    }
+
+    view_ctx_t ctx;
+    ctx.scope = scope;
+    ctx.parent_scope = NULL;
+    ctx.attrs = attrs;
+
+    render_t * old_render = get_render(root_obj);
+    lv_result_t res;
+    if(old_render && lv_streq(old_render->name, name)) {
+        res = update_view(&ctx, old_render->view, render->view, root_obj);
+    }
+    else {
+        res = render_view(&ctx, render->view, root_obj);
+    }
+
+    if(res != LV_RESULT_OK) {
+        lui_xml_arena_destroy(&render->arena);
+        lv_free(render);
+        return res;
+    }
+
+    /*Keep this render to compare the next one to it.
+     *From now the kept widgets tell their deletion to the new nodes.*/
+    link_nodes(render->view);
+    if(old_render) {
+        unlink_nodes(old_render->view);
+        lui_xml_arena_destroy(&old_render->arena);
+        *old_render = *render;
+        lv_free(render);
+    }
+    else {
+        lv_obj_add_event_cb(root_obj, render_delete_event_cb, LV_EVENT_DELETE, render);
+    }
+
+    return LV_RESULT_OK;
+}
+
+void lui_xml_reconcile_get_stats(lui_xml_reconcile_stats_t * stats)
+{
+    *stats = last_stats;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Build the element tree of a component's view with the values resolved
+ * @param arena         allocate the nodes here
+ * @param scope         the component
+ * @param parent_scope  scope in which the instance is created, or NULL
+ * @param attrs         attributes of the instance
+ * @return              the `<view>` node or NULL on error
+ */
+static node_t * build_view(lui_xml_arena_t * arena, lui_xml_component_scope_t * scope,
+                           lui_xml_component_scope_t * parent_scope, const char ** attrs)
+{
+    build_ctx_t ctx;
+    lv_memzero(&ctx, sizeof(ctx));
+    lui_xml_parser_state_init(&ctx.state);
+    ctx.state.scope = *scope;
+    ctx.state.parent_scope = parent_scope;
+    ctx.state.parent_attrs = attrs;
+    ctx.arena = arena;
+    ctx.scope = scope;
+
+    if(scope->view_tokens) {
+        lui_xml_pack_replay(scope->pack, scope->view_tokens, scope->view_token_cnt, scope->view_token_attrs,
+                            build_start_element_handler, build_end_element_handler, &ctx);
+    }
+    else {
+        XML_Memory_Handling_Suite mem_handlers;
+        mem_handlers.malloc_fcn = lv_malloc;
+        mem_handlers.realloc_fcn = lv_realloc;
+        mem_handlers.free_fcn = lv_free;
+        XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+        XML_SetUserData(parser, &ctx);
+        XML_SetElementHandler(parser, build_start_element_handler, build_end_element_handler);
+
+        if(XML_Parse(parser, scope->view_def, scope->view_def_len, XML_TRUE) == XML_STATUS_ERROR) {
+            LV_LOG_WARN("XML parsing error: %s on line %lu", XML_ErrorString(XML_GetErrorCode(parser)),
+                        (unsigned long)XML_GetCurrentLineNumber(parser));
+            ctx.error = true;
+        }
+        XML_ParserFree(parser);
+    }
+
+    if(ctx.error) return NULL;
+    return ctx.view;
+}
+
+static void build_start_element_handler(void * user_data, const char * name, const char ** attrs)
+{
+    build_ctx_t * ctx = (build_ctx_t *)user_data;
+    if(ctx->error) return;
+
+    node_t * node = lui_xml_arena_zalloc(ctx->arena, sizeof(node_t));
+    if(node == NULL) {
+        ctx->error = true;
+        return;
+    }
+
+    while(attrs[node->attr_cnt * 2]) node->attr_cnt++;
+    node->raw_attrs = copy_attrs(ctx->arena, attrs, node->attr_cnt);
+    node->attrs = copy_attrs(ctx->arena, node->raw_attrs, node->attr_cnt);
+    if(node->raw_attrs == NULL || node->attrs == NULL) {
+        ctx->error = true;
+        return;
+    }
+
+    /*Resolve the values as the creation does and keep a copy of the ones which were replaced*/
+    lui_xml_view_resolve_attrs(&ctx->state, node->attrs);
+    uint32_t i;
+    for(i = 0; i < node->attr_cnt * 2; i++) {
+        if(node->attrs[i] != node->raw_attrs[i]) {
+            node->attrs[i] = lui_xml_arena_strdup(ctx->arena, node->attrs[i]);
+            if(node->attrs[i] == NULL) {
+                ctx->error = true;
+                return;
+            }
+        }
+    }
+
+    if(ctx->cur == NULL) {
+        /*It's the `<view>`*/
+        const char * extends = lui_xml_get_value_of(node->raw_attrs, "extends");
+        node->tag = extends ? lui_xml_arena_strdup(ctx->arena, extends) : "lv_obj";
+        ctx->view = node;
+    }
+    else {
+        node->tag = lui_xml_arena_strdup(ctx->arena, name);
+        node->parent = ctx->cur;
+        if(ctx->cur->last_child) ctx->cur->last_child->next = node;
+        else ctx->cur->child = node;
+        ctx->cur->last_child = node;
+    }
+
+    if(node->tag == NULL) {
+        ctx->error = true;
+        return;
+    }
+
+    node->kind = get_kind(node->tag);
+    node->name = lui_xml_get_value_of(node->attrs, "name");
+    if(node->name && node->name[0] == '\0') node->name = NULL;
+
+    /*The view of the component is built with its own scope*/
+    if(node->kind == NODE_KIND_COMPONENT && node != ctx->view) {
+        node->scope = lui_xml_component_get_scope(node->tag);
+        node->view = build_view(ctx->arena, node->scope, ctx->scope, node->attrs);
+        if(node->view == NULL || !merge_instance_attrs(ctx->arena, node->view, node->attrs)) {
+            ctx->error = true;
+            return;
+        }
+
+        /*Views extending other components are not followed, the instance is recreated if it changes*/
+        if(node->view->kind != NODE_KIND_WIDGET) node->view = NULL;
+    }
+
+    ctx->cur = node;
+}
+
+static void build_end_element_handler(void * user_data, const char * name)
+{
+    LV_UNUSED(name);
+
+    build_ctx_t * ctx = (build_ctx_t *)user_data;
+    if(ctx->error || ctx->cur == NULL) return;
+
+    ctx->cur = ctx->cur->parent;
+}
+
+static const char ** copy_attrs(lui_xml_arena_t * arena, const char ** attrs, uint32_t attr_cnt)
+{
+    const char ** copy = lui_xml_arena_zalloc(arena, (attr_cnt * 2 + 2) * sizeof(const char *));
+    if(copy == NULL) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < attr_cnt * 2; i++) {
+        copy[i] = lui_xml_arena_strdup(arena, attrs[i]);
+        if(copy[i] == NULL) return NULL;
+    }
+
+    return copy;
+}
+
+/**
+ * Add the attributes of the instance to the ones of its `<view>`. They are applied later
+ * on creation so they replace the view's attributes with the same name.
+ * @param arena     allocate the new attribute list here
+ * @param view      the `<view>` node
+ * @param attrs     attributes of the instance or NULL
+ * @return          true: success, false: out of memory
+ */
+static bool merge_instance_attrs(lui_xml_arena_t * arena, node_t * view, const char ** attrs)
+{
+    if(attrs == NULL || attrs[0] == NULL) return true;
+
+    uint32_t attr_cnt = 0;
+    while(attrs[attr_cnt * 2]) attr_cnt++;
+
+    const char ** merged = lui_xml_arena_zalloc(arena, ((view->attr_cnt + attr_cnt) * 2 + 2) * sizeof(const char *));
+    if(merged == NULL) return false;
+
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < view->attr_cnt; i++) {
+        if(lui_xml_get_value_of(attrs, view->attrs[i * 2])) continue;
+        merged[cnt * 2] = view->attrs[i * 2];
+        merged[cnt * 2 + 1] = view->attrs[i * 2 + 1];
+        cnt++;
+    }
+
+    for(i = 0; i < attr_cnt; i++) {
+        merged[cnt * 2] = lui_xml_arena_strdup(arena, attrs[i * 2]);
+        merged[cnt * 2 + 1] = lui_xml_arena_strdup(arena, attrs[i * 2 + 1]);
+        if(merged[cnt * 2] == NULL || merged[cnt * 2 + 1] == NULL) return false;
+        cnt++;
+    }
+
+    view->attrs = merged;
+    view->attr_cnt = cnt;
+    return true;
+}
+
+static node_kind_t get_kind(const char * tag)
+{
+    if(lui_xml_widget_get_processor(tag)) {
+        /*The sub-elements are registered as e.g. `lv_obj-style`*/
+        const char * c;
+        for(c = tag; *c; c++) {
+            if(*c == '-') return NODE_KIND_SUB;
+        }
+        return NODE_KIND_WIDGET;
+    }
+
+    if(lui_xml_component_get_scope(tag)) return NODE_KIND_COMPONENT;
+
+    return NODE_KIND_SLOT;
+}
+
+/**
+ * Create the whole view in a widget without a previous render
+ * @param ctx       scope of the view
+ * @param view      the `<view>` node
+ * @param obj       the root widget
+ * @return          LV_RESULT_OK
+ */
+static lv_result_t render_view(view_ctx_t * ctx, node_t * view, lv_obj_t * obj)
+{
+    lv_obj_clean(obj);
+    if(ctx->scope->is_widget) lv_obj_remove_style_all(obj);
+
+    lui_xml_parser_state_t state;
+    lui_xml_parser_state_init(&state);
+    state.scope = *ctx->scope;
+    state.parent_scope = ctx->parent_scope;
+    state.parent_attrs = ctx->attrs;
+    state.parent = lv_obj_get_parent(obj);
+    state.item = obj;
+
+    lv_widget_processor_t * p = lui_xml_widget_get_processor(view->tag);
+    p->apply_cb(&state, view->attrs);
+    last_stats.attr_applied += view->attr_cnt;
+    view->obj = obj;
+
+    node_t * child;
+    for(child = view->child; child; child = child->next) {
+        create_node(ctx, child, obj);
+    }
+
+#if LV_USE_OBJ_NAME
+    if(ctx->scope->is_screen) {
+        lv_obj_set_name(obj, ctx->scope->name);
+        LUI_XML_UPDATE_INDEX_ADD(obj);
+    }
+#endif
+
+    lui_xml_create_timelines(obj, ctx->scope);
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Update the root widget to a new render
+ * @param ctx       scope of the view
+ * @param old_view  the `<view>` node of the previous render
+ * @param new_view  the `<view>` node of the new render
+ * @param obj       the root widget
+ * @return          LV_RESULT_OK: updated; LV_RESULT_INVALID: the root can't be updated, nothing was changed
+ */
+static lv_result_t update_view(view_ctx_t * ctx, node_t * old_view, node_t * new_view, lv_obj_t * obj)
+{
+    if(!lv_streq(old_view->tag, new_view->tag)) {
+        LV_LOG_WARN("The view extends '%s' instead of '%s'", new_view->tag, old_view->tag);
+        return LV_RESULT_INVALID;
+    }
+
+    /*The root can't be recreated so check it before changing anything*/
+    if(!subs_equal(old_view, new_view) || attrs_removed(old_view, new_view)) {
+        LV_LOG_WARN("An attribute or a sub-element of the root of '%s' changed", ctx->scope->name);
+        return LV_RESULT_INVALID;
+    }
+
+    int32_t prev_index = -1;
+    if(update_widget(ctx, old_view, new_view, &prev_index) == LV_RESULT_OK) return LV_RESULT_OK;
+
+    /*A slot of a child changed and the child couldn't be recreated. Recreate all the children.*/
+    lv_obj_clean(obj);
+    last_stats.obj_deleted += get_obj_child_count(old_view);
+
+    node_t * child;
+    for(child = new_view->child; child; child = child->next) {
+        if(child->kind != NODE_KIND_SUB) create_node(ctx, child, obj);
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Update a widget or component instance to a new render
+ * @param ctx       scope of the view containing the element
+ * @param old_node  node of the previous render, `obj` is set
+ * @param new_node  node of the new render
+ * @return          LV_RESULT_OK: updated; LV_RESULT_INVALID: it should be recreated
+ */
+static lv_result_t update_node(view_ctx_t * ctx, node_t * old_node, node_t * new_node)
+{
+    new_node->obj = old_node->obj;
+
+    int32_t prev_index = -1;
+    if(new_node->kind == NODE_KIND_WIDGET) {
+        return update_widget(ctx, old_node, new_node, &prev_index);
+    }
+
+    /*The view of the instance is not followed, so it's kept only if nothing changed*/
+    if(old_node->view == NULL || new_node->view == NULL) {
+        if(!node_equal(old_node, new_node)) return LV_RESULT_INVALID;
+        take_objs(old_node, new_node);
+        last_stats.obj_kept++;
+        last_stats.attr_skipped += count_attrs(new_node);
+        return LV_RESULT_OK;
+    }
+
+    /*Component instance: update its view with the component's scope, then the children of the instance*/
+    if(!lv_streq(old_node->view->tag, new_node->view->tag)) return LV_RESULT_INVALID;
+    if(!subs_equal(old_node, new_node)) return LV_RESULT_INVALID;
+
+    view_ctx_t comp_ctx;
+    comp_ctx.scope = new_node->scope;
+    comp_ctx.parent_scope = ctx->scope;
+    comp_ctx.attrs = new_node->attrs;
+
+    new_node->view->obj = new_node->obj;
+    if(update_widget(&comp_ctx, old_node->view, new_node->view, &prev_index) != LV_RESULT_OK) return LV_RESULT_INVALID;
+
+    return update_children(ctx, old_node, new_node, &prev_index);
+}
+
+/**
+ * Apply the changed attributes of a widget and update its children
+ * @param ctx           scope of the view containing the element
+ * @param old_node      node of the previous render, `obj` is set
+ * @param new_node      node of the new render, `obj` is set
+ * @param prev_index    index of the last updated child
+ * @return              LV_RESULT_OK: updated; LV_RESULT_INVALID: it should be recreated
+ */
+static lv_result_t update_widget(view_ctx_t * ctx, node_t * old_node, node_t * new_node, int32_t * prev_index)
+{
+    new_node->obj = old_node->obj;
+    if(!subs_equal(old_node, new_node)) return LV_RESULT_INVALID;
+    if(attrs_removed(old_node, new_node)) return LV_RESULT_INVALID;
+
+    apply_changed_attrs(ctx, old_node, new_node);
+    last_stats.obj_kept++;
+
+    node_t * sub;
+    for(sub = new_node->child; sub; sub = sub->next) {
+        if(sub->kind == NODE_KIND_SUB) {
+            sub->obj = new_node->obj;
+            last_stats.attr_skipped += count_attrs(sub);
+        }
+    }
+
+    return update_children(ctx, old_node, new_node, prev_index);
+}
+
+/**
+ * Match the children of the new render to the previous one and update, create, or delete them
+ * @param ctx           scope of the view containing the children
+ * @param old_node      node of the previous render
+ * @param new_node      node of the new render, `obj` is set
+ * @param prev_index    index of the last updated child
+ * @return              LV_RESULT_OK: updated; LV_RESULT_INVALID: the slots changed, the parent should be recreated
+ */
+static lv_result_t update_children(view_ctx_t * ctx, node_t * old_node, node_t * new_node, int32_t * prev_index)
+{
+    node_t * o;
+    node_t * n;
+    for(o = old_node->child; o; o = o->next) o->matched = false;
+
+    /*Match the children by type and name, or by order if they have no name*/
+    for(n = new_node->child; n; n = n->next) {
+        n->match = NULL;
+        if(n->kind == NODE_KIND_SUB) continue;
+
+        for(o = old_node->child; o; o = o->next) {
+            if(o->matched || (o->obj == NULL && o->kind != NODE_KIND_SLOT)) continue;
+            if(lv_streq(o->tag, n->tag) && str_equal(o->name, n->name)) {
+                o->matched = true;
+                n->match = o;
+                break;
+            }
+        }
+
+        /*The slots are part of the component, they can't be added or removed*/
+        if(n->kind == NODE_KIND_SLOT && n->match == NULL) return LV_RESULT_INVALID;
+    }
+
+    for(o = old_node->child; o; o = o->next) {
+        if(o->kind == NODE_KIND_SLOT && !o->matched) return LV_RESULT_INVALID;
+    }
+
+    for(o = old_node->child; o; o = o->next) {
+        if(o->matched || o->obj == NULL) continue;
+        if(o->kind == NODE_KIND_WIDGET || o->kind == NODE_KIND_COMPONENT) {
+            lv_obj_delete(o->obj);
+            last_stats.obj_deleted++;
+        }
+    }
+
+    for(n = new_node->child; n; n = n->next) {
+        if(n->kind == NODE_KIND_SUB) continue;
+
+        if(n->kind == NODE_KIND_SLOT) {
+            /*The widget of the slot belongs to the view of the component, so find it again*/
+            n->obj = get_slot_obj(n, new_node->obj);
+            int32_t slot_prev_index = -1;
+            if(!subs_equal(n->match, n)) return LV_RESULT_INVALID;
+            if(n->obj == NULL) continue;
+            if(update_children(ctx, n->match, n, &slot_prev_index) != LV_RESULT_OK) return LV_RESULT_INVALID;
+            continue;
+        }
+
+        if(n->match) {
+            if(update_node(ctx, n->match, n) != LV_RESULT_OK) {
+                lv_obj_delete(n->match->obj);
+                last_stats.obj_deleted++;
+                create_node(ctx, n, new_node->obj);
+            }
+        }
+        else {
+            create_node(ctx, n, new_node->obj);
+        }
+
+        if(n->obj) keep_order(n->obj, prev_index);
+    }
+
+    return LV_RESULT_OK;
+}
+
+static bool attrs_removed(const node_t * old_node, const node_t * new_node)
+{
+    uint32_t i;
+    for(i = 0; i < old_node->attr_cnt; i++) {
+        const char * name = old_node->attrs[i * 2];
+        if(name[0] == '\0') continue;
+        if(lui_xml_get_value_of(new_node->attrs, name) == NULL) return true;
+    }
+
+    return false;
+}
+
+static void apply_changed_attrs(view_ctx_t * ctx, const node_t * old_node, const node_t * new_node)
+{
+    /*Up to all the attributes can change*/
+    const char ** changed = lv_malloc((new_node->attr_cnt * 2 + 2) * sizeof(const char *));
+    LV_ASSERT_MALLOC(changed);
+    if(changed == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory");
+        return;
+    }
+
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < new_node->attr_cnt; i++) {
+        const char * name = new_node->attrs[i * 2];
+        const char * value = new_node->attrs[i * 2 + 1];
+        if(name[0] == '\0') continue;
+
+        const char * old_value = lui_xml_get_value_of(old_node->attrs, name);
+        if(old_value && lv_streq(old_value, value)) {
+            last_stats.attr_skipped++;
+            continue;
+        }
+
+        changed[cnt * 2] = name;
+        changed[cnt * 2 + 1] = value;
+        cnt++;
+    }
+    changed[cnt * 2] = NULL;
+    changed[cnt * 2 + 1] = NULL;
+
+    if(cnt) {
+        lui_xml_parser_state_t state;
+        lui_xml_parser_state_init(&state);
+        state.scope = *ctx->scope;
+        state.parent_scope = ctx->parent_scope;
+        state.parent_attrs = ctx->attrs;
+        state.parent = lv_obj_get_parent(new_node->obj);
+        state.item = new_node->obj;
+
+        lv_widget_processor_t * p = lui_xml_widget_get_processor(new_node->tag);
+        p->apply_cb(&state, changed);
+        last_stats.attr_applied += cnt;
+    }
+
+    lv_free(changed);
+}
+
+/**
+ * Check if the sub-elements of two nodes are the same
+ */
+static bool subs_equal(const node_t * a, const node_t * b)
+{
+    const node_t * sa = a->child;
+    const node_t * sb = b->child;
+    while(true) {
+        while(sa && sa->kind != NODE_KIND_SUB) sa = sa->next;
+        while(sb && sb->kind != NODE_KIND_SUB) sb = sb->next;
+        if(sa == NULL || sb == NULL) return sa == sb;
+        if(!node_equal(sa, sb)) return false;
+        sa = sa->next;
+        sb = sb->next;
+    }
+}
+
+static bool node_equal(const node_t * a, const node_t * b)
+{
+    if(!lv_streq(a->tag, b->tag) || a->attr_cnt != b->attr_cnt) return false;
+
+    uint32_t i;
+    for(i = 0; i < a->attr_cnt * 2; i++) {
+        if(!lv_streq(a->attrs[i], b->attrs[i])) return false;
+    }
+
+    const node_t * ca = a->child;
+    const node_t * cb = b->child;
+    while(ca && cb) {
+        if(!node_equal(ca, cb)) return false;
+        ca = ca->next;
+        cb = cb->next;
+    }
+
+    return ca == cb;
+}
+
+/**
+ * Create an element and its children as the creation of the component does
+ * @param ctx       scope of the view containing the element
+ * @param node      the element to create
+ * @param parent    the parent widget
+ */
+static void create_node(view_ctx_t * ctx, node_t * node, lv_obj_t * parent)
+{
+    /*Forget the widgets of a failed update, they are deleted*/
+    clear_objs(node);
+
+    lui_xml_parser_state_t state;
+    lui_xml_parser_state_init(&state);
+    state.scope = *ctx->scope;
+    state.parent = parent;
+    state.parent_attrs = ctx->attrs;
+    state.parent_scope = ctx->parent_scope;
+
+    lv_obj_t ** parent_node = lv_ll_ins_head(&state.parent_ll);
+    *parent_node = parent;
+
+    lv_obj_t * obj = replay_node(&state, node);
+    lv_ll_clear(&state.parent_ll);
+
+    last_stats.attr_applied += count_attrs(node);
+    if(node->kind == NODE_KIND_SUB) {
+        node->obj = parent;
+        return;
+    }
+
+    if(obj == NULL) return;
+
+    if(node->kind == NODE_KIND_SLOT) {
+        node->obj = obj;
+        attach_children(node, obj, 0);
+        return;
+    }
+
+    attach_node(node, obj);
+    last_stats.obj_created++;
+}
+
+static lv_obj_t * replay_node(lui_xml_parser_state_t * state, const node_t * node)
+{
+    /*The values are resolved in place so pass a copy*/
+    size_t attrs_size = (node->attr_cnt * 2 + 2) * sizeof(const char *);
+    const char ** attrs = lv_malloc(attrs_size);
+    LV_ASSERT_MALLOC(attrs);
+    if(attrs == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory");
+        return NULL;
+    }
+    lv_memcpy(attrs, node->raw_attrs, attrs_size);
+
+    lui_xml_view_start_element(state, node->tag, attrs);
+    lv_free(attrs);
+
+    /*Unknown elements are not opened*/
+    lv_obj_t * item = state->item;
+    if(item == NULL) return NULL;
+
+    const node_t * child;
+    for(child = node->child; child; child = child->next) {
+        replay_node(state, child);
+    }
+
+    lui_xml_view_end_element(state, node->tag);
+
+    return item;
+}
+
+/**
+ * Find the widgets created for the elements by the creation of the component.
+ * The children from the view are created before the ones of the instance,
+ * so they are found from the end of the parent's children.
+ * @param node      a widget or component instance
+ * @param obj       the widget created for it
+ */
+static void attach_node(node_t * node, lv_obj_t * obj)
+{
+    node->obj = obj;
+
+    uint32_t instance_child_cnt = get_obj_child_count(node);
+    if(node->kind == NODE_KIND_COMPONENT && node->view) {
+        node->view->obj = obj;
+        attach_children(node->view, obj, instance_child_cnt);
+    }
+
+    attach_children(node, obj, 0);
+}
+
+static void attach_children(node_t * node, lv_obj_t * obj, uint32_t tail_skip)
+{
+    uint32_t cnt = get_obj_child_count(node);
+    uint32_t obj_child_cnt = lv_obj_get_child_count(obj);
+    int32_t index = (int32_t)obj_child_cnt - (int32_t)(tail_skip + cnt);
+
+    node_t * child;
+    for(child = node->child; child; child = child->next) {
+        if(child->kind == NODE_KIND_SUB) {
+            child->obj = obj;
+        }
+        else if(child->kind == NODE_KIND_SLOT) {
+            child->obj = get_slot_obj(child, obj);
+            if(child->obj) attach_children(child, child->obj, 0);
+        }
+        else {
+            if(index >= 0) attach_node(child, lv_obj_get_child(obj, index));
+            index++;
+        }
+    }
+}
+
+/**
+ * Find the widget of a slot by name as the creation does, e.g. `my_card-content`
+ * @param slot      the slot node
+ * @param obj       the widget of the component instance
+ * @return          the widget of the slot or NULL if not found
+ */
+static lv_obj_t * get_slot_obj(const node_t * slot, lv_obj_t * obj)
+{
+    const char * slot_name = slot->tag;
+    while(*slot_name && *slot_name != '-') slot_name++;
+    return *slot_name ? lv_obj_find_by_name(obj, slot_name + 1) : NULL;
+}
+
+static void clear_objs(node_t * node)
+{
+    node->obj = NULL;
+    if(node->view) clear_objs(node->view);
+
+    node_t * child;
+    for(child = node->child; child; child = child->next) clear_objs(child);
+}
+
+/**
+ * Make the child widgets of a render clear the `obj` of their node when they are deleted
+ * @param node      the `<view>` node or an element of the render
+ */
+static void link_nodes(node_t * node)
+{
+    node_t * child;
+    for(child = node->child; child; child = child->next) {
+        if((child->kind == NODE_KIND_WIDGET || child->kind == NODE_KIND_COMPONENT) && child->obj) {
+            node_link_t * link = get_link(child->obj);
+            if(link == NULL) {
+                link = lv_malloc(sizeof(node_link_t));
+                LV_ASSERT_MALLOC(link);
+                if(link == NULL) {
+                    LV_LOG_WARN("Couldn't allocate memory");
+                    continue;
+                }
+                lv_obj_add_event_cb(child->obj, node_delete_event_cb, LV_EVENT_DELETE, link);
+            }
+            link->node = child;
+        }
+
+        if(child->view) link_nodes(child->view);
+        link_nodes(child);
+    }
+}
+
+/**
+ * Detach the child widgets from the nodes of a render which is freed
+ * @param node      the `<view>` node or an element of the render
+ */
+static void unlink_nodes(node_t * node)
+{
+    node_t * child;
+    for(child = node->child; child; child = child->next) {
+        if((child->kind == NODE_KIND_WIDGET || child->kind == NODE_KIND_COMPONENT) && child->obj) {
+            /*The widgets kept by the new render are linked to its nodes already*/
+            node_link_t * link = get_link(child->obj);
+            if(link && link->node == child) link->node = NULL;
+        }
+
+        if(child->view) unlink_nodes(child->view);
+        unlink_nodes(child);
+    }
+}
+
+static void take_objs(const node_t * old_node, node_t * new_node)
+{
+    new_node->obj = old_node->obj;
+
+    const node_t * o = old_node->child;
+    node_t * n = new_node->child;
+    while(o && n) {
+        take_objs(o, n);
+        o = o->next;
+        n = n->next;
+    }
+}
+
+static uint32_t get_obj_child_count(const node_t * node)
+{
+    uint32_t cnt = 0;
+    const node_t * child;
+    for(child = node->child; child; child = child->next) {
+        if(child->kind == NODE_KIND_WIDGET || child->kind == NODE_KIND_COMPONENT) cnt++;
+    }
+
+    return cnt;
+}
+
+static uint32_t count_attrs(const node_t * node)
+{
+    /*The attributes of an instance are counted with the ones of its view*/
+    uint32_t cnt = 0;
+    if(node->view) {
+        cnt += count_attrs(node->view);
+    }
+    else {
+        uint32_t i;
+        for(i = 0; i < node->attr_cnt; i++) {
+            if(node->attrs[i * 2][0] != '\0') cnt++;
+        }
+    }
+
+    const node_t * child;
+    for(child = node->child; child; child = child->next) {
+        cnt += count_attrs(child);
+    }
+
+    return cnt;
+}
+
+/**
+ * Move a child after the previously updated one if it's before it
+ * @param obj           the updated or created child
+ * @param prev_index    index of the previous child, updated to the index of `obj`
+ */
+static void keep_order(lv_obj_t * obj, int32_t * prev_index)
+{
+    int32_t index = lv_obj_get_index(obj);
+    if(index < *prev_index) {
+        /*`prev_index` is shifted down when `obj` is removed from before it*/
+        lv_obj_move_to_index(obj, *prev_index);
+    }
+    else {
+        *prev_index = index;
+    }
+}
+
+static bool str_equal(const char * a, const char * b)
+{
+    if(a == NULL || b == NULL) return a == b;
+    return lv_streq(a, b);
+}
+
+static render_t * get_render(lv_obj_t * obj)
+{
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        if(lv_event_dsc_get_cb(dsc) == render_delete_event_cb) return lv_event_dsc_get_user_data(dsc);
+    }
+
+    return NULL;
+}
+
+static void render_delete_event_cb(lv_event_t * e)
+{
+    /*The children are deleted after the root, detach them from the freed nodes*/
+    render_t * render = lv_event_get_user_data(e);
+    unlink_nodes(render->view);
+    lui_xml_arena_destroy(&render->arena);
+    lv_free(render);
+}
+
+static node_link_t * get_link(lv_obj_t * obj)
+{
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        if(lv_event_dsc_get_cb(dsc) == node_delete_event_cb) return lv_event_dsc_get_user_data(dsc);
+    }
+
+    return NULL;
+}
+
+static void node_delete_event_cb(lv_event_t * e)
+{
+    node_link_t * link = lv_event_get_user_data(e);
+    if(link->node) link->node->obj = NULL;
+    lv_free(link);
+}
+
+#endif /* LV_USE_XML */
@@ -0,0 +1,80 @@
+/**
+ * @file lui_xml_reconcile.h
+ *
+ */
+
+#ifndef LUI_XML_RECONCILE_H
+#define LUI_XML_RECONCILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * What the last `lui_xml_reconcile()` did. Applying an attribute is counted as one setter call.
+ */
+typedef struct {
+    uint32_t attr_applied;      /**< Attributes applied, including the ones of the created widgets*/
+    uint32_t attr_skipped;      /**< Attributes not applied because they didn't change*/
+    uint32_t obj_kept;          /**< Widgets and components which were updated in place*/
+    uint32_t obj_created;       /**< Widgets and components created (not counting their children)*/
+    uint32_t obj_deleted;       /**< Widgets and components deleted (not counting their children)*/
+} lui_xml_reconcile_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Render the view of a component into an existing widget, changing only what's different
+ * from the previous render. The elements of the view are matched to the ones of the previous
+ * render by their type and `name` (or their order if they have no name). Only the changed
+ * attributes are applied, and only the added or removed elements are created or deleted.
+ * The widgets which didn't change keep their styles, scroll position, etc.
+ *
+ * The first call deletes the children of `root_obj` and creates the whole view in it.
+ * If an attribute is removed, or a sub-element (e.g. `<lv_obj-style>`) changes, the widget
+ * owning it is created again. Components extending other components are created again
+ * if anything changes in them.
+ * @param root_obj  the widget to render into. It should have the type the view extends,
+ *                  e.g. a screen for `<screen>`s. The widgets of the view shouldn't be
+ *                  deleted by other means.
+ * @param name      name of a registered component or screen
+ * @param attrs     attributes of the instance, e.g. `{"title", "Settings", NULL, NULL}`. Can be NULL.
+ * @return          LV_RESULT_OK: rendered; LV_RESULT_INVALID: the component doesn't exist, or the type or the
+ *                  sub-elements of the root element changed, or one of its attributes was removed.
+ *                  Nothing is changed in this case.
+ */
+lv_result_t lui_xml_reconcile(lv_obj_t * root_obj, const char * name, const char ** attrs);
+
+/**
+ * Get what the last `lui_xml_reconcile()` did
+ * @param stats     store the result here
+ */
+void lui_xml_reconcile_get_stats(lui_xml_reconcile_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_RECONCILE_H*/
@@ -0,0 +1,516 @@
+/**
+ * @file lui_xml_reload.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_reload_private.h"
+#if LV_USE_XML && LUI_XML_USE_RELOAD
+
+#include "lui_xml_private.h"
+#include "lui_xml_component_private.h"
+#include "lui_xml_load_private.h"
+#include "lui_xml_pack_private.h"
+#include "lui_xml_doc.h"
+#include "lui_xml_utils.h"
+#include "../core/lv_obj_private.h"
+#include "../display/lv_display_private.h"
+#include "../misc/lv_fs.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define HASH_BUF_SIZE       512
+#define MAX_USE_DEPTH       16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** What is known about a loaded file*/
+typedef struct {
+    char * path;
+    uint32_t size;
+    uint32_t hash;
+    uint64_t stamp;
+    uint32_t has_stamp : 1;
+    uint32_t seen : 1;          /**< Found while reloading its directory*/
+} reload_file_t;
+
+/** A file to register again*/
+typedef struct {
+    char * path;
+    char * name;
+    reload_file_t info;         /**< The new size, hash and stamp*/
+    bool removed;
+    bool is_component;
+} reload_change_t;
+
+typedef struct {
+    reload_change_t * changes;
+    uint32_t change_cnt;
+    uint32_t change_cap;
+    lv_result_t res;
+} reload_ctx_t;
+
+typedef struct {
+    lv_obj_t * screen;
+    const char * name;
+} reload_screen_t;
+
+typedef struct {
+    const char * target;
+    uint32_t depth;
+    bool found;
+} use_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void check_file_cb(const char * path, void * user_data);
+static bool get_file_info(const char * path, reload_file_t * info);
+static reload_file_t * file_find(const char * path, uint32_t * index);
+static void file_update(const char * path, const reload_file_t * info);
+static void file_remove(reload_file_t * file);
+static bool path_is_in_dir(const char * path, const char * dir);
+static bool change_add(reload_ctx_t * ctx, const char * path, const reload_file_t * info, bool removed);
+static uint32_t collect_screens(reload_ctx_t * ctx, reload_screen_t ** screens);
+#if LV_USE_OBJ_NAME
+    static const char * obj_uses_changed(lv_obj_t * obj, reload_ctx_t * ctx);
+#endif
+static bool scope_uses(lui_xml_component_scope_t * scope, const char * target, uint32_t depth);
+static void use_start_handler(void * user_data, const char * name, const char ** attrs);
+static void use_end_handler(void * user_data, const char * name);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static reload_file_t * files;       /**< Sorted by path to find them quickly*/
+static uint32_t file_cnt;
+static uint32_t file_cap;
+static lui_xml_reload_stamp_cb_t stamp_cb;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lui_xml_reload_changed(const char * path, lui_xml_reload_cb_t cb, void * user_data)
+{
+    reload_ctx_t ctx;
+    lv_memzero(&ctx, sizeof(ctx));
+    ctx.res = LV_RESULT_OK;
+
+    uint32_t i;
+    for(i = 0; i < file_cnt; i++) {
+        files[i].seen = 0;
+    }
+
+    /*Only the files are read here, nothing is registered yet*/
+    if(lui_xml_load_for_each_file(path, check_file_cb, &ctx) != LV_RESULT_OK) ctx.res = LV_RESULT_INVALID;
+
+    /*The files which were not found anymore. Not if the directory couldn't be read.*/
+    for(i = 0; ctx.res == LV_RESULT_OK && i < file_cnt; i++) {
+        if(!files[i].seen && path_is_in_dir(files[i].path, path)) {
+            if(!change_add(&ctx, files[i].path, NULL, true)) ctx.res = LV_RESULT_INVALID;
+        }
+    }
+
+    if(ctx.change_cnt == 0) {
+        lv_free(ctx.changes);
+        return ctx.res;
+    }
+
+    /*Report the screens before unregistering the old definitions as they still use them*/
+    reload_screen_t * screens = NULL;
+    uint32_t screen_cnt = collect_screens(&ctx, &screens);
+    for(i = 0; cb && i < screen_cnt; i++) {
+        cb(screens[i].name, screens[i].screen, user_data);
+    }
+    lv_free(screens);
+
+    lui_xml_load_set_asset_path_to_dir(path);
+
+    for(i = 0; i < ctx.change_cnt; i++) {
+        reload_change_t * change = &ctx.changes[i];
+        if(change->removed) {
+            LV_LOG_INFO("%s was removed", change->path);
+            if(change->is_component && !lv_streq(change->name, "globals")) {
+                lui_xml_unregister_component(change->name);
+            }
+            uint32_t index;
+            reload_file_t * file = file_find(change->path, &index);
+            if(file) file_remove(file);
+        }
+        else {
+            if(change->is_component && !lv_streq(change->name, "globals")) {
+                LV_LOG_INFO("Registering %s again", change->path);
+                lui_xml_unregister_component(change->name);
+                lui_xml_load_file(change->path);
+            }
+            else {
+                LV_LOG_WARN("%s changed but only components can be registered again", change->path);
+            }
+            file_update(change->path, &change->info);
+        }
+
+        lv_free(change->path);
+        lv_free(change->name);
+    }
+
+    lv_free(ctx.changes);
+
+    return ctx.res;
+}
+
+void lui_xml_reload_set_stamp_cb(lui_xml_reload_stamp_cb_t cb)
+{
+    stamp_cb = cb;
+}
+
+void lui_xml_reload_track(const char * path)
+{
+    reload_file_t info;
+    if(get_file_info(path, &info)) file_update(path, &info);
+}
+
+void lui_xml_reload_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < file_cnt; i++) {
+        lv_free(files[i].path);
+    }
+
+    lv_free(files);
+    files = NULL;
+    file_cnt = 0;
+    file_cap = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void check_file_cb(const char * path, void * user_data)
+{
+    reload_ctx_t * ctx = user_data;
+
+    uint32_t index;
+    reload_file_t * file = file_find(path, &index);
+    if(file) file->seen = 1;
+
+    /*Don't even read the file if its stamp is the same*/
+    uint64_t stamp;
+    if(file && file->has_stamp && stamp_cb && stamp_cb(path, &stamp) && stamp == file->stamp) return;
+
+    reload_file_t info;
+    if(!get_file_info(path, &info)) {
+        ctx->res = LV_RESULT_INVALID;
+        return;
+    }
+
+    if(file && file->size == info.size && file->hash == info.hash) {
+        /*Only touched, remember the new stamp to skip it next time*/
+        file->stamp = info.stamp;
+        file->has_stamp = info.has_stamp;
+        return;
+    }
+
+    if(!change_add(ctx, path, &info, false)) ctx->res = LV_RESULT_INVALID;
+}
+
+/**
+ * Read a file to get its size and hash
+ * @param path      path to the file
+ * @param info      store the result here
+ * @return          true: the file could be read, false: otherwise
+ */
+static bool get_file_info(const char * path, reload_file_t * info)
+{
+    lv_memzero(info, sizeof(reload_file_t));
+    if(stamp_cb) info->has_stamp = stamp_cb(path, &info->stamp);
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't open %s", path);
+        return false;
+    }
+
+    /*FNV-1a*/
+    uint32_t hash = 2166136261u;
+    uint8_t buf[HASH_BUF_SIZE];
+    lv_fs_res_t res;
+    while(1) {
+        uint32_t rn = 0;
+        res = lv_fs_read(&f, buf, sizeof(buf), &rn);
+        if(res != LV_FS_RES_OK || rn == 0) break;
+
+        uint32_t i;
+        for(i = 0; i < rn; i++) {
+            hash = (hash ^ buf[i]) * 16777619u;
+        }
+        info->size += rn;
+    }
+
+    lv_fs_close(&f);
+    info->hash = hash;
+
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't read %s", path);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Find a tracked file with binary search
+ * @param path      path of the file
+ * @param index     store the index of the file or where it should be inserted
+ * @return          the file or NULL if it's not tracked
+ */
+static reload_file_t * file_find(const char * path, uint32_t * index)
+{
+    uint32_t lo = 0;
+    uint32_t hi = file_cnt;
+    while(lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int32_t cmp = lv_strcmp(files[mid].path, path);
+        if(cmp == 0) {
+            *index = mid;
+            return &files[mid];
+        }
+        if(cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    *index = lo;
+    return NULL;
+}
+
+static void file_update(const char * path, const reload_file_t * info)
+{
+    uint32_t index;
+    reload_file_t * file = file_find(path, &index);
+    if(file == NULL) {
+        if(file_cnt == file_cap) {
+            uint32_t new_cap = file_cap ? file_cap * 2 : 16;
+            reload_file_t * new_files = lv_realloc(files, new_cap * sizeof(reload_file_t));
+            LV_ASSERT_MALLOC(new_files);
+            if(new_files == NULL) return;
+            files = new_files;
+            file_cap = new_cap;
+        }
+
+        char * path_copy = lv_strdup(path);
+        LV_ASSERT_MALLOC(path_copy);
+        if(path_copy == NULL) return;
+
+        lv_memmove(&files[index + 1], &files[index], (file_cnt - index) * sizeof(reload_file_t));
+        file_cnt++;
+        file = &files[index];
+        file->path = path_copy;
+    }
+
+    file->size = info->size;
+    file->hash = info->hash;
+    file->stamp = info->stamp;
+    file->has_stamp = info->has_stamp;
+    file->seen = 1;
+}
+
+static void file_remove(reload_file_t * file)
+{
+    lv_free(file->path);
+
+    uint32_t index = file - files;
+    lv_memmove(&files[index], &files[index + 1], (file_cnt - index - 1) * sizeof(reload_file_t));
+    file_cnt--;
+}
+
+static bool path_is_in_dir(const char * path, const char * dir)
+{
+    size_t dir_len = lv_strlen(dir);
+    if(lv_strlen(path) <= dir_len || lv_memcmp(path, dir, dir_len) != 0) return false;
+
+    /*Not "A:dir_2/file.xml" for "A:dir"*/
+    char last = dir_len ? dir[dir_len - 1] : '\0';
+    if(last == '/' || last == '\\' || last == ':') return true;
+    return path[dir_len] == '/' || path[dir_len] == '\\';
+}
+
+static bool change_add(reload_ctx_t * ctx, const char * path, const reload_file_t * info, bool removed)
+{
+    if(ctx->change_cnt == ctx->change_cap) {
+        uint32_t new_cap = ctx->change_cap ? ctx->change_cap * 2 : 8;
+        reload_change_t * new_changes = lv_realloc(ctx->changes, new_cap * sizeof(reload_change_t));
+        LV_ASSERT_MALLOC(new_changes);
+        if(new_changes == NULL) return false;
+        ctx->changes = new_changes;
+        ctx->change_cap = new_cap;
+    }
+
+    reload_change_t * change = &ctx->changes[ctx->change_cnt];
+    lv_memzero(change, sizeof(reload_change_t));
+    change->path = lv_strdup(path);
+    change->name = lui_xml_load_get_component_name(path);
+    if(change->path == NULL || change->name == NULL) {
+        lv_free(change->path);
+        lv_free(change->name);
+        return false;
+    }
+
+    change->removed = removed;
+    if(info) change->info = *info;
+
+    /*A removed file can't be read anymore. Unregistering it does nothing if it wasn't a component.*/
+    change->is_component = removed ? true : lui_xml_load_file_is_component(path);
+
+    ctx->change_cnt++;
+    return true;
+}
+
+/**
+ * Find the live screens which use a changed component
+ * @param ctx       the context with the changes
+ * @param screens   store the screens here (free with `lv_free()`)
+ * @return          number of screens
+ */
+static uint32_t collect_screens(reload_ctx_t * ctx, reload_screen_t ** screens)
+{
+    *screens = NULL;
+
+#if LV_USE_OBJ_NAME
+    uint32_t cnt = 0;
+    lv_display_t * disp;
+    for(disp = lv_display_get_next(NULL); disp; disp = lv_display_get_next(disp)) {
+        uint32_t i;
+        for(i = 0; i < disp->screen_cnt; i++) {
+            const char * name = obj_uses_changed(disp->screens[i], ctx);
+            if(name == NULL) continue;
+
+            reload_screen_t * new_screens = lv_realloc(*screens, (cnt + 1) * sizeof(reload_screen_t));
+            LV_ASSERT_MALLOC(new_screens);
+            if(new_screens == NULL) return cnt;
+            *screens = new_screens;
+            (*screens)[cnt].screen = disp->screens[i];
+            (*screens)[cnt].name = name;
+            cnt++;
+        }
+    }
+
+    return cnt;
+#else
+    LV_UNUSED(ctx);
+    LV_LOG_WARN("LV_USE_OBJ_NAME is required to find the screens using the changed components");
+    return 0;
+#endif
+}
+
+#if LV_USE_OBJ_NAME
+/**
+ * Check if an object or its children were created from a changed component.
+ * The objects are recognized by the names `lui_xml_create()` gives them.
+ * @param obj       the object to check
+ * @param ctx       the context with the changes
+ * @return          name of the first changed component it uses or NULL
+ */
+static const char * obj_uses_changed(lv_obj_t * obj, reload_ctx_t * ctx)
+{
+    const char * obj_name = lv_obj_get_name(obj);
+    if(obj_name) {
+        /*E.g. "my_button_#" for an instance or "home" for a screen*/
+        size_t len = lv_strlen(obj_name);
+        if(len >= 2 && lv_streq(&obj_name[len - 2], "_#")) len -= 2;
+
+        char base[LUI_XML_MAX_PATH_LENGTH];
+        lv_strlcpy(base, obj_name, LV_MIN(len + 1, sizeof(base)));
+
+        lui_xml_component_scope_t * scope = lui_xml_component_find_scope(base);
+        uint32_t i;
+        for(i = 0; i < ctx->change_cnt; i++) {
+            const char * changed = ctx->changes[i].name;
+            if(lv_streq(base, changed)) return changed;
+            if(scope && scope_uses(scope, changed, 0)) return changed;
+        }
+    }
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_count(obj); i++) {
+        const char * changed = obj_uses_changed(lv_obj_get_child(obj, i), ctx);
+        if(changed) return changed;
+    }
+
+    return NULL;
+}
+#endif
+
+/**
+ * Check if a component extends or contains another component, directly or indirectly
+ * @param scope     the scope of the component
+ * @param target    name of the other component
+ * @param depth     depth of the recursion
+ * @return          true: `target` is used by the component
+ */
+static bool scope_uses(lui_xml_component_scope_t * scope, const char * target, uint32_t depth)
+{
+    if(depth >= MAX_USE_DEPTH) return false;
+
+    use_ctx_t ctx;
+    ctx.target = target;
+    ctx.depth = depth;
+    ctx.found = false;
+
+    if(scope->view_tokens) {
+        lui_xml_pack_replay(scope->pack, scope->view_tokens, scope->view_token_cnt, scope->view_token_attrs,
+                            use_start_handler, use_end_handler, &ctx);
+    }
+    else if(scope->view_def) {
+        lui_xml_doc_t doc;
+        lui_xml_doc_init(&doc);
+        if(lui_xml_doc_tokenize(&doc, scope->view_def, scope->view_def_len, true) == LV_RESULT_OK) {
+            lui_xml_doc_replay(&doc, use_start_handler, use_end_handler, &ctx);
+        }
+        lui_xml_doc_destroy(&doc);
+    }
+
+    return ctx.found;
+}
+
+static void use_start_handler(void * user_data, const char * name, const char ** attrs)
+{
+    use_ctx_t * ctx = user_data;
+    if(ctx->found) return;
+
+    if(lv_streq(name, "view")) {
+        name = lui_xml_get_value_of(attrs, "extends");
+        if(name == NULL) return;
+    }
+
+    if(lv_streq(name, ctx->target)) {
+        ctx->found = true;
+        return;
+    }
+
+    lui_xml_component_scope_t * scope = lui_xml_component_find_scope(name);
+    if(scope && scope_uses(scope, ctx->target, ctx->depth + 1)) ctx->found = true;
+}
+
+static void use_end_handler(void * user_data, const char * name)
+{
+    LV_UNUSED(user_data);
+    LV_UNUSED(name);
+}
+
+#endif /* LV_USE_XML && LUI_XML_USE_RELOAD */
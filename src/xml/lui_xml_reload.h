@@ -0,0 +1,92 @@
+/**
+ * @file lui_xml_reload.h
+ *
+ */
+
+#ifndef LUI_XML_RELOAD_H
+#define LUI_XML_RELOAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: remember the size and hash of the loaded files to reload only the changed ones later.
+ *  Loading a directory reads every file once more to hash it.*/
+#ifndef LUI_XML_USE_RELOAD
+#define LUI_XML_USE_RELOAD 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Called for each live screen which uses a changed component
+ * @param name          name of the changed component
+ * @param screen        the screen which was created with the old definition of the component
+ * @param user_data     the `user_data` of `lui_xml_reload_changed()`
+ */
+typedef void (*lui_xml_reload_cb_t)(const char * name, lv_obj_t * screen, void * user_data);
+
+/**
+ * Get a stamp of a file which changes when the file changes, e.g. its modification time
+ * @param path      lv_fs path of the file
+ * @param stamp     store the stamp here
+ * @return          true: `stamp` is set, false: the stamp is not known
+ */
+typedef bool (*lui_xml_reload_stamp_cb_t)(const char * path, uint64_t * stamp);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_RELOAD
+
+/**
+ * Register again only the files of a directory which changed since they were loaded
+ * by `lui_xml_load_all_from_path()` or the last call of this function.
+ * The changed and new components are unregistered and registered again,
+ * the components of deleted files are unregistered.
+ * Changed `globals.xml` and translation files can't be registered again, they are only reported.
+ * @param path          the path of the directory, the same as when it was loaded
+ * @param cb            called for each live screen which uses a changed component,
+ *                      before the component is registered again. The screen uses the styles
+ *                      of the old definition, so it needs to be deleted in the callback and
+ *                      created again after this function returns. Can be NULL.
+ * @param user_data     passed to `cb`
+ * @return              LV_RESULT_OK: the directory was read, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_reload_changed(const char * path, lui_xml_reload_cb_t cb, void * user_data);
+
+/**
+ * Set a function which tells cheaply whether a file changed, e.g. based on its modification time.
+ * The files whose stamp is the same as before are not read when reloading.
+ * Without it every file is read and hashed to find the changed ones,
+ * as `lv_fs` doesn't provide the modification time.
+ * @param cb        the function, or NULL to hash all the files
+ */
+void lui_xml_reload_set_stamp_cb(lui_xml_reload_stamp_cb_t cb);
+
+#endif /*LUI_XML_USE_RELOAD*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_RELOAD_H*/
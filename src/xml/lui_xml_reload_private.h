@@ -0,0 +1,57 @@
+/**
+ * @file lui_xml_reload_private.h
+ *
+ */
+
+#ifndef LUI_XML_RELOAD_PRIVATE_H
+#define LUI_XML_RELOAD_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_reload.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LUI_XML_USE_RELOAD
+
+/**
+ * Remember the size and hash of a file which was loaded, to find out later if it changed
+ * @param path      path to the file
+ */
+void lui_xml_reload_track(const char * path);
+
+/**
+ * Forget all the tracked files
+ */
+void lui_xml_reload_deinit(void);
+
+#endif /*LUI_XML_USE_RELOAD*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_XML*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_RELOAD_PRIVATE_H*/
@@ -0,0 +1,136 @@
+/**
+ * @file lui_xml_stream.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_stream.h"
+#if LV_USE_XML
+
+#include "lui_xml.h"
+#include "lui_xml_profile_private.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lui_xml_parse_file_stream(XML_Parser parser, const char * path, lui_xml_stream_chunk_cb_t chunk_cb,
+                                      void * user_data)
+{
+    lui_xml_stream_t stream;
+    lv_result_t res = lui_xml_stream_open(&stream, path);
+    if(res != LV_RESULT_OK) return res;
+
+    res = lui_xml_stream_parse(&stream, parser, chunk_cb, user_data);
+    lui_xml_stream_close(&stream);
+
+    return res;
+}
+
+lv_result_t lui_xml_stream_open(lui_xml_stream_t * stream, const char * path)
+{
+    lv_memzero(stream, sizeof(lui_xml_stream_t));
+    stream->path = path;
+
+    LUI_XML_PROFILE_BEGIN(READ);
+    lv_fs_res_t fs_res = lv_fs_open(&stream->file, path, LV_FS_MODE_RD);
+    if(fs_res != LV_FS_RES_OK) {
+        LUI_XML_PROFILE_END();
+        LV_LOG_WARN("Couldn't open %s", path);
+        return LV_RESULT_INVALID;
+    }
+
+    stream->buf = lv_malloc(LUI_XML_STREAM_BUF_SIZE);
+    LV_ASSERT_MALLOC(stream->buf);
+    if(stream->buf == NULL) {
+        LUI_XML_PROFILE_END();
+        LV_LOG_WARN("Memory allocation failed for reading %s", path);
+        lv_fs_close(&stream->file);
+        return LV_RESULT_INVALID;
+    }
+
+    /*Read the first chunk already so that it can be inspected before parsing*/
+    fs_res = lv_fs_read(&stream->file, stream->buf, LUI_XML_STREAM_BUF_SIZE, &stream->buf_len);
+    LUI_XML_PROFILE_END();
+    if(fs_res != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't read %s", path);
+        lui_xml_stream_close(stream);
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lui_xml_stream_parse(lui_xml_stream_t * stream, XML_Parser parser, lui_xml_stream_chunk_cb_t chunk_cb,
+                                 void * user_data)
+{
+    uint32_t offset = 0;
+    while(1) {
+        uint32_t rn = stream->buf_len;
+        bool is_final = rn == 0;
+        LUI_XML_PROFILE_BEGIN(PARSE);
+        enum XML_Status status = XML_Parse(parser, stream->buf, rn, is_final);
+        LUI_XML_PROFILE_END();
+        if(status == XML_STATUS_ERROR) {
+            LV_LOG_WARN("XML parsing error: %s on line %lu in %s",
+                        XML_ErrorString(XML_GetErrorCode(parser)),
+                        (unsigned long)XML_GetCurrentLineNumber(parser), stream->path);
+            return LV_RESULT_INVALID;
+        }
+
+        if(is_final) return LV_RESULT_OK;
+
+        if(chunk_cb) chunk_cb(stream->buf, rn, offset, user_data);
+        offset += rn;
+
+        LUI_XML_PROFILE_BEGIN(READ);
+        lv_fs_res_t fs_res = lv_fs_read(&stream->file, stream->buf, LUI_XML_STREAM_BUF_SIZE, &stream->buf_len);
+        LUI_XML_PROFILE_END();
+        if(fs_res != LV_FS_RES_OK) {
+            LV_LOG_WARN("Couldn't read %s", stream->path);
+            return LV_RESULT_INVALID;
+        }
+    }
+}
+
+void lui_xml_stream_close(lui_xml_stream_t * stream)
+{
+    if(stream->buf == NULL) return;
+
+    lv_free(stream->buf);
+    stream->buf = NULL;
+    stream->buf_len = 0;
+    lv_fs_close(&stream->file);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /* LV_USE_XML */
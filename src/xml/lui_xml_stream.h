@@ -0,0 +1,101 @@
+/**
+ * @file lui_xml_stream.h
+ *
+ */
+
+#ifndef LUI_XML_STREAM_H
+#define LUI_XML_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+#include "../misc/lv_fs.h"
+#include "../libs/expat/expat.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Called by `lui_xml_parse_file_stream()` after a chunk was parsed
+ * @param buf           the content of the chunk
+ * @param len           length of the chunk
+ * @param offset        position of the chunk in the file
+ * @param user_data     the `user_data` passed to `lui_xml_parse_file_stream()`
+ */
+typedef void (*lui_xml_stream_chunk_cb_t)(const char * buf, uint32_t len, uint32_t offset, void * user_data);
+
+/**
+ * A file which is parsed chunk by chunk. The first chunk is read when the file is opened,
+ * so it can be inspected (e.g. to find the root element) without reading it again.
+ */
+typedef struct {
+    lv_fs_file_t file;
+    const char * path;
+    char * buf;             /**< `LUI_XML_STREAM_BUF_SIZE` bytes*/
+    uint32_t buf_len;       /**< Number of bytes in `buf` which are not parsed yet*/
+} lui_xml_stream_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Feed a file to an expat parser through a buffer of `LUI_XML_STREAM_BUF_SIZE` bytes,
+ * so that the memory usage doesn't depend on the size of the file.
+ * @param parser        an expat parser with the handlers already set
+ * @param path          path to the XML file
+ * @param chunk_cb      called after each chunk was parsed, can be NULL
+ * @param user_data     passed to `chunk_cb`
+ * @return              LV_RESULT_OK: the whole file was parsed successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_parse_file_stream(XML_Parser parser, const char * path, lui_xml_stream_chunk_cb_t chunk_cb,
+                                      void * user_data);
+
+/**
+ * Open a file for parsing and read its first chunk to `stream->buf`
+ * @param stream    the stream to initialize
+ * @param path      path to the XML file
+ * @return          LV_RESULT_OK: the file is opened, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_stream_open(lui_xml_stream_t * stream, const char * path);
+
+/**
+ * Feed the rest of an opened file to an expat parser, starting with the chunk read on opening
+ * @param stream        an opened stream
+ * @param parser        an expat parser with the handlers already set
+ * @param chunk_cb      called after each chunk was parsed, can be NULL
+ * @param user_data     passed to `chunk_cb`
+ * @return              LV_RESULT_OK: the whole file was parsed successfully, LV_RESULT_INVALID: otherwise
+ */
+lv_result_t lui_xml_stream_parse(lui_xml_stream_t * stream, XML_Parser parser, lui_xml_stream_chunk_cb_t chunk_cb,
+                                 void * user_data);
+
+/**
+ * Close the file of a stream and free its buffer. Does nothing if it's closed already.
+ * @param stream    pointer to a stream
+ */
+void lui_xml_stream_close(lui_xml_stream_t * stream);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_STREAM_H*/
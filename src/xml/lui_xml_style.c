@@ -73,10 +73,10 @@ lv_result_t lui_xml_register_style(lui_xml_component_scope_t * scope, const char
 
     if(!found) {
         xml_style = lv_ll_ins_tail(&scope->style_ll);
-        xml_style->name = lv_strdup(style_name);
+        xml_style->name = lui_xml_arena_strdup(&scope->arena, style_name);
         lv_style_init(&xml_style->style);
         size_t long_name_len = lv_strlen(scope->name) + 1 + lv_strlen(style_name) + 1;
-        xml_style->long_name = lv_malloc(long_name_len);
+        xml_style->long_name = lui_xml_arena_alloc(&scope->arena, long_name_len);
         lv_snprintf((char *)xml_style->long_name, long_name_len, "%s.%s", scope->name, style_name); /*E.g. my_button.style1*/
     }
 
@@ -296,9 +296,10 @@ lv_result_t lui_xml_register_style(lui_xml_component_scope_t * scope, const char
                 if(value[c] == ' ') item_cnt++;
             }
 
-            /*This not freed automatically as the styles doesn't have any mechanisms to detect
-             * removal of properties. It's assumed that the styles are created once and never freed. */
-            int32_t * dsc_array = lv_malloc((item_cnt + 2) * sizeof(int32_t)); /*+2 for LV_GRID_TEMPLATE_LAST*/
+            /*The styles don't have any mechanisms to detect removal of properties,
+             *so allocate the array in the scope's arena to free it together with the scope.*/
+            int32_t * dsc_array = lui_xml_arena_alloc(&scope->arena,
+                                                      (item_cnt + 2) * sizeof(int32_t)); /*+2 for LV_GRID_TEMPLATE_LAST*/
 
             char * value_buf = (char *)value;
             item_cnt = 0;
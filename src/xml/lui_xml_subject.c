@@ -0,0 +1,645 @@
+/**
+ * @file lui_xml_subject.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_subject_private.h"
+#if LV_USE_XML
+
+#include "../lvgl.h"
+#include "lui_xml_private.h"
+#include "lui_xml_bind_private.h"
+#include "lui_xml_derived_private.h"
+#include "lui_xml_handle.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LUI_XML_USE_SUBJECT_CACHE
+typedef struct {
+    char * name;                        /**< NULL if the slot is free*/
+    uint32_t hash;
+    uint32_t handle_slot;               /**< Index of the handle slot of the subject*/
+    uint32_t gen;                       /**< Generation of the slot, it changes when the subject is unregistered*/
+    lui_xml_subject_t * entry;
+} cache_slot_t;
+
+struct _lui_xml_subject_cache_t {
+    cache_slot_t * slots;               /**< Open addressing, at most half of them is used*/
+    uint32_t cnt;
+    uint32_t cap;                       /**< 0 or a power of 2*/
+};
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lui_xml_subject_handle_t entry_get_handle(lui_xml_subject_t * entry);
+#if LUI_XML_USE_SUBJECT_CACHE
+static lv_result_t cache_grow(lui_xml_subject_cache_t * cache);
+static uint32_t name_hash(const char * name);
+#endif
+static void batch_mark_last(const lui_xml_subject_handle_t * handles, uint32_t cnt);
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+static void subject_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
+static void relay_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
+static void flush_timer_cb(lv_timer_t * timer);
+static bool value_equal(lv_subject_t * a, lv_subject_t * b);
+static lv_result_t relay_copy_string(lv_subject_t * relay, const char * str);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*The subjects with a handle. The `user_data` of the slots is the index of
+ *the last value of the subject in the current batch.*/
+static lui_xml_handle_table_t handle_table = {NULL, 0, 0, LUI_XML_HANDLE_NO_SLOT};
+
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+static lv_timer_t * flush_timer;
+static lui_xml_subject_t * dirty_head;  /**< The changed subjects in the order of their first change*/
+static lui_xml_subject_t * dirty_tail;
+static bool flushing;                   /**< The relays are being updated, don't pass their changes back*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lui_xml_subject_handle_t lui_xml_subject_get_handle(lui_xml_component_scope_t * scope, const char * name)
+{
+    lui_xml_subject_t * entry = lui_xml_find_subject_entry(scope, name);
+    if(entry == NULL) return 0;
+
+    return entry_get_handle(entry);
+}
+
+uint32_t lui_xml_subjects_set_batch(const lui_xml_subject_handle_t * handles, const int32_t * values, uint32_t cnt)
+{
+    batch_mark_last(handles, cnt);
+
+    /*Compute the derived subjects once, from all the new values*/
+#if LUI_XML_USE_DERIVED_SUBJECTS
+    lui_xml_derived_pause();
+#endif
+
+    uint32_t changed_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lui_xml_handle_slot_t * s = lui_xml_handle_table_get_slot(&handle_table, handles[i]);
+        if(s == NULL) {
+            LV_LOG_WARN("Subject handle %" LV_PRIu32 " of the batch is invalid", i);
+            continue;
+        }
+        if(s->user_data != i) continue;
+
+        lv_subject_t * subject = s->ptr;
+
+        if(subject->type != LV_SUBJECT_TYPE_INT) {
+            LV_LOG_WARN("The subject of handle %" LV_PRIu32 " is not an int subject", i);
+            continue;
+        }
+
+        if(lv_subject_get_int(subject) == values[i]) continue;
+        lv_subject_set_int(subject, values[i]);
+        changed_cnt++;
+    }
+
+#if LUI_XML_USE_DERIVED_SUBJECTS
+    lui_xml_derived_resume();
+#endif
+
+    return changed_cnt;
+}
+
+#if LV_USE_FLOAT
+uint32_t lui_xml_subjects_set_batch_float(const lui_xml_subject_handle_t * handles, const float * values,
+                                          uint32_t cnt)
+{
+    batch_mark_last(handles, cnt);
+
+    /*Compute the derived subjects once, from all the new values*/
+#if LUI_XML_USE_DERIVED_SUBJECTS
+    lui_xml_derived_pause();
+#endif
+
+    uint32_t changed_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lui_xml_handle_slot_t * s = lui_xml_handle_table_get_slot(&handle_table, handles[i]);
+        if(s == NULL) {
+            LV_LOG_WARN("Subject handle %" LV_PRIu32 " of the batch is invalid", i);
+            continue;
+        }
+        if(s->user_data != i) continue;
+
+        lv_subject_t * subject = s->ptr;
+
+        if(subject->type != LV_SUBJECT_TYPE_FLOAT) {
+            LV_LOG_WARN("The subject of handle %" LV_PRIu32 " is not a float subject", i);
+            continue;
+        }
+
+        if(lv_subject_get_float(subject) == values[i]) continue;
+        lv_subject_set_float(subject, values[i]);
+        changed_cnt++;
+    }
+
+#if LUI_XML_USE_DERIVED_SUBJECTS
+    lui_xml_derived_resume();
+#endif
+
+    return changed_cnt;
+}
+#endif
+
+void lui_xml_subject_release(lui_xml_subject_t * entry)
+{
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+    lui_xml_subject_undefer(entry);
+#endif
+
+#if LUI_XML_USE_SHARED_BINDINGS
+    lui_xml_bind_remove_subject(entry->subject);
+#endif
+
+#if LUI_XML_USE_DERIVED_SUBJECTS
+    lui_xml_derived_remove_subject(entry);
+#endif
+
+    uint32_t slot = entry->handle_slot - 1;
+    if(entry->handle_slot && slot < handle_table.cnt && handle_table.slots[slot].ptr == entry->subject) {
+        lui_xml_handle_table_remove(&handle_table, slot);
+    }
+    entry->handle_slot = 0;
+}
+
+void lui_xml_subjects_deinit(void)
+{
+    lui_xml_handle_table_destroy(&handle_table);
+
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+    if(flush_timer) {
+        lv_timer_delete(flush_timer);
+        flush_timer = NULL;
+    }
+
+    while(dirty_head) {
+        lui_xml_subject_t * entry = dirty_head;
+        dirty_head = entry->next_dirty;
+        entry->next_dirty = NULL;
+        entry->dirty = 0;
+    }
+    dirty_tail = NULL;
+#endif
+}
+
+#if LUI_XML_USE_SUBJECT_CACHE
+
+lui_xml_subject_cache_t * lui_xml_subject_cache_create(void)
+{
+    lui_xml_subject_cache_t * cache = lv_zalloc(sizeof(lui_xml_subject_cache_t));
+    LV_ASSERT_MALLOC(cache);
+    return cache;
+}
+
+void lui_xml_subject_cache_delete(lui_xml_subject_cache_t * cache)
+{
+    if(cache == NULL) return;
+
+    lui_xml_subject_cache_clear(cache);
+    lv_free(cache->slots);
+    lv_free(cache);
+}
+
+void lui_xml_subject_cache_clear(lui_xml_subject_cache_t * cache)
+{
+    if(cache->cnt == 0) return;
+
+    uint32_t i;
+    for(i = 0; i < cache->cap; i++) {
+        lv_free(cache->slots[i].name);
+        cache->slots[i].name = NULL;
+    }
+    cache->cnt = 0;
+}
+
+lui_xml_subject_t * lui_xml_subject_cache_get(lui_xml_subject_cache_t * cache, const char * name)
+{
+    if(cache->cnt == 0) return NULL;
+
+    uint32_t hash = name_hash(name);
+    uint32_t mask = cache->cap - 1;
+    uint32_t i;
+    for(i = hash & mask; cache->slots[i].name; i = (i + 1) & mask) {
+        cache_slot_t * slot = &cache->slots[i];
+        if(slot->hash != hash || !lv_streq(slot->name, name)) continue;
+
+        /*The entry is freed only after the generation of its slot is changed.
+         *Compare the full generation, not only the bits stored in a handle.*/
+        if(slot->handle_slot >= handle_table.cnt) return NULL;
+        const lui_xml_handle_slot_t * s = &handle_table.slots[slot->handle_slot];
+        if(s->ptr == NULL || s->gen != slot->gen) return NULL;
+        return slot->entry;
+    }
+
+    return NULL;
+}
+
+void lui_xml_subject_cache_add(lui_xml_subject_cache_t * cache, const char * name, lui_xml_subject_t * entry)
+{
+    lui_xml_subject_handle_t handle = entry_get_handle(entry);
+    if(handle == 0) return;
+
+    if((cache->cnt + 1) * 2 > cache->cap && cache_grow(cache) != LV_RESULT_OK) return;
+
+    uint32_t hash = name_hash(name);
+    uint32_t mask = cache->cap - 1;
+    uint32_t i = hash & mask;
+    while(cache->slots[i].name) {
+        /*The cached subject was unregistered, replace it*/
+        if(cache->slots[i].hash == hash && lv_streq(cache->slots[i].name, name)) break;
+        i = (i + 1) & mask;
+    }
+
+    cache_slot_t * slot = &cache->slots[i];
+    if(slot->name == NULL) {
+        slot->name = lv_strdup(name);
+        LV_ASSERT_MALLOC(slot->name);
+        if(slot->name == NULL) return;
+        slot->hash = hash;
+        cache->cnt++;
+    }
+    slot->handle_slot = entry->handle_slot - 1;
+    slot->gen = handle_table.slots[slot->handle_slot].gen;
+    slot->entry = entry;
+}
+
+#endif /*LUI_XML_USE_SUBJECT_CACHE*/
+
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+
+void lui_xml_subjects_flush(void)
+{
+    flushing = true;
+
+    /*The observers of a relay can change other subjects, which are appended and flushed too*/
+    while(dirty_head) {
+        lui_xml_subject_t * entry = dirty_head;
+        dirty_head = entry->next_dirty;
+        if(dirty_head == NULL) dirty_tail = NULL;
+        entry->next_dirty = NULL;
+        entry->dirty = 0;
+
+        lv_subject_t * subject = entry->subject;
+        lv_subject_t * relay = entry->relay;
+        if(value_equal(relay, subject)) continue;
+
+        switch(subject->type) {
+            case LV_SUBJECT_TYPE_INT:
+                lv_subject_set_int(relay, lv_subject_get_int(subject));
+                break;
+#if LV_USE_FLOAT
+            case LV_SUBJECT_TYPE_FLOAT:
+                lv_subject_set_float(relay, lv_subject_get_float(subject));
+                break;
+#endif
+            case LV_SUBJECT_TYPE_COLOR:
+                lv_subject_set_color(relay, lv_subject_get_color(subject));
+                break;
+            case LV_SUBJECT_TYPE_STRING:
+                relay_copy_string(relay, lv_subject_get_string(subject));
+                break;
+            default:
+                break;
+        }
+    }
+
+    flushing = false;
+
+    if(flush_timer) lv_timer_pause(flush_timer);
+}
+
+lv_result_t lui_xml_subject_defer(lui_xml_subject_t * entry)
+{
+    if(entry->relay) return LV_RESULT_OK;
+
+    lv_subject_t * subject = entry->subject;
+    lv_subject_t * relay = lv_zalloc(sizeof(lv_subject_t));
+    LV_ASSERT_MALLOC(relay);
+    if(relay == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory to defer `%s`", entry->name);
+        return LV_RESULT_INVALID;
+    }
+
+    switch(subject->type) {
+        case LV_SUBJECT_TYPE_INT:
+            lv_subject_init_int(relay, lv_subject_get_int(subject));
+            break;
+#if LV_USE_FLOAT
+        case LV_SUBJECT_TYPE_FLOAT:
+            lv_subject_init_float(relay, lv_subject_get_float(subject));
+            break;
+#endif
+        case LV_SUBJECT_TYPE_COLOR:
+            lv_subject_init_color(relay, lv_subject_get_color(subject));
+            break;
+        case LV_SUBJECT_TYPE_STRING: {
+                /*Freed in `lui_xml_subject_undefer()` as `relay_copy_string()` can reallocate them*/
+                char * buf_act = lv_malloc(subject->size);
+                char * buf_prev = lv_malloc(subject->size);
+                LV_ASSERT_MALLOC(buf_act);
+                LV_ASSERT_MALLOC(buf_prev);
+                if(buf_act == NULL || buf_prev == NULL) {
+                    LV_LOG_WARN("Couldn't allocate memory to defer `%s`", entry->name);
+                    lv_free(buf_act);
+                    lv_free(buf_prev);
+                    lv_free(relay);
+                    return LV_RESULT_INVALID;
+                }
+                lv_subject_init_string(relay, buf_act, buf_prev, subject->size, lv_subject_get_string(subject));
+                break;
+            }
+        default:
+            LV_LOG_WARN("Only int, float, color and string subjects can be deferred, `%s` is not deferred",
+                        entry->name);
+            lv_free(relay);
+            return LV_RESULT_INVALID;
+    }
+
+    if(flush_timer == NULL) {
+        flush_timer = lv_timer_create(flush_timer_cb, LUI_XML_SUBJECT_FLUSH_PERIOD, NULL);
+        LV_ASSERT_MALLOC(flush_timer);
+        if(flush_timer == NULL) {
+            LV_LOG_WARN("Couldn't create the flush timer, `%s` is not deferred", entry->name);
+            if(subject->type == LV_SUBJECT_TYPE_STRING) {
+                lv_free((void *)relay->value.pointer);
+                lv_free((void *)relay->prev_value.pointer);
+            }
+            lv_free(relay);
+            return LV_RESULT_INVALID;
+        }
+        lv_timer_pause(flush_timer);
+    }
+
+    /*The observers are notified when they are added. `relay` is still NULL and `flushing` is set
+     *so that these calls are ignored.*/
+    flushing = true;
+    entry->observer = lv_subject_add_observer(subject, subject_observer_cb, entry);
+    lv_subject_add_observer(relay, relay_observer_cb, entry);
+    flushing = false;
+
+    entry->relay = relay;
+
+    return LV_RESULT_OK;
+}
+
+void lui_xml_subject_undefer(lui_xml_subject_t * entry)
+{
+    lv_subject_t * relay = entry->relay;
+    if(relay == NULL) return;
+
+    if(entry->dirty) {
+        lui_xml_subject_t * prev = NULL;
+        lui_xml_subject_t * e = dirty_head;
+        while(e != entry) {
+            prev = e;
+            e = e->next_dirty;
+        }
+        if(prev) prev->next_dirty = entry->next_dirty;
+        else dirty_head = entry->next_dirty;
+        if(dirty_tail == entry) dirty_tail = prev;
+        entry->next_dirty = NULL;
+        entry->dirty = 0;
+    }
+
+    lv_observer_remove(entry->observer);
+    entry->observer = NULL;
+
+    /*Also unbinds the widgets*/
+#if LUI_XML_USE_SHARED_BINDINGS
+    lui_xml_bind_remove_subject(relay);
+#endif
+    lv_subject_deinit(relay);
+    if(relay->type == LV_SUBJECT_TYPE_STRING) {
+        lv_free((void *)relay->value.pointer);
+        lv_free((void *)relay->prev_value.pointer);
+    }
+    lv_free(relay);
+    entry->relay = NULL;
+}
+
+#endif /*LUI_XML_USE_DEFERRED_SUBJECTS*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the handle of a registered subject, allocating a slot for it on the first call
+ * @param entry     the registry entry of the subject
+ * @return          the handle or 0 if out of memory
+ */
+static lui_xml_subject_handle_t entry_get_handle(lui_xml_subject_t * entry)
+{
+    /*Already has a handle?*/
+    uint32_t slot = entry->handle_slot - 1;
+    if(entry->handle_slot && slot < handle_table.cnt && handle_table.slots[slot].ptr == entry->subject) {
+        return lui_xml_handle_table_get_handle(&handle_table, slot);
+    }
+
+    slot = lui_xml_handle_table_add(&handle_table, entry->subject);
+    if(slot == LUI_XML_HANDLE_NO_SLOT) {
+        LV_LOG_WARN("Out of subject handles");
+        return 0;
+    }
+
+    entry->handle_slot = slot + 1;
+
+    return lui_xml_handle_table_get_handle(&handle_table, slot);
+}
+
+#if LUI_XML_USE_SUBJECT_CACHE
+/**
+ * Double the slots of a subject cache and move the cached subjects to them
+ * @param cache     the cache
+ * @return          LV_RESULT_OK: grown; LV_RESULT_INVALID: out of memory
+ */
+static lv_result_t cache_grow(lui_xml_subject_cache_t * cache)
+{
+    uint32_t cap = cache->cap ? cache->cap * 2 : 16;
+    cache_slot_t * slots = lv_zalloc(cap * sizeof(cache_slot_t));
+    LV_ASSERT_MALLOC(slots);
+    if(slots == NULL) return LV_RESULT_INVALID;
+
+    uint32_t i;
+    for(i = 0; i < cache->cap; i++) {
+        if(cache->slots[i].name == NULL) continue;
+        uint32_t j = cache->slots[i].hash & (cap - 1);
+        while(slots[j].name) j = (j + 1) & (cap - 1);
+        slots[j] = cache->slots[i];
+    }
+
+    lv_free(cache->slots);
+    cache->slots = slots;
+    cache->cap = cap;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * FNV-1a hash of a subject name
+ * @param name      the name
+ * @return          the hash
+ */
+static uint32_t name_hash(const char * name)
+{
+    uint32_t hash = 2166136261u;
+    while(*name) {
+        hash ^= (uint8_t)*name;
+        hash *= 16777619u;
+        name++;
+    }
+    return hash;
+}
+#endif
+
+/**
+ * Find the last value of each subject in a batch, so that a subject listed more times is set once
+ * @param handles   the handles of the batch
+ * @param cnt       number of handles
+ */
+static void batch_mark_last(const lui_xml_subject_handle_t * handles, uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lui_xml_handle_slot_t * s = lui_xml_handle_table_get_slot(&handle_table, handles[i]);
+        if(s) s->user_data = i;
+    }
+}
+
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+
+/**
+ * The subject was changed by the application. Note it and wake the flush timer.
+ */
+static void subject_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    LV_UNUSED(subject);
+
+    lui_xml_subject_t * entry = lv_observer_get_user_data(observer);
+    if(entry->relay == NULL || entry->dirty) return;
+
+    entry->dirty = 1;
+    if(dirty_tail) dirty_tail->next_dirty = entry;
+    else dirty_head = entry;
+    dirty_tail = entry;
+
+    if(flush_timer) lv_timer_resume(flush_timer);
+}
+
+/**
+ * The relay was changed by a bound widget (e.g. a slider was dragged).
+ * Pass it to the subject immediately so that the application sees the same value.
+ */
+static void relay_observer_cb(lv_observer_t * observer, lv_subject_t * relay)
+{
+    if(flushing) return;
+
+    lui_xml_subject_t * entry = lv_observer_get_user_data(observer);
+    lv_subject_t * subject = entry->subject;
+    if(value_equal(relay, subject)) return;
+
+    switch(relay->type) {
+        case LV_SUBJECT_TYPE_INT:
+            lv_subject_set_int(subject, lv_subject_get_int(relay));
+            break;
+#if LV_USE_FLOAT
+        case LV_SUBJECT_TYPE_FLOAT:
+            lv_subject_set_float(subject, lv_subject_get_float(relay));
+            break;
+#endif
+        case LV_SUBJECT_TYPE_COLOR:
+            lv_subject_set_color(subject, lv_subject_get_color(relay));
+            break;
+        case LV_SUBJECT_TYPE_STRING:
+            lui_xml_subject_copy_string(subject, lv_subject_get_string(relay));
+            break;
+        default:
+            break;
+    }
+}
+
+static void flush_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+
+    lui_xml_subjects_flush();
+}
+
+static bool value_equal(lv_subject_t * a, lv_subject_t * b)
+{
+    switch(a->type) {
+        case LV_SUBJECT_TYPE_INT:
+            return lv_subject_get_int(a) == lv_subject_get_int(b);
+#if LV_USE_FLOAT
+        case LV_SUBJECT_TYPE_FLOAT:
+            return lv_subject_get_float(a) == lv_subject_get_float(b);
+#endif
+        case LV_SUBJECT_TYPE_COLOR:
+            return lv_color_eq(lv_subject_get_color(a), lv_subject_get_color(b));
+        case LV_SUBJECT_TYPE_STRING:
+            return lv_streq(lv_subject_get_string(a), lv_subject_get_string(b));
+        default:
+            return false;
+    }
+}
+
+/**
+ * Copy a string to a relay, enlarging its buffers if the subject has grown
+ * @param relay     the relay subject
+ * @param str       the new value
+ * @return          LV_RESULT_OK: copied; LV_RESULT_INVALID: out of memory, the string was truncated
+ */
+static lv_result_t relay_copy_string(lv_subject_t * relay, const char * str)
+{
+    size_t size_req = lv_strlen(str) + 1;
+    if(size_req > relay->size) {
+        char * buf_act = lv_realloc((void *)relay->value.pointer, size_req);
+        LV_ASSERT_MALLOC(buf_act);
+        if(buf_act == NULL) {
+            lv_subject_copy_string(relay, str);
+            return LV_RESULT_INVALID;
+        }
+        relay->value.pointer = buf_act;
+
+        char * buf_prev = lv_realloc((void *)relay->prev_value.pointer, size_req);
+        LV_ASSERT_MALLOC(buf_prev);
+        if(buf_prev == NULL) {
+            lv_subject_copy_string(relay, str);
+            return LV_RESULT_INVALID;
+        }
+        relay->prev_value.pointer = buf_prev;
+        relay->size = size_req;
+    }
+
+    lv_subject_copy_string(relay, str);
+    return LV_RESULT_OK;
+}
+
+#endif /*LUI_XML_USE_DEFERRED_SUBJECTS*/
+
+#endif /*LV_USE_XML*/
@@ -0,0 +1,117 @@
+/**
+ * @file lui_xml_subject.h
+ *
+ */
+
+#ifndef LUI_XML_SUBJECT_H
+#define LUI_XML_SUBJECT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: allow deferring the notifications of the subjects declared with `deferred="true"` in XML.
+ *  Their bound widgets are updated only once per refresh period with the last value.*/
+#ifndef LUI_XML_USE_DEFERRED_SUBJECTS
+#define LUI_XML_USE_DEFERRED_SUBJECTS 0
+#endif
+
+/** How often the changes of the deferred subjects are delivered [ms]*/
+#ifndef LUI_XML_SUBJECT_FLUSH_PERIOD
+#define LUI_XML_SUBJECT_FLUSH_PERIOD LV_DEF_REFR_PERIOD
+#endif
+
+/** 1: the widgets bound by the same `bind_flag_if_*` or `bind_state_if_*` rule (same subject,
+ *  condition and reference value) share one observer instead of having one each*/
+#ifndef LUI_XML_USE_SHARED_BINDINGS
+#define LUI_XML_USE_SHARED_BINDINGS 0
+#endif
+
+/** 1: allow declaring int and float subjects computed from other subjects,
+ *  e.g. `<int name="alarm" expr="temp > limit"/>`*/
+#ifndef LUI_XML_USE_DERIVED_SUBJECTS
+#define LUI_XML_USE_DERIVED_SUBJECTS 0
+#endif
+
+/** 1: remember the subjects found by name in each component, so the `bind_*` attributes
+ *  of the next instances are resolved without searching the subject lists*/
+#ifndef LUI_XML_USE_SUBJECT_CACHE
+#define LUI_XML_USE_SUBJECT_CACHE 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Refers to a registered subject without looking up its name. 0 is never a valid handle.*/
+typedef uint32_t lui_xml_subject_handle_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get a handle to a subject to set it in batches.
+ * The subject is found as by `lui_xml_get_subject()`. The same subject always gets the same
+ * handle, and the handle becomes invalid when the component registering the subject is unregistered.
+ * @param scope     the scope to start searching in or NULL to search only the global subjects
+ * @param name      name of the subject
+ * @return          the handle or 0 if the subject is not found
+ */
+lui_xml_subject_handle_t lui_xml_subject_get_handle(lui_xml_component_scope_t * scope, const char * name);
+
+/**
+ * Set many int subjects at once. If a subject is listed more times only its last value is used.
+ * The observers of a subject are notified once, and only if its value has changed.
+ * Invalid handles and subjects which are not int are skipped with a warning.
+ * @param handles   handles from `lui_xml_subject_get_handle()`
+ * @param values    the new values, `values[i]` is set to `handles[i]`
+ * @param cnt       number of handles and values
+ * @return          number of subjects changed
+ */
+uint32_t lui_xml_subjects_set_batch(const lui_xml_subject_handle_t * handles, const int32_t * values, uint32_t cnt);
+
+#if LV_USE_FLOAT
+/**
+ * Set many float subjects at once, the same way as `lui_xml_subjects_set_batch()`
+ * @param handles   handles from `lui_xml_subject_get_handle()`
+ * @param values    the new values, `values[i]` is set to `handles[i]`
+ * @param cnt       number of handles and values
+ * @return          number of subjects changed
+ */
+uint32_t lui_xml_subjects_set_batch_float(const lui_xml_subject_handle_t * handles, const float * values,
+                                          uint32_t cnt);
+#endif
+
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+
+/**
+ * Deliver the pending changes of the deferred subjects to the bound widgets now,
+ * instead of waiting for the next flush. Only the last value of each subject is delivered,
+ * and only if it differs from the last delivered one.
+ */
+void lui_xml_subjects_flush(void);
+
+#endif /*LUI_XML_USE_DEFERRED_SUBJECTS*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_SUBJECT_H*/
@@ -0,0 +1,132 @@
+/**
+ * @file lui_xml_subject_private.h
+ *
+ */
+
+#ifndef LUI_XML_SUBJECT_PRIVATE_H
+#define LUI_XML_SUBJECT_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_subject.h"
+#if LV_USE_XML
+
+#include "lui_xml_component_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lui_xml_subject_cache_t lui_xml_subject_cache_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Find the registry entry of a subject by name, see `lui_xml_get_subject()`
+ * @param scope     the scope to start searching in or NULL to search only the global subjects
+ * @param name      name of the subject
+ * @return          the entry or NULL if not found
+ */
+lui_xml_subject_t * lui_xml_find_subject_entry(lui_xml_component_scope_t * scope, const char * name);
+
+/**
+ * Get the subject to bind widgets to. It's the subject returned by `lui_xml_get_subject()`,
+ * except for deferred subjects, whose widgets are bound to a relay subject updated by the flushes.
+ * @param scope     the scope to start searching in, see `lui_xml_get_subject()`
+ * @param name      name of the subject
+ * @return          the subject to bind to or NULL if not found
+ */
+lv_subject_t * lui_xml_get_bind_subject(lui_xml_component_scope_t * scope, const char * name);
+
+/**
+ * Invalidate the handle of a subject and delete its relay if it's deferred.
+ * Should be called before the subject is freed.
+ * @param entry     the registry entry of the subject
+ */
+void lui_xml_subject_release(lui_xml_subject_t * entry);
+
+/**
+ * Free the handles and delete the flush timer
+ */
+void lui_xml_subjects_deinit(void);
+
+#if LUI_XML_USE_SUBJECT_CACHE
+
+/**
+ * Create an empty cache for the subjects found by name in a scope
+ * @return          the cache or NULL if out of memory
+ */
+lui_xml_subject_cache_t * lui_xml_subject_cache_create(void);
+
+/**
+ * Delete a subject cache
+ * @param cache     the cache or NULL
+ */
+void lui_xml_subject_cache_delete(lui_xml_subject_cache_t * cache);
+
+/**
+ * Forget all the subjects of a cache, e.g. because a new subject can hide one of them
+ * @param cache     the cache
+ */
+void lui_xml_subject_cache_clear(lui_xml_subject_cache_t * cache);
+
+/**
+ * Get a subject from the cache. Subjects unregistered since they were cached are not returned.
+ * @param cache     the cache
+ * @param name      name of the subject
+ * @return          the registry entry of the subject or NULL if it's not in the cache
+ */
+lui_xml_subject_t * lui_xml_subject_cache_get(lui_xml_subject_cache_t * cache, const char * name);
+
+/**
+ * Add a subject to the cache, or update it if the cached one was unregistered
+ * @param cache     the cache
+ * @param name      name of the subject
+ * @param entry     the registry entry the name was resolved to
+ */
+void lui_xml_subject_cache_add(lui_xml_subject_cache_t * cache, const char * name, lui_xml_subject_t * entry);
+
+#endif /*LUI_XML_USE_SUBJECT_CACHE*/
+
+#if LUI_XML_USE_DEFERRED_SUBJECTS
+
+/**
+ * Defer the notifications of a registered subject. A relay subject is created with the same
+ * type and value, and the changes of the subject are copied to it on the next flush.
+ * The changes of the relay (e.g. by a slider) are passed back to the subject immediately.
+ * @param entry     the registry entry of the subject
+ * @return          LV_RESULT_OK: deferred; LV_RESULT_INVALID: the type is not supported or out of memory
+ */
+lv_result_t lui_xml_subject_defer(lui_xml_subject_t * entry);
+
+/**
+ * Delete the relay of a deferred subject and drop its pending change
+ * @param entry     the registry entry of the subject
+ */
+void lui_xml_subject_undefer(lui_xml_subject_t * entry);
+
+#endif /*LUI_XML_USE_DEFERRED_SUBJECTS*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_SUBJECT_PRIVATE_H*/
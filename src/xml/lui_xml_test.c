@@ -13,6 +13,7 @@
 #include "lv_xml.h"
 #include "lui_xml_utils.h"
 #include "lui_xml_component_private.h"
+#include "lui_xml_private.h"
 #include "../misc/lv_fs.h"
 #include "../libs/expat/expat.h"
 #include "../display/lv_display_private.h"
@@ -136,47 +137,32 @@ lv_result_t lui_xml_test_register_from_data(const char * xml_def, const char * r
 
 lv_result_t lui_xml_test_register_from_file(const char * path, const char * ref_image_path_prefix)
 {
-    lv_fs_res_t fs_res;
-    lv_fs_file_t f;
-    fs_res = lv_fs_open(&f, path, LV_FS_MODE_RD);
-    if(fs_res != LV_FS_RES_OK) {
-        LV_LOG_WARN("Failed to open %s", path);
-        return LV_RESULT_INVALID;
-    }
-
-    /* Determine file size */
-    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
-    uint32_t file_size = 0;
-    lv_fs_tell(&f, &file_size);
-    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    /*Cleanup the previous test*/
+    lui_xml_unregister_test();
 
-    /* Create the buffer */
-    char * xml_buf = lv_zalloc(file_size + 1);
-    if(xml_buf == NULL) {
-        LV_LOG_WARN("Memory allocation failed for file %s (%" LV_PRIu32 "bytes)", path, file_size + 1);
-        lv_fs_close(&f);
-        return LV_RESULT_INVALID;
-    }
+    test.ref_image_path_prefix = ref_image_path_prefix;
 
-    /* Read the file content  */
-    uint32_t rn;
-    lv_fs_read(&f, xml_buf, file_size, &rn);
-    if(rn != file_size) {
-        LV_LOG_WARN("Couldn't read %s fully", path);
-        lv_free(xml_buf);
-        lv_fs_close(&f);
+    /*Register as a component first to allow creating the view of the test later.
+     *Both this and the steps below read the file chunk by chunk.*/
+    lv_result_t res = lui_xml_component_register_from_file_with_name(LV_TEST_NAME, path);
+    if(res != LV_RESULT_OK) {
+        LV_LOG_WARN("Couldn't register the test as a component");
+        test.ref_image_path_prefix = NULL;
         return LV_RESULT_INVALID;
     }
 
-    /* Null-terminate the buffer */
-    xml_buf[rn] = '\0';
+    /* Parse the XML to extract the steps */
+    XML_Memory_Handling_Suite mem_handlers;
+    mem_handlers.malloc_fcn = lv_malloc;
+    mem_handlers.realloc_fcn = lv_realloc;
+    mem_handlers.free_fcn = lv_free;
+    XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+    XML_SetElementHandler(parser, start_metadata_handler, end_metadata_handler);
 
-    /* Register the test */
-    lv_result_t res = lui_xml_test_register_from_data(xml_buf, ref_image_path_prefix);
+    res = lui_xml_parse_file_stream(parser, path, NULL, NULL);
 
-    /* Housekeeping */
-    lv_free(xml_buf);
-    lv_fs_close(&f);
+    XML_ParserFree(parser);
+    test.ref_image_path_prefix = NULL;
 
     return res;
 }
@@ -424,7 +410,7 @@ static bool execute_step(lui_xml_test_step_t * step, uint32_t slowdown)
             lv_subject_set_int(step->param.subject_set.subject, lui_xml_atoi(step->param.subject_set.value));
         }
         else if(type == LV_SUBJECT_TYPE_STRING) {
-            lv_subject_copy_string(step->param.subject_set.subject, step->param.subject_set.value);
+            lui_xml_subject_copy_string(step->param.subject_set.subject, step->param.subject_set.value);
         }
         else {
             LV_LOG_WARN("Not supported subject type %d", type);
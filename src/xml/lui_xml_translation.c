@@ -12,6 +12,8 @@
 #include "../others/translation/lv_translation_private.h"
 #include "lui_xml_widget.h"
 #include "lui_xml_parser.h"
+#include "lui_xml_private.h"
+#include "lui_xml_pack_private.h"
 #include "../others/translation/lv_translation.h"
 #include "../libs/expat/expat.h"
 
@@ -43,48 +45,31 @@ static void end_handler(void * user_data, const char * name);
 
 lv_result_t lui_xml_register_translation_from_file(const char * path)
 {
-    lv_fs_res_t fs_res;
-    lv_fs_file_t f;
-    fs_res = lv_fs_open(&f, path, LV_FS_MODE_RD);
-    if(fs_res != LV_FS_RES_OK) {
-        LV_LOG_WARN("Couldn't open %s", path);
-        return LV_RESULT_INVALID;
-    }
+    lui_xml_stream_t stream;
+    lv_result_t res = lui_xml_stream_open(&stream, path);
+    if(res != LV_RESULT_OK) return res;
 
-    /* Determine file size */
-    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
-    uint32_t file_size = 0;
-    lv_fs_tell(&f, &file_size);
-    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
-
-    /* Create the buffer */
-    char * xml_buf = lv_malloc(file_size + 1);
-    LV_ASSERT_MALLOC(xml_buf);
-    if(xml_buf == NULL) {
-        LV_LOG_WARN("Memory allocation failed for file %s (%" LV_PRIu32 " bytes)", path, file_size + 1);
-        lv_fs_close(&f);
-        return LV_RESULT_INVALID;
-    }
+    res = lui_xml_translation_register_from_stream(&stream);
+    lui_xml_stream_close(&stream);
 
-    /* Read the file content  */
-    uint32_t rn;
-    lv_fs_read(&f, xml_buf, file_size, &rn);
-    if(rn != file_size) {
-        LV_LOG_WARN("Couldn't read %s fully", path);
-        lv_free(xml_buf);
-        lv_fs_close(&f);
-        return LV_RESULT_INVALID;
-    }
+    return res;
+}
 
-    /* Null-terminate the buffer */
-    xml_buf[rn] = '\0';
+lv_result_t lui_xml_translation_register_from_stream(lui_xml_stream_t * stream)
+{
+    lv_translation_pack_t * pack = lv_translation_add_dynamic();
 
-    /* Register the component */
-    lv_result_t res = lui_xml_register_translation_from_data(xml_buf);
+    /* Parse the file chunk by chunk as translation files can be huge */
+    XML_Memory_Handling_Suite mem_handlers;
+    mem_handlers.malloc_fcn = lv_malloc;
+    mem_handlers.realloc_fcn = lv_realloc;
+    mem_handlers.free_fcn = lv_free;
+    XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+    XML_SetUserData(parser, pack);
+    XML_SetElementHandler(parser, start_handler, end_handler);
 
-    /* Housekeeping */
-    lv_free(xml_buf);
-    lv_fs_close(&f);
+    lv_result_t res = lui_xml_stream_parse(stream, parser, NULL, NULL);
+    XML_ParserFree(parser);
 
     return res;
 }
@@ -109,6 +94,27 @@ lv_result_t lui_xml_register_translation_from_data(const char * xml_def)
     return LV_RESULT_OK;
 }
 
+lv_result_t lui_xml_translation_register_from_doc(const lui_xml_doc_t * doc)
+{
+    if(doc->error) return LV_RESULT_INVALID;
+
+    lv_translation_pack_t * pack = lv_translation_add_dynamic();
+    lui_xml_doc_replay(doc, start_handler, end_handler, pack);
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lui_xml_translation_register_from_pack(const lui_xml_pack_t * pack, uint32_t entry_index)
+{
+    const lui_xml_pack_entry_t * entry = &pack->entries[entry_index];
+
+    lv_translation_pack_t * tr_pack = lv_translation_add_dynamic();
+    /*Replayed only once so the attribute array is allocated just for this call*/
+    lui_xml_pack_replay(pack, &pack->tokens[entry->token_start], entry->token_word_cnt, NULL,
+                        start_handler, end_handler, tr_pack);
+
+    return LV_RESULT_OK;
+}
 
 /**********************
  *   STATIC FUNCTIONS
@@ -6,7 +6,7 @@
 /*********************
  *      INCLUDES
  *********************/
-#include "lui_xml_update.h"
+#include "lui_xml_update_private.h"
 #if LV_USE_XML &&  LV_USE_OBJ_NAME
 
 #include "../lvgl.h"
@@ -18,19 +18,49 @@
  *      DEFINES
  *********************/
 
+#define INDEX_BUCKET_CNT_MIN    64
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    lui_xml_parser_state_t state;
+    lv_obj_t * act_screen;      /**< Read once for the whole batch*/
+} update_ctx_t;
+
+#if LUI_XML_USE_NAME_INDEX
+typedef struct name_entry_s {
+    struct name_entry_s * next;
+    lv_obj_t * obj;
+    uint32_t hash;
+    char name[];                /**< The name when it was indexed. If the widget was renamed since, it's ignored.*/
+} name_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void start_handler(void * user_data, const char * name, const char ** attrs);
 static void end_handler(void * user_data, const char * name);
+static lv_obj_t * find_target(lv_obj_t * act_screen, const char * path);
+#if LUI_XML_USE_NAME_INDEX
+    static lv_obj_t * index_find(lv_obj_t * screen, const char * name, size_t len);
+    static name_entry_t * index_get_entry(lv_obj_t * obj);
+    static void index_insert(name_entry_t * entry);
+    static void index_remove(name_entry_t * entry);
+    static void index_delete_event_cb(lv_event_t * e);
+    static uint32_t name_hash(const char * name, size_t len);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LUI_XML_USE_NAME_INDEX
+    static name_entry_t ** index_buckets;   /**< Chains of entries by hash, in the order of indexing*/
+    static uint32_t index_bucket_cnt;       /**< Power of 2*/
+    static uint32_t index_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -44,12 +74,17 @@ static void end_handler(void * user_data, const char * name);
 lv_result_t lui_xml_update_from_data(const char * xml_def)
 {
     /*Create a dummy parser state*/
-    lui_xml_parser_state_t state;
-    lui_xml_parser_state_init(&state);
+    update_ctx_t ctx;
+    lui_xml_parser_state_init(&ctx.state);
+    ctx.act_screen = lv_screen_active();
 
     /* Parse the XML to extract metadata */
-    XML_Parser parser = XML_ParserCreate(NULL);
-    XML_SetUserData(parser, &state);
+    XML_Memory_Handling_Suite mem_handlers;
+    mem_handlers.malloc_fcn = lv_malloc;
+    mem_handlers.realloc_fcn = lv_realloc;
+    mem_handlers.free_fcn = lv_free;
+    XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+    XML_SetUserData(parser, &ctx);
     XML_SetElementHandler(parser, start_handler, end_handler);
 
     if(XML_Parse(parser, xml_def, lv_strlen(xml_def), XML_TRUE) == XML_STATUS_ERROR) {
@@ -63,13 +98,108 @@ lv_result_t lui_xml_update_from_data(const char * xml_def)
     return LV_RESULT_OK;
 }
 
+lv_obj_t * lui_xml_update_find(const char * path)
+{
+    return find_target(lv_screen_active(), path);
+}
+
+#if LUI_XML_USE_NAME_INDEX
+
+void lui_xml_update_index_add(lv_obj_t * obj)
+{
+    const char * name = lv_obj_get_name(obj);
+
+    name_entry_t * entry = index_get_entry(obj);
+    if(entry) {
+        if(name && lv_streq(entry->name, name)) return;
+
+        /*Renamed*/
+        lv_obj_remove_event_cb_with_user_data(obj, index_delete_event_cb, entry);
+        index_remove(entry);
+    }
+
+    if(name == NULL) return;
+
+    size_t len = lv_strlen(name);
+    size_t i;
+    for(i = 0; i < len; i++) {
+        if(name[i] == '#') return;
+    }
+
+    /*Keep about one entry per bucket*/
+    if(index_cnt >= index_bucket_cnt) {
+        uint32_t bucket_cnt_old = index_bucket_cnt;
+        name_entry_t ** buckets_old = index_buckets;
+        uint32_t bucket_cnt_new = bucket_cnt_old ? bucket_cnt_old * 2 : INDEX_BUCKET_CNT_MIN;
+        name_entry_t ** buckets_new = lv_zalloc(bucket_cnt_new * sizeof(name_entry_t *));
+        LV_ASSERT_MALLOC(buckets_new);
+        if(buckets_new == NULL) {
+            LV_LOG_WARN("Couldn't grow the name index");
+            if(bucket_cnt_old == 0) return;
+        }
+        else {
+            index_buckets = buckets_new;
+            index_bucket_cnt = bucket_cnt_new;
+            index_cnt = 0;
+
+            uint32_t b;
+            for(b = 0; b < bucket_cnt_old; b++) {
+                name_entry_t * e = buckets_old[b];
+                while(e) {
+                    name_entry_t * next = e->next;
+                    index_insert(e);
+                    e = next;
+                }
+            }
+            lv_free(buckets_old);
+        }
+    }
+
+    entry = lv_malloc(sizeof(name_entry_t) + len + 1);
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        LV_LOG_WARN("Couldn't add `%s` to the name index", name);
+        return;
+    }
+
+    entry->obj = obj;
+    entry->hash = name_hash(name, len);
+    lv_memcpy(entry->name, name, len + 1);
+    index_insert(entry);
+    lv_obj_add_event_cb(obj, index_delete_event_cb, LV_EVENT_DELETE, entry);
+}
+
+void lui_xml_update_index_deinit(void)
+{
+    uint32_t b;
+    for(b = 0; b < index_bucket_cnt; b++) {
+        name_entry_t * e = index_buckets[b];
+        while(e) {
+            name_entry_t * next = e->next;
+            lv_obj_remove_event_cb_with_user_data(e->obj, index_delete_event_cb, e);
+            lv_free(e);
+            e = next;
+        }
+    }
+
+    lv_free(index_buckets);
+    index_buckets = NULL;
+    index_bucket_cnt = 0;
+    index_cnt = 0;
+}
+
+#endif /*LUI_XML_USE_NAME_INDEX*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 static void start_handler(void * user_data, const char * name, const char ** attrs)
 {
-    lui_xml_parser_state_t * state = (lui_xml_parser_state_t *)user_data;
+    update_ctx_t * ctx = (update_ctx_t *)user_data;
+
+    /*Just wraps a batch of updates*/
+    if(lv_streq(name, "updates")) return;
 
     size_t update_len = lv_strlen("update-");
     size_t name_len = lv_strlen(name);
@@ -98,7 +228,7 @@ static void start_handler(void * user_data, const char * name, const char ** att
         return;
     }
 
-    lv_obj_t * obj = lv_obj_get_child_by_name(lv_screen_active(), widget_name);
+    lv_obj_t * obj = find_target(ctx->act_screen, widget_name);
     if(obj == NULL) {
         LV_LOG_WARN("No widget is found with the name of `%s`", widget_name);
         return;
@@ -111,8 +241,8 @@ static void start_handler(void * user_data, const char * name, const char ** att
             attrs[i + 1] = "";
         }
     }
-    state->item = obj;
-    proc->apply_cb(state, attrs);
+    ctx->state.item = obj;
+    proc->apply_cb(&ctx->state, attrs);
 }
 
 static void end_handler(void * user_data, const char * name)
@@ -121,4 +251,122 @@ static void end_handler(void * user_data, const char * name)
     LV_UNUSED(name);
 }
 
+static lv_obj_t * find_target(lv_obj_t * act_screen, const char * path)
+{
+#if LUI_XML_USE_NAME_INDEX
+    size_t len = lv_strlen(path);
+    size_t screen_len;
+    for(screen_len = 0; screen_len < len; screen_len++) {
+        if(path[screen_len] == '/') break;
+    }
+
+    if(screen_len < len) {
+        /*`screen/name` or a path on the active screen*/
+        lv_obj_t * screen = index_find(NULL, path, screen_len);
+        if(screen) {
+            const char * name = &path[screen_len + 1];
+            lv_obj_t * obj = index_find(screen, name, len - screen_len - 1);
+            if(obj) return obj;
+            return lv_obj_get_child_by_name(screen, name);
+        }
+    }
+    else if(act_screen) {
+        lv_obj_t * obj = index_find(act_screen, path, len);
+        if(obj) return obj;
+    }
+#endif
+
+    if(act_screen == NULL) return NULL;
+    return lv_obj_get_child_by_name(act_screen, path);
+}
+
+#if LUI_XML_USE_NAME_INDEX
+
+/**
+ * Find a widget in the name index
+ * @param screen    find a widget on this screen, or NULL to find a screen
+ * @param name      the name (not '\0' terminated)
+ * @param len       length of the name
+ * @return          the first widget indexed with this name or NULL if not found
+ */
+static lv_obj_t * index_find(lv_obj_t * screen, const char * name, size_t len)
+{
+    if(index_cnt == 0) return NULL;
+
+    uint32_t hash = name_hash(name, len);
+    name_entry_t * e;
+    for(e = index_buckets[hash & (index_bucket_cnt - 1)]; e; e = e->next) {
+        if(e->hash != hash || lv_strncmp(e->name, name, len) != 0 || e->name[len] != '\0') continue;
+
+        /*Renamed since it was indexed*/
+        const char * obj_name = lv_obj_get_name(e->obj);
+        if(obj_name == NULL || !lv_streq(obj_name, e->name)) continue;
+
+        if(screen == NULL) {
+            if(lv_obj_get_parent(e->obj) == NULL) return e->obj;
+        }
+        else if(e->obj != screen && lv_obj_get_screen(e->obj) == screen) {
+            return e->obj;
+        }
+    }
+
+    return NULL;
+}
+
+static name_entry_t * index_get_entry(lv_obj_t * obj)
+{
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        if(lv_event_dsc_get_cb(dsc) == index_delete_event_cb) return lv_event_dsc_get_user_data(dsc);
+    }
+
+    return NULL;
+}
+
+/**
+ * Append an entry to the end of its chain to find the widgets in the order they were indexed
+ */
+static void index_insert(name_entry_t * entry)
+{
+    name_entry_t ** link = &index_buckets[entry->hash & (index_bucket_cnt - 1)];
+    while(*link) link = &(*link)->next;
+
+    entry->next = NULL;
+    *link = entry;
+    index_cnt++;
+}
+
+static void index_remove(name_entry_t * entry)
+{
+    name_entry_t ** link = &index_buckets[entry->hash & (index_bucket_cnt - 1)];
+    while(*link && *link != entry) link = &(*link)->next;
+
+    if(*link) {
+        *link = entry->next;
+        index_cnt--;
+    }
+    lv_free(entry);
+}
+
+static void index_delete_event_cb(lv_event_t * e)
+{
+    index_remove(lv_event_get_user_data(e));
+}
+
+/** FNV-1a*/
+static uint32_t name_hash(const char * name, size_t len)
+{
+    uint32_t hash = 2166136261u;
+    size_t i;
+    for(i = 0; i < len; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#endif /*LUI_XML_USE_NAME_INDEX*/
+
 #endif /* LV_USE_XML */
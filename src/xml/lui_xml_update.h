@@ -16,6 +16,16 @@ extern "C" {
 #include "../misc/lv_types.h"
 #if LV_USE_XML && LV_USE_OBJ_NAME
 
+/*********************
+ *      DEFINES
+ *********************/
+
+/** 1: index the widgets named in XML to find the targets of the updates without searching
+ *  the widget tree. It also allows addressing the widgets of inactive screens.*/
+#ifndef LUI_XML_USE_NAME_INDEX
+#define LUI_XML_USE_NAME_INDEX 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -26,13 +36,27 @@ extern "C" {
 
 /**
  * Change the properties of a given widget by processing XML snippets.
- * For example `<lv_slider name="my_slider_1" min_value="30" "style_bg_color="0xff0000"/>`
+ * For example `<update-lv_slider name="my_slider_1" min_value="30" style_bg_color="0xff0000"/>`
  * Note that the tag should be the underlying widget's name and the component's name.
+ * More updates can be wrapped into an `<updates>` element to process them in one batch.
+ * The targets are found by `lui_xml_update_find()`.
  * @param xml_def   the XML to process as a string
  * @return          LV_RESULT_OK: loaded successfully, LV_RES_INVALID: otherwise
  */
 lv_result_t lui_xml_update_from_data(const char * xml_def);
 
+/**
+ * Find the target of an update.
+ * `name` is looked up on the active screen, `screen/name` on the screen called `screen`.
+ * With `LUI_XML_USE_NAME_INDEX` the widgets named in XML are found without searching the
+ * widget tree, and screens can be addressed even if they are not active.
+ * The other widgets are searched by `lv_obj_get_child_by_name()` on the active screen.
+ * If more widgets have the same name on a screen, the one named first is found.
+ * @param path      name of the widget, optionally prefixed by the name of its screen
+ * @return          the widget or NULL if not found
+ */
+lv_obj_t * lui_xml_update_find(const char * path);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,684 @@
+/**
+ * @file lui_xml_update_bin.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lui_xml_update_bin.h"
+#if LV_USE_XML && LV_USE_OBJ_NAME
+
+#include "../lvgl.h"
+#include "lui_xml_update_private.h"
+#include "lui_xml_widget.h"
+#include "lui_xml_parser.h"
+#include "lui_xml_utils.h"
+#include "lui_xml_base_types.h"
+#include "lui_xml_handle.h"
+#include "../libs/expat/expat.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** How the value of an attribute is converted to the value of a record*/
+typedef enum {
+    VALUE_SIZE,
+    VALUE_INT,
+    VALUE_BOOL,
+    VALUE_ALIGN,
+    VALUE_OPA,
+    VALUE_COLOR,
+    VALUE_STRING,
+} value_type_t;
+
+/** A property which can be set by a record. Its id is its index in `props`.*/
+typedef struct {
+    const char * widget;                /**< Only for the updates of this widget or NULL for all*/
+    const char * name;                  /**< Name of the attribute in XML*/
+    value_type_t type;
+    const lv_obj_class_t * class_p;     /**< The target needs to be this type or NULL for any*/
+    void (*set_cb)(lv_obj_t * obj, int32_t value);
+    void (*set_text_cb)(lv_obj_t * obj, const char * value);
+} prop_dsc_t;
+
+typedef struct {
+    lui_xml_update_bin_record_t * records;
+    uint32_t record_cnt;
+    uint32_t record_cap;
+    char * str_data;
+    uint32_t str_data_size;
+    uint32_t str_data_cap;
+    bool error;
+} bin_builder_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool update_is_valid(const uint8_t * buf, uint32_t len);
+static bool str_is_valid(int64_t offset, uint32_t str_data_size);
+static bool attrs_are_valid(const char * str_data, uint32_t str_data_size, uint32_t offset);
+static void apply_attrs(lv_obj_t * obj, const char * attrs_str);
+static lv_obj_t * handle_get_obj(uint32_t handle);
+static void handle_delete_event_cb(lv_event_t * e);
+static int32_t find_prop(const char * widget, const char * name, const char ** attrs);
+static void to_binary_start_handler(void * user_data, const char * name, const char ** attrs);
+static void to_binary_end_handler(void * user_data, const char * name);
+static void builder_add_record(bin_builder_t * b, uint32_t target, uint32_t prop, int32_t value);
+static uint32_t builder_add_str(bin_builder_t * b, const char * str);
+
+static void set_x(lv_obj_t * obj, int32_t value);
+static void set_y(lv_obj_t * obj, int32_t value);
+static void set_width(lv_obj_t * obj, int32_t value);
+static void set_height(lv_obj_t * obj, int32_t value);
+static void set_align(lv_obj_t * obj, int32_t value);
+static void set_hidden(lv_obj_t * obj, int32_t value);
+static void set_clickable(lv_obj_t * obj, int32_t value);
+static void set_checked(lv_obj_t * obj, int32_t value);
+static void set_disabled(lv_obj_t * obj, int32_t value);
+static void set_style_opa(lv_obj_t * obj, int32_t value);
+static void set_style_bg_color(lv_obj_t * obj, int32_t value);
+static void set_style_text_color(lv_obj_t * obj, int32_t value);
+#if LV_USE_LABEL
+    static void set_label_text(lv_obj_t * obj, const char * value);
+#endif
+#if LV_USE_BAR
+    static void set_bar_value(lv_obj_t * obj, int32_t value);
+#endif
+#if LV_USE_SLIDER
+    static void set_slider_value(lv_obj_t * obj, int32_t value);
+#endif
+#if LV_USE_ARC
+    static void set_arc_value(lv_obj_t * obj, int32_t value);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/*The attributes as the widget parsers name and convert them*/
+static const prop_dsc_t props[LUI_XML_UPDATE_PROP_NUM] = {
+    [LUI_XML_UPDATE_PROP_X] = {NULL, "x", VALUE_SIZE, NULL, set_x, NULL},
+    [LUI_XML_UPDATE_PROP_Y] = {NULL, "y", VALUE_SIZE, NULL, set_y, NULL},
+    [LUI_XML_UPDATE_PROP_WIDTH] = {NULL, "width", VALUE_SIZE, NULL, set_width, NULL},
+    [LUI_XML_UPDATE_PROP_HEIGHT] = {NULL, "height", VALUE_SIZE, NULL, set_height, NULL},
+    [LUI_XML_UPDATE_PROP_ALIGN] = {NULL, "align", VALUE_ALIGN, NULL, set_align, NULL},
+    [LUI_XML_UPDATE_PROP_HIDDEN] = {NULL, "hidden", VALUE_BOOL, NULL, set_hidden, NULL},
+    [LUI_XML_UPDATE_PROP_CLICKABLE] = {NULL, "clickable", VALUE_BOOL, NULL, set_clickable, NULL},
+    [LUI_XML_UPDATE_PROP_CHECKED] = {NULL, "checked", VALUE_BOOL, NULL, set_checked, NULL},
+    [LUI_XML_UPDATE_PROP_DISABLED] = {NULL, "disabled", VALUE_BOOL, NULL, set_disabled, NULL},
+    [LUI_XML_UPDATE_PROP_STYLE_OPA] = {NULL, "style_opa", VALUE_OPA, NULL, set_style_opa, NULL},
+    [LUI_XML_UPDATE_PROP_STYLE_BG_COLOR] = {NULL, "style_bg_color", VALUE_COLOR, NULL, set_style_bg_color, NULL},
+    [LUI_XML_UPDATE_PROP_STYLE_TEXT_COLOR] = {NULL, "style_text_color", VALUE_COLOR, NULL, set_style_text_color, NULL},
+#if LV_USE_LABEL
+    [LUI_XML_UPDATE_PROP_LABEL_TEXT] = {"lv_label", "text", VALUE_STRING, &lv_label_class, NULL, set_label_text},
+#endif
+#if LV_USE_BAR
+    [LUI_XML_UPDATE_PROP_BAR_VALUE] = {"lv_bar", "value", VALUE_INT, &lv_bar_class, set_bar_value, NULL},
+#endif
+#if LV_USE_SLIDER
+    [LUI_XML_UPDATE_PROP_SLIDER_VALUE] = {"lv_slider", "value", VALUE_INT, &lv_slider_class, set_slider_value, NULL},
+#endif
+#if LV_USE_ARC
+    [LUI_XML_UPDATE_PROP_ARC_VALUE] = {"lv_arc", "value", VALUE_INT, &lv_arc_class, set_arc_value, NULL},
+#endif
+};
+
+/*The widgets with a handle. Their slot is released when they are deleted.*/
+static lui_xml_handle_table_t handle_table = {NULL, 0, 0, LUI_XML_HANDLE_NO_SLOT};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint32_t lui_xml_update_get_handle(const char * path)
+{
+    lv_obj_t * obj = lui_xml_update_find(path);
+    if(obj == NULL) return 0;
+
+    /*Already has a handle?*/
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        if(lv_event_dsc_get_cb(dsc) == handle_delete_event_cb) {
+            uint32_t slot = (uint32_t)(lv_uintptr_t)lv_event_dsc_get_user_data(dsc);
+            return lui_xml_handle_table_get_handle(&handle_table, slot);
+        }
+    }
+
+    uint32_t slot = lui_xml_handle_table_add(&handle_table, obj);
+    if(slot == LUI_XML_HANDLE_NO_SLOT) {
+        LV_LOG_WARN("Out of update handles");
+        return 0;
+    }
+
+    lv_obj_add_event_cb(obj, handle_delete_event_cb, LV_EVENT_DELETE, (void *)(lv_uintptr_t)slot);
+
+    return lui_xml_handle_table_get_handle(&handle_table, slot);
+}
+
+lv_result_t lui_xml_update_apply_binary(const void * buf, uint32_t len)
+{
+    if(buf == NULL || ((lv_uintptr_t)buf & 0x3) != 0) {
+        LV_LOG_WARN("The binary update needs to be aligned to 4 bytes");
+        return LV_RESULT_INVALID;
+    }
+
+    /*Check everything first to not apply a part of a corrupted update*/
+    if(!update_is_valid(buf, len)) return LV_RESULT_INVALID;
+
+    const lui_xml_update_bin_header_t * header = buf;
+    const lui_xml_update_bin_record_t * records = (const lui_xml_update_bin_record_t *)(header + 1);
+    const char * str_data = (const char *)(records + header->record_cnt);
+
+    uint32_t i;
+    for(i = 0; i < header->record_cnt; i++) {
+        const lui_xml_update_bin_record_t * rec = &records[i];
+
+        lv_obj_t * obj;
+        if(rec->target & LUI_XML_UPDATE_BIN_TARGET_PATH) {
+            obj = lui_xml_update_find(&str_data[rec->target & ~LUI_XML_UPDATE_BIN_TARGET_PATH]);
+        }
+        else {
+            obj = handle_get_obj(rec->target);
+        }
+
+        if(obj == NULL) {
+            LV_LOG_WARN("The target of record %" LV_PRIu32 " is not found", i);
+            continue;
+        }
+
+        if(rec->prop == LUI_XML_UPDATE_PROP_ATTRS) {
+            apply_attrs(obj, &str_data[rec->value]);
+            continue;
+        }
+
+        const prop_dsc_t * dsc = &props[rec->prop];
+        if(dsc->class_p && !lv_obj_check_type(obj, dsc->class_p)) {
+            LV_LOG_WARN("The target of record %" LV_PRIu32 " doesn't have the `%s` property", i, dsc->name);
+            continue;
+        }
+
+        if(dsc->set_text_cb) dsc->set_text_cb(obj, &str_data[rec->value]);
+        else dsc->set_cb(obj, rec->value);
+    }
+
+    return LV_RESULT_OK;
+}
+
+void * lui_xml_update_to_binary(const char * xml_def, uint32_t * len)
+{
+    *len = 0;
+
+    bin_builder_t b;
+    lv_memzero(&b, sizeof(b));
+
+    XML_Memory_Handling_Suite mem_handlers;
+    mem_handlers.malloc_fcn = lv_malloc;
+    mem_handlers.realloc_fcn = lv_realloc;
+    mem_handlers.free_fcn = lv_free;
+    XML_Parser parser = XML_ParserCreate_MM(NULL, &mem_handlers, NULL);
+    XML_SetUserData(parser, &b);
+    XML_SetElementHandler(parser, to_binary_start_handler, to_binary_end_handler);
+
+    if(XML_Parse(parser, xml_def, lv_strlen(xml_def), XML_TRUE) == XML_STATUS_ERROR) {
+        LV_LOG_WARN("XML parsing error: %s on line %lu",
+                    XML_ErrorString(XML_GetErrorCode(parser)),
+                    (unsigned long)XML_GetCurrentLineNumber(parser));
+        b.error = true;
+    }
+    XML_ParserFree(parser);
+
+    uint8_t * buf = NULL;
+    if(!b.error) {
+        uint32_t str_data_size_aligned = (b.str_data_size + 3) & ~0x3;
+        uint32_t size = sizeof(lui_xml_update_bin_header_t) + b.record_cnt * sizeof(lui_xml_update_bin_record_t) +
+                        str_data_size_aligned;
+        buf = lv_zalloc(size);
+        LV_ASSERT_MALLOC(buf);
+        if(buf) {
+            lui_xml_update_bin_header_t * header = (lui_xml_update_bin_header_t *)buf;
+            lv_memcpy(header->magic, LUI_XML_UPDATE_BIN_MAGIC, 4);
+            header->version = LUI_XML_UPDATE_BIN_VERSION;
+            header->byte_order = LUI_XML_UPDATE_BIN_BYTE_ORDER;
+            header->record_cnt = b.record_cnt;
+            header->str_data_size = str_data_size_aligned;
+
+            uint8_t * records = buf + sizeof(lui_xml_update_bin_header_t);
+            if(b.record_cnt) lv_memcpy(records, b.records, b.record_cnt * sizeof(lui_xml_update_bin_record_t));
+            if(b.str_data_size) {
+                lv_memcpy(records + b.record_cnt * sizeof(lui_xml_update_bin_record_t), b.str_data, b.str_data_size);
+            }
+            *len = size;
+        }
+    }
+
+    lv_free(b.records);
+    lv_free(b.str_data);
+
+    return buf;
+}
+
+void lui_xml_update_bin_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < handle_table.cnt; i++) {
+        if(handle_table.slots[i].ptr) {
+            lv_obj_remove_event_cb_with_user_data(handle_table.slots[i].ptr, handle_delete_event_cb,
+                                                  (void *)(lv_uintptr_t)i);
+        }
+    }
+
+    lui_xml_handle_table_destroy(&handle_table);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool update_is_valid(const uint8_t * buf, uint32_t len)
+{
+    const lui_xml_update_bin_header_t * header = (const lui_xml_update_bin_header_t *)buf;
+
+    if(len < sizeof(lui_xml_update_bin_header_t) || lv_memcmp(header->magic, LUI_XML_UPDATE_BIN_MAGIC, 4) != 0) {
+        LV_LOG_WARN("Not a binary update");
+        return false;
+    }
+
+    if(header->byte_order != LUI_XML_UPDATE_BIN_BYTE_ORDER) {
+        LV_LOG_WARN("The binary update was written with a different byte order");
+        return false;
+    }
+
+    if(header->version != LUI_XML_UPDATE_BIN_VERSION) {
+        LV_LOG_WARN("Binary update version %" LV_PRIu32 " is not supported (expected %d)", header->version,
+                    LUI_XML_UPDATE_BIN_VERSION);
+        return false;
+    }
+
+    uint64_t records_size = (uint64_t)header->record_cnt * sizeof(lui_xml_update_bin_record_t);
+    if(records_size + header->str_data_size > len - sizeof(lui_xml_update_bin_header_t)) {
+        LV_LOG_WARN("The binary update is truncated");
+        return false;
+    }
+
+    const lui_xml_update_bin_record_t * records = (const lui_xml_update_bin_record_t *)(header + 1);
+    const char * str_data = (const char *)(records + header->record_cnt);
+
+    /*If the string data ends with '\0' all the strings are terminated inside it*/
+    if(header->str_data_size && str_data[header->str_data_size - 1] != '\0') {
+        LV_LOG_WARN("Invalid string data in the binary update");
+        return false;
+    }
+
+    uint32_t i;
+    for(i = 0; i < header->record_cnt; i++) {
+        const lui_xml_update_bin_record_t * rec = &records[i];
+
+        bool valid = true;
+        if(rec->target & LUI_XML_UPDATE_BIN_TARGET_PATH) {
+            valid = str_is_valid(rec->target & ~LUI_XML_UPDATE_BIN_TARGET_PATH, header->str_data_size);
+        }
+
+        if(rec->prop == LUI_XML_UPDATE_PROP_ATTRS) {
+            valid = valid && attrs_are_valid(str_data, header->str_data_size, rec->value);
+        }
+        else if(rec->prop >= LUI_XML_UPDATE_PROP_NUM ||
+                (props[rec->prop].set_cb == NULL && props[rec->prop].set_text_cb == NULL)) {
+            LV_LOG_WARN("Property %" LV_PRIu32 " of record %" LV_PRIu32 " is unknown or not enabled", rec->prop, i);
+            valid = false;
+        }
+        else if(props[rec->prop].set_text_cb) {
+            valid = valid && str_is_valid(rec->value, header->str_data_size);
+        }
+
+        if(!valid) {
+            LV_LOG_WARN("Invalid record %" LV_PRIu32 " in the binary update", i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool str_is_valid(int64_t offset, uint32_t str_data_size)
+{
+    return offset >= 0 && offset < str_data_size;
+}
+
+/**
+ * Check that a "widget\0name\0value\0...\0\0" list is inside the string data
+ */
+static bool attrs_are_valid(const char * str_data, uint32_t str_data_size, uint32_t offset)
+{
+    /*The widget's name, then name-value pairs until an empty name*/
+    uint32_t str_i = 0;
+    while(true) {
+        if(!str_is_valid(offset, str_data_size)) return false;
+
+        const char * str = &str_data[offset];
+        if(str_i > 0 && str_i % 2 == 1 && str[0] == '\0') return true;
+
+        offset += lv_strlen(str) + 1;
+        str_i++;
+    }
+}
+
+static void apply_attrs(lv_obj_t * obj, const char * attrs_str)
+{
+    const char * widget = attrs_str;
+    lv_widget_processor_t * proc = lui_xml_widget_get_processor(widget);
+    if(proc == NULL) {
+        LV_LOG_WARN("%s is not a known widget", widget);
+        return;
+    }
+
+    const char * first_attr = widget + lv_strlen(widget) + 1;
+    uint32_t attr_cnt = 0;
+    const char * str = first_attr;
+    while(str[0] != '\0') {
+        str += lv_strlen(str) + 1;  /*Name*/
+        str += lv_strlen(str) + 1;  /*Value*/
+        attr_cnt++;
+    }
+
+    const char ** attrs = lv_malloc((attr_cnt * 2 + 1) * sizeof(const char *));
+    LV_ASSERT_MALLOC(attrs);
+    if(attrs == NULL) return;
+
+    str = first_attr;
+    uint32_t i;
+    for(i = 0; i < attr_cnt * 2; i++) {
+        attrs[i] = str;
+        str += lv_strlen(str) + 1;
+    }
+    attrs[attr_cnt * 2] = NULL;
+
+    lui_xml_parser_state_t state;
+    lui_xml_parser_state_init(&state);
+    state.item = obj;
+    proc->apply_cb(&state, attrs);
+
+    lv_free(attrs);
+}
+
+static lv_obj_t * handle_get_obj(uint32_t handle)
+{
+    const lui_xml_handle_slot_t * s = lui_xml_handle_table_get_slot(&handle_table, handle);
+    return s ? s->ptr : NULL;
+}
+
+static void handle_delete_event_cb(lv_event_t * e)
+{
+    uint32_t slot = (uint32_t)(lv_uintptr_t)lv_event_get_user_data(e);
+
+    lui_xml_handle_table_remove(&handle_table, slot);
+}
+
+/**
+ * Find the record property of an attribute
+ * @param widget    the widget type from the `update-...` tag
+ * @param name      name of the attribute
+ * @param attrs     all the attributes of the element
+ * @return          a `lui_xml_update_prop_t` or -1 if the attribute needs to be applied by the widget's parser
+ */
+static int32_t find_prop(const char * widget, const char * name, const char ** attrs)
+{
+    int32_t id;
+    for(id = 0; id < LUI_XML_UPDATE_PROP_NUM; id++) {
+        const prop_dsc_t * dsc = &props[id];
+        if(dsc->name == NULL || !lv_streq(dsc->name, name)) continue;
+        if(dsc->widget && !lv_streq(dsc->widget, widget)) continue;
+        break;
+    }
+
+    if(id == LUI_XML_UPDATE_PROP_NUM) return -1;
+
+    /*E.g. `value-animated` changes how `value` is set*/
+    char animated[64];
+    lv_snprintf(animated, sizeof(animated), "%s-animated", name);
+    if(lui_xml_get_value_of(attrs, animated)) return -1;
+
+    return id;
+}
+
+static void to_binary_start_handler(void * user_data, const char * name, const char ** attrs)
+{
+    bin_builder_t * b = user_data;
+
+    /*Just wraps a batch of updates*/
+    if(lv_streq(name, "updates")) return;
+
+    size_t update_len = lv_strlen("update-");
+    if(lv_strlen(name) <= update_len || lv_memcmp(name, "update-", update_len)) {
+        LV_LOG_WARN("%s doesn't start with `update-`", name);
+        return;
+    }
+
+    const char * widget = &name[update_len];
+    if(lui_xml_widget_get_processor(widget) == NULL) {
+        LV_LOG_WARN("%s is not a known widget", widget);
+        return;
+    }
+
+    const char * path = lui_xml_get_value_of(attrs, "name");
+    if(path == NULL) {
+        LV_LOG_WARN("There is no name property");
+        return;
+    }
+
+    uint32_t target = lui_xml_update_get_handle(path);
+    if(target == 0) target = LUI_XML_UPDATE_BIN_TARGET_PATH | builder_add_str(b, path);
+
+    uint32_t attrs_offset = 0;
+    bool has_attrs = false;
+
+    uint32_t i;
+    for(i = 0; attrs[i]; i += 2) {
+        if(lv_streq(attrs[i], "name")) continue;
+
+        int32_t id = find_prop(widget, attrs[i], attrs);
+        if(id < 0) {
+            /*Collect them into a list to apply them together*/
+            if(!has_attrs) {
+                attrs_offset = builder_add_str(b, widget);
+                has_attrs = true;
+            }
+            builder_add_str(b, attrs[i]);
+            builder_add_str(b, attrs[i + 1]);
+            continue;
+        }
+
+        const char * value = attrs[i + 1];
+        int32_t v;
+        switch(props[id].type) {
+            case VALUE_SIZE:
+                v = lui_xml_to_size(value);
+                break;
+            case VALUE_INT:
+                v = lui_xml_atoi(value);
+                break;
+            case VALUE_BOOL:
+                v = lui_xml_to_bool(value);
+                break;
+            case VALUE_ALIGN:
+                v = lui_xml_align_to_enum(value);
+                break;
+            case VALUE_OPA:
+                v = lui_xml_to_opa(value);
+                break;
+            case VALUE_COLOR:
+                v = (int32_t)lv_color_to_int(lui_xml_to_color(value));
+                break;
+            case VALUE_STRING:
+            default:
+                v = (int32_t)builder_add_str(b, value);
+                break;
+        }
+
+        builder_add_record(b, target, id, v);
+    }
+
+    if(has_attrs) {
+        builder_add_str(b, "");
+        builder_add_record(b, target, LUI_XML_UPDATE_PROP_ATTRS, (int32_t)attrs_offset);
+    }
+}
+
+static void to_binary_end_handler(void * user_data, const char * name)
+{
+    LV_UNUSED(user_data);
+    LV_UNUSED(name);
+}
+
+static void builder_add_record(bin_builder_t * b, uint32_t target, uint32_t prop, int32_t value)
+{
+    if(b->error) return;
+
+    if(b->record_cnt == b->record_cap) {
+        uint32_t cap = b->record_cap ? b->record_cap * 2 : 16;
+        lui_xml_update_bin_record_t * records = lv_realloc(b->records, cap * sizeof(lui_xml_update_bin_record_t));
+        LV_ASSERT_MALLOC(records);
+        if(records == NULL) {
+            b->error = true;
+            return;
+        }
+        b->records = records;
+        b->record_cap = cap;
+    }
+
+    lui_xml_update_bin_record_t * rec = &b->records[b->record_cnt];
+    rec->target = target;
+    rec->prop = prop;
+    rec->value = value;
+    b->record_cnt++;
+}
+
+/**
+ * Append a string to the string data
+ * @return      offset of the string
+ */
+static uint32_t builder_add_str(bin_builder_t * b, const char * str)
+{
+    if(b->error) return 0;
+
+    uint32_t len = lv_strlen(str) + 1;
+    if(b->str_data_size + len > b->str_data_cap) {
+        uint32_t cap = LV_MAX(b->str_data_cap * 2, b->str_data_size + len + 64);
+        char * str_data = lv_realloc(b->str_data, cap);
+        LV_ASSERT_MALLOC(str_data);
+        if(str_data == NULL) {
+            b->error = true;
+            return 0;
+        }
+        b->str_data = str_data;
+        b->str_data_cap = cap;
+    }
+
+    uint32_t offset = b->str_data_size;
+    lv_memcpy(&b->str_data[offset], str, len);
+    b->str_data_size += len;
+
+    return offset;
+}
+
+static void set_x(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_x(obj, value);
+}
+
+static void set_y(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_y(obj, value);
+}
+
+static void set_width(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_width(obj, value);
+}
+
+static void set_height(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_height(obj, value);
+}
+
+static void set_align(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_align(obj, (lv_align_t)value);
+}
+
+static void set_hidden(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_flag(obj, LV_OBJ_FLAG_HIDDEN, value != 0);
+}
+
+static void set_clickable(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_flag(obj, LV_OBJ_FLAG_CLICKABLE, value != 0);
+}
+
+static void set_checked(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_state(obj, LV_STATE_CHECKED, value != 0);
+}
+
+static void set_disabled(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_state(obj, LV_STATE_DISABLED, value != 0);
+}
+
+static void set_style_opa(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_style_opa(obj, (lv_opa_t)value, 0);
+}
+
+static void set_style_bg_color(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_style_bg_color(obj, lv_color_hex((uint32_t)value), 0);
+}
+
+static void set_style_text_color(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_set_style_text_color(obj, lv_color_hex((uint32_t)value), 0);
+}
+
+#if LV_USE_LABEL
+static void set_label_text(lv_obj_t * obj, const char * value)
+{
+    lv_label_set_text(obj, value);
+}
+#endif
+
+#if LV_USE_BAR
+static void set_bar_value(lv_obj_t * obj, int32_t value)
+{
+    lv_bar_set_value(obj, value, LV_ANIM_OFF);
+}
+#endif
+
+#if LV_USE_SLIDER
+static void set_slider_value(lv_obj_t * obj, int32_t value)
+{
+    lv_slider_set_value(obj, value, LV_ANIM_OFF);
+}
+#endif
+
+#if LV_USE_ARC
+static void set_arc_value(lv_obj_t * obj, int32_t value)
+{
+    lv_arc_set_value(obj, value);
+}
+#endif
+
+#endif /* LV_USE_XML && LV_USE_OBJ_NAME */
@@ -0,0 +1,129 @@
+/**
+ * @file lui_xml_update_bin.h
+ *
+ */
+
+#ifndef LUI_XML_UPDATE_BIN_H
+#define LUI_XML_UPDATE_BIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#if LV_USE_XML && LV_USE_OBJ_NAME
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Version of the binary update format. Updates with other versions are rejected.*/
+#define LUI_XML_UPDATE_BIN_VERSION 1
+
+#define LUI_XML_UPDATE_BIN_MAGIC        "LXUP"
+#define LUI_XML_UPDATE_BIN_BYTE_ORDER   0x01020304
+
+/** Set in the target of a record if it's the offset of a path string instead of a handle*/
+#define LUI_XML_UPDATE_BIN_TARGET_PATH  0x80000000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The properties which can be set directly by a record. The value of the record is
+ * an integer, or the offset of a string for the `_TEXT` properties.
+ * The ids are part of the format, so new properties are added only at the end.
+ */
+typedef enum {
+    LUI_XML_UPDATE_PROP_X,              /**< Coordinate, as `lui_xml_to_size()` converts it*/
+    LUI_XML_UPDATE_PROP_Y,
+    LUI_XML_UPDATE_PROP_WIDTH,
+    LUI_XML_UPDATE_PROP_HEIGHT,
+    LUI_XML_UPDATE_PROP_ALIGN,          /**< `lv_align_t`*/
+    LUI_XML_UPDATE_PROP_HIDDEN,         /**< 0 or 1*/
+    LUI_XML_UPDATE_PROP_CLICKABLE,
+    LUI_XML_UPDATE_PROP_CHECKED,
+    LUI_XML_UPDATE_PROP_DISABLED,
+    LUI_XML_UPDATE_PROP_STYLE_OPA,      /**< `lv_opa_t` on the main part*/
+    LUI_XML_UPDATE_PROP_STYLE_BG_COLOR, /**< 0xRRGGBB on the main part*/
+    LUI_XML_UPDATE_PROP_STYLE_TEXT_COLOR,
+    LUI_XML_UPDATE_PROP_LABEL_TEXT,     /**< Offset of the text*/
+    LUI_XML_UPDATE_PROP_BAR_VALUE,      /**< Set without animation*/
+    LUI_XML_UPDATE_PROP_SLIDER_VALUE,
+    LUI_XML_UPDATE_PROP_ARC_VALUE,
+    LUI_XML_UPDATE_PROP_NUM,
+
+    /** Any attributes applied by the widget's XML parser. The value is the offset of
+     *  "widget\0name\0value\0name\0value\0...\0\0", e.g. `"lv_slider\0value\0" "30\0\0"`*/
+    LUI_XML_UPDATE_PROP_ATTRS = 0xFFFF,
+} lui_xml_update_prop_t;
+
+/*
+ * Layout of a binary update. All the fields are 32 bit words in the byte order of the target.
+ *
+ * - header
+ * - records: `record_cnt` records, applied in order
+ * - string data: NULL terminated strings, referenced by their offset from the start of the data
+ */
+
+typedef struct {
+    char magic[4];              /**< LUI_XML_UPDATE_BIN_MAGIC*/
+    uint32_t version;           /**< LUI_XML_UPDATE_BIN_VERSION*/
+    uint32_t byte_order;        /**< LUI_XML_UPDATE_BIN_BYTE_ORDER as written by the sender*/
+    uint32_t record_cnt;
+    uint32_t str_data_size;
+} lui_xml_update_bin_header_t;
+
+typedef struct {
+    uint32_t target;            /**< A handle or `LUI_XML_UPDATE_BIN_TARGET_PATH | string offset`*/
+    uint32_t prop;              /**< A `lui_xml_update_prop_t`*/
+    int32_t value;              /**< The value or the offset of a string*/
+} lui_xml_update_bin_record_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get a handle to a widget to address it in binary updates.
+ * The widget is found by `lui_xml_update_find()`. The same widget always gets the same
+ * handle, and the handle becomes invalid when the widget is deleted.
+ * @param path      name of the widget, optionally prefixed by the name of its screen
+ * @return          the handle or 0 if the widget is not found
+ */
+uint32_t lui_xml_update_get_handle(const char * path);
+
+/**
+ * Apply a binary update. The records addressing deleted or unknown widgets, and the ones
+ * with properties not supported by the widget are skipped with a warning.
+ * @param buf       the update, aligned to 4 bytes
+ * @param len       size of the update in bytes
+ * @return          LV_RESULT_OK: applied, LV_RESULT_INVALID: the update is corrupted and nothing was applied
+ */
+lv_result_t lui_xml_update_apply_binary(const void * buf, uint32_t len);
+
+/**
+ * Convert XML update snippets, as accepted by `lui_xml_update_from_data()`, to a binary update.
+ * The targets are converted to handles if they exist already, else their paths are stored.
+ * The attributes without a `lui_xml_update_prop_t` are stored as `LUI_XML_UPDATE_PROP_ATTRS`.
+ * @param xml_def   the XML to convert as a string
+ * @param len       store the size of the binary update here
+ * @return          the binary update (free with `lv_free()`) or NULL on error
+ */
+void * lui_xml_update_to_binary(const char * xml_def, uint32_t * len);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_XML && LV_USE_OBJ_NAME */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_UPDATE_BIN_H*/
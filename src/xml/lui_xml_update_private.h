@@ -0,0 +1,69 @@
+/**
+ * @file lui_xml_update_private.h
+ *
+ */
+
+#ifndef LUI_XML_UPDATE_PRIVATE_H
+#define LUI_XML_UPDATE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lui_xml_update.h"
+#if LV_USE_XML && LV_USE_OBJ_NAME
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Invalidate the handles of the binary updates
+ */
+void lui_xml_update_bin_deinit(void);
+
+#if LUI_XML_USE_NAME_INDEX
+
+/**
+ * Add a widget to the name index with its current name, or move it if it was renamed.
+ * Indexed names (containing `#`) are not added. The widget is removed when it's deleted.
+ * @param obj       the widget whose name was set
+ */
+void lui_xml_update_index_add(lv_obj_t * obj);
+
+/**
+ * Remove all the widgets from the name index
+ */
+void lui_xml_update_index_deinit(void);
+
+#endif /*LUI_XML_USE_NAME_INDEX*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#if LUI_XML_USE_NAME_INDEX
+#define LUI_XML_UPDATE_INDEX_ADD(obj)   lui_xml_update_index_add(obj)
+#else
+#define LUI_XML_UPDATE_INDEX_ADD(obj)
+#endif
+
+#endif /*LV_USE_XML && LV_USE_OBJ_NAME*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LUI_XML_UPDATE_PRIVATE_H*/
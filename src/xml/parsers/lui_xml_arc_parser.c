@@ -11,6 +11,7 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
 
 /*********************
  *      DEFINES
@@ -64,7 +65,7 @@ void lui_xml_arc_apply(lui_xml_parser_state_t * state, const char ** attrs)
         else if(lv_streq("max_value", name)) lv_arc_set_max_value(item, lui_xml_atoi(value));
         else if(lv_streq("mode", name)) lv_arc_set_mode(item, mode_text_to_enum_value(value));
         else if(lv_streq("bind_value", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_arc_bind_value(item, subject);
             }
@@ -11,6 +11,7 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
 
 /*********************
  *      DEFINES
@@ -72,7 +73,7 @@ void lui_xml_bar_apply(lui_xml_parser_state_t * state, const char ** attrs)
         else if(lv_streq("orientation", name)) lv_bar_set_orientation(item, orientation_text_to_enum_value(value));
         else if(lv_streq("mode", name)) lv_bar_set_mode(item, mode_text_to_enum_value(value));
         else if(lv_streq("bind_value", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_bar_bind_value(item, subject);
             }
@@ -11,6 +11,7 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
 
 /*********************
  *      DEFINES
@@ -60,7 +61,7 @@ void lui_xml_dropdown_apply(lui_xml_parser_state_t * state, const char ** attrs)
         else if(lv_streq("selected", name)) lv_dropdown_set_selected(item, lui_xml_atoi(value));
         else if(lv_streq("symbol", name)) lv_dropdown_set_symbol(item, lui_xml_get_image(&state->scope, value));
         else if(lv_streq("bind_value", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_dropdown_bind_value(item, subject);
             }
@@ -11,6 +11,7 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
 
 /*********************
  *      DEFINES
@@ -68,7 +69,7 @@ void lui_xml_image_apply(lui_xml_parser_state_t * state, const char ** attrs)
         else if(lv_streq("pivot_x", name)) lv_image_set_pivot_x(item, lui_xml_to_size(value));
         else if(lv_streq("pivot_y", name)) lv_image_set_pivot_y(item, lui_xml_to_size(value));
         else if(lv_streq("bind_src", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_image_bind_src(item, subject);
             }
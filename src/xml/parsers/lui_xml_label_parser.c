@@ -11,6 +11,8 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
+#include "../lui_xml_fmt_private.h"
 
 /*********************
  *      DEFINES
@@ -61,12 +63,20 @@ void lui_xml_label_apply(lui_xml_parser_state_t * state, const char ** attrs)
         else if(lv_streq("translation_tag", name)) lv_label_set_translation_tag(item, value);
 #endif
         else if(lv_streq("bind_text", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject == NULL) {
                 LV_LOG_WARN("Subject \"%s\" doesn't exist in label bind_text", value);
                 continue;
             }
             const char * fmt = lui_xml_get_value_of(attrs, "bind_text-fmt");
+#if LUI_XML_USE_COMPILED_FMT
+            /*Compiled once and shared by all the labels with the same format*/
+            const lui_xml_fmt_t * compiled = fmt ? lui_xml_fmt_get(fmt) : NULL;
+            if(compiled) {
+                lui_xml_fmt_bind_label(item, subject, compiled);
+                continue;
+            }
+#endif
             if(fmt) {
                 fmt = lv_strdup(fmt);
                 lv_obj_add_event_cb(item, lv_event_free_user_data_cb, LV_EVENT_DELETE, (void *) fmt);
@@ -11,6 +11,10 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_update_private.h"
+#include "../lui_xml_subject_private.h"
+#include "../lui_xml_bind_private.h"
+#include "../lui_xml_event_private.h"
 
 /*********************
  *      DEFINES
@@ -38,10 +42,18 @@ typedef struct {
     lv_obj_t * base_obj; /**< Get the objs by name from here (the view) */
 } play_anim_dsc_t;
 
+typedef struct {
+    lv_subject_t * subject;
+    char value[];
+} subject_set_string_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_obj_flag_t flag_to_enum(const char * txt);
+#if LUI_XML_USE_SHARED_BINDINGS
+    static lui_xml_bind_op_t bind_op_to_enum(const char * txt, const char * prefix);
+#endif
 static void apply_styles(lui_xml_parser_state_t * state, lv_obj_t * obj, const char * name, const char * value);
 static void screen_create_on_trigger_event_cb(lv_event_t * e);
 static void screen_load_on_trigger_event_cb(lv_event_t * e);
@@ -49,6 +61,7 @@ static void delete_on_screen_unloaded_event_cb(lv_event_t * e);
 static void free_screen_create_user_data_on_delete_event_cb(lv_event_t * e);
 static void play_anim_on_trigger_event_cb(lv_event_t * e);
 static void free_play_anim_user_data_on_delete_event_cb(lv_event_t * e);
+static void subject_set_string_event_cb(lv_event_t * e);
 
 /**********************
  *  STATIC VARIABLES
@@ -87,6 +100,7 @@ void lui_xml_obj_apply(lui_xml_parser_state_t * state, const char ** attrs)
 #if LV_USE_OBJ_NAME
         if(lv_streq("name", name)) {
             lv_obj_set_name(item, value);
+            LUI_XML_UPDATE_INDEX_ADD(item);
         }
 #endif
         if(lv_streq("x", name)) lv_obj_set_x(item, lui_xml_to_size(value));
@@ -156,7 +170,7 @@ void lui_xml_obj_apply(lui_xml_parser_state_t * state, const char ** attrs)
         else if(lv_streq("disabled", name)) lv_obj_set_state(item, LV_STATE_DISABLED, lui_xml_to_bool(value));
 
         else if(lv_streq("bind_checked", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_obj_bind_checked(item, subject);
             }
@@ -266,7 +280,11 @@ void lv_obj_xml_event_cb_apply(lui_xml_parser_state_t * state, const char ** att
     }
 
     lv_obj_t * obj = lui_xml_state_get_parent(state);
+#if LUI_XML_USE_EVENT_CB_CACHE
+    lv_event_cb_t cb = lui_xml_event_cache_get_cb(&state->scope, cb_str);
+#else
     lv_event_cb_t cb = lui_xml_get_event_cb(&state->scope, cb_str);
+#endif
     if(cb == NULL) {
         LV_LOG_WARN("Couldn't add call function event because `%s` callback is not found.", cb_str);
         return;
@@ -390,7 +408,17 @@ void lv_obj_xml_subject_set_apply(lui_xml_parser_state_t * state, const char **
 #endif
     }
     else if(subject_type == LV_SUBJECT_TYPE_STRING) {
-        lv_obj_add_subject_set_string_event(item, subject, trigger, value_str);
+        /*Not `lv_obj_add_subject_set_string_event()` as growable string subjects
+         *need to be set by `lui_xml_subject_copy_string()`*/
+        size_t value_len = lv_strlen(value_str);
+        subject_set_string_dsc_t * dsc = lv_malloc(sizeof(subject_set_string_dsc_t) + value_len + 1);
+        LV_ASSERT_MALLOC(dsc);
+        if(dsc == NULL) return;
+        dsc->subject = subject;
+        lv_memcpy(dsc->value, value_str, value_len + 1);
+
+        lv_obj_add_event_cb(item, subject_set_string_event_cb, trigger, dsc);
+        lv_obj_add_event_cb(item, lv_event_free_user_data_cb, LV_EVENT_DELETE, dsc);
     }
 }
 
@@ -473,7 +501,7 @@ void lv_obj_xml_bind_style_apply(lui_xml_parser_state_t * state, const char ** a
         return;
     }
 
-    lv_subject_t * subject = lui_xml_get_subject(&state->scope, subject_str);
+    lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, subject_str);
     if(subject == NULL) {
         LV_LOG_WARN("Subject `%s` doesn't exist in lv_obj bind_style", subject_str);
         return;
@@ -518,7 +546,7 @@ void lv_obj_xml_bind_style_prop_apply(lui_xml_parser_state_t * state, const char
         return;
     }
 
-    lv_subject_t * subject = lui_xml_get_subject(&state->scope, subject_str);
+    lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, subject_str);
     if(subject == NULL) {
         LV_LOG_WARN("Subject `%s` doesn't exist in lv_obj bind_style_prop", subject_str);
         return;
@@ -545,6 +573,13 @@ void lv_obj_xml_bind_flag_apply(lui_xml_parser_state_t * state, const char ** at
     /*If starts with "lv_obj-" skip that part*/
     if(op[0] == 'l') op += 7;
 
+#if LUI_XML_USE_SHARED_BINDINGS
+    lui_xml_bind_op_t bind_op = bind_op_to_enum(op, "bind_flag_if_");
+    if(bind_op == LUI_XML_BIND_OP_INVALID) {
+        LV_LOG_WARN("`%s` is not known", op);
+        return;
+    }
+#else
     lv_observer_t * (*cb)(lv_obj_t * obj, lv_subject_t * subject, lv_obj_flag_t flag, int32_t ref_value) = NULL;
     if(lv_streq(op, "bind_flag_if_eq")) cb = lv_obj_bind_flag_if_eq;
     else if(lv_streq(op, "bind_flag_if_not_eq")) cb = lv_obj_bind_flag_if_not_eq;
@@ -556,6 +591,7 @@ void lv_obj_xml_bind_flag_apply(lui_xml_parser_state_t * state, const char ** at
         LV_LOG_WARN("`%s` is not known", op);
         return;
     }
+#endif
 
     const char * subject_str =  lui_xml_get_value_of(attrs, "subject");
     const char * flag_str =  lui_xml_get_value_of(attrs, "flag");
@@ -571,7 +607,7 @@ void lv_obj_xml_bind_flag_apply(lui_xml_parser_state_t * state, const char ** at
         LV_LOG_WARN("`ref_value` is missing in lv_obj bind_flag");
     }
     else {
-        lv_subject_t * subject = lui_xml_get_subject(&state->scope, subject_str);
+        lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, subject_str);
         if(subject == NULL) {
             LV_LOG_WARN("Subject `%s` doesn't exist in lv_obj bind_flag", subject_str);
         }
@@ -579,7 +615,11 @@ void lv_obj_xml_bind_flag_apply(lui_xml_parser_state_t * state, const char ** at
             lv_obj_flag_t flag = flag_to_enum(flag_str);
             int32_t ref_value = lui_xml_atoi(ref_value_str);
             void * item = lui_xml_state_get_item(state);
+#if LUI_XML_USE_SHARED_BINDINGS
+            lui_xml_bind_flag_if(item, subject, bind_op, flag, ref_value);
+#else
             cb(item, subject, flag, ref_value);
+#endif
         }
     }
 }
@@ -598,6 +638,13 @@ void lv_obj_xml_bind_state_apply(lui_xml_parser_state_t * state, const char ** a
     /*If starts with "lv_obj-" skip that part*/
     if(op[0] == 'l') op += 7;
 
+#if LUI_XML_USE_SHARED_BINDINGS
+    lui_xml_bind_op_t bind_op = bind_op_to_enum(op, "bind_state_if_");
+    if(bind_op == LUI_XML_BIND_OP_INVALID) {
+        LV_LOG_WARN("`%s` is not known", op);
+        return;
+    }
+#else
     lv_observer_t * (*cb)(lv_obj_t * obj, lv_subject_t * subject, lv_state_t flag, int32_t ref_value) = NULL;
     if(lv_streq(op, "bind_state_if_eq")) cb = lv_obj_bind_state_if_eq;
     else if(lv_streq(op, "bind_state_if_not_eq")) cb = lv_obj_bind_state_if_not_eq;
@@ -609,6 +656,7 @@ void lv_obj_xml_bind_state_apply(lui_xml_parser_state_t * state, const char ** a
         LV_LOG_WARN("`%s` is not known", op);
         return;
     }
+#endif
 
     const char * subject_str =  lui_xml_get_value_of(attrs, "subject");
     const char * state_str =  lui_xml_get_value_of(attrs, "state");
@@ -624,7 +672,7 @@ void lv_obj_xml_bind_state_apply(lui_xml_parser_state_t * state, const char ** a
         LV_LOG_WARN("`ref_value` is missing in lv_obj state_flag");
     }
     else {
-        lv_subject_t * subject = lui_xml_get_subject(&state->scope, subject_str);
+        lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, subject_str);
         if(subject == NULL) {
             LV_LOG_WARN("Subject `%s` doesn't exist in bind_state", subject_str);
         }
@@ -632,7 +680,11 @@ void lv_obj_xml_bind_state_apply(lui_xml_parser_state_t * state, const char ** a
             lv_state_t s = lui_xml_state_to_enum(state_str);
             int32_t ref_value = lui_xml_atoi(ref_value_str);
             void * item = lui_xml_state_get_item(state);
+#if LUI_XML_USE_SHARED_BINDINGS
+            lui_xml_bind_state_if(item, subject, bind_op, s, ref_value);
+#else
             cb(item, subject, s, ref_value);
+#endif
         }
     }
 }
@@ -795,6 +847,29 @@ void lv_obj_xml_play_timeline_event_apply(lui_xml_parser_state_t * state, const
  *   STATIC FUNCTIONS
  **********************/
 
+#if LUI_XML_USE_SHARED_BINDINGS
+/**
+ * Convert the condition of a `bind_flag_if_*` or `bind_state_if_*` element
+ * @param txt       the name of the element, e.g. "bind_flag_if_not_eq"
+ * @param prefix    the part before the condition, e.g. "bind_flag_if_"
+ * @return          the condition or `LUI_XML_BIND_OP_INVALID` if it's not known
+ */
+static lui_xml_bind_op_t bind_op_to_enum(const char * txt, const char * prefix)
+{
+    size_t prefix_len = lv_strlen(prefix);
+    if(lv_strncmp(txt, prefix, prefix_len) != 0) return LUI_XML_BIND_OP_INVALID;
+    txt += prefix_len;
+
+    if(lv_streq("eq", txt)) return LUI_XML_BIND_OP_EQ;
+    if(lv_streq("not_eq", txt)) return LUI_XML_BIND_OP_NOT_EQ;
+    if(lv_streq("gt", txt)) return LUI_XML_BIND_OP_GT;
+    if(lv_streq("ge", txt)) return LUI_XML_BIND_OP_GE;
+    if(lv_streq("lt", txt)) return LUI_XML_BIND_OP_LT;
+    if(lv_streq("le", txt)) return LUI_XML_BIND_OP_LE;
+    return LUI_XML_BIND_OP_INVALID;
+}
+#endif
+
 static lv_obj_flag_t flag_to_enum(const char * txt)
 {
     if(lv_streq("hidden", txt)) return LV_OBJ_FLAG_HIDDEN;
@@ -1133,4 +1208,10 @@ static void free_play_anim_user_data_on_delete_event_cb(lv_event_t * e)
     lv_free(dsc);
 }
 
+static void subject_set_string_event_cb(lv_event_t * e)
+{
+    subject_set_string_dsc_t * dsc = lv_event_get_user_data(e);
+    lui_xml_subject_copy_string(dsc->subject, dsc->value);
+}
+
 #endif /* LV_USE_XML */
@@ -11,6 +11,7 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
 
 /*********************
  *      DEFINES
@@ -106,7 +107,7 @@ void lui_xml_scale_section_apply(lui_xml_parser_state_t * state, const char ** a
             lv_scale_set_section_style_items(scale, section, &style_dsc->style);
         }
         else if(lv_streq("bind_min_value", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_scale_bind_section_min_value(scale, section, subject);
             }
@@ -115,7 +116,7 @@ void lui_xml_scale_section_apply(lui_xml_parser_state_t * state, const char ** a
             }
         }
         else if(lv_streq("bind_max_value", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_scale_bind_section_max_value(scale, section, subject);
             }
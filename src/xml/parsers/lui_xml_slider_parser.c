@@ -11,6 +11,7 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
 
 /*********************
  *      DEFINES
@@ -68,7 +69,7 @@ void lui_xml_slider_apply(lui_xml_parser_state_t * state, const char ** attrs)
             lv_slider_set_start_value(item, v, anim);
         }
         else if(lv_streq("bind_value", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_slider_bind_value(item, subject);
             }
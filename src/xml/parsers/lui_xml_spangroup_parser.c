@@ -11,6 +11,8 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
+#include "../lui_xml_fmt_private.h"
 
 /*********************
  *      DEFINES
@@ -88,12 +90,20 @@ void lui_xml_spangroup_span_apply(lui_xml_parser_state_t * state, const char **
             lv_spangroup_set_span_style(spangroup, span, &style_dsc->style);
         }
         else if(lv_streq("bind_text", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject == NULL) {
                 LV_LOG_WARN("Subject \"%s\" doesn't exist in spangroup span bind_text", value);
                 continue;
             }
             const char * fmt = lui_xml_get_value_of(attrs, "bind_text-fmt");
+#if LUI_XML_USE_COMPILED_FMT
+            /*The spans are formatted by LVGL, but the format string is shared instead of copied*/
+            const lui_xml_fmt_t * compiled = fmt ? lui_xml_fmt_get(fmt) : NULL;
+            if(compiled) {
+                lv_spangroup_bind_span_text(spangroup, span, subject, lui_xml_fmt_get_str(compiled));
+                continue;
+            }
+#endif
             if(fmt) {
                 fmt = lv_strdup(fmt);
                 lv_obj_add_event_cb(spangroup, lv_event_free_user_data_cb, LV_EVENT_DELETE, (void *) fmt);
@@ -11,6 +11,7 @@
 
 #include <lvgl.h>
 #include "luixml_compat.h"
+#include "../lui_xml_subject_private.h"
 
 /*********************
  *      DEFINES
@@ -61,7 +62,7 @@ void lui_xml_spinbox_apply(lui_xml_parser_state_t * state, const char ** attrs)
         else if(lv_streq("max_value", name)) lv_spinbox_set_max_value(item, lui_xml_atoi(value));
         else if(lv_streq("step", name)) lv_spinbox_set_step(item, lui_xml_atoi(value));
         else if(lv_streq("bind_value", name)) {
-            lv_subject_t * subject = lui_xml_get_subject(&state->scope, value);
+            lv_subject_t * subject = lui_xml_get_bind_subject(&state->scope, value);
             if(subject) {
                 lv_spinbox_bind_value(item, subject);
             }
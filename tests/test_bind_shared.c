@@ -0,0 +1,147 @@
+/**
+ * @file test_bind_shared.c
+ * @brief Shared bindings: widgets with the same bind_flag_if_* / bind_state_if_* rule share an observer
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_subject.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BIND_WIDGET_COUNT   800
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <subjects>\n"
+    "    <int name=\"bs_edit_mode\" value=\"0\"/>\n"
+    "  </subjects>\n"
+    "</globals>\n";
+
+static const char * item_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\">\n"
+    "    <lv_obj-bind_flag_if_eq subject=\"bs_edit_mode\" flag=\"hidden\" ref_value=\"1\"/>\n"
+    "    <lv_obj-bind_state_if_ge subject=\"bs_edit_mode\" state=\"disabled\" ref_value=\"2\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static bool all_match(lv_obj_t * screen, uint32_t start, bool hidden, bool disabled)
+{
+    uint32_t cnt = lv_obj_get_child_count(screen);
+    uint32_t i;
+    for (i = start; i < cnt; i++) {
+        lv_obj_t * item = lv_obj_get_child(screen, i);
+        if (lv_obj_has_flag(item, LV_OBJ_FLAG_HIDDEN) != hidden) return false;
+        if (lv_obj_has_state(item, LV_STATE_DISABLED) != disabled) return false;
+    }
+    return true;
+}
+
+/* Test: All the widgets follow the subject, also after some of them are deleted */
+int test_bind_shared_fan_out(void)
+{
+    printf("TEST: Update %d widgets bound by the same rule...\n", BIND_WIDGET_COUNT);
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("bs_item", item_xml);
+    lv_subject_t * subject = lui_xml_get_subject(NULL, "bs_edit_mode");
+    lv_obj_t * screen = test_create_screen();
+
+    int i;
+    for (i = 0; i < BIND_WIDGET_COUNT; i++) lui_xml_create(screen, "bs_item", NULL);
+
+    bool ok = subject != NULL && all_match(screen, 0, false, false);
+
+    double start = now_ms();
+    lv_subject_set_int(subject, 1);
+    double notify_time = now_ms() - start;
+    ok = ok && all_match(screen, 0, true, false);
+
+    lv_subject_set_int(subject, 2);
+    ok = ok && all_match(screen, 0, false, true);
+
+    /* Delete every second widget */
+    for (i = BIND_WIDGET_COUNT - 2; i >= 0; i -= 2) lv_obj_delete(lv_obj_get_child(screen, i));
+    ok = ok && lv_obj_get_child_count(screen) == BIND_WIDGET_COUNT / 2;
+
+    lv_subject_set_int(subject, 1);
+    ok = ok && all_match(screen, 0, true, false);
+
+    /* The bindings are removed with the last widget */
+    lv_obj_clean(screen);
+    lv_subject_set_int(subject, 0);
+
+    /* And created again for a new widget */
+    lv_obj_t * item = lui_xml_create(screen, "bs_item", NULL);
+    ok = ok && item && !lv_obj_has_flag(item, LV_OBJ_FLAG_HIDDEN);
+    lv_subject_set_int(subject, 1);
+    ok = ok && item && lv_obj_has_flag(item, LV_OBJ_FLAG_HIDDEN);
+
+    printf("  one notification: %.3f ms\n", notify_time);
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("bs_item");
+    lui_xml_unregister_component("globals");
+
+    printf(ok ? "PASS\n" : "FAIL\n");
+    return ok ? 0 : 1;
+}
+
+/* Test: Unregistering the subject removes the bindings of the living widgets */
+int test_bind_shared_unregister_subject(void)
+{
+    printf("TEST: Unregister a subject bound to widgets... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("bs_item", item_xml);
+    lv_obj_t * screen = test_create_screen();
+    lv_obj_t * item = lui_xml_create(screen, "bs_item", NULL);
+
+    lui_xml_unregister_component("globals");
+
+    /* The widget is deleted after its subject */
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("bs_item");
+
+    if (item) printf("PASS\n");
+    else {
+        printf("FAIL (the widget wasn't created)\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Shared Binding Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_bind_shared_fan_out();
+    failed += test_bind_shared_unregister_subject();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
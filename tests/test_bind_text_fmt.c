@@ -0,0 +1,197 @@
+/**
+ * @file test_bind_text_fmt.c
+ * @brief Compiled bind_text-fmt formats: same output as lv_snprintf, with a benchmark
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_fmt.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_UPDATE_COUNT  1000000
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <subjects>\n"
+    "    <int name=\"tf_speed\" value=\"0\"/>\n"
+    "  </subjects>\n"
+    "</globals>\n";
+
+static const char * gauge_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\">\n"
+    "    <lv_label name=\"value\" bind_text=\"tf_speed\" bind_text-fmt=\"%d km/h\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* Test: The compiled formats write the same text as lv_snprintf */
+int test_fmt_same_as_snprintf(void)
+{
+    printf("TEST: Compiled formats match lv_snprintf... ");
+
+    static const char * int_fmts[] = {"%d", "T: %d C", "%5d|", "%-5d|", "%05d", "%+d", "% d", "%.3d", "%u",
+                                      "%x", "%08X", "100%% %d%%", "no value", "%#x"
+                                     };
+    static const int32_t int_values[] = {0, 1, -1, 42, -42, 123456, INT32_MIN, INT32_MAX};
+    char buf1[64];
+    char buf2[64];
+    bool ok = true;
+
+    uint32_t i, j;
+    for (i = 0; i < sizeof(int_fmts) / sizeof(int_fmts[0]); i++) {
+        const lui_xml_fmt_t * fmt = lui_xml_fmt_get(int_fmts[i]);
+        for (j = 0; j < sizeof(int_values) / sizeof(int_values[0]); j++) {
+            lui_xml_fmt_int(fmt, int_values[j], buf1, sizeof(buf1));
+            lv_snprintf(buf2, sizeof(buf2), int_fmts[i], int_values[j]);
+            if (strcmp(buf1, buf2) != 0) {
+                printf("\n  `%s` with %d: \"%s\" instead of \"%s\"", int_fmts[i], (int)int_values[j], buf1, buf2);
+                ok = false;
+            }
+        }
+    }
+
+    const lui_xml_fmt_t * fmt = lui_xml_fmt_get("[%-6s]");
+    lui_xml_fmt_str(fmt, "abc", buf1, sizeof(buf1));
+    ok = ok && strcmp(buf1, "[abc   ]") == 0;
+
+    /* Truncated like snprintf */
+    fmt = lui_xml_fmt_get("%d km");
+    ok = ok && lui_xml_fmt_int(fmt, 12345, buf1, 4) == 8 && strcmp(buf1, "123") == 0;
+
+    /* Compiled once */
+    ok = ok && lui_xml_fmt_get("%d km") == fmt;
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("\nFAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: A label bound in XML shows the formatted value */
+int test_fmt_bind_label(void)
+{
+    printf("TEST: Bind a label with a compiled format... ");
+
+#if LV_USE_LABEL
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("tf_gauge", gauge_xml);
+    lv_subject_t * subject = lui_xml_get_subject(NULL, "tf_speed");
+    lv_obj_t * screen = test_create_screen();
+    lv_obj_t * gauge1 = lui_xml_create(screen, "tf_gauge", NULL);
+    lv_obj_t * gauge2 = lui_xml_create(screen, "tf_gauge", NULL);
+    lv_obj_t * label1 = gauge1 ? lv_obj_get_child(gauge1, 0) : NULL;
+    lv_obj_t * label2 = gauge2 ? lv_obj_get_child(gauge2, 0) : NULL;
+
+    bool ok = subject && label1 && label2 && strcmp(lv_label_get_text(label1), "0 km/h") == 0;
+    if (ok) lv_subject_set_int(subject, 88);
+    ok = ok && strcmp(lv_label_get_text(label1), "88 km/h") == 0 && strcmp(lv_label_get_text(label2), "88 km/h") == 0;
+
+    /* The binding is removed with the label */
+    if (gauge1) lv_obj_delete(gauge1);
+    if (ok) lv_subject_set_int(subject, 90);
+    ok = ok && strcmp(lv_label_get_text(label2), "90 km/h") == 0;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("tf_gauge");
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (wrong text)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+int test_fmt_bench(void)
+{
+    printf("TEST: Benchmark of %d bound label updates...\n", BENCH_UPDATE_COUNT);
+
+#if LV_USE_LABEL
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("tf_gauge", gauge_xml);
+    lv_subject_t * subject = lui_xml_get_subject(NULL, "tf_speed");
+    lv_obj_t * screen = test_create_screen();
+
+    /* lv_label_bind_text() formats with lv_snprintf on every change */
+    lv_obj_t * label = lv_label_create(screen);
+    lv_label_bind_text(label, subject, "%d km/h");
+    double start = now_ms();
+    int32_t i;
+    for (i = 0; i < BENCH_UPDATE_COUNT; i++) lv_subject_set_int(subject, i);
+    double lv_time = now_ms() - start;
+    lv_obj_delete(label);
+
+    lv_obj_t * gauge = lui_xml_create(screen, "tf_gauge", NULL);
+    start = now_ms();
+    for (i = 0; i < BENCH_UPDATE_COUNT; i++) lv_subject_set_int(subject, i);
+    double compiled_time = now_ms() - start;
+
+    bool ok = gauge && strcmp(lv_label_get_text(lv_obj_get_child(gauge, 0)), "999999 km/h") == 0;
+
+    /* Only the formatting */
+    char buf[32];
+    start = now_ms();
+    for (i = 0; i < BENCH_UPDATE_COUNT; i++) lv_snprintf(buf, sizeof(buf), "%d km/h", i);
+    double snprintf_time = now_ms() - start;
+
+    const lui_xml_fmt_t * fmt = lui_xml_fmt_get("%d km/h");
+    start = now_ms();
+    for (i = 0; i < BENCH_UPDATE_COUNT; i++) lui_xml_fmt_int(fmt, i, buf, sizeof(buf));
+    double fmt_time = now_ms() - start;
+
+    printf("  lv_label_bind_text: %.1f ms, compiled: %.1f ms\n", lv_time, compiled_time);
+    printf("  formatting only: lv_snprintf %.1f ms, compiled %.1f ms\n", snprintf_time, fmt_time);
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("tf_gauge");
+    lui_xml_unregister_component("globals");
+
+    printf(ok ? "PASS\n" : "FAIL\n");
+    if (!ok) return 1;
+#else
+    printf("SKIP (requires LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Compiled Format Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_fmt_same_as_snprintf();
+    failed += test_fmt_bind_label();
+    failed += test_fmt_bench();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file test_codegen_differential.c
+ * @brief Create the same screen from XML files and from the generated C code and compare the results
+ *
+ * `aot_ui.c` and `aot_ui.h` are generated from the files in `aot/` by the
+ * lui_xml_codegen tool when building the tests.
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_component.h"
+
+#include "aot_ui.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ROUNDS    100
+
+static void dump_screen(lv_obj_t * screen, char * buf, size_t buf_size)
+{
+    lv_obj_update_layout(screen);
+    buf[0] = '\0';
+    test_dump_tree(screen, 0, buf, buf_size);
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static lv_obj_t * create_from_xml(void)
+{
+    return lui_xml_create_screen("home");
+}
+
+static lv_obj_t * create_from_code(void)
+{
+    return home_create(NULL);
+}
+
+/* Average time of creating and deleting the screen */
+static double bench(lv_obj_t * (*create_cb)(void))
+{
+    double start = now_us();
+    int i;
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        lv_obj_delete(create_cb());
+    }
+    return (now_us() - start) / BENCH_ROUNDS;
+}
+
+/* Test: The generated code creates the same object tree as the XML files */
+int test_codegen_matches_xml(void)
+{
+    printf("TEST: Generated code vs. XML object tree... ");
+
+#if LV_USE_FS_STDIO
+    static char xml_dump[4096];
+    static char code_dump[4096];
+
+    char path[256];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, AOT_XML_DIR);
+
+    if (lui_xml_load_all_from_path(path) != LV_RESULT_OK) {
+        printf("FAIL (couldn't load the XML files)\n");
+        return 1;
+    }
+
+    lv_obj_t * screen = create_from_xml();
+    if (screen == NULL) {
+        printf("FAIL (couldn't create the screen from XML)\n");
+        return 1;
+    }
+    dump_screen(screen, xml_dump, sizeof(xml_dump));
+    lv_obj_delete(screen);
+
+    screen = create_from_code();
+    dump_screen(screen, code_dump, sizeof(code_dump));
+    lv_obj_delete(screen);
+
+    if (strcmp(xml_dump, code_dump) != 0) {
+        printf("FAIL (different trees)\nXML:\n%sCode:\n%s", xml_dump, code_dump);
+        return 1;
+    }
+
+    double xml_us = bench(create_from_xml);
+    double code_us = bench(create_from_code);
+    printf("PASS (XML: %.1f us, code: %.1f us per screen)\n", xml_us, code_us);
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: The properties of the generated components fall back to their defaults */
+int test_codegen_params(void)
+{
+    printf("TEST: Generated component properties... ");
+
+    card_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.title = "Custom";
+
+    lv_obj_t * card = card_create(lv_screen_active(), &params);
+    lv_obj_t * title = lv_obj_get_child(card, 0);
+    bool ok = strcmp(lv_label_get_text(title), "Custom") == 0 && lv_obj_get_style_height(card, LV_PART_MAIN) == 60;
+    lv_obj_delete(card);
+
+    card = card_create(lv_screen_active(), NULL);
+    title = lv_obj_get_child(card, 0);
+    ok = ok && strcmp(lv_label_get_text(title), "Untitled") == 0;
+    lv_obj_delete(card);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the properties were not applied)\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Code Generator Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    aot_ui_init();
+
+    failed += test_codegen_matches_xml();
+    failed += test_codegen_params();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
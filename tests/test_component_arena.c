@@ -0,0 +1,115 @@
+/**
+ * @file test_component_arena.c
+ * @brief Component arenas: the metadata of a component is released at once on unregistration
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define CYCLE_COUNT     10
+
+static const char * card_xml =
+    "<component>\n"
+    "  <consts>\n"
+    "    <px name=\"ca_size\" value=\"100\"/>\n"
+    "    <string name=\"ca_title\" value=\"A long enough title to need some room\"/>\n"
+    "  </consts>\n"
+    "  <api>\n"
+    "    <prop name=\"ca_text\" type=\"string\" default=\"Hello\"/>\n"
+    "  </api>\n"
+    "  <styles>\n"
+    "    <style name=\"ca_style\" bg_color=\"0xff0000\" radius=\"8\"/>\n"
+    "  </styles>\n"
+    "  <subjects>\n"
+    "    <int name=\"ca_value\" value=\"3\"/>\n"
+    "    <string name=\"ca_name\" value=\"card\"/>\n"
+    "  </subjects>\n"
+    "  <view extends=\"lv_obj\" width=\"#ca_size\" styles=\"ca_style\"/>\n"
+    "</component>\n";
+
+/* Test: The metadata of a component is stored in its arena */
+int test_arena_stats(void)
+{
+    printf("TEST: Arena stats of a registered component... ");
+
+    lui_xml_register_component_from_data("ca_card", card_xml);
+
+    lui_xml_arena_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    lv_result_t res = lui_xml_component_get_arena_stats("ca_card", &stats);
+    bool ok = res == LV_RESULT_OK && stats.alloc_cnt > 0 && stats.used_size > 0 &&
+              stats.total_size >= stats.used_size && stats.chunk_cnt > 0;
+
+    lui_xml_unregister_component("ca_card");
+    ok = ok && lui_xml_component_get_arena_stats("ca_card", &stats) == LV_RESULT_INVALID;
+
+    if (ok) printf("PASS (%u allocations, %u of %u bytes used)\n", (unsigned)stats.alloc_cnt,
+                       (unsigned)stats.used_size, (unsigned)stats.total_size);
+    else {
+        printf("FAIL (no arena stats)\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: Registering and unregistering a component doesn't leave anything on the heap */
+int test_arena_released(void)
+{
+    printf("TEST: Release the arena on unregistration... ");
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    /* The first registration can allocate tables which are kept */
+    lui_xml_register_component_from_data("ca_card", card_xml);
+    lui_xml_unregister_component("ca_card");
+
+    lv_mem_monitor_t mon_before;
+    lv_mem_monitor(&mon_before);
+
+    uint32_t i;
+    for (i = 0; i < CYCLE_COUNT; i++) {
+        lui_xml_register_component_from_data("ca_card", card_xml);
+        lui_xml_unregister_component("ca_card");
+    }
+
+    lv_mem_monitor_t mon_after;
+    lv_mem_monitor(&mon_after);
+
+    if (mon_after.used_cnt <= mon_before.used_cnt) printf("PASS\n");
+    else {
+        printf("FAIL (%u bytes leaked in %d cycles)\n", (unsigned)(mon_after.used_cnt - mon_before.used_cnt),
+               CYCLE_COUNT);
+        return 1;
+    }
+#else
+    printf("SKIP (requires the builtin allocator)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Component Arena Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_arena_stats();
+    failed += test_arena_released();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
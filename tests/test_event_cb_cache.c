@@ -0,0 +1,266 @@
+/**
+ * @file test_event_cb_cache.c
+ * @brief Event callback cache: the `<event_cb>` callbacks of a component are looked up by name only once
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_event.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_CB_COUNT          500
+#define BENCH_INSTANCE_COUNT    2000
+#define USER_DATA_ITEM_COUNT    200
+
+static const char * row_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\">\n"
+    "    <event_cb callback=\"ec_click\" trigger=\"clicked\" user_data=\"row\"/>\n"
+    "    <event_cb callback=\"ec_press\" trigger=\"pressed\"/>\n"
+    "    <event_cb callback=\"ec_release\" trigger=\"released\" user_data=\"row\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static const char * item_xml =
+    "<component>\n"
+    "  <api>\n"
+    "    <prop name=\"ec_id\" type=\"string\" default=\"none\"/>\n"
+    "  </api>\n"
+    "  <view extends=\"lv_obj\">\n"
+    "    <event_cb callback=\"ec_click\" trigger=\"clicked\" user_data=\"$ec_id\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static uint32_t first_cnt;
+static uint32_t second_cnt;
+static const char * last_user_data;
+
+static void first_cb(lv_event_t * e)
+{
+    first_cnt++;
+    last_user_data = lv_event_get_user_data(e);
+}
+
+static void second_cb(lv_event_t * e)
+{
+    second_cnt++;
+    last_user_data = lv_event_get_user_data(e);
+}
+
+static void register_cbs(lv_event_cb_t cb)
+{
+    lui_xml_register_event_cb(NULL, "ec_click", cb);
+    lui_xml_register_event_cb(NULL, "ec_press", cb);
+    lui_xml_register_event_cb(NULL, "ec_release", cb);
+}
+
+/* Create items with a different user_data each, starting from `first_id` */
+static bool create_items(lv_obj_t * screen, uint32_t first_id)
+{
+    char id[32];
+    uint32_t i;
+    for (i = 0; i < USER_DATA_ITEM_COUNT; i++) {
+        snprintf(id, sizeof(id), "id_%u", (unsigned)(first_id + i));
+        const char * attrs[] = {"ec_id", id, NULL, NULL};
+        lv_obj_t * item = lui_xml_create(screen, "ec_item", attrs);
+        if (item == NULL) return false;
+
+        last_user_data = NULL;
+        lv_obj_send_event(item, LV_EVENT_CLICKED, NULL);
+        if (last_user_data == NULL || strcmp(last_user_data, id) != 0) return false;
+    }
+    return true;
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* Test: All the instances get the callbacks and the user data */
+int test_cache_instances(void)
+{
+    printf("TEST: Add the callbacks of the instances... ");
+
+    register_cbs(first_cb);
+    lui_xml_register_component_from_data("ec_row", row_xml);
+    lv_obj_t * screen = test_create_screen();
+
+    lv_obj_t * row1 = lui_xml_create(screen, "ec_row", NULL);
+    lv_obj_t * row2 = lui_xml_create(screen, "ec_row", NULL);
+    bool ok = row1 && row2;
+
+    first_cnt = 0;
+    if (ok) lv_obj_send_event(row1, LV_EVENT_CLICKED, NULL);
+    const char * user_data1 = last_user_data;
+    if (ok) lv_obj_send_event(row2, LV_EVENT_CLICKED, NULL);
+    const char * user_data2 = last_user_data;
+    ok = ok && first_cnt == 2 && user_data1 && user_data2 && strcmp(user_data1, "row") == 0 &&
+         strcmp(user_data2, "row") == 0;
+
+    if (ok) lv_obj_send_event(row1, LV_EVENT_PRESSED, NULL);
+    ok = ok && first_cnt == 3 && last_user_data == NULL;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("ec_row");
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (callback called %u times)\n", (unsigned)first_cnt);
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: Registering a callback again is ignored, a new one hides the global one */
+int test_cache_reregister(void)
+{
+    printf("TEST: Register a cached callback again... ");
+
+    register_cbs(first_cb);
+    lui_xml_register_component_from_data("ec_row", row_xml);
+    lv_obj_t * screen = test_create_screen();
+
+    lv_obj_t * row1 = lui_xml_create(screen, "ec_row", NULL);
+    register_cbs(second_cb);
+    lv_obj_t * row2 = lui_xml_create(screen, "ec_row", NULL);
+
+    first_cnt = 0;
+    second_cnt = 0;
+    if (row1 && row2) {
+        lv_obj_send_event(row1, LV_EVENT_CLICKED, NULL);
+        lv_obj_send_event(row2, LV_EVENT_CLICKED, NULL);
+    }
+    bool ok = first_cnt == 2 && second_cnt == 0;
+
+    /* A callback of the component hides the global one */
+    lui_xml_register_event_cb(lui_xml_component_get_scope("ec_row"), "ec_click", second_cb);
+    lv_obj_t * row3 = lui_xml_create(screen, "ec_row", NULL);
+    if (row3) lv_obj_send_event(row3, LV_EVENT_CLICKED, NULL);
+    ok = ok && first_cnt == 2 && second_cnt == 1;
+
+    /* The global callbacks are removed with the globals */
+    lui_xml_unregister_component("globals");
+    first_cnt = 0;
+    lv_obj_t * row4 = lui_xml_create(screen, "ec_row", NULL);
+    if (row4) lv_obj_send_event(row4, LV_EVENT_PRESSED, NULL);
+    ok = ok && first_cnt == 0;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("ec_row");
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (called %u and %u times)\n", (unsigned)first_cnt, (unsigned)second_cnt);
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: The user_data strings of the instances are freed with the instances */
+int test_cache_user_data_freed(void)
+{
+    printf("TEST: Free the user_data of deleted instances... ");
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    register_cbs(first_cb);
+    lui_xml_register_component_from_data("ec_item", item_xml);
+    lv_obj_t * screen = test_create_screen();
+
+    /* The first round can grow tables which are kept */
+    bool ok = create_items(screen, 0);
+    lv_obj_clean(screen);
+
+    lv_mem_monitor_t mon_before;
+    lv_mem_monitor(&mon_before);
+
+    ok = ok && create_items(screen, USER_DATA_ITEM_COUNT);
+    lv_obj_clean(screen);
+
+    lv_mem_monitor_t mon_after;
+    lv_mem_monitor(&mon_after);
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("ec_item");
+    lui_xml_unregister_component("globals");
+
+    if (!ok) {
+        printf("FAIL (wrong user_data)\n");
+        return 1;
+    }
+    if (mon_after.used_cnt > mon_before.used_cnt) {
+        printf("FAIL (%u bytes leaked)\n", (unsigned)(mon_after.used_cnt - mon_before.used_cnt));
+        return 1;
+    }
+    printf("PASS\n");
+#else
+    printf("SKIP (requires the builtin allocator)\n");
+#endif
+    return 0;
+}
+
+int test_cache_bench(void)
+{
+    printf("TEST: Benchmark of %d instances with %d global callbacks...\n", BENCH_INSTANCE_COUNT,
+           BENCH_CB_COUNT);
+
+    register_cbs(first_cb);
+    lui_xml_register_component_from_data("ec_row", row_xml);
+
+    /* The callbacks registered later are searched first */
+    char name[32];
+    uint32_t i;
+    for (i = 0; i < BENCH_CB_COUNT; i++) {
+        snprintf(name, sizeof(name), "ec_other_%u", (unsigned)i);
+        lui_xml_register_event_cb(NULL, name, second_cb);
+    }
+
+    lv_obj_t * screen = test_create_screen();
+    double start = now_ms();
+    for (i = 0; i < BENCH_INSTANCE_COUNT; i++) lui_xml_create(screen, "ec_row", NULL);
+    double create_time = now_ms() - start;
+
+    bool ok = lv_obj_get_child_count(screen) == BENCH_INSTANCE_COUNT;
+    printf("  create: %.1f ms\n", create_time);
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("ec_row");
+    lui_xml_unregister_component("globals");
+
+    printf(ok ? "PASS\n" : "FAIL\n");
+    return ok ? 0 : 1;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Event Callback Cache Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_cache_instances();
+    failed += test_cache_reregister();
+    failed += test_cache_user_data_freed();
+    failed += test_cache_bench();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
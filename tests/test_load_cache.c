@@ -0,0 +1,266 @@
+/**
+ * @file test_load_cache.c
+ * @brief Cache directory: the compiled form of the files is reused instead of parsing them again
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_cache.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define CACHE_XML_DIR   "/tmp/lui_xml_cache_test_xml"
+#define CACHE_DIR       "/tmp/lui_xml_cache_test_cache"
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <consts>\n"
+    "    <px name=\"card_width\" value=\"180\"/>\n"
+    "  </consts>\n"
+    "</globals>\n";
+
+static const char * card_xml =
+    "<component>\n"
+    "  <api>\n"
+    "    <prop name=\"title\" type=\"string\" default=\"Untitled\"/>\n"
+    "  </api>\n"
+    "  <view extends=\"lv_obj\" width=\"#card_width\" height=\"60\">\n"
+    "    <lv_label text=\"$title\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static const char * home_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <card title=\"Cached\"/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+/* Offset of the pack's size in the header of a cache file */
+#define CACHE_PACK_SIZE_OFFSET  24
+
+/* Call a function with the path of every cache file */
+static void for_each_cache_file(void (*cb)(const char * path))
+{
+    DIR * dir = opendir(CACHE_DIR);
+    if (dir == NULL) return;
+
+    struct dirent * entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", CACHE_DIR, entry->d_name);
+        cb(path);
+    }
+
+    closedir(dir);
+}
+
+/* Overwrite a byte in the middle of a cache file */
+static void corrupt_cache_file(const char * path)
+{
+    FILE * f = fopen(path, "r+b");
+    if (f == NULL) return;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, size / 2, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, size / 2, SEEK_SET);
+    fputc(c ^ 0xFF, f);
+    fclose(f);
+}
+
+/* Cut the end of a cache file as if writing it was interrupted */
+static void truncate_cache_file(const char * path)
+{
+    struct stat st;
+    if (stat(path, &st) != 0) return;
+    if (truncate(path, st.st_size - 8) != 0) fprintf(stderr, "Couldn't truncate %s\n", path);
+}
+
+/* Store a garbage pack size in the header of a cache file */
+static void break_cache_pack_size(const char * path)
+{
+    FILE * f = fopen(path, "r+b");
+    if (f == NULL) return;
+    uint32_t pack_size = 0xFFFFFFF0;
+    fseek(f, CACHE_PACK_SIZE_OFFSET, SEEK_SET);
+    fwrite(&pack_size, sizeof(pack_size), 1, f);
+    fclose(f);
+}
+
+static void remove_test_dirs(void)
+{
+    test_remove_dir(CACHE_XML_DIR);
+    test_remove_dir(CACHE_DIR);
+}
+
+static bool load_and_check(const char * path)
+{
+    lui_xml_unregister_component("home");
+    lui_xml_unregister_component("card");
+    if (lui_xml_load_all_from_path(path) != LV_RESULT_OK) return false;
+
+    lv_obj_t * screen = lui_xml_create_screen("home");
+    if (screen == NULL) return false;
+
+    lv_obj_update_layout(screen);
+    lv_obj_t * card = lv_obj_get_child(screen, 0);
+    lv_obj_t * label = card ? lv_obj_get_child(card, 0) : NULL;
+    bool ok = card && lv_obj_get_width(card) == 180 && label &&
+              strcmp(lv_label_get_text(label), "Cached") == 0;
+    lv_obj_delete(screen);
+    return ok;
+}
+
+/* Test: The files are added to the cache on the first load and registered from it later */
+int test_cache_hit_and_miss(void)
+{
+    printf("TEST: Cache misses, hits and corrupted files... ");
+
+#if LV_USE_FS_STDIO
+    remove_test_dirs();
+    const char * files[] = {"globals.xml", globals_xml, "card.xml", card_xml, "home.xml", home_xml, NULL};
+    mkdir(CACHE_DIR, 0755);
+    if (test_create_dir(CACHE_XML_DIR, files) != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        remove_test_dirs();
+        return 1;
+    }
+
+    char xml_path[64];
+    char cache_path[64];
+    snprintf(xml_path, sizeof(xml_path), "%c:%s", LV_FS_STDIO_LETTER, CACHE_XML_DIR);
+    snprintf(cache_path, sizeof(cache_path), "%c:%s", LV_FS_STDIO_LETTER, CACHE_DIR);
+
+    lui_xml_cache_set_path(cache_path);
+    lui_xml_cache_reset_stats();
+
+    lui_xml_cache_stats_t stats;
+    bool ok = load_and_check(xml_path);
+    lui_xml_cache_get_stats(&stats);
+    if (!ok || stats.miss_cnt != 3 || stats.hit_cnt != 0 || stats.write_err_cnt != 0) {
+        printf("FAIL (first load: %u misses, %u hits)\n", (unsigned)stats.miss_cnt, (unsigned)stats.hit_cnt);
+        lui_xml_cache_set_path(NULL);
+        remove_test_dirs();
+        return 1;
+    }
+
+    ok = load_and_check(xml_path);
+    lui_xml_cache_get_stats(&stats);
+    if (!ok || stats.miss_cnt != 3 || stats.hit_cnt != 3) {
+        printf("FAIL (second load: %u misses, %u hits)\n", (unsigned)stats.miss_cnt, (unsigned)stats.hit_cnt);
+        lui_xml_cache_set_path(NULL);
+        remove_test_dirs();
+        return 1;
+    }
+
+    /* The corrupted files are ignored and written again */
+    for_each_cache_file(corrupt_cache_file);
+    ok = load_and_check(xml_path);
+    lui_xml_cache_get_stats(&stats);
+    lui_xml_cache_set_path(NULL);
+    lui_xml_unregister_component("home");
+    lui_xml_unregister_component("card");
+    remove_test_dirs();
+
+    if (ok && stats.invalid_cnt == 3 && stats.miss_cnt == 6) printf("PASS\n");
+    else {
+        printf("FAIL (corrupted files: %u invalid, %u misses)\n", (unsigned)stats.invalid_cnt,
+               (unsigned)stats.miss_cnt);
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: Truncated files and files with a garbage size are ignored before reading the pack */
+int test_cache_truncated_and_garbage(void)
+{
+    printf("TEST: Truncated cache files and garbage sizes... ");
+
+#if LV_USE_FS_STDIO
+    remove_test_dirs();
+    const char * files[] = {"globals.xml", globals_xml, "card.xml", card_xml, "home.xml", home_xml, NULL};
+    mkdir(CACHE_DIR, 0755);
+    if (test_create_dir(CACHE_XML_DIR, files) != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        remove_test_dirs();
+        return 1;
+    }
+
+    char xml_path[64];
+    char cache_path[64];
+    snprintf(xml_path, sizeof(xml_path), "%c:%s", LV_FS_STDIO_LETTER, CACHE_XML_DIR);
+    snprintf(cache_path, sizeof(cache_path), "%c:%s", LV_FS_STDIO_LETTER, CACHE_DIR);
+
+    lui_xml_cache_set_path(cache_path);
+    lui_xml_cache_reset_stats();
+
+    /* Write the cache files, then truncate them */
+    lui_xml_cache_stats_t stats;
+    bool ok = load_and_check(xml_path);
+    for_each_cache_file(truncate_cache_file);
+    ok = ok && load_and_check(xml_path);
+    lui_xml_cache_get_stats(&stats);
+    if (!ok || stats.invalid_cnt != 3 || stats.hit_cnt != 0 || stats.miss_cnt != 6) {
+        printf("FAIL (truncated files: %u invalid, %u hits)\n", (unsigned)stats.invalid_cnt,
+               (unsigned)stats.hit_cnt);
+        lui_xml_cache_set_path(NULL);
+        remove_test_dirs();
+        return 1;
+    }
+
+    /* The files were written again, now with a huge size in the header */
+    for_each_cache_file(break_cache_pack_size);
+    ok = load_and_check(xml_path);
+    lui_xml_cache_get_stats(&stats);
+    lui_xml_cache_set_path(NULL);
+    lui_xml_unregister_component("home");
+    lui_xml_unregister_component("card");
+    remove_test_dirs();
+
+    if (ok && stats.invalid_cnt == 6 && stats.hit_cnt == 0 && stats.miss_cnt == 9) printf("PASS\n");
+    else {
+        printf("FAIL (garbage sizes: %u invalid, %u hits)\n", (unsigned)stats.invalid_cnt,
+               (unsigned)stats.hit_cnt);
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Cache Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_cache_hit_and_miss();
+    failed += test_cache_truncated_and_garbage();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
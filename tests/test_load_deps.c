@@ -0,0 +1,155 @@
+/**
+ * @file test_load_deps.c
+ * @brief Dependency order: components are registered after the components they use
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define DEPS_DIR    "/tmp/lui_xml_deps_test"
+
+/* The paths are in the reverse order of the dependencies */
+static const char * a_home_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <b_card/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static const char * b_card_xml =
+    "<component>\n"
+    "  <view extends=\"c_base\" width=\"150\">\n"
+    "    <lv_obj styles=\"c_base.frame\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static const char * c_base_xml =
+    "<component>\n"
+    "  <styles>\n"
+    "    <style name=\"frame\" border_width=\"2\"/>\n"
+    "  </styles>\n"
+    "  <view extends=\"lv_obj\" height=\"40\"/>\n"
+    "</component>\n";
+
+static const char * c_base_cycle_xml =
+    "<component>\n"
+    "  <view extends=\"a_home\"/>\n"
+    "</component>\n";
+
+static void unregister_all(void)
+{
+    lui_xml_unregister_component("a_home");
+    lui_xml_unregister_component("b_card");
+    lui_xml_unregister_component("c_base");
+}
+
+/* Test: The components are registered in dependency order and work the same */
+int test_deps_order(void)
+{
+    printf("TEST: Registration in dependency order... ");
+
+#if LV_USE_FS_STDIO
+    const char * files[] = {"a_home.xml", a_home_xml, "b_card.xml", b_card_xml, "c_base.xml", c_base_xml, NULL};
+    if (test_create_dir(DEPS_DIR, files) != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(DEPS_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, DEPS_DIR);
+
+    lui_xml_load_set_dep_order(true);
+    lv_result_t res = lui_xml_load_all_from_path(path);
+    lui_xml_load_set_dep_order(false);
+
+    lv_obj_t * screen = res == LV_RESULT_OK ? lui_xml_create_screen("a_home") : NULL;
+    if (screen == NULL) {
+        printf("FAIL (couldn't load the directory)\n");
+        unregister_all();
+        test_remove_dir(DEPS_DIR);
+        return 1;
+    }
+
+    lv_obj_update_layout(screen);
+    lv_obj_t * card = lv_obj_get_child(screen, 0);
+    lv_obj_t * framed = card ? lv_obj_get_child(card, 0) : NULL;
+    bool ok = card && lv_obj_get_width(card) == 150 && lv_obj_get_height(card) == 40 &&
+              framed && lv_obj_get_style_border_width(framed, LV_PART_MAIN) == 2;
+    lv_obj_delete(screen);
+    unregister_all();
+    test_remove_dir(DEPS_DIR);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the components were created wrong)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: A dependency cycle is reported */
+int test_deps_cycle(void)
+{
+    printf("TEST: Dependency cycle detection... ");
+
+#if LV_USE_FS_STDIO
+    const char * files[] = {"a_home.xml", a_home_xml, "b_card.xml", b_card_xml,
+                            "c_base.xml", c_base_cycle_xml, NULL};
+    if (test_create_dir(DEPS_DIR, files) != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(DEPS_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, DEPS_DIR);
+
+    lui_xml_load_set_dep_order(true);
+    lv_result_t res = lui_xml_load_all_from_path(path);
+    lui_xml_load_set_dep_order(false);
+    unregister_all();
+    test_remove_dir(DEPS_DIR);
+
+    if (res == LV_RESULT_INVALID) printf("PASS\n");
+    else {
+        printf("FAIL (the cycle was not reported)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Dependency Order Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_deps_order();
+    failed += test_deps_cycle();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file test_load_lazy.c
+ * @brief Lazy loading: components are indexed when loading and registered on first use
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_component.h"
+#include "lui_xml_memory.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define LAZY_DIR    "/tmp/lui_xml_lazy_test"
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <consts>\n"
+    "    <px name=\"card_width\" value=\"180\"/>\n"
+    "  </consts>\n"
+    "</globals>\n";
+
+static const char * card_xml =
+    "<component>\n"
+    "  <api>\n"
+    "    <prop name=\"title\" type=\"string\" default=\"Untitled\"/>\n"
+    "  </api>\n"
+    "  <view extends=\"lv_obj\" width=\"#card_width\" height=\"60\">\n"
+    "    <lv_label text=\"$title\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static const char * big_card_xml =
+    "<!-- Extends a component which is indexed too -->\n"
+    "<component>\n"
+    "  <view extends=\"card\" height=\"120\"/>\n"
+    "</component>\n";
+
+static const char * home_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <big_card title=\"First\"/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static const char * settings_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <lv_label text=\"Settings\"/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static const char * about_xml =
+    "<screen>\n"
+    "  <view/>\n"
+    "</screen>\n";
+
+static int create_test_dir(void)
+{
+    const char * files[] = {"globals.xml", globals_xml, "card.xml", card_xml, "big_card.xml", big_card_xml,
+                            "home.xml", home_xml, "settings.xml", settings_xml, "about.xml", about_xml, NULL};
+    return test_create_dir(LAZY_DIR, files);
+}
+
+static void unregister_components(void)
+{
+    const char * names[] = {"card", "big_card", "home", "settings", "about"};
+    size_t i;
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        lui_xml_unregister_component(names[i]);
+    }
+}
+
+/* Test: Only the components used by a screen are registered when it's created */
+int test_lazy_register_on_use(void)
+{
+    printf("TEST: Lazy registration on first use... ");
+
+#if LV_USE_FS_STDIO
+    if (create_test_dir() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(LAZY_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, LAZY_DIR);
+
+    lui_xml_load_set_lazy(true);
+    lv_result_t res = lui_xml_load_all_from_path(path);
+    lui_xml_load_set_lazy(false);
+
+    if (res != LV_RESULT_OK || lui_xml_load_get_indexed_count() != 5) {
+        printf("FAIL (%u components indexed instead of 5)\n", (unsigned)lui_xml_load_get_indexed_count());
+        test_remove_dir(LAZY_DIR);
+        return 1;
+    }
+
+    /* The files are read only now */
+    lv_obj_t * screen = lui_xml_create_screen("home");
+    test_remove_dir(LAZY_DIR);
+    if (screen == NULL) {
+        printf("FAIL (couldn't create the screen)\n");
+        return 1;
+    }
+
+    lv_obj_update_layout(screen);
+    lv_obj_t * card = lv_obj_get_child(screen, 0);
+    bool ok = card && lv_obj_get_width(card) == 180 && lv_obj_get_style_height(card, LV_PART_MAIN) == 120;
+    lv_obj_delete(screen);
+    if (!ok) {
+        printf("FAIL (the component was created wrong)\n");
+        return 1;
+    }
+
+    /* home, big_card and card are registered, about and settings are still indexed */
+    if (lui_xml_load_get_indexed_count() != 2) {
+        printf("FAIL (%u components still indexed instead of 2)\n", (unsigned)lui_xml_load_get_indexed_count());
+        return 1;
+    }
+
+    lui_xml_unregister_component("home");
+    lui_xml_unregister_component("big_card");
+    lui_xml_unregister_component("card");
+    lui_xml_unregister_component("about");
+    if (lui_xml_load_get_indexed_count() != 1) {
+        printf("FAIL (unregistering didn't remove the indexed component)\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: Indexed components can be registered in advance */
+int test_lazy_register_eagerly(void)
+{
+    printf("TEST: Eager registration of indexed components... ");
+
+#if LV_USE_FS_STDIO
+    if (create_test_dir() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(LAZY_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, LAZY_DIR);
+
+    lui_xml_load_set_lazy(true);
+    lui_xml_load_all_from_path(path);
+    lui_xml_load_set_lazy(false);
+
+    bool ok = lui_xml_load_component("settings") == LV_RESULT_OK &&
+              lui_xml_load_get_indexed_count() == 4 &&
+              lui_xml_load_component("no_such_component") == LV_RESULT_INVALID &&
+              lui_xml_load_component(NULL) == LV_RESULT_OK &&
+              lui_xml_load_get_indexed_count() == 0;
+    unregister_components();
+    test_remove_dir(LAZY_DIR);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the components were not registered)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: Querying the memory of an indexed component doesn't register it */
+int test_lazy_memory_stats(void)
+{
+    printf("TEST: Memory stats of indexed components... ");
+
+#if LV_USE_FS_STDIO
+    if (create_test_dir() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(LAZY_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, LAZY_DIR);
+
+    lui_xml_load_set_lazy(true);
+    lui_xml_load_all_from_path(path);
+    lui_xml_load_set_lazy(false);
+
+    lui_xml_memory_stats_t stats;
+    bool ok = lui_xml_get_memory_stats("card", &stats) == LV_RESULT_INVALID &&
+              lui_xml_load_get_indexed_count() == 5;
+
+    /* Once it's registered the stats are available */
+    ok = ok && lui_xml_load_component("card") == LV_RESULT_OK &&
+         lui_xml_get_memory_stats("card", &stats) == LV_RESULT_OK &&
+         stats.metadata_size > 0;
+
+    lui_xml_load_component(NULL);
+    unregister_components();
+    test_remove_dir(LAZY_DIR);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the indexed component was registered)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Lazy Loading Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_lazy_register_on_use();
+    failed += test_lazy_register_eagerly();
+    failed += test_lazy_memory_stats();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test_load_lazy_fonts.c
+ * @brief Lazy fonts: only the paths of the fonts are stored while registering, they are created on first use
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* The files don't exist, so creating the fonts fails, but that is visible only when they are created */
+static const char * fonts_xml =
+    "<component>\n"
+    "  <fonts>\n"
+    "    <bin as_file=\"true\" name=\"font_a\" src_path=\"missing_a.bin\"/>\n"
+    "    <bin as_file=\"true\" name=\"font_b\" src_path=\"missing_b.bin\"/>\n"
+    "    <bin as_file=\"true\" name=\"font_c\" src_path=\"missing_c.bin\"/>\n"
+    "  </fonts>\n"
+    "  <view extends=\"lv_obj\"/>\n"
+    "</component>\n";
+
+/* Test: The fonts are not created while registering */
+int test_lazy_fonts_deferred(void)
+{
+    printf("TEST: Fonts are created on first use... ");
+
+    lui_xml_load_set_lazy_fonts(true);
+    lv_result_t res = lui_xml_register_component_from_data("lazy_fonts", fonts_xml);
+    lui_xml_load_set_lazy_fonts(false);
+
+    lui_xml_component_scope_t * scope = lui_xml_component_get_scope("lazy_fonts");
+    if (res != LV_RESULT_OK || scope == NULL) {
+        printf("FAIL (couldn't register the component)\n");
+        lui_xml_unregister_component("lazy_fonts");
+        return 1;
+    }
+
+    /* Using a font creates only that one */
+    const lv_font_t * font = lui_xml_get_font(scope, "font_b");
+
+    /* One more is created, so one of the three is still pending */
+    uint32_t pending_cnt1 = lui_xml_load_pending_fonts(1);
+    uint32_t pending_cnt2 = lui_xml_load_pending_fonts(0);
+    lui_xml_unregister_component("lazy_fonts");
+
+    if (font == lv_font_get_default() && pending_cnt1 == 1 && pending_cnt2 == 0) printf("PASS\n");
+    else {
+        printf("FAIL (%u and %u fonts pending)\n", (unsigned)pending_cnt1, (unsigned)pending_cnt2);
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: Without lazy fonts they are created while registering */
+int test_lazy_fonts_disabled(void)
+{
+    printf("TEST: Fonts are created while registering by default... ");
+
+    lv_result_t res = lui_xml_register_component_from_data("eager_fonts", fonts_xml);
+    uint32_t pending_cnt = lui_xml_load_pending_fonts(0);
+    lui_xml_unregister_component("eager_fonts");
+
+    if (res == LV_RESULT_OK && pending_cnt == 0) printf("PASS\n");
+    else {
+        printf("FAIL (%u fonts pending)\n", (unsigned)pending_cnt);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Lazy Font Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_lazy_fonts_deferred();
+    failed += test_lazy_fonts_disabled();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file test_load_parallel_bench.c
+ * @brief Benchmark of loading a directory on multiple threads
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML parser headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#define BENCH_DIR           "/tmp/lui_xml_bench"
+#define BENCH_DIR_COUNT     10
+#define BENCH_FILE_COUNT    1000
+
+/* Write a component with some API, styles and a view to tokenize */
+static int create_component_file(const char * path, int id)
+{
+    FILE * f = fopen(path, "w");
+    if (f == NULL) return -1;
+
+    fprintf(f, "<component>\n");
+    fprintf(f, "  <api>\n");
+    fprintf(f, "    <prop name=\"title\" type=\"string\" default=\"Card %d\"/>\n", id);
+    fprintf(f, "    <prop name=\"value\" type=\"int\" default=\"%d\"/>\n", id);
+    fprintf(f, "  </api>\n");
+    fprintf(f, "  <styles>\n");
+    for (int i = 0; i < 4; i++) {
+        fprintf(f, "    <style name=\"style_%d\" bg_color=\"0x%06x\" radius=\"%d\" pad_all=\"%d\"/>\n",
+                i, (id * 97 + i) & 0xffffff, i * 2, i + 4);
+    }
+    fprintf(f, "  </styles>\n");
+    fprintf(f, "  <view extends=\"lv_obj\" width=\"200\" height=\"content\" flex_flow=\"column\">\n");
+    fprintf(f, "    <style name=\"style_0\"/>\n");
+    for (int i = 0; i < 8; i++) {
+        fprintf(f, "    <lv_label text=\"$title\" width=\"100%%\"><style name=\"style_%d\"/></lv_label>\n", i % 4);
+    }
+    fprintf(f, "  </view>\n");
+    fprintf(f, "</component>\n");
+
+    fclose(f);
+    return 0;
+}
+
+static int create_bench_pack(void)
+{
+    char path[128];
+
+    mkdir(BENCH_DIR, 0755);
+
+    snprintf(path, sizeof(path), "%s/globals.xml", BENCH_DIR);
+    FILE * f = fopen(path, "w");
+    if (f == NULL) return -1;
+    fprintf(f, "<globals>\n  <consts>\n    <int name=\"card_width\" value=\"200\"/>\n  </consts>\n</globals>\n");
+    fclose(f);
+
+    for (int d = 0; d < BENCH_DIR_COUNT; d++) {
+        snprintf(path, sizeof(path), "%s/dir_%d", BENCH_DIR, d);
+        mkdir(path, 0755);
+    }
+
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        snprintf(path, sizeof(path), "%s/dir_%d/card_%d.xml", BENCH_DIR, i % BENCH_DIR_COUNT, i);
+        if (create_component_file(path, i) != 0) return -1;
+    }
+
+    return 0;
+}
+
+static void remove_bench_pack(void)
+{
+    char path[128];
+
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        snprintf(path, sizeof(path), "%s/dir_%d/card_%d.xml", BENCH_DIR, i % BENCH_DIR_COUNT, i);
+        remove(path);
+    }
+
+    for (int d = 0; d < BENCH_DIR_COUNT; d++) {
+        snprintf(path, sizeof(path), "%s/dir_%d", BENCH_DIR, d);
+        remove(path);
+    }
+
+    snprintf(path, sizeof(path), "%s/globals.xml", BENCH_DIR);
+    remove(path);
+    remove(BENCH_DIR);
+}
+
+/* Check that a card is created from the parallel loaded data as it's written */
+static bool card_is_valid(int id)
+{
+    char name[32];
+    char title[32];
+    snprintf(name, sizeof(name), "card_%d", id);
+    snprintf(title, sizeof(title), "Card %d", id);
+
+    lv_obj_t * card = lui_xml_create(lv_screen_active(), name, NULL);
+    if (card == NULL) return false;
+
+    bool ok = lv_obj_get_style_width(card, LV_PART_MAIN) == 200 && lv_obj_get_child_count(card) == 8;
+    lv_obj_t * label = lv_obj_get_child(card, 0);
+    if (ok) ok = label && strcmp(lv_label_get_text(label), title) == 0;
+    lv_obj_delete(card);
+
+    return ok;
+}
+
+/* Unregister the cards and return how many were registered */
+static int unregister_cards(void)
+{
+    char name[32];
+    int cnt = 0;
+
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        snprintf(name, sizeof(name), "card_%d", i);
+        if (lui_xml_unregister_component(name) == LV_RESULT_OK) cnt++;
+    }
+
+    return cnt;
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* Test: Load 1000 files with 1 to 8 threads */
+int test_load_parallel_scaling(void)
+{
+    printf("TEST: Parallel loading of %d files...\n", BENCH_FILE_COUNT);
+
+#if LV_USE_OS != LV_OS_NONE && LV_USE_FS_STDIO
+    if (create_bench_pack() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        remove_bench_pack();
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, BENCH_DIR);
+
+    static const uint32_t thread_counts[] = {1, 2, 4, 8};
+    double time_1 = 0;
+    bool failed = false;
+
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+        lui_xml_load_set_thread_count(thread_counts[i]);
+
+        double start = now_ms();
+        lv_result_t res = lui_xml_load_all_from_path(path);
+        double elapsed = now_ms() - start;
+
+        /* The first, a middle and the last file of the batches */
+        bool valid = card_is_valid(0) && card_is_valid(BENCH_FILE_COUNT / 2) && card_is_valid(BENCH_FILE_COUNT - 1);
+        int registered = unregister_cards();
+        if (!valid) {
+            printf("  %u threads: FAIL (a card was created wrong)\n", (unsigned)thread_counts[i]);
+            failed = true;
+            continue;
+        }
+        if (res != LV_RESULT_OK || registered != BENCH_FILE_COUNT) {
+            printf("  %u threads: FAIL (%d of %d registered)\n", (unsigned)thread_counts[i],
+                   registered, BENCH_FILE_COUNT);
+            failed = true;
+            continue;
+        }
+
+        if (thread_counts[i] == 1) time_1 = elapsed;
+        printf("  %u threads: %.1f ms (%.2fx)\n", (unsigned)thread_counts[i], elapsed,
+               elapsed > 0 ? time_1 / elapsed : 0.0);
+    }
+
+    lui_xml_load_set_thread_count(LUI_XML_LOAD_THREAD_CNT);
+    remove_bench_pack();
+
+    printf(failed ? "FAIL\n" : "PASS\n");
+    if (failed) return 1;
+#else
+    printf("SKIP (requires LV_USE_OS and LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Parallel Loading Benchmark ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_load_parallel_scaling();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file test_load_profile.c
+ * @brief Load profiling: the phases of loading each file are measured and reported as JSON
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_profile.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFILE_DIR     "/tmp/lui_xml_profile_test"
+#define PROFILE_JSON    "/tmp/lui_xml_profile_test.json"
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <images>\n"
+    "    <file name=\"logo\" src_path=\"logo.png\"/>\n"
+    "  </images>\n"
+    "</globals>\n";
+
+static const char * card_xml =
+    "<component>\n"
+    "  <styles>\n"
+    "    <style name=\"frame\" border_width=\"2\"/>\n"
+    "    <style name=\"pressed\" bg_opa=\"50%\"/>\n"
+    "  </styles>\n"
+    "  <view extends=\"lv_obj\" styles=\"frame\"/>\n"
+    "</component>\n";
+
+static const char * home_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <card/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static void remove_test_dir(void)
+{
+    test_remove_dir(PROFILE_DIR);
+    remove(PROFILE_JSON);
+}
+
+static const lui_xml_profile_file_t * find_file(const lui_xml_profile_report_t * report, const char * name)
+{
+    const lui_xml_profile_file_t * file;
+    for (file = report->files; file; file = file->next) {
+        const char * last = strrchr(file->path, '/');
+        if (last && strcmp(last + 1, name) == 0) return file;
+    }
+    return NULL;
+}
+
+/* Test: Every loaded file is in the report with its phases */
+int test_profile_report(void)
+{
+    printf("TEST: Profile report of a directory... ");
+
+#if LV_USE_FS_STDIO
+    const char * files[] = {"globals.xml", globals_xml, "card.xml", card_xml, "home.xml", home_xml, NULL};
+    if (test_create_dir(PROFILE_DIR, files) != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        remove_test_dir();
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, PROFILE_DIR);
+
+    lui_xml_profile_start();
+    lv_result_t res = lui_xml_load_all_from_path(path);
+    lui_xml_profile_stop();
+
+    lui_xml_profile_report_t report;
+    lui_xml_profile_get_report(&report);
+
+    const lui_xml_profile_file_t * globals = find_file(&report, "globals.xml");
+    const lui_xml_profile_file_t * card = find_file(&report, "card.xml");
+    const lui_xml_profile_file_t * home = find_file(&report, "home.xml");
+
+    bool ok = res == LV_RESULT_OK && report.file_cnt == 3 && globals && card && home;
+    if (!ok) {
+        printf("FAIL (%u files in the report)\n", (unsigned)report.file_cnt);
+        lui_xml_unregister_component("home");
+        lui_xml_unregister_component("card");
+        remove_test_dir();
+        return 1;
+    }
+
+    /* The globals are registered first */
+    ok = report.files == globals;
+    ok = ok && card->phases[LUI_XML_PROFILE_PHASE_READ].cnt > 0 && card->phases[LUI_XML_PROFILE_PHASE_PARSE].cnt > 0;
+    ok = ok && card->phases[LUI_XML_PROFILE_PHASE_STYLES].cnt == 2;
+    ok = ok && globals->phases[LUI_XML_PROFILE_PHASE_IMAGES].cnt == 1;
+    ok = ok && home->phases[LUI_XML_PROFILE_PHASE_STYLES].cnt == 0;
+    if (!ok) {
+        printf("FAIL (the phases were not counted correctly)\n");
+        lui_xml_unregister_component("home");
+        lui_xml_unregister_component("card");
+        remove_test_dir();
+        return 1;
+    }
+
+    /* The whole JSON is measured even if the buffer is too small */
+    char small_buf[16];
+    uint32_t len = lui_xml_profile_to_json(small_buf, sizeof(small_buf));
+    char * json = malloc(len + 1);
+    uint32_t len2 = json ? lui_xml_profile_to_json(json, len + 1) : 0;
+    ok = len > sizeof(small_buf) && strlen(small_buf) == sizeof(small_buf) - 1 && len2 == len &&
+         strlen(json) == len && json[0] == '{' && strstr(json, "\"styles\":") && strstr(json, "card.xml");
+    free(json);
+
+    char json_path[64];
+    snprintf(json_path, sizeof(json_path), "%c:%s", LV_FS_STDIO_LETTER, PROFILE_JSON);
+    ok = ok && lui_xml_profile_save_json(json_path) == LV_RESULT_OK;
+
+    struct stat st;
+    ok = ok && stat(PROFILE_JSON, &st) == 0 && (uint32_t)st.st_size == len;
+
+    lui_xml_unregister_component("home");
+    lui_xml_unregister_component("card");
+    remove_test_dir();
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the JSON was not written correctly)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: Nothing is recorded when profiling is stopped */
+int test_profile_stopped(void)
+{
+    printf("TEST: No results when stopped... ");
+
+#if LV_USE_FS_STDIO
+    const char * files[] = {"card.xml", card_xml, NULL};
+    if (test_create_dir(PROFILE_DIR, files) != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        remove_test_dir();
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, PROFILE_DIR);
+
+    lui_xml_profile_start();
+    lui_xml_profile_stop();
+    lui_xml_load_all_from_path(path);
+
+    lui_xml_profile_report_t report;
+    lui_xml_profile_get_report(&report);
+    lui_xml_unregister_component("card");
+    remove_test_dir();
+
+    if (report.file_cnt == 0 && report.files == NULL && report.time == 0) printf("PASS\n");
+    else {
+        printf("FAIL (%u files recorded)\n", (unsigned)report.file_cnt);
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Load Profile Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_profile_report();
+    failed += test_profile_stopped();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
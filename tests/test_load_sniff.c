@@ -0,0 +1,214 @@
+/**
+ * @file test_load_sniff.c
+ * @brief The type of the files is found out even if their root element is far from the beginning
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_component.h"
+#include "lui_xml_load_private.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SNIFF_DIR   "/tmp/lui_xml_sniff_test"
+
+/* Longer than both the first chunk of a stream and the sniffed beginning of a file */
+#define LICENSE_LINE_CNT    64
+
+static const char * card_body_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\" width=\"150\"/>\n"
+    "</component>\n";
+
+static const char * translations_body_xml =
+    "<translations languages=\"en\">\n"
+    "  <translation tag=\"hello\" en=\"Hello\"/>\n"
+    "</translations>\n";
+
+/* Prepend a long license header to the root element */
+static char * add_license(const char * body)
+{
+    static const char * head = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<!--\n";
+    static const char * line = "  Permission is hereby granted, free of charge, to any person.\n";
+    static const char * tail = "-->\n";
+
+    char * buf = malloc(strlen(head) + LICENSE_LINE_CNT * strlen(line) + strlen(tail) + strlen(body) + 1);
+    if (buf == NULL) return NULL;
+
+    strcpy(buf, head);
+    int i;
+    for (i = 0; i < LICENSE_LINE_CNT; i++) strcat(buf, line);
+    strcat(buf, tail);
+    strcat(buf, body);
+    return buf;
+}
+
+static int create_test_dir(void)
+{
+    char * card = add_license(card_body_xml);
+    char * translations = add_license(translations_body_xml);
+    int res = -1;
+    if (card && translations) {
+        const char * files[] = {"licensed_card.xml", card, "licensed_translations.xml", translations, NULL};
+        res = test_create_dir(SNIFF_DIR, files);
+    }
+
+    free(card);
+    free(translations);
+    return res;
+}
+
+/* Test: A component with a long license header is registered when loading eagerly */
+int test_sniff_long_header_eager(void)
+{
+    printf("TEST: Long header, eager loading... ");
+
+#if LV_USE_FS_STDIO
+    if (create_test_dir() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(SNIFF_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, SNIFF_DIR);
+    lv_result_t res = lui_xml_load_all_from_path(path);
+    test_remove_dir(SNIFF_DIR);
+
+    if (res != LV_RESULT_OK) {
+        printf("FAIL (loading failed)\n");
+        return 1;
+    }
+
+    lv_obj_t * card = lui_xml_create(lv_screen_active(), "licensed_card", NULL);
+    if (card == NULL) {
+        printf("FAIL (the component was not registered)\n");
+        return 1;
+    }
+
+    bool ok = lv_obj_get_style_width(card, LV_PART_MAIN) == 150;
+    lv_obj_delete(card);
+    lui_xml_unregister_component("licensed_card");
+    if (!ok) {
+        printf("FAIL (the component was created wrong)\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: The type of a file with a long license header is found out */
+int test_sniff_long_header_is_component(void)
+{
+    printf("TEST: Long header, file type... ");
+
+#if LV_USE_FS_STDIO
+    if (create_test_dir() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(SNIFF_DIR);
+        return 1;
+    }
+
+    char card_path[96];
+    char translations_path[96];
+    snprintf(card_path, sizeof(card_path), "%c:%s/licensed_card.xml", LV_FS_STDIO_LETTER, SNIFF_DIR);
+    snprintf(translations_path, sizeof(translations_path), "%c:%s/licensed_translations.xml",
+             LV_FS_STDIO_LETTER, SNIFF_DIR);
+
+    bool card_ok = lui_xml_load_file_is_component(card_path);
+    bool translations_ok = !lui_xml_load_file_is_component(translations_path);
+    test_remove_dir(SNIFF_DIR);
+
+    if (!card_ok || !translations_ok) {
+        printf("FAIL (%s)\n", !card_ok ? "the component was not recognized" : "the translations were taken as a component");
+        return 1;
+    }
+
+    printf("PASS\n");
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: A component with a long license header is indexed when loading lazily */
+int test_sniff_long_header_lazy(void)
+{
+    printf("TEST: Long header, lazy loading... ");
+
+#if LV_USE_FS_STDIO
+    if (create_test_dir() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(SNIFF_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, SNIFF_DIR);
+
+    lui_xml_load_set_lazy(true);
+    lv_result_t res = lui_xml_load_all_from_path(path);
+    lui_xml_load_set_lazy(false);
+
+    /* Only the component is indexed, the translations are registered right away */
+    if (res != LV_RESULT_OK || lui_xml_load_get_indexed_count() != 1) {
+        printf("FAIL (%u components indexed instead of 1)\n", (unsigned)lui_xml_load_get_indexed_count());
+        lui_xml_load_component(NULL);
+        test_remove_dir(SNIFF_DIR);
+        return 1;
+    }
+
+    /* The file is read only now */
+    lv_obj_t * card = lui_xml_create(lv_screen_active(), "licensed_card", NULL);
+    test_remove_dir(SNIFF_DIR);
+    if (card == NULL) {
+        printf("FAIL (the indexed component was not registered)\n");
+        return 1;
+    }
+
+    bool ok = lv_obj_get_style_width(card, LV_PART_MAIN) == 150 && lui_xml_load_get_indexed_count() == 0;
+    lv_obj_delete(card);
+    lui_xml_unregister_component("licensed_card");
+    if (!ok) {
+        printf("FAIL (the component was created wrong)\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML File Type Sniffing Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_sniff_long_header_eager();
+    failed += test_sniff_long_header_is_component();
+    failed += test_sniff_long_header_lazy();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file test_memory_stats.c
+ * @brief Memory accounting of components and their instances
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_memory.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char * card_xml =
+    "<component>\n"
+    "  <consts>\n"
+    "    <px name=\"ms_size\" value=\"100\"/>\n"
+    "  </consts>\n"
+    "  <styles>\n"
+    "    <style name=\"ms_style\" bg_color=\"0xff0000\" radius=\"8\"/>\n"
+    "  </styles>\n"
+    "  <view extends=\"lv_obj\" width=\"#ms_size\" styles=\"ms_style\">\n"
+    "    <lv_obj style_bg_color=\"0x00ff00\"/>\n"
+    "    <lv_obj/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static const char * list_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\">\n"
+    "    <ms_card/>\n"
+    "    <ms_card/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+/* Test: The metadata includes the used bytes of the arena */
+int test_memory_metadata(void)
+{
+    printf("TEST: Metadata size of a component... ");
+
+    lui_xml_register_component_from_data("ms_card", card_xml);
+
+    lui_xml_memory_stats_t stats;
+    lui_xml_arena_stats_t arena;
+    bool ok = lui_xml_get_memory_stats("ms_card", &stats) == LV_RESULT_OK;
+    ok = ok && lui_xml_component_get_arena_stats("ms_card", &arena) == LV_RESULT_OK;
+
+    /* The arena holds the view definition too, which is reported separately */
+    ok = ok && stats.view_def_size > 0 && stats.metadata_size + stats.view_def_size >= arena.used_size;
+
+    lui_xml_unregister_component("ms_card");
+    ok = ok && lui_xml_get_memory_stats("ms_card", &stats) == LV_RESULT_INVALID;
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (wrong metadata size)\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: Each created instance is counted and the last one is measured */
+int test_memory_instances(void)
+{
+    printf("TEST: Instance sizes of nested components... ");
+
+    lui_xml_register_component_from_data("ms_card", card_xml);
+    lui_xml_register_component_from_data("ms_list", list_xml);
+    lv_obj_t * screen = test_create_screen();
+
+    lui_xml_create(screen, "ms_list", NULL);
+    lui_xml_create(screen, "ms_list", NULL);
+
+    lui_xml_memory_stats_t card;
+    lui_xml_memory_stats_t list;
+    lui_xml_get_memory_stats("ms_card", &card);
+    lui_xml_get_memory_stats("ms_list", &list);
+
+    bool ok = card.instance_cnt == 4 && list.instance_cnt == 2;
+    /* 3 widgets in a card, 1 + 2 cards in a list */
+    ok = ok && card.instance_obj_size >= 3 * sizeof(lv_obj_t);
+    ok = ok && list.instance_obj_size >= 2 * card.instance_obj_size + sizeof(lv_obj_t);
+    ok = ok && card.instance_style_size > 0 && list.instance_style_size >= 2 * card.instance_style_size;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("ms_list");
+    lui_xml_unregister_component("ms_card");
+
+    if (ok) printf("PASS (card: %u + %u bytes)\n", (unsigned)card.instance_obj_size,
+                       (unsigned)card.instance_style_size);
+    else {
+        printf("FAIL (%u cards, %u lists)\n", (unsigned)card.instance_cnt, (unsigned)list.instance_cnt);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Memory Stats Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_memory_metadata();
+    failed += test_memory_instances();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
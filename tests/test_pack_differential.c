@@ -0,0 +1,184 @@
+/**
+ * @file test_pack_differential.c
+ * @brief Create the same screen from XML files and from a compiled pack and compare the results
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_component.h"
+#include "lui_xml_pack.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define PACK_DIR    "/tmp/lui_xml_pack_test"
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <consts>\n"
+    "    <px name=\"card_width\" value=\"180\"/>\n"
+    "    <color name=\"accent\" value=\"0x2196f3\"/>\n"
+    "  </consts>\n"
+    "  <styles>\n"
+    "    <style name=\"panel\" pad_all=\"8\" bg_color=\"#accent\"/>\n"
+    "  </styles>\n"
+    "</globals>\n";
+
+static const char * card_xml =
+    "<component>\n"
+    "  <api>\n"
+    "    <prop name=\"title\" type=\"string\" default=\"Untitled\"/>\n"
+    "    <prop name=\"height\" type=\"int\" default=\"60\"/>\n"
+    "  </api>\n"
+    "  <styles>\n"
+    "    <style name=\"rounded\" radius=\"12\"/>\n"
+    "  </styles>\n"
+    "  <view extends=\"lv_obj\" width=\"#card_width\" height=\"$height\" flex_flow=\"column\">\n"
+    "    <style name=\"rounded\"/>\n"
+    "    <style name=\"panel\"/>\n"
+    "    <lv_label text=\"$title\"/>\n"
+    "    <lv_label text=\"details\" width=\"100%\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static const char * home_xml =
+    "<screen>\n"
+    "  <view flex_flow=\"row_wrap\">\n"
+    "    <card title=\"First\"/>\n"
+    "    <card title=\"Second\" height=\"90\"/>\n"
+    "    <lv_button width=\"120\" height=\"40\">\n"
+    "      <lv_label text=\"OK\" align=\"center\"/>\n"
+    "    </lv_button>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static int create_test_dir(void)
+{
+    const char * files[] = {"globals.xml", globals_xml, "card.xml", card_xml, "home.xml", home_xml, NULL};
+    return test_create_dir(PACK_DIR, files);
+}
+
+static int create_and_dump(char * buf, size_t buf_size)
+{
+    lv_obj_t * screen = lui_xml_create_screen("home");
+    if (screen == NULL) return -1;
+
+    lv_obj_update_layout(screen);
+    buf[0] = '\0';
+    test_dump_tree(screen, 0, buf, buf_size);
+    lv_obj_delete(screen);
+    return 0;
+}
+
+/* Test: The pack creates the same object tree as the XML files */
+int test_pack_matches_xml(void)
+{
+    printf("TEST: Pack vs. XML object tree... ");
+
+#if LV_USE_FS_STDIO
+    static char xml_dump[4096];
+    static char pack_dump[4096];
+
+    if (create_test_dir() != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(PACK_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, PACK_DIR);
+
+    if (lui_xml_load_all_from_path(path) != LV_RESULT_OK || create_and_dump(xml_dump, sizeof(xml_dump)) != 0) {
+        printf("FAIL (couldn't create the screen from XML)\n");
+        test_remove_dir(PACK_DIR);
+        return 1;
+    }
+    lui_xml_unregister_component("home");
+    lui_xml_unregister_component("card");
+
+    uint32_t size;
+    void * buf = lui_xml_pack_compile(path, &size);
+    test_remove_dir(PACK_DIR);
+    if (buf == NULL) {
+        printf("FAIL (couldn't compile the pack)\n");
+        return 1;
+    }
+
+    lui_xml_pack_t * pack = lui_xml_load_pack(buf, size);
+    if (pack == NULL || create_and_dump(pack_dump, sizeof(pack_dump)) != 0) {
+        printf("FAIL (couldn't create the screen from the pack)\n");
+        lui_xml_unload_pack(pack);
+        lv_free(buf);
+        return 1;
+    }
+
+    lui_xml_unload_pack(pack);
+    bool unloaded = lui_xml_component_get_scope("home") == NULL && lui_xml_component_get_scope("card") == NULL;
+    lv_free(buf);
+
+    if (strcmp(xml_dump, pack_dump) != 0) {
+        printf("FAIL (different trees)\nXML:\n%sPack:\n%s", xml_dump, pack_dump);
+        return 1;
+    }
+    else if (!unloaded) {
+        printf("FAIL (components are still registered after unloading)\n");
+        return 1;
+    }
+    else {
+        printf("PASS (%u byte pack)\n", (unsigned)size);
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO)\n");
+#endif
+    return 0;
+}
+
+/* Test: Corrupted packs are rejected */
+int test_pack_rejects_invalid(void)
+{
+    printf("TEST: Invalid packs are rejected... ");
+
+    static uint32_t garbage[16];
+    memcpy(garbage, "LXPK", 4);
+    garbage[1] = LUI_XML_PACK_VERSION;
+    garbage[2] = 0x01020304;
+    garbage[3] = 0xFFFFFF00; /* Larger than the buffer */
+
+    if (lui_xml_load_pack(garbage, sizeof(garbage)) != NULL) {
+        printf("FAIL (truncated pack was accepted)\n");
+        return 1;
+    }
+
+    if (lui_xml_load_pack((const uint8_t *)garbage + 1, sizeof(garbage) - 4) != NULL) {
+        printf("FAIL (unaligned pack was accepted)\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Pack Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_pack_matches_xml();
+    failed += test_pack_rejects_invalid();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
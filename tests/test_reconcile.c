@@ -0,0 +1,243 @@
+/**
+ * @file test_reconcile.c
+ * @brief Reconcile: re-render a changed view into the live widgets and count the saved setter calls
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_reconcile.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char * card_xml =
+    "<component>\n"
+    "  <api>\n"
+    "    <prop name=\"title\" type=\"string\" default=\"Untitled\"/>\n"
+    "  </api>\n"
+    "  <view extends=\"lv_obj\" width=\"180\" height=\"60\">\n"
+    "    <lv_label name=\"title\" text=\"$title\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static const char * home_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <lv_label name=\"header\" text=\"Home\" x=\"10\" y=\"5\"/>\n"
+    "    <card name=\"wifi\" title=\"Wi-Fi\" y=\"40\"/>\n"
+    "    <card name=\"audio\" title=\"Audio\" y=\"110\"/>\n"
+    "    <lv_slider name=\"volume\" value=\"10\" y=\"180\" width=\"150\"/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+/* The header and the volume changed, the Wi-Fi card was removed and a Bluetooth card was added */
+static const char * home_changed_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <lv_label name=\"header\" text=\"Settings\" x=\"10\" y=\"5\"/>\n"
+    "    <card name=\"bluetooth\" title=\"Bluetooth\" y=\"40\"/>\n"
+    "    <card name=\"audio\" title=\"Audio\" y=\"110\"/>\n"
+    "    <lv_slider name=\"volume\" value=\"30\" y=\"180\" width=\"150\"/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static bool register_home(const char * xml_def)
+{
+    lui_xml_unregister_component("rc_home");
+    return lui_xml_register_component_from_data("rc_home", xml_def) == LV_RESULT_OK;
+}
+
+/* Test: Re-rendering the same view changes nothing */
+int test_reconcile_unchanged(void)
+{
+    printf("TEST: Reconcile an unchanged view... ");
+
+#if LV_USE_SLIDER && LV_USE_LABEL
+    lui_xml_register_component_from_data("card", card_xml);
+    register_home(home_xml);
+
+    lv_obj_t * screen = lv_obj_create(NULL);
+    lui_xml_reconcile_stats_t stats;
+    bool ok = lui_xml_reconcile(screen, "rc_home", NULL) == LV_RESULT_OK;
+    lui_xml_reconcile_get_stats(&stats);
+    ok = ok && lv_obj_get_child_count(screen) == 4 && stats.obj_created == 4;
+
+    lv_obj_t * header = lv_obj_get_child(screen, 0);
+    ok = ok && lui_xml_reconcile(screen, "rc_home", NULL) == LV_RESULT_OK;
+    lui_xml_reconcile_get_stats(&stats);
+    ok = ok && stats.attr_applied == 0 && stats.obj_created == 0 && stats.obj_deleted == 0;
+    ok = ok && lv_obj_get_child(screen, 0) == header;
+
+    lv_obj_delete(screen);
+    lui_xml_unregister_component("rc_home");
+    lui_xml_unregister_component("card");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (widgets were changed)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_SLIDER and LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+/* Test: Only the changes are applied and the setter calls saved are reported */
+int test_reconcile_changed(void)
+{
+    printf("TEST: Reconcile a changed view...\n");
+
+#if LV_USE_SLIDER && LV_USE_LABEL
+    lui_xml_register_component_from_data("card", card_xml);
+    register_home(home_xml);
+
+    lv_obj_t * screen = lv_obj_create(NULL);
+    lui_xml_reconcile_stats_t stats;
+    bool ok = lui_xml_reconcile(screen, "rc_home", NULL) == LV_RESULT_OK;
+
+    lv_obj_t * header = lv_obj_find_by_name(screen, "header");
+    lv_obj_t * audio = lv_obj_find_by_name(screen, "audio");
+    lv_obj_t * volume = lv_obj_find_by_name(screen, "volume");
+
+    /* What recreating the screen would cost */
+    ok = ok && register_home(home_changed_xml);
+    lv_obj_t * recreated = lv_obj_create(NULL);
+    ok = ok && lui_xml_reconcile(recreated, "rc_home", NULL) == LV_RESULT_OK;
+    lui_xml_reconcile_get_stats(&stats);
+    uint32_t full_cnt = stats.attr_applied;
+    lv_obj_delete(recreated);
+
+    ok = ok && lui_xml_reconcile(screen, "rc_home", NULL) == LV_RESULT_OK;
+    lui_xml_reconcile_get_stats(&stats);
+
+    /* The unchanged widgets are kept and the order of the view is followed */
+    ok = ok && lv_obj_get_child_count(screen) == 4;
+    ok = ok && lv_obj_get_child(screen, 0) == header && lv_obj_get_child(screen, 2) == audio &&
+         lv_obj_get_child(screen, 3) == volume;
+    ok = ok && lv_obj_find_by_name(screen, "wifi") == NULL &&
+         lv_obj_get_child(screen, 1) == lv_obj_find_by_name(screen, "bluetooth");
+    ok = ok && strcmp(lv_label_get_text(header), "Settings") == 0 && lv_slider_get_value(volume) == 30;
+    ok = ok && stats.obj_created == 1 && stats.obj_deleted == 1;
+
+    printf("  setter calls: %u applied, %u saved (%u to recreate)\n",
+           (unsigned)stats.attr_applied, (unsigned)stats.attr_skipped, (unsigned)full_cnt);
+    ok = ok && stats.attr_applied < full_cnt && stats.attr_applied + stats.attr_skipped == full_cnt;
+
+    lv_obj_delete(screen);
+    lui_xml_unregister_component("rc_home");
+    lui_xml_unregister_component("card");
+
+    printf(ok ? "PASS\n" : "FAIL\n");
+    if (!ok) return 1;
+#else
+    printf("SKIP (requires LV_USE_SLIDER and LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+/* Test: A root attribute can't be removed, nothing is changed then */
+int test_reconcile_root_attr_removed(void)
+{
+    printf("TEST: Reconcile without an attribute of the root... ");
+
+    lui_xml_register_component_from_data("rc_panel",
+                                          "<component><view width=\"100\"><lv_obj name=\"inner\"/></view></component>");
+    lv_obj_t * screen = test_create_screen();
+    lv_obj_t * panel = lv_obj_create(screen);
+    bool ok = lui_xml_reconcile(panel, "rc_panel", NULL) == LV_RESULT_OK;
+    lv_obj_t * inner = lv_obj_get_child(panel, 0);
+
+    lui_xml_unregister_component("rc_panel");
+    lui_xml_register_component_from_data("rc_panel",
+                                          "<component><view><lv_obj name=\"inner\" x=\"5\"/></view></component>");
+    ok = ok && lui_xml_reconcile(panel, "rc_panel", NULL) == LV_RESULT_INVALID;
+    ok = ok && lv_obj_get_child(panel, 0) == inner && lv_obj_get_x(inner) == 0;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("rc_panel");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the widgets were changed)\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: The widgets deleted by the application between two renders are created again */
+int test_reconcile_deleted_child(void)
+{
+    printf("TEST: Reconcile after deleting children... ");
+
+#if LV_USE_SLIDER && LV_USE_LABEL
+    lui_xml_register_component_from_data("card", card_xml);
+    register_home(home_xml);
+
+    lv_obj_t * screen = lv_obj_create(NULL);
+    bool ok = lui_xml_reconcile(screen, "rc_home", NULL) == LV_RESULT_OK;
+
+    /* A child of the view and a child of a component's view */
+    lv_obj_t * header = lv_obj_find_by_name(screen, "header");
+    lv_obj_t * audio = lv_obj_find_by_name(screen, "audio");
+    if (ok) {
+        lv_obj_delete(lv_obj_find_by_name(screen, "volume"));
+        lv_obj_clean(audio);
+    }
+
+    lui_xml_reconcile_stats_t stats;
+    ok = ok && lui_xml_reconcile(screen, "rc_home", NULL) == LV_RESULT_OK;
+    lui_xml_reconcile_get_stats(&stats);
+    lv_obj_t * volume = lv_obj_find_by_name(screen, "volume");
+    ok = ok && stats.obj_created == 2 && stats.obj_deleted == 0;
+    ok = ok && lv_obj_get_child_count(screen) == 4 && lv_obj_get_child(screen, 0) == header &&
+         lv_obj_get_child(screen, 2) == audio && lv_obj_get_child(screen, 3) == volume;
+    ok = ok && volume && lv_slider_get_value(volume) == 10 && lv_obj_get_child_count(audio) == 1;
+
+    /* All the children are deleted */
+    if (ok) lv_obj_clean(screen);
+    ok = ok && lui_xml_reconcile(screen, "rc_home", NULL) == LV_RESULT_OK;
+    lui_xml_reconcile_get_stats(&stats);
+    ok = ok && stats.obj_created == 4 && lv_obj_get_child_count(screen) == 4;
+
+    lv_obj_delete(screen);
+    lui_xml_unregister_component("rc_home");
+    lui_xml_unregister_component("card");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the deleted widgets were not created again)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_SLIDER and LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Reconcile Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_reconcile_unchanged();
+    failed += test_reconcile_changed();
+    failed += test_reconcile_root_attr_removed();
+    failed += test_reconcile_deleted_child();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
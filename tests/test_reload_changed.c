@@ -0,0 +1,150 @@
+/**
+ * @file test_reload_changed.c
+ * @brief Hot reload: only the changed files of a directory are registered again
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_load.h"
+#include "lui_xml_reload.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RELOAD_DIR  "/tmp/lui_xml_reload_test"
+
+static const char * card_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\" width=\"100\" height=\"60\"/>\n"
+    "</component>\n";
+
+static const char * card_wide_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\" width=\"200\" height=\"60\"/>\n"
+    "</component>\n";
+
+static const char * home_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <card/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static const char * about_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <lv_label text=\"About\"/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+typedef struct {
+    uint32_t cnt;
+    lv_obj_t * screen;
+    const char * name;
+} reload_result_t;
+
+static void reload_cb(const char * name, lv_obj_t * screen, void * user_data)
+{
+    reload_result_t * result = user_data;
+    result->cnt++;
+    result->screen = screen;
+    result->name = name;
+}
+
+/* Test: A changed component is registered again and the screen using it is reported */
+int test_reload_changed_component(void)
+{
+    printf("TEST: Reload a changed component... ");
+
+#if LV_USE_FS_STDIO && LV_USE_OBJ_NAME
+    const char * files[] = {"card.xml", card_xml, "home.xml", home_xml, "about.xml", about_xml, NULL};
+    if (test_create_dir(RELOAD_DIR, files) != 0) {
+        printf("FAIL (couldn't create the files)\n");
+        test_remove_dir(RELOAD_DIR);
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, RELOAD_DIR);
+    lui_xml_load_all_from_path(path);
+
+    lv_obj_t * home = lui_xml_create_screen("home");
+    lv_obj_t * about = lui_xml_create_screen("about");
+
+    /* Nothing changed yet */
+    reload_result_t result = {0};
+    if (lui_xml_reload_changed(path, reload_cb, &result) != LV_RESULT_OK || result.cnt != 0) {
+        printf("FAIL (unchanged files were reloaded)\n");
+        test_remove_dir(RELOAD_DIR);
+        return 1;
+    }
+
+    test_write_file(RELOAD_DIR, "card.xml", card_wide_xml);
+    lv_result_t res = lui_xml_reload_changed(path, reload_cb, &result);
+
+    /* Only the screen using the card is affected, not the other one */
+    bool ok = res == LV_RESULT_OK && result.cnt == 1 && result.screen == home &&
+              result.name && strcmp(result.name, "card") == 0;
+    lv_obj_delete(home);
+    lv_obj_delete(about);
+    if (!ok) {
+        printf("FAIL (the screen using the component was not reported)\n");
+        test_remove_dir(RELOAD_DIR);
+        return 1;
+    }
+
+    home = lui_xml_create_screen("home");
+    lv_obj_update_layout(home);
+    lv_obj_t * card = lv_obj_get_child(home, 0);
+    ok = card && lv_obj_get_width(card) == 200;
+    lv_obj_delete(home);
+    if (!ok) {
+        printf("FAIL (the new definition was not registered)\n");
+        test_remove_dir(RELOAD_DIR);
+        return 1;
+    }
+
+    /* A removed file is unregistered */
+    remove(RELOAD_DIR "/about.xml");
+    result.cnt = 0;
+    res = lui_xml_reload_changed(path, reload_cb, &result);
+    ok = res == LV_RESULT_OK && result.cnt == 0 && lui_xml_component_get_scope("about") == NULL;
+
+    lui_xml_unregister_component("home");
+    lui_xml_unregister_component("card");
+    test_remove_dir(RELOAD_DIR);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the removed component is still registered)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_FS_STDIO and LV_USE_OBJ_NAME)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Reload Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_reload_changed_component();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_stream_large_translation.c
+ * @brief Streaming parser tests with a large translations file
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML parser headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_translation.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_FILE_PATH      "/tmp/lui_xml_stream_test.xml"
+#define TEST_FILE_SIZE      (10 * 1024 * 1024)
+#define TEST_TAG_COUNT      200
+
+/* Allowed growth of the heap while the file is being registered.
+ * The tags and translations are stored, the rest of the file must not be. */
+#define TEST_MAX_PEAK_INCREASE  (256 * 1024)
+
+/* Write a translations file of about TEST_FILE_SIZE bytes.
+ * Most of the file is comments so that only a little data is stored. */
+static int create_test_file(void)
+{
+    FILE * f = fopen(TEST_FILE_PATH, "w");
+    if (f == NULL) return -1;
+
+    fprintf(f, "<translations languages=\"en de\">\n");
+
+    char comment[1024];
+    memset(comment, 'x', sizeof(comment));
+    memcpy(comment, "<!--", 4);
+    memcpy(comment + sizeof(comment) - 4, "-->\n", 4);
+
+    long size = 0;
+    int tag_id = 0;
+    while (size < TEST_FILE_SIZE) {
+        if (fwrite(comment, 1, sizeof(comment), f) != sizeof(comment)) {
+            fclose(f);
+            return -1;
+        }
+        size += sizeof(comment);
+
+        /* Spread the tags over the whole file so that all chunks are parsed */
+        if (tag_id < TEST_TAG_COUNT && size >= (long)tag_id * (TEST_FILE_SIZE / TEST_TAG_COUNT)) {
+            fprintf(f, "<translation tag=\"tag_%d\" en=\"English %d\" de=\"Deutsch %d\"/>\n",
+                    tag_id, tag_id, tag_id);
+            tag_id++;
+        }
+    }
+
+    fprintf(f, "</translations>\n");
+    fclose(f);
+    return 0;
+}
+
+/* Test: A 10 MB translations file is registered with a small buffer */
+int test_stream_large_translation(void)
+{
+    printf("TEST: Stream 10 MB translations file (%d byte buffer)... ", LUI_XML_STREAM_BUF_SIZE);
+
+#if LV_USE_TRANSLATION && LV_USE_FS_STDIO && LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    if (create_test_file() != 0) {
+        printf("FAIL (couldn't create test file)\n");
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, TEST_FILE_PATH);
+
+    /* max_used is the high-water mark since lv_init(). Use the heap up to it first,
+     * so that any allocation made while loading raises it. */
+    lv_mem_monitor_t mon_before;
+    lv_mem_monitor(&mon_before);
+    void * ballast = NULL;
+    if (mon_before.max_used > mon_before.used_cnt) ballast = lv_malloc(mon_before.max_used - mon_before.used_cnt);
+    lv_mem_monitor(&mon_before);
+
+    lv_result_t res = lui_xml_register_translation_from_file(path);
+
+    lv_mem_monitor_t mon_after;
+    lv_mem_monitor(&mon_after);
+    lv_free(ballast);
+    remove(TEST_FILE_PATH);
+
+    if (res != LV_RESULT_OK) {
+        printf("FAIL (registration failed)\n");
+        return 1;
+    }
+
+    lv_translation_set_language("de");
+    if (strcmp(lv_tr("tag_0"), "Deutsch 0") != 0 ||
+        strcmp(lv_tr("tag_199"), "Deutsch 199") != 0) {
+        printf("FAIL (wrong translation)\n");
+        return 1;
+    }
+
+    size_t peak_increase = 0;
+    if (mon_after.max_used > mon_before.used_cnt) peak_increase = mon_after.max_used - mon_before.used_cnt;
+    if (peak_increase > TEST_MAX_PEAK_INCREASE) {
+        printf("FAIL (peak heap increase: %zu bytes)\n", peak_increase);
+        return 1;
+    }
+
+    printf("PASS (peak heap increase: %zu bytes)\n", peak_increase);
+#else
+    printf("SKIP (requires LV_USE_TRANSLATION, LV_USE_FS_STDIO and the builtin allocator)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Streaming Parser Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_stream_large_translation();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file test_subject_batch.c
+ * @brief Subject batches: many subjects set by handles, with a benchmark
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_subject.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SUBJECT_COUNT     10000
+#define BENCH_BATCH_COUNT       10
+
+static lv_subject_t subjects[BENCH_SUBJECT_COUNT];
+static uint32_t notify_cnt;
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void count_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    (void)observer;
+    (void)subject;
+    notify_cnt++;
+}
+
+static bool register_subjects(uint32_t cnt)
+{
+    if (lui_xml_register_component_from_data("globals", "<globals></globals>") != LV_RESULT_OK) return false;
+
+    char name[32];
+    uint32_t i;
+    for (i = 0; i < cnt; i++) {
+        snprintf(name, sizeof(name), "telemetry_%u", (unsigned)i);
+        lv_subject_init_int(&subjects[i], 0);
+        lv_subject_add_observer(&subjects[i], count_observer_cb, NULL);
+        if (lui_xml_register_subject(NULL, name, &subjects[i]) != LV_RESULT_OK) return false;
+    }
+
+    return true;
+}
+
+static void unregister_subjects(uint32_t cnt)
+{
+    lui_xml_unregister_component("globals");
+
+    uint32_t i;
+    for (i = 0; i < cnt; i++) lv_subject_deinit(&subjects[i]);
+}
+
+/* Test: Only the last value of a subject is set and only the changed subjects are notified */
+int test_subject_batch_set(void)
+{
+    printf("TEST: Set subjects in a batch... ");
+
+    bool ok = register_subjects(3);
+    lui_xml_subject_handle_t h0 = lui_xml_subject_get_handle(NULL, "telemetry_0");
+    lui_xml_subject_handle_t h1 = lui_xml_subject_get_handle(NULL, "telemetry_1");
+    lui_xml_subject_handle_t h2 = lui_xml_subject_get_handle(NULL, "telemetry_2");
+    ok = ok && h0 && h1 && h2 && h0 != h1;
+    ok = ok && lui_xml_subject_get_handle(NULL, "telemetry_1") == h1;
+    ok = ok && lui_xml_subject_get_handle(NULL, "no_such_subject") == 0;
+
+    /* telemetry_0 is listed twice, telemetry_2 doesn't change */
+    lui_xml_subject_handle_t handles[] = {h0, h1, h2, h0};
+    int32_t values[] = {5, 6, 0, 7};
+    notify_cnt = 0;
+    ok = ok && lui_xml_subjects_set_batch(handles, values, 4) == 2;
+    ok = ok && notify_cnt == 2;
+    ok = ok && lv_subject_get_int(&subjects[0]) == 7 && lv_subject_get_int(&subjects[1]) == 6;
+
+    unregister_subjects(3);
+
+    /* The handles are invalid after unregistering */
+    ok = ok && register_subjects(3);
+    notify_cnt = 0;
+    ok = ok && lui_xml_subjects_set_batch(handles, values, 4) == 0 && notify_cnt == 0;
+    unregister_subjects(3);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+int test_subject_batch_bench(void)
+{
+    printf("TEST: Benchmark of %d x %d subject updates...\n", BENCH_BATCH_COUNT, BENCH_SUBJECT_COUNT);
+
+    lui_xml_subject_handle_t * handles = malloc(BENCH_SUBJECT_COUNT * sizeof(lui_xml_subject_handle_t));
+    int32_t * values = malloc(BENCH_SUBJECT_COUNT * sizeof(int32_t));
+    if (handles == NULL || values == NULL || !register_subjects(BENCH_SUBJECT_COUNT)) {
+        printf("FAIL (couldn't register the subjects)\n");
+        free(handles);
+        free(values);
+        return 1;
+    }
+
+    char name[32];
+    int i;
+    double start = now_ms();
+    int batch;
+    for (batch = 0; batch < BENCH_BATCH_COUNT; batch++) {
+        for (i = 0; i < BENCH_SUBJECT_COUNT; i++) {
+            snprintf(name, sizeof(name), "telemetry_%d", i);
+            lv_subject_set_int(lui_xml_get_subject(NULL, name), batch + i);
+        }
+    }
+    double name_time = now_ms() - start;
+
+    start = now_ms();
+    for (i = 0; i < BENCH_SUBJECT_COUNT; i++) {
+        snprintf(name, sizeof(name), "telemetry_%d", i);
+        handles[i] = lui_xml_subject_get_handle(NULL, name);
+    }
+    double resolve_time = now_ms() - start;
+
+    bool ok = true;
+    notify_cnt = 0;
+    start = now_ms();
+    for (batch = 0; batch < BENCH_BATCH_COUNT; batch++) {
+        for (i = 0; i < BENCH_SUBJECT_COUNT; i++) values[i] = batch + i + 1;
+        if (lui_xml_subjects_set_batch(handles, values, BENCH_SUBJECT_COUNT) != BENCH_SUBJECT_COUNT) ok = false;
+    }
+    double batch_time = now_ms() - start;
+
+    ok = ok && notify_cnt == (uint32_t)BENCH_BATCH_COUNT * BENCH_SUBJECT_COUNT;
+    ok = ok && lv_subject_get_int(&subjects[BENCH_SUBJECT_COUNT - 1]) == BENCH_BATCH_COUNT + BENCH_SUBJECT_COUNT - 1;
+
+    double update_cnt = (double)BENCH_BATCH_COUNT * BENCH_SUBJECT_COUNT;
+    printf("  by name:    %.1f ms (%.0f updates/s)\n", name_time,
+           name_time > 0 ? update_cnt * 1000.0 / name_time : 0.0);
+    printf("  by handle:  %.1f ms (%.0f updates/s), resolving the handles once: %.1f ms\n", batch_time,
+           batch_time > 0 ? update_cnt * 1000.0 / batch_time : 0.0, resolve_time);
+
+    unregister_subjects(BENCH_SUBJECT_COUNT);
+    free(handles);
+    free(values);
+
+    printf(ok ? "PASS\n" : "FAIL\n");
+    return ok ? 0 : 1;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Subject Batch Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_subject_batch_set();
+    failed += test_subject_batch_bench();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file test_subject_cache.c
+ * @brief Subject cache: the bind_* subjects of a component are looked up by name only once
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_subject.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SUBJECT_COUNT     500
+#define BENCH_INSTANCE_COUNT    2000
+#define REUSE_COUNT             300
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <subjects>\n"
+    "    <int name=\"sc_value\" value=\"5\"/>\n"
+    "  </subjects>\n"
+    "</globals>\n";
+
+static const char * item_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\">\n"
+    "    <lv_label bind_text=\"sc_value\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static lv_subject_t bench_subjects[BENCH_SUBJECT_COUNT];
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char * item_text(lv_obj_t * item)
+{
+    lv_obj_t * label = item ? lv_obj_get_child(item, 0) : NULL;
+    return label ? lv_label_get_text(label) : "";
+}
+
+/* Test: The instances created after the first one bind to the same subject */
+int test_cache_instances(void)
+{
+    printf("TEST: Bind the instances of a component... ");
+
+#if LV_USE_LABEL
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("sc_item", item_xml);
+    lv_obj_t * screen = test_create_screen();
+
+    lv_obj_t * item1 = lui_xml_create(screen, "sc_item", NULL);
+    lv_obj_t * item2 = lui_xml_create(screen, "sc_item", NULL);
+    bool ok = strcmp(item_text(item1), "5") == 0 && strcmp(item_text(item2), "5") == 0;
+
+    lv_subject_set_int(lui_xml_get_subject(NULL, "sc_value"), 6);
+    ok = ok && strcmp(item_text(item1), "6") == 0 && strcmp(item_text(item2), "6") == 0;
+
+    /* The globals are registered again with new subjects */
+    lv_obj_clean(screen);
+    lui_xml_unregister_component("globals");
+    lui_xml_register_component_from_data("globals", globals_xml);
+
+    lv_obj_t * item3 = lui_xml_create(screen, "sc_item", NULL);
+    ok = ok && strcmp(item_text(item3), "5") == 0;
+    lv_subject_set_int(lui_xml_get_subject(NULL, "sc_value"), 7);
+    ok = ok && strcmp(item_text(item3), "7") == 0;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("sc_item");
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (wrong text)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+/* Test: A subject registered in the component later hides the global one */
+int test_cache_hidden_global(void)
+{
+    printf("TEST: Hide a cached global subject... ");
+
+#if LV_USE_LABEL
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("sc_item", item_xml);
+    lv_obj_t * screen = test_create_screen();
+
+    lv_obj_t * item1 = lui_xml_create(screen, "sc_item", NULL);
+
+    lv_subject_t local;
+    lv_subject_init_int(&local, 42);
+    lui_xml_register_subject(lui_xml_component_get_scope("sc_item"), "sc_value", &local);
+
+    lv_obj_t * item2 = lui_xml_create(screen, "sc_item", NULL);
+    bool ok = strcmp(item_text(item1), "5") == 0 && strcmp(item_text(item2), "42") == 0;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("sc_item");
+    lui_xml_unregister_component("globals");
+    lv_subject_deinit(&local);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (bound to the wrong subject)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+/* Test: A cached subject is not returned after the slot of its handle was reused many times */
+int test_cache_reused_slot(void)
+{
+    printf("TEST: Reuse the handle slot of a cached subject %d times... ", REUSE_COUNT);
+
+#if LV_USE_LABEL
+    static const char * other_xml =
+        "<component>\n"
+        "  <view extends=\"lv_obj\">\n"
+        "    <lv_label bind_text=\"sc_value\"/>\n"
+        "  </view>\n"
+        "</component>\n";
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("sc_item", item_xml);
+    lui_xml_register_component_from_data("sc_other", other_xml);
+    lv_obj_t * screen = test_create_screen();
+
+    /* Cache the subject in `sc_item` only once */
+    lv_obj_t * item = lui_xml_create(screen, "sc_item", NULL);
+    bool ok = strcmp(item_text(item), "5") == 0;
+    lv_obj_clean(screen);
+
+    /* Each new `sc_value` takes the freed handle slot with the next generation */
+    int i;
+    for (i = 0; ok && i < REUSE_COUNT; i++) {
+        lui_xml_unregister_component("globals");
+        lui_xml_register_component_from_data("globals", globals_xml);
+        lv_obj_t * other = lui_xml_create(screen, "sc_other", NULL);
+        ok = strcmp(item_text(other), "5") == 0;
+        lv_obj_clean(screen);
+    }
+
+    lv_subject_set_int(lui_xml_get_subject(NULL, "sc_value"), 9);
+    item = lui_xml_create(screen, "sc_item", NULL);
+    ok = ok && strcmp(item_text(item), "9") == 0;
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("sc_other");
+    lui_xml_unregister_component("sc_item");
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (bound to a stale subject)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+int test_cache_bench(void)
+{
+    printf("TEST: Benchmark of %d instances with %d global subjects...\n", BENCH_INSTANCE_COUNT,
+           BENCH_SUBJECT_COUNT);
+
+#if LV_USE_LABEL
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("sc_item", item_xml);
+
+    /* The subjects registered later are searched first */
+    char name[32];
+    uint32_t i;
+    for (i = 0; i < BENCH_SUBJECT_COUNT; i++) {
+        snprintf(name, sizeof(name), "sc_other_%u", (unsigned)i);
+        lv_subject_init_int(&bench_subjects[i], 0);
+        lui_xml_register_subject(NULL, name, &bench_subjects[i]);
+    }
+
+    lv_obj_t * screen = test_create_screen();
+    double start = now_ms();
+    for (i = 0; i < BENCH_INSTANCE_COUNT; i++) lui_xml_create(screen, "sc_item", NULL);
+    double create_time = now_ms() - start;
+
+    bool ok = lv_obj_get_child_count(screen) == BENCH_INSTANCE_COUNT;
+    printf("  create: %.1f ms\n", create_time);
+
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("sc_item");
+    lui_xml_unregister_component("globals");
+    for (i = 0; i < BENCH_SUBJECT_COUNT; i++) lv_subject_deinit(&bench_subjects[i]);
+
+    printf(ok ? "PASS\n" : "FAIL\n");
+    if (!ok) return 1;
+#else
+    printf("SKIP (requires LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Subject Cache Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_cache_instances();
+    failed += test_cache_hidden_global();
+    failed += test_cache_reused_slot();
+    failed += test_cache_bench();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_subject_deferred.c
+ * @brief Deferred subjects: many changes per frame update the bound widgets only once
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_subject.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <subjects>\n"
+    "    <int name=\"sd_speed\" value=\"0\" deferred=\"true\"/>\n"
+    "    <int name=\"sd_level\" value=\"0\"/>\n"
+    "  </subjects>\n"
+    "</globals>\n";
+
+static const char * view_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\">\n"
+    "    <lv_label name=\"speed\" bind_text=\"sd_speed\"/>\n"
+    "    <lv_label name=\"level\" bind_text=\"sd_level\"/>\n"
+    "    <lv_slider name=\"slider\" bind_value=\"sd_speed\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+static lv_obj_t * create_view(lv_obj_t * screen)
+{
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("sd_view", view_xml);
+    return lui_xml_create(screen, "sd_view", NULL);
+}
+
+static void delete_view(lv_obj_t * screen)
+{
+    test_cleanup_screen(screen);
+    lui_xml_unregister_component("sd_view");
+    lui_xml_unregister_component("globals");
+}
+
+/* Test: Only the last of many changes is shown, and only after a flush */
+int test_subject_deferred_coalesce(void)
+{
+    printf("TEST: Coalesce the changes of a deferred subject... ");
+
+#if LV_USE_SLIDER && LV_USE_LABEL
+    lv_obj_t * screen = test_create_screen();
+    lv_obj_t * view = create_view(screen);
+    lv_obj_t * speed = lv_obj_find_by_name(view, "speed");
+    lv_obj_t * level = lv_obj_find_by_name(view, "level");
+    lv_subject_t * speed_subject = lui_xml_get_subject(NULL, "sd_speed");
+    lv_subject_t * level_subject = lui_xml_get_subject(NULL, "sd_level");
+
+    bool ok = speed && level && speed_subject && level_subject;
+    for(int32_t i = 1; ok && i <= 50; i++) {
+        lv_subject_set_int(speed_subject, i);
+        lv_subject_set_int(level_subject, i);
+    }
+
+    /* The application sees the new value at once, the widgets only after the flush */
+    ok = ok && lv_subject_get_int(speed_subject) == 50;
+    ok = ok && strcmp(lv_label_get_text(speed), "0") == 0;
+    ok = ok && strcmp(lv_label_get_text(level), "50") == 0;
+
+    lui_xml_subjects_flush();
+    ok = ok && strcmp(lv_label_get_text(speed), "50") == 0;
+
+    delete_view(screen);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the label wasn't updated once)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_SLIDER and LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+/* Test: The flush timer delivers the changes once per period */
+int test_subject_deferred_timer(void)
+{
+    printf("TEST: Flush the deferred subjects from the timer... ");
+
+#if LV_USE_SLIDER && LV_USE_LABEL
+    lv_obj_t * screen = test_create_screen();
+    lv_obj_t * view = create_view(screen);
+    lv_obj_t * speed = lv_obj_find_by_name(view, "speed");
+    lv_subject_t * speed_subject = lui_xml_get_subject(NULL, "sd_speed");
+
+    bool ok = speed && speed_subject;
+    if(ok) lv_subject_set_int(speed_subject, 12);
+    ok = ok && strcmp(lv_label_get_text(speed), "0") == 0;
+
+    lv_tick_inc(LUI_XML_SUBJECT_FLUSH_PERIOD);
+    lv_timer_handler();
+    ok = ok && strcmp(lv_label_get_text(speed), "12") == 0;
+
+    delete_view(screen);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the label wasn't updated by the timer)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_SLIDER and LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+/* Test: A change made by a widget reaches the subject immediately */
+int test_subject_deferred_two_way(void)
+{
+    printf("TEST: Pass the changes of a widget to a deferred subject... ");
+
+#if LV_USE_SLIDER && LV_USE_LABEL
+    lv_obj_t * screen = test_create_screen();
+    lv_obj_t * view = create_view(screen);
+    lv_obj_t * slider = lv_obj_find_by_name(view, "slider");
+    lv_obj_t * speed = lv_obj_find_by_name(view, "speed");
+    lv_subject_t * speed_subject = lui_xml_get_subject(NULL, "sd_speed");
+
+    bool ok = slider && speed && speed_subject;
+    if(ok) {
+        lv_slider_set_value(slider, 40, LV_ANIM_OFF);
+        lv_obj_send_event(slider, LV_EVENT_VALUE_CHANGED, NULL);
+    }
+    ok = ok && lv_subject_get_int(speed_subject) == 40;
+
+    /* The label is bound to the same relay so it's already updated */
+    ok = ok && strcmp(lv_label_get_text(speed), "40") == 0;
+
+    delete_view(screen);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the subject wasn't changed)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_SLIDER and LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Deferred Subject Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_subject_deferred_coalesce();
+    failed += test_subject_deferred_timer();
+    failed += test_subject_deferred_two_way();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
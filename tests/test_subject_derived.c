@@ -0,0 +1,238 @@
+/**
+ * @file test_subject_derived.c
+ * @brief Derived subjects: subjects computed from an expression of other subjects
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_subject.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NESTING_COUNT   10000
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <subjects>\n"
+    "    <int name=\"temp_c\" value=\"20\"/>\n"
+    "    <int name=\"temp_limit\" value=\"30\"/>\n"
+    "    <int name=\"temp_f\" expr=\"temp_c * 9 / 5 + 32\"/>\n"
+    "    <int name=\"alarm\" expr=\"temp_c &gt; temp_limit\"/>\n"
+    "    <int name=\"level\" expr=\"temp_c &lt; 0 ? 0 : min(temp_c, 100)\"/>\n"
+    "    <int name=\"plus_one\" expr=\"temp_c + 1\"/>\n"
+    "    <int name=\"times_two\" expr=\"temp_c * 2\"/>\n"
+    "    <int name=\"sum\" expr=\"plus_one + times_two\"/>\n"
+    "    <int name=\"broken\" value=\"7\" expr=\"temp_c +\"/>\n"
+    "    <int name=\"unknown\" value=\"8\" expr=\"no_such_subject\"/>\n"
+    "  </subjects>\n"
+    "</globals>\n";
+
+static uint32_t notify_cnt;
+static int32_t sum_seen[8];
+
+static void sum_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    (void)observer;
+    if (notify_cnt < 8) sum_seen[notify_cnt] = lv_subject_get_int(subject);
+    notify_cnt++;
+}
+
+static int32_t get(const char * name)
+{
+    lv_subject_t * subject = lui_xml_get_subject(NULL, name);
+    return subject ? lv_subject_get_int(subject) : INT32_MIN;
+}
+
+/* Test: The derived subjects follow their inputs */
+int test_derived_values(void)
+{
+    printf("TEST: Compute subjects from expressions... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lv_subject_t * temp_c = lui_xml_get_subject(NULL, "temp_c");
+
+    bool ok = temp_c != NULL;
+    ok = ok && get("temp_f") == 68 && get("alarm") == 0 && get("level") == 20;
+
+    if (ok) lv_subject_set_int(temp_c, 35);
+    ok = ok && get("temp_f") == 95 && get("alarm") == 1 && get("level") == 35;
+
+    if (ok) lv_subject_set_int(lui_xml_get_subject(NULL, "temp_limit"), 40);
+    ok = ok && get("alarm") == 0;
+
+    if (ok) lv_subject_set_int(temp_c, -5);
+    ok = ok && get("temp_f") == 23 && get("level") == 0;
+
+    /* Invalid expressions leave the subject as a plain one */
+    ok = ok && get("broken") == 7 && get("unknown") == 8;
+
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (wrong value)\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: A subject depending on the same input twice is computed once, from the new values */
+int test_derived_glitch_free(void)
+{
+    printf("TEST: Update a diamond of derived subjects... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lv_subject_t * temp_c = lui_xml_get_subject(NULL, "temp_c");
+    lv_subject_t * sum = lui_xml_get_subject(NULL, "sum");
+
+    bool ok = temp_c && sum && lv_subject_get_int(sum) == 61;
+    lv_observer_t * observer = NULL;
+    if (ok) {
+        observer = lv_subject_add_observer(sum, sum_observer_cb, NULL);
+        notify_cnt = 0;
+        lv_subject_set_int(temp_c, 10);
+    }
+    /* Never (10 + 1) + 20*2 = 51 */
+    ok = ok && notify_cnt == 1 && sum_seen[0] == 31;
+
+    /* No change, no notification */
+    notify_cnt = 0;
+    if (ok) lv_subject_set_int(temp_c, 10);
+    ok = ok && notify_cnt == 0;
+
+    if (observer) lv_observer_remove(observer);
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (notified %u times)\n", (unsigned)notify_cnt);
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: Setting the inputs in a batch computes the derived subjects once */
+int test_derived_batch(void)
+{
+    printf("TEST: Set the inputs of a derived subject in a batch... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lv_subject_t * alarm = lui_xml_get_subject(NULL, "alarm");
+    lui_xml_subject_handle_t handles[2] = {
+        lui_xml_subject_get_handle(NULL, "temp_c"),
+        lui_xml_subject_get_handle(NULL, "temp_limit"),
+    };
+
+    bool ok = alarm && handles[0] && handles[1];
+    lv_observer_t * observer = NULL;
+    if (ok) {
+        observer = lv_subject_add_observer(alarm, sum_observer_cb, NULL);
+        notify_cnt = 0;
+        /* 50 > 30 would raise the alarm if it was computed before the limit is set */
+        int32_t values[2] = {50, 60};
+        lui_xml_subjects_set_batch(handles, values, 2);
+    }
+    ok = ok && notify_cnt == 0 && lv_subject_get_int(alarm) == 0;
+
+    if (observer) lv_observer_remove(observer);
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: A component's subject computed from a global one stops when the global is unregistered */
+int test_derived_unregister(void)
+{
+    printf("TEST: Unregister the inputs of a derived subject... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lui_xml_register_component_from_data("ds_item",
+                                         "<component>\n"
+                                         "  <subjects>\n"
+                                         "    <int name=\"local_f\" expr=\"temp_f - 32\"/>\n"
+                                         "  </subjects>\n"
+                                         "  <view extends=\"lv_obj\"/>\n"
+                                         "</component>\n");
+
+    lui_xml_unregister_component("globals");
+    lui_xml_unregister_component("ds_item");
+
+    printf("PASS\n");
+    return 0;
+}
+
+/* Test: Too deeply nested expressions are rejected instead of overflowing the stack */
+int test_derived_nesting(void)
+{
+    printf("TEST: Reject deeply nested expressions... ");
+
+    static char xml[4 * NESTING_COUNT + 512];
+    char expr[2 * NESTING_COUNT + 2];
+    int i;
+
+    /* Parentheses */
+    for (i = 0; i < NESTING_COUNT; i++) expr[i] = '(';
+    expr[i] = '1';
+    for (i = 0; i < NESTING_COUNT; i++) expr[NESTING_COUNT + 1 + i] = ')';
+    expr[2 * NESTING_COUNT + 1] = '\0';
+    int len = snprintf(xml, sizeof(xml),
+                       "<globals>\n"
+                       "  <subjects>\n"
+                       "    <int name=\"parens\" value=\"7\" expr=\"%s\"/>\n", expr);
+
+    /* Unary operators */
+    for (i = 0; i < NESTING_COUNT; i++) expr[i] = '-';
+    expr[i] = '1';
+    expr[i + 1] = '\0';
+    len += snprintf(xml + len, sizeof(xml) - len, "    <int name=\"negs\" value=\"8\" expr=\"%s\"/>\n", expr);
+
+    snprintf(xml + len, sizeof(xml) - len,
+             "    <int name=\"shallow\" expr=\"((-(1 + 2)) * abs(-3))\"/>\n"
+             "  </subjects>\n"
+             "</globals>\n");
+
+    lui_xml_register_component_from_data("globals", xml);
+    bool ok = get("parens") == 7 && get("negs") == 8 && get("shallow") == -9;
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (wrong value)\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Derived Subject Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_derived_values();
+    failed += test_derived_glitch_free();
+    failed += test_derived_batch();
+    failed += test_derived_unregister();
+    failed += test_derived_nesting();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
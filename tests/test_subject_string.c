@@ -0,0 +1,220 @@
+/**
+ * @file test_subject_string.c
+ * @brief String subjects: default size, `max_length`, auto sized and `growable` buffers
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char * globals_xml =
+    "<globals>\n"
+    "  <subjects>\n"
+    "    <string name=\"ss_default\" value=\"Idle\"/>\n"
+    "    <string name=\"ss_short\" value=\"Idle\" max_length=\"8\"/>\n"
+    "    <string name=\"ss_auto\" value=\"Idle\" max_length=\"auto\"/>\n"
+    "    <string name=\"ss_auto_long\" value=\"Temperature and humidity\" max_length=\"auto\"/>\n"
+    "    <string name=\"ss_growable\" value=\"\" growable=\"true\"/>\n"
+    "    <string name=\"ss_growable_max\" value=\"ab\" max_length=\"4\" growable=\"true\"/>\n"
+    "  </subjects>\n"
+    "</globals>\n";
+
+#define AUTO_SUBJECT_COUNT  50
+
+static char long_str[1024];
+static char subjects_xml[AUTO_SUBJECT_COUNT * 96 + 64];
+
+static void make_long_str(size_t len)
+{
+    size_t i;
+    for (i = 0; i < len; i++) long_str[i] = 'a' + (char)(i % 26);
+    long_str[len] = '\0';
+}
+
+/* Create a globals file with many string subjects with the given `max_length` attribute */
+static void make_subjects_xml(const char * max_length_attr)
+{
+    size_t len = (size_t)snprintf(subjects_xml, sizeof(subjects_xml), "<globals>\n  <subjects>\n");
+    uint32_t i;
+    for (i = 0; i < AUTO_SUBJECT_COUNT; i++) {
+        len += (size_t)snprintf(subjects_xml + len, sizeof(subjects_xml) - len,
+                                "    <string name=\"ss_many_%u\" value=\"Label %u\"%s/>\n",
+                                (unsigned)i, (unsigned)i, max_length_attr);
+    }
+    snprintf(subjects_xml + len, sizeof(subjects_xml) - len, "  </subjects>\n</globals>\n");
+}
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+/* Get how much memory registering the subjects in `subjects_xml` takes */
+static size_t measure_subjects_xml(void)
+{
+    lv_mem_monitor_t mon_before;
+    lv_mem_monitor(&mon_before);
+
+    lui_xml_register_component_from_data("globals", subjects_xml);
+
+    lv_mem_monitor_t mon_after;
+    lv_mem_monitor(&mon_after);
+
+    lui_xml_unregister_component("globals");
+
+    size_t used_before = mon_before.total_size - mon_before.free_size;
+    size_t used_after = mon_after.total_size - mon_after.free_size;
+    return used_after > used_before ? used_after - used_before : 0;
+}
+#endif
+
+/* Test: Without max_length the buffer keeps the default size */
+int test_string_default(void)
+{
+    printf("TEST: Default size of string subjects... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lv_subject_t * subject = lui_xml_get_subject(NULL, "ss_default");
+
+    bool ok = subject && strcmp(lv_subject_get_string(subject), "Idle") == 0;
+    ok = ok && subject->size == LUI_XML_STRING_SUBJECT_DEFAULT_SIZE;
+
+    /* Longer than the initial value, but fits the default size */
+    make_long_str(200);
+    if (ok) lv_subject_copy_string(subject, long_str);
+    ok = ok && strcmp(lv_subject_get_string(subject), long_str) == 0;
+
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the string was truncated)\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: max_length limits the length of the string */
+int test_string_max_length(void)
+{
+    printf("TEST: String subject with max_length... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lv_subject_t * subject = lui_xml_get_subject(NULL, "ss_short");
+
+    bool ok = subject && subject->size == 9;
+    ok = ok && lui_xml_subject_copy_string(subject, "12345678") == LV_RESULT_OK;
+    ok = ok && strcmp(lv_subject_get_string(subject), "12345678") == 0;
+    ok = ok && lui_xml_subject_copy_string(subject, "0123456789") == LV_RESULT_INVALID;
+    ok = ok && strcmp(lv_subject_get_string(subject), "01234567") == 0;
+
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (wrong string)\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: max_length="auto" sizes the buffer to the initial value */
+int test_string_auto_size(void)
+{
+    printf("TEST: Auto sized string subjects... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lv_subject_t * subject = lui_xml_get_subject(NULL, "ss_auto");
+    lv_subject_t * subject_long = lui_xml_get_subject(NULL, "ss_auto_long");
+
+    bool ok = subject && subject_long && subject->size == LUI_XML_STRING_SUBJECT_MIN_SIZE && subject_long->size == 25;
+    ok = ok && strcmp(lv_subject_get_string(subject_long), "Temperature and humidity") == 0;
+
+    /* Like with max_length, longer strings are truncated */
+    ok = ok && lui_xml_subject_copy_string(subject_long, "Temperature and humidity!") == LV_RESULT_INVALID;
+
+    lui_xml_unregister_component("globals");
+
+    if (!ok) {
+        printf("FAIL (wrong buffer size)\n");
+        return 1;
+    }
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    make_subjects_xml("");
+    size_t default_size = measure_subjects_xml();
+    make_subjects_xml(" max_length=\"auto\"");
+    size_t auto_size = measure_subjects_xml();
+
+    /* Each subject has 2 buffers, which shrink from the default size to the minimum.
+     * Allow some difference as the arena allocates in chunks. */
+    size_t saved_min = AUTO_SUBJECT_COUNT * 2 * (LUI_XML_STRING_SUBJECT_DEFAULT_SIZE - LUI_XML_STRING_SUBJECT_MIN_SIZE);
+    saved_min = saved_min * 3 / 4;
+    printf("(%u -> %u bytes) ", (unsigned)default_size, (unsigned)auto_size);
+    if (auto_size + saved_min > default_size) {
+        printf("FAIL (expected to save at least %u bytes)\n", (unsigned)saved_min);
+        return 1;
+    }
+#endif
+
+    printf("PASS\n");
+    return 0;
+}
+
+/* Test: Growable subjects are enlarged to fit the new strings */
+int test_string_growable(void)
+{
+    printf("TEST: Growable string subjects... ");
+
+    lui_xml_register_component_from_data("globals", globals_xml);
+    lv_subject_t * subject = lui_xml_get_subject(NULL, "ss_growable");
+    lv_subject_t * subject_max = lui_xml_get_subject(NULL, "ss_growable_max");
+
+    bool ok = subject && subject_max && subject->size == LUI_XML_STRING_SUBJECT_MIN_SIZE && subject_max->size == 5;
+
+    make_long_str(1000);
+    ok = ok && lui_xml_subject_copy_string(subject, long_str) == LV_RESULT_OK;
+    ok = ok && strcmp(lv_subject_get_string(subject), long_str) == 0 && subject->size >= 1001;
+
+    /* max_length is only the initial capacity */
+    ok = ok && lui_xml_subject_copy_string(subject_max, "abcdefgh") == LV_RESULT_OK;
+    ok = ok && strcmp(lv_subject_get_string(subject_max), "abcdefgh") == 0;
+
+    /* The previous value is kept too */
+    ok = ok && lui_xml_subject_copy_string(subject_max, "x") == LV_RESULT_OK;
+    ok = ok && strcmp(lv_subject_get_previous_string(subject_max), "abcdefgh") == 0;
+
+    lui_xml_unregister_component("globals");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the buffer didn't grow)\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML String Subject Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_string_default();
+    failed += test_string_max_length();
+    failed += test_string_auto_size();
+    failed += test_string_growable();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
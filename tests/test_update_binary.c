@@ -0,0 +1,257 @@
+/**
+ * @file test_update_binary.c
+ * @brief Binary updates: XML update snippets converted to records and applied, with a benchmark
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_update.h"
+#include "lui_xml_update_bin.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SLIDER_COUNT  100
+#define BENCH_BATCH_COUNT   1000
+#define STALE_REUSE_COUNT   300
+
+static const char * screen_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <lv_slider name=\"volume\" value=\"10\"/>\n"
+    "    <lv_label name=\"title\" text=\"Home\"/>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* Test: The converted update sets the same properties as the XML update */
+int test_binary_convert_apply(void)
+{
+    printf("TEST: Convert and apply a binary update... ");
+
+#if LV_USE_SLIDER && LV_USE_LABEL
+    lui_xml_register_component_from_data("bin_home", screen_xml);
+    lv_obj_t * screen = lui_xml_create_screen("bin_home");
+    if (screen == NULL) {
+        printf("FAIL (couldn't create the screen)\n");
+        lui_xml_unregister_component("bin_home");
+        return 1;
+    }
+    lv_screen_load(screen);
+
+    uint32_t len = 0;
+    void * bin = lui_xml_update_to_binary(
+                     "<updates>\n"
+                     "  <update-lv_slider name=\"volume\" value=\"30\" width=\"120\" style_bg_color=\"0x112233\"/>\n"
+                     "  <update-lv_slider name=\"volume\" max_value=\"200\"/>\n"
+                     "  <update-lv_label name=\"title\" text=\"Audio\"/>\n"
+                     "</updates>\n", &len);
+
+    lv_obj_t * volume = lui_xml_update_find("volume");
+    lv_obj_t * title = lui_xml_update_find("title");
+
+    bool ok = bin && volume && title && lui_xml_update_apply_binary(bin, len) == LV_RESULT_OK;
+    ok = ok && lv_slider_get_value(volume) == 30 && lv_obj_get_style_width(volume, 0) == 120 &&
+         lv_slider_get_max_value(volume) == 200 && strcmp(lv_label_get_text(title), "Audio") == 0 &&
+         lv_color_to_int(lv_obj_get_style_bg_color(volume, 0)) == 0x112233;
+
+    /* A corrupted update is rejected */
+    if (ok) {
+        lui_xml_update_bin_header_t * header = bin;
+        header->record_cnt++;
+        ok = lui_xml_update_apply_binary(bin, len) == LV_RESULT_INVALID;
+    }
+    lv_free(bin);
+
+    /* The handles of deleted widgets are invalid */
+    uint32_t handle = lui_xml_update_get_handle("volume");
+    ok = ok && handle != 0 && handle == lui_xml_update_get_handle("volume");
+    lv_obj_t * empty = test_create_screen();
+    lv_obj_delete(screen);
+    lui_xml_unregister_component("bin_home");
+
+    struct {
+        lui_xml_update_bin_header_t header;
+        lui_xml_update_bin_record_t record;
+    } stale = {{{'L', 'X', 'U', 'P'}, LUI_XML_UPDATE_BIN_VERSION, LUI_XML_UPDATE_BIN_BYTE_ORDER, 1, 0},
+        {handle, LUI_XML_UPDATE_PROP_X, 10}
+    };
+    ok = ok && lui_xml_update_apply_binary(&stale, sizeof(stale)) == LV_RESULT_OK;
+    test_cleanup_screen(empty);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the properties were not set)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_SLIDER and LV_USE_LABEL)\n");
+#endif
+    return 0;
+}
+
+/* Test: Compare the speed of XML and binary updates */
+int test_binary_bench(void)
+{
+    printf("TEST: Benchmark of %d x %d slider updates...\n", BENCH_BATCH_COUNT, BENCH_SLIDER_COUNT);
+
+#if LV_USE_SLIDER
+    lv_obj_t * screen = test_create_screen();
+    char name[32];
+    int i;
+    for (i = 0; i < BENCH_SLIDER_COUNT; i++) {
+        snprintf(name, sizeof(name), "slider_%d", i);
+        const char * attrs[] = {"name", name, "max_value", "1000000", NULL, NULL};
+        lui_xml_create(screen, "lv_slider", attrs);
+    }
+
+    /* The same batch in both formats, with the values changed in each round */
+    size_t xml_size = BENCH_SLIDER_COUNT * 64 + 32;
+    char * xml = malloc(xml_size);
+    struct {
+        lui_xml_update_bin_header_t header;
+        lui_xml_update_bin_record_t records[BENCH_SLIDER_COUNT];
+    } * bin = malloc(sizeof(*bin));
+    if (xml == NULL || bin == NULL) {
+        printf("FAIL (out of memory)\n");
+        free(xml);
+        free(bin);
+        test_cleanup_screen(screen);
+        return 1;
+    }
+
+    memcpy(bin->header.magic, LUI_XML_UPDATE_BIN_MAGIC, 4);
+    bin->header.version = LUI_XML_UPDATE_BIN_VERSION;
+    bin->header.byte_order = LUI_XML_UPDATE_BIN_BYTE_ORDER;
+    bin->header.record_cnt = BENCH_SLIDER_COUNT;
+    bin->header.str_data_size = 0;
+    for (i = 0; i < BENCH_SLIDER_COUNT; i++) {
+        snprintf(name, sizeof(name), "slider_%d", i);
+        bin->records[i].target = lui_xml_update_get_handle(name);
+        bin->records[i].prop = LUI_XML_UPDATE_PROP_SLIDER_VALUE;
+    }
+
+    double start = now_ms();
+    int batch;
+    for (batch = 0; batch < BENCH_BATCH_COUNT; batch++) {
+        size_t len = snprintf(xml, xml_size, "<updates>");
+        for (i = 0; i < BENCH_SLIDER_COUNT; i++) {
+            len += snprintf(xml + len, xml_size - len, "<update-lv_slider name=\"slider_%d\" value=\"%d\"/>", i,
+                            batch + i);
+        }
+        snprintf(xml + len, xml_size - len, "</updates>");
+        lui_xml_update_from_data(xml);
+    }
+    double xml_time = now_ms() - start;
+
+    bool ok = true;
+    start = now_ms();
+    for (batch = 0; batch < BENCH_BATCH_COUNT; batch++) {
+        for (i = 0; i < BENCH_SLIDER_COUNT; i++) bin->records[i].value = batch + i + 1;
+        if (lui_xml_update_apply_binary(bin, sizeof(*bin)) != LV_RESULT_OK) ok = false;
+    }
+    double bin_time = now_ms() - start;
+
+    snprintf(name, sizeof(name), "slider_%d", BENCH_SLIDER_COUNT - 1);
+    ok = ok && lv_slider_get_value(lui_xml_update_find(name)) == BENCH_BATCH_COUNT + BENCH_SLIDER_COUNT - 1;
+
+    double update_cnt = (double)BENCH_BATCH_COUNT * BENCH_SLIDER_COUNT;
+    printf("  XML:    %.1f ms (%.0f updates/s)\n", xml_time, xml_time > 0 ? update_cnt * 1000.0 / xml_time : 0.0);
+    printf("  binary: %.1f ms (%.0f updates/s)\n", bin_time, bin_time > 0 ? update_cnt * 1000.0 / bin_time : 0.0);
+
+    free(xml);
+    free(bin);
+    test_cleanup_screen(screen);
+
+    printf(ok ? "PASS\n" : "FAIL\n");
+    if (!ok) return 1;
+#else
+    printf("SKIP (requires LV_USE_SLIDER)\n");
+#endif
+    return 0;
+}
+
+/* Test: The handle of a deleted widget stays invalid after its slot was reused many times */
+int test_binary_stale_handle(void)
+{
+    printf("TEST: Stale handles after %d reuses... ", STALE_REUSE_COUNT);
+
+#if LV_USE_SLIDER
+    lv_obj_t * screen = test_create_screen();
+    const char * attrs[] = {"name", "reused", NULL, NULL};
+
+    lv_obj_t * first = lui_xml_create(screen, "lv_slider", attrs);
+    uint32_t stale = lui_xml_update_get_handle("reused");
+    lv_obj_delete(first);
+
+    struct {
+        lui_xml_update_bin_header_t header;
+        lui_xml_update_bin_record_t record;
+    } bin;
+    memcpy(bin.header.magic, LUI_XML_UPDATE_BIN_MAGIC, 4);
+    bin.header.version = LUI_XML_UPDATE_BIN_VERSION;
+    bin.header.byte_order = LUI_XML_UPDATE_BIN_BYTE_ORDER;
+    bin.header.record_cnt = 1;
+    bin.header.str_data_size = 0;
+    bin.record.target = stale;
+    bin.record.prop = LUI_XML_UPDATE_PROP_SLIDER_VALUE;
+    bin.record.value = 42;
+
+    /* Each new widget gets the freed slot with the next generation */
+    bool ok = stale != 0;
+    int i;
+    for (i = 0; ok && i < STALE_REUSE_COUNT; i++) {
+        lv_obj_t * slider = lui_xml_create(screen, "lv_slider", attrs);
+        uint32_t handle = lui_xml_update_get_handle("reused");
+        ok = slider && handle != 0 && handle != stale;
+        ok = ok && lui_xml_update_apply_binary(&bin, sizeof(bin)) == LV_RESULT_OK;
+        ok = ok && lv_slider_get_value(slider) != 42;
+        lv_obj_delete(slider);
+    }
+
+    test_cleanup_screen(screen);
+
+    if (!ok) {
+        printf("FAIL (a stale handle was resolved after %d reuses)\n", i);
+        return 1;
+    }
+    printf("PASS\n");
+#else
+    printf("SKIP (requires LV_USE_SLIDER)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Binary Update Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_binary_convert_apply();
+    failed += test_binary_bench();
+    failed += test_binary_stale_handle();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file test_update_name_index.c
+ * @brief Name index: the targets of the updates are found by name, also on inactive screens
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_update.h"
+#include "lui_xml_component.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char * screen_xml =
+    "<screen>\n"
+    "  <view>\n"
+    "    <lv_obj name=\"panel\">\n"
+    "      <lv_slider name=\"volume\" value=\"10\"/>\n"
+    "    </lv_obj>\n"
+    "  </view>\n"
+    "</screen>\n";
+
+/* Test: Widgets are updated on the active and on an inactive screen */
+int test_update_screens(void)
+{
+    printf("TEST: Update widgets by name and by screen/name... ");
+
+#if LV_USE_OBJ_NAME && LV_USE_SLIDER
+    lui_xml_register_component_from_data("index_home", screen_xml);
+    lui_xml_register_component_from_data("index_settings", screen_xml);
+
+    lv_obj_t * home = lui_xml_create_screen("index_home");
+    lv_obj_t * settings = lui_xml_create_screen("index_settings");
+    if (home == NULL || settings == NULL) {
+        printf("FAIL (couldn't create the screens)\n");
+        if (home) lv_obj_delete(home);
+        if (settings) lv_obj_delete(settings);
+        return 1;
+    }
+    lv_screen_load(home);
+
+    lv_obj_t * home_volume = lui_xml_update_find("volume");
+    lv_obj_t * settings_volume = lui_xml_update_find("index_settings/volume");
+
+    lv_result_t res = lui_xml_update_from_data(
+                          "<updates>\n"
+                          "  <update-lv_slider name=\"volume\" value=\"30\"/>\n"
+                          "  <update-lv_slider name=\"index_settings/volume\" value=\"70\"/>\n"
+                          "</updates>\n");
+
+    bool ok = res == LV_RESULT_OK && home_volume && settings_volume && home_volume != settings_volume &&
+              lv_obj_get_screen(home_volume) == home && lv_obj_get_screen(settings_volume) == settings;
+    ok = ok && lv_slider_get_value(home_volume) == 30 && lv_slider_get_value(settings_volume) == 70;
+
+#if LUI_XML_USE_NAME_INDEX
+    /* Deleted widgets are not found any more */
+    lv_obj_delete(settings);
+    settings = NULL;
+    ok = ok && lui_xml_update_find("index_settings/volume") == NULL;
+#endif
+
+    lv_obj_t * empty = test_create_screen();
+    lv_obj_delete(home);
+    if (settings) lv_obj_delete(settings);
+    lui_xml_unregister_component("index_home");
+    lui_xml_unregister_component("index_settings");
+    test_cleanup_screen(empty);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the widgets were not updated)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_OBJ_NAME and LV_USE_SLIDER)\n");
+#endif
+    return 0;
+}
+
+/* Test: Renamed widgets are found by their new name */
+int test_update_renamed(void)
+{
+    printf("TEST: Renamed widgets... ");
+
+#if LV_USE_OBJ_NAME
+    lv_obj_t * screen = test_create_screen();
+
+    const char * attrs[] = {"name", "old_name", NULL, NULL};
+    lv_obj_t * obj = lui_xml_create(screen, "lv_obj", attrs);
+    lv_obj_set_name(obj, "new_name");
+
+    bool ok = obj && lui_xml_update_find("old_name") == NULL && lui_xml_update_find("new_name") == obj;
+    ok = ok && lui_xml_update_find("missing") == NULL;
+
+    test_cleanup_screen(screen);
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the widget was not found by its new name)\n");
+        return 1;
+    }
+#else
+    printf("SKIP (requires LV_USE_OBJ_NAME)\n");
+#endif
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML Update Name Index Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_update_screens();
+    failed += test_update_renamed();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
@@ -7,6 +7,9 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
 
 /* Static test display */
 static lv_display_t *test_display = NULL;
@@ -110,3 +113,85 @@ void test_cleanup_screen(lv_obj_t *screen)
         lv_obj_delete(screen);
     }
 }
+
+/**
+ * Write a text file
+ */
+int test_write_file(const char *dir, const char *name, const char *content)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return -1;
+    fputs(content, f);
+    fclose(f);
+    return 0;
+}
+
+/**
+ * Create a directory with text files
+ */
+int test_create_dir(const char *dir, const char * const *files)
+{
+    mkdir(dir, 0755);
+
+    for (; files[0] != NULL; files += 2) {
+        if (test_write_file(dir, files[0], files[1]) != 0) return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Remove a directory and the files in it
+ */
+void test_remove_dir(const char *dir)
+{
+    DIR *d = opendir(dir);
+    if (d != NULL) {
+        struct dirent *entry;
+        while ((entry = readdir(d)) != NULL) {
+            if (entry->d_name[0] == '.') continue;
+
+            char path[256];
+            snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+            remove(path);
+        }
+        closedir(d);
+    }
+
+    remove(dir);
+}
+
+/**
+ * Dump an object tree
+ */
+void test_dump_tree(lv_obj_t *obj, int depth, char *buf, size_t buf_size)
+{
+    size_t len = strlen(buf);
+    const lv_obj_class_t *class_p = lv_obj_get_class(obj);
+    snprintf(buf + len, buf_size - len, "%*s%s %dx%d@%d,%d r=%d pad=%d bg=%06x children=%u%s%s\n",
+             depth * 2, "",
+             class_p->name ? class_p->name : "?",
+             (int)lv_obj_get_width(obj), (int)lv_obj_get_height(obj),
+             (int)lv_obj_get_x(obj), (int)lv_obj_get_y(obj),
+             (int)lv_obj_get_style_radius(obj, LV_PART_MAIN),
+             (int)lv_obj_get_style_pad_top(obj, LV_PART_MAIN),
+             (unsigned)lv_color_to_u32(lv_obj_get_style_bg_color(obj, LV_PART_MAIN)) & 0xffffff,
+             (unsigned)lv_obj_get_child_count(obj),
+             lv_obj_check_type(obj, &lv_label_class) ? " text=" : "",
+             lv_obj_check_type(obj, &lv_label_class) ? lv_label_get_text(obj) : "");
+
+#if LV_USE_OBJ_NAME
+    len = strlen(buf);
+    char name[64];
+    lv_obj_get_name_resolved(obj, name, sizeof(name));
+    snprintf(buf + len, buf_size - len, "%*sname=%s\n", depth * 2 + 2, "", name);
+#endif
+
+    uint32_t i;
+    for (i = 0; i < lv_obj_get_child_count(obj); i++) {
+        test_dump_tree(lv_obj_get_child(obj, i), depth + 1, buf, buf_size);
+    }
+}
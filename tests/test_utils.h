@@ -50,4 +50,45 @@ lv_obj_t* test_create_screen(void);
  */
 void test_cleanup_screen(lv_obj_t *screen);
 
+/**
+ * Write a text file
+ *
+ * @param dir Directory of the file, it must exist
+ * @param name Name of the file in the directory
+ * @param content NULL terminated text to write
+ * @return 0 on success, -1 on failure
+ */
+int test_write_file(const char *dir, const char *name, const char *content);
+
+/**
+ * Create a directory with text files
+ *
+ * @param dir Directory to create
+ * @param files NULL terminated list of file name and content pairs
+ * @return 0 on success, -1 on failure
+ */
+int test_create_dir(const char *dir, const char * const *files);
+
+/**
+ * Remove a directory and the files in it
+ *
+ * Subdirectories are not removed.
+ *
+ * @param dir Directory to remove
+ */
+void test_remove_dir(const char *dir);
+
+/**
+ * Dump an object tree
+ *
+ * Appends the class, layout, styles, text and name of every object
+ * to a buffer in tree order, so that two trees can be compared as strings.
+ *
+ * @param obj Root of the tree
+ * @param depth Indentation level of the root
+ * @param buf Buffer to append to, it must be NULL terminated
+ * @param buf_size Size of the buffer
+ */
+void test_dump_tree(lv_obj_t *obj, int depth, char *buf, size_t buf_size);
+
 #endif /* TEST_UTILS_H */
@@ -0,0 +1,121 @@
+/**
+ * @file test_view_def_static.c
+ * @brief View definitions referenced in place from a buffer which is not NULL terminated
+ */
+
+#include "test_utils.h"
+
+/* Include the real Lui-XML headers from extracted code */
+#include "lui_xml.h"
+#include "lui_xml_memory.h"
+#include "lui_xml_component.h"
+#include "lui_xml_component_private.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char * card_xml =
+    "<component>\n"
+    "  <view extends=\"lv_obj\" width=\"123\">\n"
+    "    <lv_obj height=\"45\"/>\n"
+    "  </view>\n"
+    "</component>\n";
+
+/* The XML followed by bytes which are not part of it, like the next file in a blob */
+static char blob[512];
+static size_t card_len;
+
+static void fill_blob(void)
+{
+    card_len = strlen(card_xml);
+    memset(blob, '<', sizeof(blob));
+    memcpy(blob, card_xml, card_len);
+}
+
+static bool check_instance(const char * name)
+{
+    lv_obj_t * screen = test_create_screen();
+    lv_obj_t * card = lui_xml_create(screen, name, NULL);
+    lv_obj_t * child = card ? lv_obj_get_child(card, 0) : NULL;
+    bool ok = child && lv_obj_get_child_count(card) == 1;
+    if (ok) {
+        lv_obj_update_layout(card);
+        ok = lv_obj_get_width(card) == 123 && lv_obj_get_height(child) == 45;
+    }
+    test_cleanup_screen(screen);
+    return ok;
+}
+
+/* Test: A static buffer is referenced, not copied */
+int test_view_def_in_place(void)
+{
+    printf("TEST: Reference the view definition in place... ");
+
+    fill_blob();
+    bool ok = lui_xml_component_register_from_buf("vs_card", blob, card_len, true) == LV_RESULT_OK;
+
+    lui_xml_component_scope_t * scope = lui_xml_component_get_scope("vs_card");
+    ok = ok && scope && scope->view_def_static && scope->view_def >= blob && scope->view_def < blob + card_len;
+    ok = ok && scope->view_def + scope->view_def_len <= blob + card_len;
+
+    lui_xml_memory_stats_t stats;
+    ok = ok && lui_xml_get_memory_stats("vs_card", &stats) == LV_RESULT_OK && stats.view_def_size == 0;
+    ok = ok && check_instance("vs_card");
+
+    lui_xml_unregister_component("vs_card");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the view definition was copied or created wrong)\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* Test: A buffer which is not static is copied and can be overwritten */
+int test_view_def_copied(void)
+{
+    printf("TEST: Copy the view definition of a temporary buffer... ");
+
+    fill_blob();
+    bool ok = lui_xml_component_register_from_buf("vs_card", blob, card_len, false) == LV_RESULT_OK;
+    memset(blob, 0, sizeof(blob));
+
+    lui_xml_component_scope_t * scope = lui_xml_component_get_scope("vs_card");
+    ok = ok && scope && !scope->view_def_static;
+
+    lui_xml_memory_stats_t stats;
+    ok = ok && lui_xml_get_memory_stats("vs_card", &stats) == LV_RESULT_OK && stats.view_def_size > 0;
+    ok = ok && check_instance("vs_card");
+
+    lui_xml_unregister_component("vs_card");
+
+    if (ok) printf("PASS\n");
+    else {
+        printf("FAIL (the view definition was not copied)\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("=== Lui-XML In-Place View Definition Tests ===\n");
+    printf("\n");
+
+    if (test_lvgl_init() != 0) {
+        fprintf(stderr, "Failed to initialize LVGL\n");
+        return 1;
+    }
+
+    failed += test_view_def_in_place();
+    failed += test_view_def_copied();
+
+    test_lvgl_deinit();
+
+    printf("\n=== Tests Complete ===\n");
+
+    return failed ? 1 : 0;
+}
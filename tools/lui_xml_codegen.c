@@ -0,0 +1,79 @@
+/**
+ * @file lui_xml_codegen.c
+ * @brief Generate C code from a directory of XML files for `lui_xml_codegen()`
+ *
+ * Usage: lui_xml_codegen <xml_dir> <module> <out_dir> <name>...
+ *
+ * Writes `<out_dir>/<module>.c` and `<out_dir>/<module>.h` which create the
+ * given components and screens (and the components used by them) without XML.
+ */
+
+#include "lvgl.h"
+#include "lui_xml_load.h"
+#include "lui_xml_codegen.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int write_file(const char * out_dir, const char * module, const char * ext, const char * content)
+{
+    char path[LV_FS_MAX_PATH_LENGTH];
+    snprintf(path, sizeof(path), "%s/%s.%s", out_dir, module, ext);
+
+    FILE * f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return -1;
+    }
+
+    size_t len = strlen(content);
+    int res = fwrite(content, 1, len, f) == len ? 0 : -1;
+    fclose(f);
+
+    if (res != 0) fprintf(stderr, "Failed to write %s\n", path);
+    return res;
+}
+
+int main(int argc, char ** argv)
+{
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <xml_dir> <module> <out_dir> <name>...\n", argv[0]);
+        return 1;
+    }
+
+#if LV_USE_FS_STDIO
+    lv_init();
+
+    char path[LV_FS_MAX_PATH_LENGTH];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, argv[1]);
+
+    if (lui_xml_load_all_from_path(path) != LV_RESULT_OK) {
+        fprintf(stderr, "Failed to load %s\n", argv[1]);
+        lv_deinit();
+        return 1;
+    }
+
+    /* argv is NULL terminated, so the names can be passed as they are */
+    char * source;
+    char * header;
+    if (lui_xml_codegen((const char **)&argv[4], argv[2], &source, &header) != LV_RESULT_OK) {
+        fprintf(stderr, "Failed to generate the code, see the log for the reason\n");
+        lv_deinit();
+        return 1;
+    }
+
+    int res = 0;
+    if (write_file(argv[3], argv[2], "c", source) != 0) res = 1;
+    if (write_file(argv[3], argv[2], "h", header) != 0) res = 1;
+
+    lv_free(source);
+    lv_free(header);
+    lv_deinit();
+
+    if (res == 0) printf("Wrote %s/%s.c and %s/%s.h\n", argv[3], argv[2], argv[3], argv[2]);
+    return res;
+#else
+    fprintf(stderr, "LV_USE_FS_STDIO needs to be enabled\n");
+    return 1;
+#endif
+}
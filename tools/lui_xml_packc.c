@@ -0,0 +1,56 @@
+/**
+ * @file lui_xml_packc.c
+ * @brief Compile a directory of XML files to a binary pack for `lui_xml_load_pack()`
+ *
+ * Usage: lui_xml_packc <xml_dir> <out.bin>
+ *
+ * The pack is written in the byte order of the host, so run the tool on a host
+ * with the same byte order as the target.
+ */
+
+#include "lvgl.h"
+#include "lui_xml_pack.h"
+
+#include <stdio.h>
+
+int main(int argc, char ** argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <xml_dir> <out.bin>\n", argv[0]);
+        return 1;
+    }
+
+#if LV_USE_FS_STDIO
+    lv_init();
+
+    char path[LV_FS_MAX_PATH_LENGTH];
+    snprintf(path, sizeof(path), "%c:%s", LV_FS_STDIO_LETTER, argv[1]);
+
+    uint32_t size;
+    void * pack = lui_xml_pack_compile(path, &size);
+    if (pack == NULL) {
+        fprintf(stderr, "Failed to compile %s\n", argv[1]);
+        lv_deinit();
+        return 1;
+    }
+
+    FILE * f = fopen(argv[2], "wb");
+    if (f == NULL || fwrite(pack, 1, size, f) != size) {
+        fprintf(stderr, "Failed to write %s\n", argv[2]);
+        if (f) fclose(f);
+        lv_free(pack);
+        lv_deinit();
+        return 1;
+    }
+
+    fclose(f);
+    lv_free(pack);
+    lv_deinit();
+
+    printf("Wrote %s (%u bytes)\n", argv[2], (unsigned)size);
+    return 0;
+#else
+    fprintf(stderr, "LV_USE_FS_STDIO needs to be enabled\n");
+    return 1;
+#endif
+}